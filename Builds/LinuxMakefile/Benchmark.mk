@@ -0,0 +1,40 @@
+# Builds the layout and drawing benchmark alongside the m+m manager, from the same objects.
+# The Introjucer regenerates Makefile, so the benchmark is kept in this separate file:
+#
+#   make -f Benchmark.mk [CONFIG=Release]
+#
+# 'build/m+mManagerBenchmark -?' lists the options of the benchmark; it doesn't need a display
+# or a running YARP network.
+
+include Makefile
+
+.DEFAULT_GOAL := all
+
+BENCHMARK_TARGET := m+mManagerBenchmark
+BENCHMARK_OBJECTS := \
+  $(filter-out $(OBJDIR)/m+mManagerMain_%.o, $(OBJECTS)) \
+  $(OBJDIR)/m+mManagerBenchmark_4d1c2b7e.o \
+
+.PHONY: all benchmark clean-benchmark
+
+all: $(OUTDIR)/$(TARGET) benchmark
+
+benchmark: $(OUTDIR)/$(BENCHMARK_TARGET)
+
+$(OUTDIR)/$(BENCHMARK_TARGET): $(BENCHMARK_OBJECTS) $(RESOURCES)
+	@echo Linking m+m manager benchmark
+	-@mkdir -p $(BINDIR)
+	-@mkdir -p $(LIBDIR)
+	-@mkdir -p $(OUTDIR)
+	@$(CXX) -o $(OUTDIR)/$(BENCHMARK_TARGET) $(BENCHMARK_OBJECTS) $(LDFLAGS) $(RESOURCES) $(TARGET_ARCH)
+
+clean-benchmark:
+	@echo Cleaning m+m manager benchmark
+	@rm -f $(OUTDIR)/$(BENCHMARK_TARGET) $(OBJDIR)/m+mManagerBenchmark_4d1c2b7e.*
+
+$(OBJDIR)/m+mManagerBenchmark_4d1c2b7e.o: $(SRCDIR)/m+mManagerBenchmark.cpp
+	-@mkdir -p $(OBJDIR)
+	@echo "Compiling m+mManagerBenchmark.cpp"
+	@$(CXX) $(CXXFLAGS) -o "$@" -c "$<"
+
+-include $(OBJDIR)/m+mManagerBenchmark_4d1c2b7e.d
@@ -0,0 +1,148 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mActivityInputHandler.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the custom data channel input handler used to detect
+//              activity on a channel.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmActivityInputHandler_HPP_))
+# define mpmActivityInputHandler_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# include <m+m/m+mBaseInputHandler.hpp>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the custom data channel input handler used to detect activity
+ on a channel. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief A handler that counts the data arriving from a channel.
+
+     The data itself is ignored; only the number of messages and bytes is kept, until they are
+     collected by the activity sampler. */
+    class ActivityInputHandler : public MplusM::Common::BaseInputHandler
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef BaseInputHandler inherited;
+
+    public :
+
+        /*! @brief The constructor. */
+        ActivityInputHandler(void);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ActivityInputHandler(void);
+
+        /*! @brief Return the amount of data that has arrived since the previous call and start
+         counting again.
+         @param[out] numBytes The number of bytes that have arrived.
+         @return The number of messages that have arrived. */
+        int
+        takeActivity(int64 & numBytes);
+
+    protected :
+
+    private :
+
+        /*! @brief The copy constructor.
+         @param[in] other The object to be copied. */
+        ActivityInputHandler(const ActivityInputHandler & other);
+
+        /*! @brief Process partially-structured input data.
+         @param[in] input The partially-structured input data.
+         @param[in] senderChannel The name of the channel used to send the input data.
+         @param[in] replyMechanism @c NULL if no reply is expected and non-@c NULL otherwise.
+         @param[in] numBytes The number of bytes available on the connection.
+         @return @c true if the input was correctly structured and successfully processed. */
+        virtual bool
+        handleInput(const yarp::os::Bottle &     input,
+                    const YarpString &           senderChannel,
+                    yarp::os::ConnectionWriter * replyMechanism,
+                    const size_t                 numBytes);
+
+        /*! @brief The assignment operator.
+         @param[in] other The object to be copied.
+         @return The updated object. */
+        ActivityInputHandler &
+        operator =(const ActivityInputHandler & other);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The number of bytes that have arrived since the count was last taken. It is
+         updated by the YARP reader thread. */
+        Atomic<int64> _byteCount;
+
+        /*! @brief The number of messages that have arrived since the count was last taken. It is
+         updated by the YARP reader thread. */
+        Atomic<int> _messageCount;
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[4];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+    }; // ActivityInputHandler
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmActivityInputHandler_HPP_)
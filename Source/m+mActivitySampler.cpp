@@ -0,0 +1,449 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mActivitySampler.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the sampler of activity on channels.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mActivitySampler.hpp"
+#include "m+mActivityInputHandler.hpp"
+#include "m+mChannelEntry.hpp"
+#include "m+mEntitiesPanel.hpp"
+#include "m+mScrollingMonitorWindow.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the sampler of activity on channels. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The number of milliseconds between collections of the activity on the channels. This
+ also limits how often an activity marker or a scrolling monitor is redrawn. */
+static const int kActivitySampleInterval = 200;
+
+/*! @brief The number of hidden ports that are connected at the same time. */
+static const int kConnectThreadCount = 2;
+
+/*! @brief The time, in milliseconds, to wait for a connection to finish when the sampler is
+ destroyed; opening and connecting a hidden port both retry for a while, so this is generous. */
+static const int kJobKillTime = 10000;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Close the hidden port and the scrolling monitor of a probe and discard the probe.
+ @param[in,out] aProbe The probe to be discarded. */
+static void
+releaseProbe(ActivityProbe & aProbe)
+{
+    ODL_ENTER(); //####
+    ODL_P1("aProbe = ", &aProbe); //####
+    delete aProbe._monitor;
+    aProbe._monitor = NULL;
+    if (aProbe._channel)
+    {
+#if defined(MpM_DoExplicitClose)
+        aProbe._channel->close();
+#endif // defined(MpM_DoExplicitClose)
+        Common::GeneralChannel::RelinquishChannel(aProbe._channel);
+        aProbe._channel = NULL;
+    }
+    // The handler can only be discarded once the port that uses it is gone.
+    delete aProbe._handler;
+    aProbe._handler = NULL;
+    ODL_EXIT(); //####
+} // releaseProbe
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ActivityConnectJob::ActivityConnectJob(const YarpString &    portName,
+                                       const ActivityProbe & aProbe) :
+    inherited("Activity connect"), _portName(portName), _channel(aProbe._channel),
+    _handler(aProbe._handler), _connected(false)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P1("aProbe = ", &aProbe); //####
+    ODL_EXIT_P(this); //####
+} // ActivityConnectJob::ActivityConnectJob
+
+ActivityConnectJob::~ActivityConnectJob(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ActivityConnectJob::~ActivityConnectJob
+
+ActivitySampler::ActivitySampler(EntitiesPanel & owner) :
+    inherited(), _probes(), _owner(owner), _pool(kConnectThreadCount), _lastSampleTime(0)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    ODL_EXIT_P(this); //####
+} // ActivitySampler::ActivitySampler
+
+ActivitySampler::~ActivitySampler(void)
+{
+    ODL_OBJENTER(); //####
+    bool allStopped;
+
+    stopTimer();
+    allStopped = _pool.removeAllJobs(true, kJobKillTime);
+    for (ActivityProbeMap::iterator walker(_probes.begin()); _probes.end() != walker; ++walker)
+    {
+        ActivityProbe & aProbe = walker->second;
+
+        // A hidden port that is still being connected can't be released safely.
+        if (allStopped || (! aProbe._connector))
+        {
+            delete aProbe._connector;
+            aProbe._connector = NULL;
+            releaseProbe(aProbe);
+        }
+    }
+    _probes.clear();
+    ODL_OBJEXIT(); //####
+} // ActivitySampler::~ActivitySampler
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+ActivityProbeMap::iterator
+ActivitySampler::addProbe(const YarpString & portName)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ActivityProbeMap::iterator result(_probes.find(portName));
+
+    if (_probes.end() == result)
+    {
+        ActivityProbe aProbe;
+
+        aProbe._channel = new Common::GeneralChannel(false);
+        aProbe._handler = new ActivityInputHandler;
+        aProbe._monitor = NULL;
+        aProbe._showIndicator = false;
+        if (aProbe._channel && aProbe._handler)
+        {
+            aProbe._channel->setInputMode(true);
+            aProbe._channel->setOutputMode(false);
+            // Opening and connecting the hidden port can take seconds, so it's done in the
+            // background; the channel is sampled once the job has finished.
+            aProbe._connector = new ActivityConnectJob(portName, aProbe);
+            result = _probes.insert(ActivityProbeMap::value_type(portName, aProbe)).first;
+            _pool.addJob(aProbe._connector, false);
+            if (! isTimerRunning())
+            {
+                _lastSampleTime = Time::getMillisecondCounterHiRes();
+                startTimer(kActivitySampleInterval);
+            }
+        }
+        else
+        {
+            aProbe._connector = NULL;
+            releaseProbe(aProbe);
+        }
+    }
+    ODL_OBJEXIT(); //####
+    return result;
+} // ActivitySampler::addProbe
+
+void
+ActivitySampler::collectConnectedProbes(void)
+{
+    ODL_OBJENTER(); //####
+    for (ActivityProbeMap::iterator walker(_probes.begin()); _probes.end() != walker; )
+    {
+        ActivityProbe & aProbe = walker->second;
+
+        if (aProbe._connector && (! _pool.contains(aProbe._connector)))
+        {
+            bool wanted = (aProbe._showIndicator || aProbe._monitor);
+            bool connected = aProbe._connector->wasConnected();
+
+            delete aProbe._connector;
+            aProbe._connector = NULL;
+            if (connected && wanted)
+            {
+                ++walker;
+            }
+            else
+            {
+                if (aProbe._showIndicator)
+                {
+                    ChannelEntry * aChannel = _owner.findKnownPort(walker->first);
+
+                    if (aChannel)
+                    {
+                        aChannel->clearActivityMarker();
+                    }
+                }
+                releaseProbe(aProbe);
+                walker = _probes.erase(walker);
+            }
+        }
+        else
+        {
+            ++walker;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ActivitySampler::collectConnectedProbes
+
+bool
+ActivitySampler::isWatching(const YarpString & portName)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ActivityProbeMap::const_iterator match(_probes.find(portName));
+    bool                             result = ((_probes.end() != match) &&
+                                               match->second._showIndicator);
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ActivitySampler::isWatching
+
+void
+ActivitySampler::removeProbeIfUnused(ActivityProbeMap::iterator match)
+{
+    ODL_OBJENTER(); //####
+    ActivityProbe & aProbe = match->second;
+
+    // A hidden port that is still being connected is discarded when its job finishes, unless the
+    // job hadn't started yet.
+    if ((! aProbe._showIndicator) && (! aProbe._monitor) &&
+        ((! aProbe._connector) || _pool.removeJob(aProbe._connector, false, 0)))
+    {
+        delete aProbe._connector;
+        aProbe._connector = NULL;
+        // Closing the hidden port also removes its connection to the channel.
+        releaseProbe(aProbe);
+        _probes.erase(match);
+    }
+    if (_probes.empty())
+    {
+        stopTimer();
+    }
+    ODL_OBJEXIT(); //####
+} // ActivitySampler::removeProbeIfUnused
+
+bool
+ActivitySampler::startMonitoring(const YarpString & portName)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ActivityProbeMap::iterator match(addProbe(portName));
+    bool                       result = (_probes.end() != match);
+
+    if (result)
+    {
+        if (match->second._monitor)
+        {
+            match->second._monitor->toFront(true);
+        }
+        else
+        {
+            match->second._monitor = new ScrollingMonitorWindow(portName, *this);
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ActivitySampler::startMonitoring
+
+bool
+ActivitySampler::startWatching(const YarpString & portName)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ActivityProbeMap::iterator match(addProbe(portName));
+    bool                       result = (_probes.end() != match);
+
+    if (result)
+    {
+        match->second._showIndicator = true;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ActivitySampler::startWatching
+
+void
+ActivitySampler::stopMonitoring(const YarpString & portName)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ActivityProbeMap::iterator match(_probes.find(portName));
+
+    if (_probes.end() != match)
+    {
+        delete match->second._monitor;
+        match->second._monitor = NULL;
+        removeProbeIfUnused(match);
+    }
+    ODL_OBJEXIT(); //####
+} // ActivitySampler::stopMonitoring
+
+void
+ActivitySampler::stopWatching(const YarpString & portName)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ActivityProbeMap::iterator match(_probes.find(portName));
+
+    if (_probes.end() != match)
+    {
+        match->second._showIndicator = false;
+        removeProbeIfUnused(match);
+    }
+    ODL_OBJEXIT(); //####
+} // ActivitySampler::stopWatching
+
+void
+ActivitySampler::timerCallback(void)
+{
+    ODL_OBJENTER(); //####
+    double now = Time::getMillisecondCounterHiRes();
+    // The timer isn't exact, so the rates are based on the time that actually passed.
+    double elapsedSeconds = jmax(now - _lastSampleTime, 1.0) / 1000;
+
+    _lastSampleTime = now;
+    collectConnectedProbes();
+    for (ActivityProbeMap::iterator walker(_probes.begin()); _probes.end() != walker; )
+    {
+        ActivityProbe & aProbe = walker->second;
+        ChannelEntry *  aChannel = _owner.findKnownPort(walker->first);
+
+        if (aProbe._connector)
+        {
+            // The hidden port is still being connected.
+            ++walker;
+        }
+        else if (aChannel)
+        {
+            int64 numBytes;
+            int   numMessages = aProbe._handler->takeActivity(numBytes);
+
+            if (aProbe._showIndicator)
+            {
+                aChannel->updateActivityMarker(0 < numMessages);
+            }
+            if (aProbe._monitor)
+            {
+                aProbe._monitor->addSample(static_cast<float>(numMessages / elapsedSeconds),
+                                           static_cast<float>(numBytes / elapsedSeconds));
+            }
+            ++walker;
+        }
+        else
+        {
+            // The channel has gone away, so there's nothing left to watch.
+            releaseProbe(aProbe);
+            walker = _probes.erase(walker);
+        }
+    }
+    if (_probes.empty())
+    {
+        stopTimer();
+    }
+    ODL_OBJEXIT(); //####
+} // ActivitySampler::timerCallback
+
+ThreadPoolJob::JobStatus
+ActivityConnectJob::runJob(void)
+{
+    ODL_OBJENTER(); //####
+    YarpString probeName(Common::GetRandomChannelName(HIDDEN_CHANNEL_PREFIX_ "activity_/"
+                                                      DEFAULT_CHANNEL_ROOT_));
+
+    if (_channel->openWithRetries(probeName, STANDARD_WAIT_TIME_))
+    {
+        _channel->setReader(*_handler);
+        if (shouldExit())
+        {
+            ODL_LOG("(shouldExit())"); //####
+        }
+        else if (Utilities::NetworkConnectWithRetries(_portName, _channel->name(),
+                                                      STANDARD_WAIT_TIME_))
+        {
+            _connected = true;
+        }
+        else
+        {
+            ODL_LOG("(! Utilities::NetworkConnectWithRetries(_portName, " //####
+                    "_channel->name(), STANDARD_WAIT_TIME_))"); //####
+        }
+    }
+    else
+    {
+        ODL_LOG("(! _channel->openWithRetries(probeName, STANDARD_WAIT_TIME_))"); //####
+    }
+    ODL_OBJEXIT(); //####
+    return jobHasFinished;
+} // ActivityConnectJob::runJob
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,263 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mActivitySampler.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the sampler of activity on channels.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmActivitySampler_HPP_))
+# define mpmActivitySampler_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the sampler of activity on channels. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class EntitiesPanel;
+
+    /*! @brief A job that opens the hidden port of a probe and connects the watched channel to
+     it. */
+    class ActivityConnectJob : public ThreadPoolJob
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef ThreadPoolJob inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] portName The name of the channel to be watched.
+         @param[in] aProbe The probe whose hidden port is to be connected. */
+        ActivityConnectJob(const YarpString &    portName,
+                           const ActivityProbe & aProbe);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ActivityConnectJob(void);
+
+        /*! @brief Return @c true if the channel was connected to the hidden port and @c false
+         otherwise; only meaningful once the job has finished.
+         @return @c true if the channel was connected to the hidden port and @c false
+         otherwise. */
+        inline bool
+        wasConnected(void)
+        const
+        {
+            return _connected;
+        } // wasConnected
+
+    protected :
+
+    private :
+
+        /*! @brief Open the hidden port and connect the channel to it.
+         @return @c jobHasFinished, since the job is always completed. */
+        virtual JobStatus
+        runJob(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The name of the channel to be watched. */
+        YarpString _portName;
+
+        /*! @brief The hidden port. */
+        MplusM::Common::GeneralChannel * _channel;
+
+        /*! @brief The handler that counts the traffic arriving at the hidden port. */
+        ActivityInputHandler * _handler;
+
+        /*! @brief @c true if the channel was connected to the hidden port. */
+        bool _connected;
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[7];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ActivityConnectJob)
+
+    }; // ActivityConnectJob
+
+    /*! @brief A sampler of the activity on channels, for their activity indicators and scrolling
+     monitors.
+
+     Each channel that is watched is connected to a hidden port, whose reader thread counts the
+     arriving data. The hidden port is opened and connected by a job on a small thread pool, so
+     that a slow or missing channel doesn't hold up the message thread; sampling of the channel
+     starts once the connection has been made. The counts are collected periodically on the
+     message thread; the activity marker of the channel is flipped while data is arriving and the
+     rates are passed to the scrolling monitor of the channel, if it has one. A channel's indicator
+     and monitor share its hidden port. The timer only runs while at least one channel is being
+     watched or connected. */
+    class ActivitySampler : private Timer
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef Timer inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] owner The panel containing the channels that are to be watched. */
+        explicit
+        ActivitySampler(EntitiesPanel & owner);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ActivitySampler(void);
+
+        /*! @brief Return @c true if a channel is being watched, or is being connected to, for its
+         activity indicator and @c false otherwise.
+         @param[in] portName The name of the channel.
+         @return @c true if the channel is being watched and @c false otherwise. */
+        bool
+        isWatching(const YarpString & portName)
+        const;
+
+        /*! @brief Open a scrolling monitor for a channel, or bring its monitor to the front if it
+         already has one.
+         @param[in] portName The name of the channel.
+         @return @c true if the channel has a monitor and @c false if a hidden port could not be
+         created for it. */
+        bool
+        startMonitoring(const YarpString & portName);
+
+        /*! @brief Start watching a channel for its activity indicator.
+         @param[in] portName The name of the channel.
+         @return @c true if the channel is being watched and @c false if a hidden port could not
+         be created for it. */
+        bool
+        startWatching(const YarpString & portName);
+
+        /*! @brief Close the scrolling monitor for a channel.
+         @param[in] portName The name of the channel. */
+        void
+        stopMonitoring(const YarpString & portName);
+
+        /*! @brief Stop watching a channel for its activity indicator.
+         @param[in] portName The name of the channel. */
+        void
+        stopWatching(const YarpString & portName);
+
+    protected :
+
+    private :
+
+        /*! @brief The copy constructor.
+         @param[in] other The object to be copied. */
+        ActivitySampler(const ActivitySampler & other);
+
+        /*! @brief Find the hidden port watching a channel, starting to connect a new one if there
+         is none.
+         @param[in] portName The name of the channel.
+         @return The position of the hidden port or the end of the set of hidden ports if a hidden
+         port could not be created. */
+        ActivityProbeMap::iterator
+        addProbe(const YarpString & portName);
+
+        /*! @brief The assignment operator.
+         @param[in] other The object to be copied.
+         @return The updated object. */
+        ActivitySampler &
+        operator =(const ActivitySampler & other);
+
+        /*! @brief Start sampling the channels whose hidden ports have been connected, and discard
+         the hidden ports that could not be connected or that are no longer wanted. */
+        void
+        collectConnectedProbes(void);
+
+        /*! @brief Discard a hidden port if neither an indicator nor a monitor is using it.
+         @param[in] match The position of the hidden port. */
+        void
+        removeProbeIfUnused(ActivityProbeMap::iterator match);
+
+        /*! @brief Collect the activity of the watched channels and update their markers and
+         monitors. */
+        virtual void
+        timerCallback(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The hidden ports that are watching channels, by the names of the channels. */
+        ActivityProbeMap _probes;
+
+        /*! @brief The panel containing the channels that are being watched. */
+        EntitiesPanel & _owner;
+
+        /*! @brief The threads that connect the hidden ports to the channels. */
+        ThreadPool _pool;
+
+        /*! @brief The time at which the activity was last collected, in milliseconds. */
+        double _lastSampleTime;
+
+    }; // ActivitySampler
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmActivitySampler_HPP_)
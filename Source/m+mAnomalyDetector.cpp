@@ -0,0 +1,503 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mAnomalyDetector.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the detection of stalled channels and other anomalies in
+//              the metrics.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mAnomalyDetector.hpp"
+#include "m+mChannelContainer.hpp"
+#include "m+mChannelEntry.hpp"
+#include "m+mEntitiesPanel.hpp"
+#include "m+mMetricsPoller.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the detection of stalled channels and other anomalies in the
+ metrics. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The weight given to a new sample by the running statistics of a channel. */
+static const double kBaselineWeight = 0.2;
+
+/*! @brief The weight given to a new sample by the running statistics of a channel while its
+ traffic is far below its usual level; this is small, so that a drop stays visible for a while
+ before it is accepted as the new usual level. */
+static const double kDroppedBaselineWeight = 0.02;
+
+/*! @brief The number of standard deviations below the mean that a byte rate must be to count as
+ a drop. */
+static const double kDropDeviations = 3;
+
+/*! @brief The fraction of the mean that a byte rate must be below to count as a drop. */
+static const double kDropFraction = 0.2;
+
+/*! @brief The smallest mean byte rate for which a drop is noticed; slower channels are too
+ irregular for their drops to mean anything. */
+static const double kMinimumBaselineRate = 64;
+
+/*! @brief The number of consecutive samples without traffic after which a connected channel is
+ idle. */
+static const int kIdleSampleCount = 5;
+
+/*! @brief The number of consecutive samples without any counter advancing after which a service
+ is stalled. */
+static const int kStalledSampleCount = 10;
+
+/*! @brief The number of samples needed before the statistics of a channel are trusted. */
+static const int kWarmupSampleCount = 10;
+
+/*! @brief The colour of the badge for an idle connection. */
+static const Colour & kIdleConnectionColour(Colours::lightsteelblue);
+
+/*! @brief The colour of the badge for a drop in traffic. */
+static const Colour & kRateDropColour(Colours::orangered);
+
+/*! @brief The colour of the badge for a stalled service. */
+static const Colour & kStalledServiceColour(Colours::red);
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Clear the statistics of a channel, so that they start again from the next sample.
+ @param[in,out] aChannel The statistics of the channel.
+ @param[in] channelName The name of the channel. */
+static void
+resetChannelBaseline(ChannelBaseline &  aChannel,
+                     const YarpString & channelName)
+{
+    ODL_ENTER(); //####
+    ODL_P1("aChannel = ", &aChannel); //####
+    ODL_S1s("channelName = ", channelName); //####
+    aChannel._channelName = channelName;
+    aChannel._meanRate = aChannel._rateVariance = 0;
+    aChannel._idleCount = aChannel._sampleCount = 0;
+    aChannel._dropped = false;
+    ODL_EXIT(); //####
+} // resetChannelBaseline
+
+/*! @brief Add a byte rate to the statistics of a channel and check it for a drop.
+ @param[in,out] aChannel The statistics of the channel.
+ @param[in] rate The byte rate of the channel since the previous sample. */
+static void
+updateChannelStatistics(ChannelBaseline & aChannel,
+                        const double      rate)
+{
+    ODL_ENTER(); //####
+    ODL_P1("aChannel = ", &aChannel); //####
+    ODL_D1("rate = ", rate); //####
+    double deviation = rate - aChannel._meanRate;
+    double weight;
+
+    if (0 == aChannel._sampleCount)
+    {
+        aChannel._meanRate = rate;
+        aChannel._rateVariance = 0;
+    }
+    else
+    {
+        if (kWarmupSampleCount <= aChannel._sampleCount)
+        {
+            aChannel._dropped = ((kMinimumBaselineRate <= aChannel._meanRate) &&
+                                 (rate < (aChannel._meanRate * kDropFraction)) &&
+                                 ((- deviation) > (kDropDeviations *
+                                                   sqrt(aChannel._rateVariance))));
+        }
+        weight = (aChannel._dropped ? kDroppedBaselineWeight : kBaselineWeight);
+        aChannel._meanRate += weight * deviation;
+        aChannel._rateVariance = (1 - weight) * (aChannel._rateVariance +
+                                                 (weight * deviation * deviation));
+    }
+    // Only the start of the statistics is of interest, so the count stops there.
+    if (kWarmupSampleCount > aChannel._sampleCount)
+    {
+        ++aChannel._sampleCount;
+    }
+    ODL_EXIT(); //####
+} // updateChannelStatistics
+
+/*! @brief Update the statistics of a service and its channels from a sample, and record any
+ anomalies that are seen.
+ @param[in,out] baseline The statistics of the service.
+ @param[in] metrics The sample of the metrics of the service.
+ @param[in] servicePortName The name of the service port.
+ @param[in,out] channelAnomalies The anomalies of the channels.
+ @param[in,out] serviceAnomalies The anomalies of the services. */
+static void
+updateServiceBaseline(ServiceBaseline &      baseline,
+                      const ServiceMetrics & metrics,
+                      const YarpString &     servicePortName,
+                      AnomalyMap &           channelAnomalies,
+                      AnomalyMap &           serviceAnomalies)
+{
+    ODL_ENTER(); //####
+    ODL_P4("baseline = ", &baseline, "metrics = ", &metrics, "channelAnomalies = ", //####
+           &channelAnomalies, "serviceAnomalies = ", &serviceAnomalies); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    const ChannelMetricsList & channels = metrics._channels;
+    bool                       isFirstSample = (0 >= baseline._lastSampleTime);
+    double                     interval = (metrics._sampleTime - baseline._lastSampleTime) / 1000;
+
+    // The poller can report again without a new sample of this service, and a repeated sample
+    // says nothing about its traffic.
+    if (isFirstSample || (0 < interval))
+    {
+        bool advanced = false;
+
+        baseline._channels.resize(channels.size());
+        for (size_t ii = 0, mm = channels.size(); mm > ii; ++ii)
+        {
+            ChannelBaseline &      aChannel = baseline._channels[ii];
+            const ChannelMetrics & sample = channels[ii];
+            int64                  totalBytes = sample._inBytes + sample._outBytes;
+
+            // The statistics of a channel start again if the channels of the service have
+            // changed or if its counters have gone back, as when the service was restarted.
+            if (isFirstSample || (aChannel._channelName != sample._channelName) ||
+                (aChannel._lastBytes > totalBytes))
+            {
+                resetChannelBaseline(aChannel, sample._channelName);
+            }
+            else
+            {
+                if (aChannel._lastBytes < totalBytes)
+                {
+                    advanced = true;
+                    aChannel._idleCount = 0;
+                }
+                else if (kIdleSampleCount > aChannel._idleCount)
+                {
+                    ++aChannel._idleCount;
+                }
+                updateChannelStatistics(aChannel, (totalBytes - aChannel._lastBytes) / interval);
+            }
+            aChannel._lastBytes = totalBytes;
+        }
+        if (! isFirstSample)
+        {
+            if (advanced)
+            {
+                baseline._hasAdvanced = true;
+                baseline._idleCount = 0;
+            }
+            else if (kStalledSampleCount > baseline._idleCount)
+            {
+                ++baseline._idleCount;
+            }
+        }
+        baseline._lastSampleTime = metrics._sampleTime;
+    }
+    for (size_t ii = 0, mm = baseline._channels.size(); mm > ii; ++ii)
+    {
+        const ChannelBaseline & aChannel = baseline._channels[ii];
+
+        if (aChannel._dropped)
+        {
+            channelAnomalies[aChannel._channelName] = kAnomalyRateDrop;
+        }
+        else if (kIdleSampleCount <= aChannel._idleCount)
+        {
+            channelAnomalies[aChannel._channelName] = kAnomalyIdleConnection;
+        }
+    }
+    if (baseline._hasAdvanced && (kStalledSampleCount <= baseline._idleCount))
+    {
+        serviceAnomalies[servicePortName] = kAnomalyStalledService;
+    }
+    ODL_EXIT(); //####
+} // updateServiceBaseline
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+AnomalyDetector::AnomalyDetector(EntitiesPanel & owner) :
+    inherited(), _channelAnomalies(), _serviceAnomalies(), _baselines(), _owner(owner),
+    _poller(NULL)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    ODL_EXIT_P(this); //####
+} // AnomalyDetector::AnomalyDetector
+
+AnomalyDetector::~AnomalyDetector(void)
+{
+    ODL_OBJENTER(); //####
+    setMetricsPoller(NULL);
+    ODL_OBJEXIT(); //####
+} // AnomalyDetector::~AnomalyDetector
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+AnomalyDetector::analyseServices(const ServiceMetricsMap & services)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("services = ", &services); //####
+    ServiceBaselineMap::iterator baselineWalker(_baselines.begin());
+
+    _channelAnomalies.clear();
+    _serviceAnomalies.clear();
+    // Both mappings are in order of the service port names, so they are walked together rather
+    // than searched.
+    for (ServiceMetricsMap::const_iterator walker(services.begin()); services.end() != walker;
+         ++walker)
+    {
+        // The statistics of services that are no longer polled are discarded.
+        while ((_baselines.end() != baselineWalker) && (baselineWalker->first < walker->first))
+        {
+            _baselines.erase(baselineWalker++);
+        }
+        if ((_baselines.end() == baselineWalker) || (walker->first < baselineWalker->first))
+        {
+            baselineWalker = _baselines.insert(baselineWalker,
+                                               make_pair(walker->first, ServiceBaseline()));
+        }
+        if (walker->second._valid && walker->second._enabled)
+        {
+            updateServiceBaseline(baselineWalker->second, walker->second, walker->first,
+                                  _channelAnomalies, _serviceAnomalies);
+        }
+        else
+        {
+            // A service that isn't reporting its metrics starts again when it does.
+            baselineWalker->second = ServiceBaseline();
+        }
+        ++baselineWalker;
+    }
+    _baselines.erase(baselineWalker, _baselines.end());
+    ODL_OBJEXIT(); //####
+} // AnomalyDetector::analyseServices
+
+void
+AnomalyDetector::applyAnomalies(void)
+{
+    ODL_OBJENTER(); //####
+    bool anomaliesChanged = false;
+
+    for (size_t ii = 0, mm = _owner.getNumberOfEntities(); mm > ii; ++ii)
+    {
+        ChannelContainer * anEntity = _owner.getEntity(ii);
+        AnomalyKind        worstAnomaly = kAnomalyNone;
+
+        for (int jj = 0, nn = (anEntity ? anEntity->getNumPorts() : 0); nn > jj; ++jj)
+        {
+            ChannelEntry * aPort = anEntity->getPort(jj);
+
+            if (aPort)
+            {
+                AnomalyKind                kind = kAnomalyNone;
+                AnomalyMap::const_iterator match(_channelAnomalies.find(aPort->getPortName()));
+
+                if (_channelAnomalies.end() != match)
+                {
+                    kind = match->second;
+                    // A channel without connections is expected to be idle.
+                    if ((kAnomalyIdleConnection == kind) &&
+                        aPort->getInputConnections().empty() &&
+                        aPort->getOutputConnections().empty())
+                    {
+                        kind = kAnomalyNone;
+                    }
+                }
+                if (aPort->setAnomaly(kind))
+                {
+                    anomaliesChanged = true;
+                }
+                worstAnomaly = jmax(worstAnomaly, kind);
+                if (aPort->isService())
+                {
+                    match = _serviceAnomalies.find(aPort->getPortName());
+                    if (_serviceAnomalies.end() != match)
+                    {
+                        worstAnomaly = jmax(worstAnomaly, match->second);
+                    }
+                }
+            }
+        }
+        // The entity shows the worst anomaly of its channels, so that it can be seen when the
+        // channels are too small to show their badges.
+        if (anEntity && anEntity->setAnomaly(worstAnomaly))
+        {
+            anomaliesChanged = true;
+        }
+    }
+    if (anomaliesChanged)
+    {
+        _owner.repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // AnomalyDetector::applyAnomalies
+
+void
+AnomalyDetector::changeListenerCallback(ChangeBroadcaster * source)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("source = ", source); //####
+    MetricsSnapshot::Ptr snapshot;
+
+    if (_poller)
+    {
+        snapshot = _poller->getSnapshot();
+    }
+    if (snapshot)
+    {
+        analyseServices(snapshot->getServices());
+        applyAnomalies();
+    }
+    ODL_OBJEXIT(); //####
+} // AnomalyDetector::changeListenerCallback
+
+Colour
+AnomalyDetector::getAnomalyColour(const AnomalyKind kind)
+{
+    ODL_ENTER(); //####
+    ODL_I1("kind = ", kind); //####
+    Colour result;
+
+    switch (kind)
+    {
+        case kAnomalyIdleConnection :
+            result = kIdleConnectionColour;
+            break;
+
+        case kAnomalyRateDrop :
+            result = kRateDropColour;
+            break;
+
+        case kAnomalyStalledService :
+            result = kStalledServiceColour;
+            break;
+
+        default :
+            result = Colours::transparentBlack;
+            break;
+
+    }
+    ODL_EXIT(); //####
+    return result;
+} // AnomalyDetector::getAnomalyColour
+
+String
+AnomalyDetector::getAnomalyDescription(const AnomalyKind kind)
+{
+    ODL_ENTER(); //####
+    ODL_I1("kind = ", kind); //####
+    String result;
+
+    switch (kind)
+    {
+        case kAnomalyIdleConnection :
+            result = "It is connected, but no traffic has passed through it recently.";
+            break;
+
+        case kAnomalyRateDrop :
+            result = "Its traffic has dropped far below its recent level.";
+            break;
+
+        case kAnomalyStalledService :
+            result = "Its counters have stopped advancing.";
+            break;
+
+        default :
+            break;
+
+    }
+    ODL_EXIT_s(result.toStdString()); //####
+    return result;
+} // AnomalyDetector::getAnomalyDescription
+
+void
+AnomalyDetector::setMetricsPoller(MetricsPoller * poller)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("poller = ", poller); //####
+    if (poller != _poller)
+    {
+        if (_poller)
+        {
+            _poller->removeChangeListener(this);
+        }
+        _poller = poller;
+        if (_poller)
+        {
+            _poller->addChangeListener(this);
+        }
+        // The anomalies that are shown came from the previous source, so they are cleared.
+        _baselines.clear();
+        _channelAnomalies.clear();
+        _serviceAnomalies.clear();
+        applyAnomalies();
+    }
+    ODL_OBJEXIT(); //####
+} // AnomalyDetector::setMetricsPoller
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
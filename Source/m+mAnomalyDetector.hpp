@@ -0,0 +1,156 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mAnomalyDetector.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the detection of stalled channels and other anomalies in
+//              the metrics.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmAnomalyDetector_HPP_))
+# define mpmAnomalyDetector_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the detection of stalled channels and other anomalies in the
+ metrics. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class EntitiesPanel;
+    class MetricsPoller;
+
+    /*! @brief The detection of connections that carry no traffic, channels whose traffic drops far
+     below its recent level and services whose counters have stopped advancing.
+
+     Each snapshot from the metrics poller updates running statistics of the byte rate of each
+     channel - an exponentially-weighted mean and variance - so that the cost of a snapshot
+     depends only on the number of channels in it and no history is kept. The anomalies are then
+     passed to the channels and entities of the panel, which show them as badges. */
+    class AnomalyDetector : private ChangeListener
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef ChangeListener inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] owner The panel containing the channels and entities. */
+        explicit
+        AnomalyDetector(EntitiesPanel & owner);
+
+        /*! @brief The destructor. */
+        virtual
+        ~AnomalyDetector(void);
+
+        /*! @brief Return the colour of the badge for an anomaly.
+         @param[in] kind The kind of anomaly.
+         @return The colour of the badge for the anomaly. */
+        static Colour
+        getAnomalyColour(const AnomalyKind kind);
+
+        /*! @brief Return a description of an anomaly.
+         @param[in] kind The kind of anomaly.
+         @return A description of the anomaly. */
+        static String
+        getAnomalyDescription(const AnomalyKind kind);
+
+        /*! @brief Set the source of the metrics, and clear the anomalies that are shown.
+         @param[in] poller The source of the metrics, or @c NULL if there is none. */
+        void
+        setMetricsPoller(MetricsPoller * poller);
+
+    protected :
+
+    private :
+
+        /*! @brief Update the statistics from the metrics of the services and work out the
+         anomalies.
+         @param[in] services The metrics of the services. */
+        void
+        analyseServices(const ServiceMetricsMap & services);
+
+        /*! @brief Pass the anomalies to the channels and entities of the panel. */
+        void
+        applyAnomalies(void);
+
+        /*! @brief Called when the metrics poller has new metrics.
+         @param[in] source The metrics poller. */
+        virtual void
+        changeListenerCallback(ChangeBroadcaster * source);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The anomalies of the channels, by channel name. */
+        AnomalyMap _channelAnomalies;
+
+        /*! @brief The anomalies of the services, by service port name. */
+        AnomalyMap _serviceAnomalies;
+
+        /*! @brief The statistics of the services and their channels. */
+        ServiceBaselineMap _baselines;
+
+        /*! @brief The panel containing the channels and entities. */
+        EntitiesPanel & _owner;
+
+        /*! @brief The source of the metrics. */
+        MetricsPoller * _poller;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnomalyDetector)
+
+    }; // AnomalyDetector
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmAnomalyDetector_HPP_)
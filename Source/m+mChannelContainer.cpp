@@ -37,11 +37,15 @@
 //--------------------------------------------------------------------------------------------------
 
 #include "m+mChannelContainer.hpp"
+#include "m+mAnomalyDetector.hpp"
 #include "m+mChannelEntry.hpp"
 #include "m+mConfigurationWindow.hpp"
 #include "m+mContentPanel.hpp"
 #include "m+mEntitiesPanel.hpp"
+#include "m+mEntityCluster.hpp"
 #include "m+mManagerApplication.hpp"
+#include "m+mMetricsPoller.hpp"
+#include "m+mServiceStateCache.hpp"
 
 //#include <odlEnable.h>
 #include <odlInclude.h>
@@ -70,6 +74,9 @@ using namespace std;
 # pragma mark Private structures, constants and variables
 #endif // defined(__APPLE__)
 
+/*! @brief The amount of space around the anomaly badge in the heading. */
+static const float kBadgeInset = 2;
+
 /*! @brief The colour to be used for the gap between entries. */
 static const Colour & kGapFillColour(Colours::grey);
 
@@ -79,6 +86,9 @@ static const Colour & kHeadingBackgroundColour(Colours::darkgrey);
 /*! @brief The colour to be used for text in the entry. */
 static const Colour & kHeadingTextColour(Colours::white);
 
+/*! @brief The colour to be used for the heading of the container when it is selected. */
+static const Colour & kSelectedHeadingBackgroundColour(Colours::darkorange);
+
 /*! @brief The amount of space between each row of the entries in the container. */
 static const float kEntryGap = 1;
 
@@ -93,6 +103,41 @@ static const float kTextInset = 2;
 # pragma mark Local functions
 #endif // defined(__APPLE__)
 
+/*! @brief Return the most recent metrics collected by the background poller.
+ @param[in] owner The panel containing the entity.
+ @return The most recent metrics or an empty reference if there are none. */
+static MetricsSnapshot::Ptr
+getMetricsSnapshot(EntitiesPanel & owner)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    ContentPanel *       thePanel = owner.getContent();
+    MetricsPoller *      poller = (thePanel ? thePanel->getMetricsPoller() : NULL);
+    MetricsSnapshot::Ptr result;
+
+    if (poller)
+    {
+        result = poller->getSnapshot();
+    }
+    ODL_EXIT_P(result.get()); //####
+    return result;
+} // getMetricsSnapshot
+
+/*! @brief Return the last known states of the services.
+ @param[in] owner The panel containing the entity.
+ @return The last known states of the services or @c NULL if there are none. */
+static ServiceStateCache *
+getServiceStateCache(EntitiesPanel & owner)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    ContentPanel *      thePanel = owner.getContent();
+    ServiceStateCache * result = (thePanel ? &thePanel->getServiceStateCache() : NULL);
+
+    ODL_EXIT_P(result); //####
+    return result;
+} // getServiceStateCache
+
 #if defined(__APPLE__)
 # pragma mark Class methods
 #endif // defined(__APPLE__)
@@ -110,12 +155,10 @@ ChannelContainer::ChannelContainer(const ContainerKind kind,
                                    const YarpString &  requests,
                                    EntitiesPanel &     owner) :
     inherited(title.c_str()), _behaviour(behaviour), _description(description),
-    _extraInfo(extraInfo), _IPAddress(ipAddress), _requests(requests),
-#if defined(USE_OGDF_POSITIONING_)
-    _node(NULL),
-#endif // defined(USE_OGDF_POSITIONING_)
-    _owner(owner), _kind(kind), _hidden(false), _newlyCreated(true), _selected(false),
-    _visited(false)
+    _extraInfo(extraInfo), _IPAddress(ipAddress), _requests(requests), _titleLayoutText(),
+    _titleLayout(), _owner(owner), _cluster(NULL), _titleLayoutWidth(-1), _anomaly(kAnomalyNone),
+    _kind(kind),
+    _hidden(false), _newlyCreated(true), _selected(false), _visited(false)
 {
     ODL_ENTER(); //####
     ODL_S4s("title = ", title, "behaviour = ", behaviour, "description = ", description, //####
@@ -351,7 +394,14 @@ ChannelContainer::configureTheService(void)
                                                                          holder,
                                                                          STANDARD_WAIT_TIME_))
                             {
+                                ServiceStateCache * stateCache = getServiceStateCache(_owner);
+
                                 _extraInfo = holder;
+                                if (stateCache)
+                                {
+                                    stateCache->noteExtraInformation(aPort->getPortName(),
+                                                                     holder);
+                                }
                             }
                         }
                     }
@@ -384,12 +434,20 @@ ChannelContainer::displayAndProcessPopupMenu(void)
 
     switch (result)
     {
+        case kPopupCollapseGroup :
+            _owner.collapseCluster(_cluster);
+            break;
+
         case kPopupConfigureService :
             configureTheService();
             break;
 
-        case kPopupDisplayChangeServiceMetrics :
-            setMetricsState(! getMetricsState());
+        case kPopupDisableServiceMetrics :
+            setMetricsState(false);
+            break;
+
+        case kPopupEnableServiceMetrics :
+            setMetricsState(true);
             break;
 
         case kPopupDisplayEntityInfo :
@@ -451,6 +509,8 @@ ChannelContainer::displayInformation(const bool moreDetails)
     bodyText += thePanelDescription.c_str();
     if (moreDetails)
     {
+        bool extraInfoIsStale = false;
+
         for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
         {
             ChannelEntry * aPort = getPort(ii);
@@ -475,12 +535,17 @@ ChannelContainer::displayInformation(const bool moreDetails)
                 }
                 if (configurable)
                 {
-                    YarpString holder;
+                    ServiceState state;
 
-                    if (Utilities::GetExtraInformationForService(aPort->getPortName(), holder,
-                                                                 STANDARD_WAIT_TIME_))
+                    // The service is asked in the background if the information is out of date,
+                    // so that an unresponsive service doesn't hold up the display.
+                    if (getServiceState(state, true))
                     {
-                        _extraInfo = holder;
+                        if (0 <= state._extraInfoTime)
+                        {
+                            _extraInfo = state._extraInfo;
+                        }
+                        extraInfoIsStale = state._extraInfoIsStale;
                     }
                 }
                 break;
@@ -492,6 +557,15 @@ ChannelContainer::displayInformation(const bool moreDetails)
             bodyText += "\n";
             bodyText += _extraInfo.c_str();
         }
+        if (extraInfoIsStale)
+        {
+            bodyText += "\n(This information might be out of date; it is being refreshed.)";
+        }
+        if (kAnomalyStalledService == _anomaly)
+        {
+            bodyText += "\n\n";
+            bodyText += AnomalyDetector::getAnomalyDescription(_anomaly);
+        }
         switch (_kind)
         {
             case kContainerKindAdapter :
@@ -518,24 +592,73 @@ ChannelContainer::displayMetrics(void)
 {
     ODL_OBJENTER(); //####
                        // Popup of metrics.
-    String      result;
-    StringArray metricsArray = getMetrics();
-    int         numRows = metricsArray.size();
+    String         result;
+    ServiceMetrics metrics;
 
-    for (int ii = 0; ii < numRows; ++ii)
+    if (getMetrics(metrics))
     {
-        const String & aRow = metricsArray[ii];
-
-        if (0 < ii)
+        for (ChannelMetricsList::const_iterator walker(metrics._channels.begin());
+             metrics._channels.end() != walker; ++walker)
         {
-            result += "\n";
+            if (metrics._channels.begin() != walker)
+            {
+                result += "\n";
+            }
+            result += formatChannelMetrics(*walker) + "\n";
         }
-        result += formatMetricRow(aRow) + "\n";
     }
     DisplayInformationPanel(this, result, String("Metrics for ") + getName());
     ODL_OBJEXIT(); //####
 } // ChannelContainer::displayMetrics
 
+void
+ChannelContainer::drawContent(Graphics &                   gg,
+                              const juce::Rectangle<int> & area)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("gg = ", &gg, "area = ", &area); //####
+    juce::Rectangle<int> area1(area.getX(), area.getY(), area.getWidth(), _titleHeight);
+    juce::Rectangle<int> area2(area.getX(), area.getY() + _titleHeight, area.getWidth(),
+                               area.getHeight() - _titleHeight);
+
+    gg.setColour(_selected ? kSelectedHeadingBackgroundColour : kHeadingBackgroundColour);
+    gg.fillRect(area1);
+    // When zoomed out, the title wouldn't be legible.
+    if (_owner.isDetailVisible())
+    {
+        area1.setLeft(static_cast<int>(area1.getX() + getTextInset()));
+        // Only arrange the text again if the title or the space for it has changed.
+        if ((_titleLayoutWidth != static_cast<float>(area1.getWidth())) ||
+            (_titleLayoutText != getName()))
+        {
+            AttributedString as;
+
+            as.setJustification(Justification::left);
+            as.append(getName(), _owner.getNormalFont(), kHeadingTextColour);
+            _titleLayout.createLayout(as, static_cast<float>(area1.getWidth()));
+            _titleLayoutText = getName();
+            _titleLayoutWidth = static_cast<float>(area1.getWidth());
+        }
+        if (gg.clipRegionIntersects(area1))
+        {
+            _titleLayout.draw(gg, area1.toFloat());
+        }
+    }
+    // The badge is shown even when zoomed out, as it is the only sign of trouble in the channels
+    // at that size.
+    if (kAnomalyNone != _anomaly)
+    {
+        float badgeSide = static_cast<float>(_titleHeight) - (2 * kBadgeInset);
+
+        gg.setColour(AnomalyDetector::getAnomalyColour(_anomaly));
+        gg.fillEllipse(static_cast<float>(area1.getRight()) - (badgeSide + kBadgeInset),
+                       static_cast<float>(area1.getY()) + kBadgeInset, badgeSide, badgeSide);
+    }
+    gg.setColour(kGapFillColour);
+    gg.fillRect(area2);
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::drawContent
+
 void
 ChannelContainer::drawOutgoingConnections(Graphics & gg)
 {
@@ -554,32 +677,20 @@ ChannelContainer::drawOutgoingConnections(Graphics & gg)
 } // ChannelContainer::drawOutgoingConnections
 
 String
-ChannelContainer::formatMetricRow(const String & aRow)
+ChannelContainer::formatChannelMetrics(const ChannelMetrics & metrics)
 {
-    ODL_OBJENTER();
-    ODL_S1s("aRow = ", aRow.toStdString()); //####
-    String      result;
-    StringArray asPieces;
-
-    asPieces.addTokens(aRow, "\t", "");
-    if (7 == asPieces.size())
-    {
-        // We are ignoring the date and time information.
-        String channelName = asPieces[0];
-        String inBytes = asPieces[3];
-        String outBytes = asPieces[4];
-        String inMessages = asPieces[5];
-        String outMessages = asPieces[6];
-
-        result = "Channel:      " + channelName + "\n";
-        result += "In bytes:     " + inBytes + "\n";
-        result += "Out bytes:    " + outBytes + "\n";
-        result += "In messages:  " + inMessages + "\n";
-        result += "Out messages: " + outMessages;
-    }
-    ODL_OBJEXIT_S(result.toStdString().c_str());
+    ODL_ENTER(); //####
+    ODL_P1("metrics = ", &metrics); //####
+    String result;
+
+    result = String("Channel:      ") + metrics._channelName.c_str() + "\n";
+    result += "In bytes:     " + String(metrics._inBytes) + "\n";
+    result += "Out bytes:    " + String(metrics._outBytes) + "\n";
+    result += "In messages:  " + String(metrics._inMessages) + "\n";
+    result += "Out messages: " + String(metrics._outMessages);
+    ODL_EXIT_s(result.toStdString()); //####
     return result;
-} // ChannelContainer::formatMetricRow
+} // ChannelContainer::formatChannelMetrics
 
 MplusM::Utilities::BaseArgumentDescriptor *
 ChannelContainer::getArgumentDescriptor(const size_t idx)
@@ -601,11 +712,13 @@ const
     return result;
 } // ChannelContainer::getArgumentDescriptor
 
-StringArray
-ChannelContainer::getMetrics(void)
+bool
+ChannelContainer::getMetrics(ServiceMetrics & result)
 {
     ODL_OBJENTER(); //####
-    StringArray result;
+    ODL_P1("result = ", &result); //####
+    bool                 okSoFar = false;
+    MetricsSnapshot::Ptr snapshot(getMetricsSnapshot(_owner));
 
     for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
     {
@@ -613,58 +726,23 @@ ChannelContainer::getMetrics(void)
 
         if (aPort && aPort->isService())
         {
-            yarp::os::Bottle metrics;
+            const ServiceMetrics * cached = (snapshot ?
+                                             snapshot->findService(aPort->getPortName()) : NULL);
 
-            if (Utilities::GetMetricsForService(aPort->getPortName(), metrics, STANDARD_WAIT_TIME_))
+            // The service is never asked directly, as that would hold up the message thread.
+            if (cached && cached->_valid && cached->_enabled)
             {
-                String metricsString = Utilities::ConvertMetricsToString(metrics,
-                                                             Common::kOutputFlavourTabs).c_str();
-
-                result.addLines(metricsString);
+                result = *cached;
+                okSoFar = true;
                 break;
             }
 
         }
     }
-    ODL_OBJEXIT(); //####
-    return result;
+    ODL_OBJEXIT_B(okSoFar); //####
+    return okSoFar;
 } // ChannelContainer::getMetrics
 
-bool
-ChannelContainer::getMetricsState(void)
-{
-    ODL_OBJENTER(); //####
-    bool result = false;
-
-    for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
-    {
-        ChannelEntry * aPort = getPort(ii);
-
-        if (aPort && aPort->isService())
-        {
-            if (Utilities::GetMetricsStateForService(aPort->getPortName(), result,
-                                                     STANDARD_WAIT_TIME_))
-            {
-                break;
-            }
-
-        }
-    }
-    ODL_OBJEXIT_B(result); //####
-    return result;
-} // ChannelContainer::getMetricsState
-
-#if defined(USE_OGDF_POSITIONING_)
-ogdf::node
-ChannelContainer::getNode(void)
-const
-{
-    ODL_OBJENTER(); //####
-    ODL_OBJEXIT_P(_node); //####
-    return _node;
-} // ChannelContainer::getNode
-#endif // defined(USE_OGDF_POSITIONING_)
-
 ChannelEntry *
 ChannelContainer::getPort(const int num)
 const
@@ -696,6 +774,57 @@ const
     return result;
 } // ChannelContainer::getPositionInPanel
 
+YarpString
+ChannelContainer::getServicePortName(void)
+const
+{
+    ODL_OBJENTER(); //####
+    YarpString result;
+
+    for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
+    {
+        ChannelEntry * aPort = getPort(ii);
+
+        if (aPort && aPort->isService())
+        {
+            result = aPort->getPortName();
+            break;
+        }
+
+    }
+    ODL_OBJEXIT_s(result); //####
+    return result;
+} // ChannelContainer::getServicePortName
+
+bool
+ChannelContainer::getServiceState(ServiceState & result,
+                                  const bool     needExtraInfo)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("result = ", &result); //####
+    ODL_B1("needExtraInfo = ", needExtraInfo); //####
+    bool                okSoFar = false;
+    ServiceStateCache * stateCache = getServiceStateCache(_owner);
+
+    if (stateCache)
+    {
+        for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
+        {
+            ChannelEntry * aPort = getPort(ii);
+
+            if (aPort && aPort->isService())
+            {
+                stateCache->getState(aPort->getPortName(), needExtraInfo, result);
+                okSoFar = true;
+                break;
+            }
+
+        }
+    }
+    ODL_OBJEXIT_B(okSoFar); //####
+    return okSoFar;
+} // ChannelContainer::getServiceState
+
 float
 ChannelContainer::getTextInset(void)
 const
@@ -742,6 +871,36 @@ ChannelContainer::hide(void)
     ODL_OBJEXIT(); //####
 } // ChannelContainer::hide
 
+bool
+ChannelContainer::hitTest(int x,
+                          int y)
+{
+    ODL_OBJENTER(); //####
+    ODL_I2("x = ", x, "y = ", y); //####
+    // An entity that is too small to be seen can't be pressed.
+    bool result = ((! _owner.isTooSmallToSee(getLocalBounds().toFloat())) &&
+                   inherited::hitTest(x, y));
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ChannelContainer::hitTest
+
+void
+ChannelContainer::invalidateConnectionGeometry(void)
+{
+    ODL_OBJENTER(); //####
+    for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
+    {
+        ChannelEntry * aPort = getPort(ii);
+
+        if (aPort)
+        {
+            aPort->invalidateConnectionGeometry();
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::invalidateConnectionGeometry
+
 void
 ChannelContainer::invalidateConnections(void)
 {
@@ -758,6 +917,34 @@ ChannelContainer::invalidateConnections(void)
     ODL_OBJEXIT(); //####
 } // ChannelContainer::invalidateConnections
 
+void
+ChannelContainer::invalidateTitleLayouts(void)
+{
+    ODL_OBJENTER(); //####
+    _titleLayoutWidth = -1;
+    for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
+    {
+        ChannelEntry * aPort = getPort(ii);
+
+        if (aPort)
+        {
+            aPort->invalidateTitleLayout();
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::invalidateTitleLayouts
+
+bool
+ChannelContainer::isInCollapsedCluster(void)
+const
+{
+    ODL_OBJENTER(); //####
+    bool result = (_cluster && _cluster->isCollapsed());
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ChannelContainer::isInCollapsedCluster
+
 bool
 ChannelContainer::isMarked(void)
 const
@@ -825,11 +1012,26 @@ ChannelContainer::mouseDown(const MouseEvent & ee)
         displayAndProcessPopupMenu();
         doDrag = false;
     }
+    else if (ee.mods.isShiftDown())
+    {
+        // Shift-clicking adds the entity to the set that bulk operations apply to, or removes it.
+        if (_selected)
+        {
+            deselect();
+        }
+        else
+        {
+            select();
+        }
+        repaint();
+        doDrag = false;
+    }
     else
     {
         _owner.getContent()->setContainerOfInterest(this);
     }
-    if (doDrag)
+    // When the panel draws the entities itself, it also moves them.
+    if (doDrag && (! _owner.isDrawingEntitiesDirectly()))
     {
         _dragger.startDraggingComponent(this, ee);
     }
@@ -844,41 +1046,68 @@ ChannelContainer::mouseDrag(const MouseEvent & ee)
     bool doDrag = true;
 
     // Moves this Component according to the mouse drag event and applies our constraints to it
-    if (ee.mods.isAltDown() || ee.mods.isCommandDown() || ee.mods.isPopupMenu())
+    if (ee.mods.isAltDown() || ee.mods.isCommandDown() || ee.mods.isPopupMenu() ||
+        _owner.isDrawingEntitiesDirectly())
     {
         doDrag = false;
     }
     if (doDrag)
     {
 #if (! SETTINGS_FOR_MANUAL_)
+        // Only the areas that the entity and its connections covered before and after the move
+        // need to be redrawn.
+        juce::Rectangle<float> dirtyArea(_owner.getEntityDrawingArea(this));
+
+        _owner.beginMovingEntity(this);
         _dragger.dragComponent(this, ee, &_constrainer);
-#endif // ! SETTINGS_FOR_MANUAL_
+        dirtyArea = dirtyArea.getUnion(_owner.getEntityDrawingArea(this));
+        _owner.repaint(dirtyArea.getSmallestIntegerContainer());
+#else // ! SETTINGS_FOR_MANUAL_
         _owner.repaint();
+#endif // ! SETTINGS_FOR_MANUAL_
     }
     ODL_OBJEXIT(); //####
 } // ChannelContainer::mouseDrag
 
+#if (! MAC_OR_LINUX_)
+# pragma warning(push)
+# pragma warning(disable: 4100)
+#endif // ! MAC_OR_LINUX_
 void
-ChannelContainer::paint(Graphics & gg)
+ChannelContainer::mouseUp(const MouseEvent & ee)
 {
+#if (! defined(ODL_ENABLE_LOGGING_))
+# if MAC_OR_LINUX_
+#  pragma unused(ee)
+# endif // MAC_OR_LINUX_
+#endif // ! defined(ODL_ENABLE_LOGGING_)
     ODL_OBJENTER(); //####
-    ODL_P1("gg = ", &gg); //####
-    AttributedString as;
+    ODL_P1("ee = ", &ee); //####
+    _owner.endMovingEntity();
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::mouseUp
+#if (! MAC_OR_LINUX_)
+# pragma warning(pop)
+#endif // ! MAC_OR_LINUX_
 
-    as.setJustification(Justification::left);
-    as.append(getName(), _owner.getNormalFont(), kHeadingTextColour);
-    juce::Rectangle<int> localBounds(getLocalBounds());
-    juce::Rectangle<int> area1(localBounds.getX(), localBounds.getY(), localBounds.getWidth(),
-                               _titleHeight);
-    juce::Rectangle<int> area2(localBounds.getX(), localBounds.getY() + _titleHeight,
-                               localBounds.getWidth(), localBounds.getHeight() - _titleHeight);
+void
+ChannelContainer::moved(void)
+{
+    ODL_OBJENTER(); //####
+    invalidateConnectionGeometry();
+    _owner.updateSpatialIndex(this);
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::moved
 
-    gg.setColour(kHeadingBackgroundColour);
-    gg.fillRect(area1);
-    area1.setLeft(static_cast<int>(area1.getX() + getTextInset()));
-    as.draw(gg, area1.toFloat());
-    gg.setColour(kGapFillColour);
-    gg.fillRect(area2);
+void
+ChannelContainer::paint(Graphics & gg)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    if (! _owner.isTooSmallToSee(getLocalBounds().toFloat()))
+    {
+        drawContent(gg, getLocalBounds());
+    }
     ODL_OBJEXIT(); //####
 } // ChannelContainer::paint
 
@@ -906,6 +1135,8 @@ ChannelContainer::resized(void)
     _constrainer.setMinimumOnscreenAmounts(getHeight(), getWidth(),
                                            static_cast<int>(getHeight() * 0.8),
                                            static_cast<int>(getWidth() * 0.8));
+    invalidateConnectionGeometry();
+    _owner.updateSpatialIndex(this);
     ODL_OBJEXIT(); //####
 } // ChannelContainer::resized
 
@@ -954,6 +1185,18 @@ ChannelContainer::select(void)
     ODL_OBJEXIT(); //####
 } // ChannelContainer::select
 
+bool
+ChannelContainer::setAnomaly(const AnomalyKind newAnomaly)
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("newAnomaly = ", newAnomaly); //####
+    bool changed = (newAnomaly != _anomaly);
+
+    _anomaly = newAnomaly;
+    ODL_OBJEXIT_B(changed); //####
+    return changed;
+} // ChannelContainer::setAnomaly
+
 void
 ChannelContainer::setHidden(void)
 {
@@ -976,6 +1219,19 @@ ChannelContainer::setMetricsState(const bool newState)
             if (Utilities::SetMetricsStateForService(aPort->getPortName(), newState,
                                                      STANDARD_WAIT_TIME_))
             {
+                ContentPanel *      thePanel = _owner.getContent();
+                MetricsPoller *     poller = (thePanel ? thePanel->getMetricsPoller() : NULL);
+                ServiceStateCache * stateCache = getServiceStateCache(_owner);
+
+                // The poller has to see the change before its snapshot is correct again.
+                if (poller)
+                {
+                    poller->pollSoon();
+                }
+                if (stateCache)
+                {
+                    stateCache->noteMetricsState(aPort->getPortName(), newState);
+                }
                 break;
             }
 
@@ -984,16 +1240,6 @@ ChannelContainer::setMetricsState(const bool newState)
     ODL_OBJEXIT(); //####
 } // ChannelContainer::setMetricsState
 
-#if defined(USE_OGDF_POSITIONING_)
-void
-ChannelContainer::setNode(ogdf::node newNode)
-{
-    ODL_OBJENTER(); //####
-    _node = newNode;
-    ODL_OBJEXIT(); //####
-} // ChannelContainer::setNode
-#endif // defined(USE_OGDF_POSITIONING_)
-
 void
 ChannelContainer::setOld(void)
 {
@@ -1100,6 +1346,15 @@ ChannelContainer::stopTheService(void)
     ODL_OBJEXIT(); //####
 } // ChannelContainer::stopTheService
 
+void
+ChannelContainer::visibilityChanged(void)
+{
+    ODL_OBJENTER(); //####
+    // The connections of a hidden entity aren't drawn.
+    _owner.invalidateConnectionsLayer();
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::visibilityChanged
+
 #if defined(__APPLE__)
 # pragma mark Global functions
 #endif // defined(__APPLE__)
@@ -41,23 +41,6 @@
 
 # include "m+mManagerDataTypes.hpp"
 
-# if defined(USE_OGDF_POSITIONING_)
-#  if MAC_OR_LINUX_
-#   pragma clang diagnostic push
-#   pragma clang diagnostic ignored "-Wunused-parameter"
-#  else // ! MAC_OR_LINUX_
-#   pragma warning(push)
-#   pragma warning(disable: 4100)
-#   pragma warning(disable: 4512)
-#  endif // ! MAC_OR_LINUX_
-#  include <ogdf/basic/Graph.h>
-#  if MAC_OR_LINUX_
-#   pragma clang diagnostic pop
-#  else // ! MAC_OR_LINUX_
-#   pragma warning(pop)
-#  endif // ! MAC_OR_LINUX_
-# endif // defined(USE_OGDF_POSITIONING_)
-
 # if defined(__APPLE__)
 #  pragma clang diagnostic push
 #  pragma clang diagnostic ignored "-Wunknown-pragmas"
@@ -76,6 +59,7 @@
 namespace MPlusM_Manager
 {
     class EntitiesPanel;
+    class EntityCluster;
 
     /*! @brief A container for one or more ports or channels. */
     class ChannelContainer : public Component
@@ -168,16 +152,25 @@ namespace MPlusM_Manager
         void
         displayMetrics(void);
 
+        /*! @brief Draw the heading and background of the container into an area, which is its own
+         bounds when it is painted as a component and its location in the panel when the panel
+         draws the entities itself.
+         @param[in,out] gg The graphics context in which to draw.
+         @param[in] area The area to draw the container into. */
+        void
+        drawContent(Graphics &                   gg,
+                    const juce::Rectangle<int> & area);
+
         /*! @brief Display the connections between containers.
          @param[in,out] gg The graphics context in which to draw. */
         void
         drawOutgoingConnections(Graphics & gg);
 
-        /*! @brief Convert a tab-delimited line of metric data into a more readable form.
-         @param[in] aRow A line of metric data.
-         @return The metric data reformatted. */
-        String
-        formatMetricRow(const String & aRow);
+        /*! @brief Convert the metrics for a channel into a readable form.
+         @param[in] metrics The metrics for the channel.
+         @return The metrics in a readable form. */
+        static String
+        formatChannelMetrics(const ChannelMetrics & metrics);
 
         /*! @brief Return a particular argument descriptor.
          @param[in] idx The index of the argument of interest.
@@ -195,6 +188,15 @@ namespace MPlusM_Manager
             return _behaviour;
         } // getBehaviour
 
+        /*! @brief Return the group that the entity belongs to.
+         @return The group that the entity belongs to, or @c NULL if it is not in a group. */
+        inline EntityCluster *
+        getCluster(void)
+        const
+        {
+            return _cluster;
+        } // getCluster
+
         /*! @brief Return the description of the entity.
          @return The description of the entity. */
         inline const YarpString &
@@ -232,23 +234,14 @@ namespace MPlusM_Manager
         } // getKind
 
         /*! @brief Return the metrics for the container, if it is a service.
-         @return The metrics for the container, if it is a service or an empty string. */
-        StringArray
-        getMetrics(void);
 
-        /*! @brief Return the state of measurment collection for the container, if it is a service.
-         @return @c true if the service is collecting measurements and @c false if it is not a
-         service or if it is a service that is not collecting measurements. */
+         Only the metrics collected by the background poller are used; the service is not asked
+         for them directly.
+         @param[out] result The metrics for the container.
+         @return @c true if the container is a service whose metrics have been collected and
+         @c false otherwise. */
         bool
-        getMetricsState(void);
-
-# if defined(USE_OGDF_POSITIONING_)
-        /*! @brief Return the node corresponding to the entity.
-         @return The node corresponding to the entity. */
-        ogdf::node
-        getNode(void)
-        const;
-# endif // defined(USE_OGDF_POSITIONING_)
+        getMetrics(ServiceMetrics & result);
 
         /*! @brief Returns the number of argument descriptions in this container.
          @return The number of argument descriptions in this container. */
@@ -297,6 +290,24 @@ namespace MPlusM_Manager
             return _requests;
         } // getRequests
 
+        /*! @brief Return the name of the service port of the container, if it is a service.
+         @return The name of the service port or an empty string if the container is not a
+         service. */
+        YarpString
+        getServicePortName(void)
+        const;
+
+        /*! @brief Return the last known state of the container, if it is a service.
+
+         The state is taken from the cache of service states, which refreshes it in the background
+         if it is out of date, so this never waits for the service to respond.
+         @param[out] result The last known state of the service.
+         @param[in] needExtraInfo @c true if the extra information for the service is wanted.
+         @return @c true if the container is a service and @c false otherwise. */
+        bool
+        getServiceState(ServiceState & result,
+                        const bool     needExtraInfo);
+
         /*! @brief Return the amount of space to the left of the text being displayed.
          @return The amount of space to the left of the text being displayed. */
         float
@@ -313,10 +324,35 @@ namespace MPlusM_Manager
         void
         hide(void);
 
+        /*! @brief Determine whether a point is within the entity, for mouse events.
+         @param[in] x The horizontal coordinate of the point, relative to the entity.
+         @param[in] y The vertical coordinate of the point, relative to the entity.
+         @return @c true if the point is within the entity and the entity can be seen and @c false
+         otherwise. */
+        virtual bool
+        hitTest(int x,
+                int y);
+
+        /*! @brief Mark the appearance of all the connections to and from the entity as needing to
+         be recalculated. */
+        void
+        invalidateConnectionGeometry(void);
+
         /*! @brief Mark all the connections as invalid. */
         void
         invalidateConnections(void);
 
+        /*! @brief Mark the arrangement of the text of the heading and of all the entries as needing
+         to be recalculated. */
+        void
+        invalidateTitleLayouts(void);
+
+        /*! @brief Return @c true if the entity belongs to a group that is displayed in its place.
+         @return @c true if the entity belongs to a collapsed group and @c false otherwise. */
+        bool
+        isInCollapsedCluster(void)
+        const;
+
         /*! @brief Returns @c true if one of the port entries is marked and @c false otherwise.
          @return @c true if one of the port entries is marked and @c false otherwise. */
         bool
@@ -358,6 +394,15 @@ namespace MPlusM_Manager
         virtual void
         mouseDrag(const MouseEvent & ee);
 
+        /*! @brief Called when a mouse button is released.
+         @param[in] ee Details about the position and status of the mouse event. */
+        virtual void
+        mouseUp(const MouseEvent & ee);
+
+        /*! @brief Called when the component position has been changed. */
+        virtual void
+        moved(void);
+
         /*! @brief Remove connections that are invalid. */
         void
         removeInvalidConnections(void);
@@ -374,6 +419,22 @@ namespace MPlusM_Manager
         void
         select(void);
 
+        /*! @brief Set the worst anomaly seen in the metrics of the entity or its channels.
+         @param[in] newAnomaly The worst anomaly seen in the metrics of the entity or its
+         channels.
+         @return @c true if the anomaly has changed and @c false otherwise. */
+        bool
+        setAnomaly(const AnomalyKind newAnomaly);
+
+        /*! @brief Record the group that the entity belongs to.
+         @param[in] aCluster The group that the entity belongs to, or @c NULL if it is not in a
+         group. */
+        inline void
+        setCluster(EntityCluster * aCluster)
+        {
+            _cluster = aCluster;
+        } // setCluster
+
         /*! @brief Sets the hidden flag for the entity. */
         void
         setHidden(void);
@@ -383,13 +444,6 @@ namespace MPlusM_Manager
         void
         setMetricsState(const bool newState);
 
-# if defined(USE_OGDF_POSITIONING_)
-        /*! @brief Sets the node corresponding to the entity.
-         @param[in] newNode The new value for the node corresponding to the entity. */
-        void
-        setNode(ogdf::node newNode);
-# endif // defined(USE_OGDF_POSITIONING_)
-
         /*! @brief Marks the entity as not newly created. */
         void
         setOld(void);
@@ -433,6 +487,10 @@ namespace MPlusM_Manager
         virtual void
         paint(Graphics & gg);
 
+        /*! @brief Called when the component is made visible or invisible. */
+        virtual void
+        visibilityChanged(void);
+
     public :
 
     protected :
@@ -463,17 +521,28 @@ namespace MPlusM_Manager
         /*! @brief The requests for the entity, if it is a service or an adapter. */
         YarpString _requests;
 
-# if defined(USE_OGDF_POSITIONING_)
-        /*! @brief The node corresponding to the container. */
-        ogdf::node _node;
-# endif // defined(USE_OGDF_POSITIONING_)
+        /*! @brief The title that was used for the arrangement of the text. */
+        String _titleLayoutText;
+
+        /*! @brief The arrangement of the title of the container. */
+        TextLayout _titleLayout;
 
         /*! @brief The owner of the container. */
         EntitiesPanel & _owner;
 
+        /*! @brief The group that the container belongs to. */
+        EntityCluster * _cluster;
+
         /*! @brief The height of the title of the container. */
         int _titleHeight;
 
+        /*! @brief The width used for the arrangement of the text, or a negative value if the text
+         has not been arranged. */
+        float _titleLayoutWidth;
+
+        /*! @brief The worst anomaly seen in the metrics of the entity or its channels. */
+        AnomalyKind _anomaly;
+
         /*! @brief The kind of container. */
         ContainerKind _kind;
 
@@ -37,9 +37,12 @@
 //--------------------------------------------------------------------------------------------------
 
 #include "m+mChannelEntry.hpp"
+#include "m+mActivitySampler.hpp"
+#include "m+mAnomalyDetector.hpp"
 #include "m+mChannelContainer.hpp"
 #include "m+mContentPanel.hpp"
 #include "m+mEntitiesPanel.hpp"
+#include "m+mTrafficHeatMap.hpp"
 
 //#include <odlEnable.h>
 #include <odlInclude.h>
@@ -101,6 +104,9 @@ static const float kArrowSize = 7;
 /*! @brief The scale factor to apply to get the length of the control vector. */
 static const float kControlLengthScale = 0.25;
 
+/*! @brief The additional line width for a highlighted connection. */
+static const float kHighlightExtraWidth = 2;
+
 /*! @brief The width and height of the marker displayed during movement. */
 static const float kMarkerSide = 10;
 
@@ -124,6 +130,217 @@ static const float kTargetBoxScale = 0.25;
 # pragma mark Local functions
 #endif // defined(__APPLE__)
 
+/*! @brief Add a connection to a set of connections, unless it is already present.
+ @param[in,out] connections The set of connections.
+ @param[in,out] index The positions of the connections, by the name of the other port.
+ @param[in] other The port that is to be connected.
+ @param[in] mode The mode of the connection.
+ @param[in] wasOverridden @c true if the protocol matching was overridden and @c false otherwise. */
+static void
+addConnection(ChannelConnections &      connections,
+              ChannelConnectionIndex &  index,
+              ChannelEntry *            other,
+              const Common::ChannelMode mode,
+              const bool                wasOverridden)
+{
+    ODL_ENTER(); //####
+    ODL_P3("connections = ", &connections, "index = ", &index, "other = ", other); //####
+    ODL_B1("wasOverridden = ", wasOverridden); //####
+    ChannelConnectionIndex::const_iterator match(index.find(other->getPortName()));
+
+    if (index.end() == match)
+    {
+        ChannelInfo newConnection;
+
+        newConnection._otherChannel = other;
+        newConnection._connectionMode = mode;
+        newConnection._forced = wasOverridden;
+        newConnection._valid = true;
+        newConnection._geometry._valid = false;
+        newConnection._trafficColour = Colours::transparentBlack;
+        newConnection._trafficWidth = 0;
+        index[other->getPortName()] = connections.size();
+        connections.push_back(newConnection);
+    }
+    else
+    {
+        ODL_LOG("already present"); //####
+        connections[match->second]._valid = true;
+    }
+    ODL_EXIT(); //####
+} // addConnection
+
+/*! @brief Adds the outline of an anchor leaving the given location.
+ @param[in,out] anchors The outlines of the anchors.
+ @param[in] anchor The side to which the anchor is attached.
+ @param[in] anchorPos The coordinates of the anchor point.
+ @param[in] thickness The line thickness to be used. */
+static void
+addSourceAnchor(Path &           anchors,
+                const AnchorSide anchor,
+                const Position & anchorPos,
+                const float      thickness)
+{
+    ODL_ENTER(); //####
+    ODL_P2("anchors = ", &anchors, "anchorPos = ", &anchorPos); //####
+    ODL_I1("anchor = ", static_cast<int>(anchor)); //####
+    ODL_D1("thickness = ", thickness); //####
+    Position first;
+    Position second;
+
+    switch (anchor)
+    {
+        case kAnchorLeft :
+            first = anchorPos + Position(kArrowSize, -kArrowSize);
+            second = anchorPos + Position(kArrowSize, kArrowSize);
+            break;
+
+        case kAnchorRight :
+            first = anchorPos + Position(-kArrowSize, -kArrowSize);
+            second = anchorPos + Position(-kArrowSize, kArrowSize);
+            break;
+
+        case kAnchorBottomCentre :
+            first = anchorPos + Position(-kArrowSize, -kArrowSize);
+            second = anchorPos + Position(kArrowSize, -kArrowSize);
+            break;
+
+        case kAnchorTopCentre :
+            first = anchorPos + Position(-kArrowSize, kArrowSize);
+            second = anchorPos + Position(kArrowSize, kArrowSize);
+            break;
+
+        default :
+            break;
+
+    }
+    if (kAnchorUnknown != anchor)
+    {
+        ODL_D4("anchor.x = ", anchorPos.getX(), "anchor.y = ", anchorPos.getY(), //####
+               "first.x = ", first.getX(), "first.y = ", first.getY()); //####
+        ODL_D2("second.x = ", second.getX(), "second.y = ", second.getY()); //####
+        anchors.addLineSegment(Line<float>(anchorPos, first), thickness);
+        anchors.addLineSegment(Line<float>(anchorPos, second), thickness);
+    }
+    ODL_EXIT(); //####
+} // addSourceAnchor
+
+/*! @brief Adds the outline of an anchor arriving at the given location.
+ @param[in,out] anchors The outlines of the anchors.
+ @param[in] anchor The side to which the anchor is attached.
+ @param[in] anchorPos The coordinates of the anchor point.
+ @param[in] thickness The line thickness to be used. */
+static void
+addTargetAnchor(Path &           anchors,
+                const AnchorSide anchor,
+                const Position & anchorPos,
+                const float      thickness)
+{
+    ODL_ENTER(); //####
+    ODL_P2("anchors = ", &anchors, "anchorPos = ", &anchorPos); //####
+    ODL_I1("anchor = ", static_cast<int>(anchor)); //####
+    ODL_D1("thickness = ", thickness); //####
+    Position first;
+    Position second;
+
+    switch (anchor)
+    {
+        case kAnchorLeft :
+            first = anchorPos + Position(-kArrowSize, -kArrowSize);
+            second = anchorPos + Position(-kArrowSize, kArrowSize);
+            break;
+
+        case kAnchorRight :
+            first = anchorPos + Position(kArrowSize, -kArrowSize);
+            second = anchorPos + Position(kArrowSize, kArrowSize);
+            break;
+
+        case kAnchorBottomCentre :
+            first = anchorPos + Position(-kArrowSize, kArrowSize);
+            second = anchorPos + Position(kArrowSize, kArrowSize);
+            break;
+
+        case kAnchorTopCentre :
+            first = anchorPos + Position(-kArrowSize, -kArrowSize);
+            second = anchorPos + Position(kArrowSize, -kArrowSize);
+            break;
+
+        default :
+            break;
+
+    }
+    if (kAnchorUnknown != anchor)
+    {
+        ODL_D4("anchor.x = ", anchorPos.getX(), "anchor.y = ", anchorPos.getY(), //####
+               "first.x = ", first.getX(), "first.y = ", first.getY()); //####
+        ODL_D2("second.x = ", second.getX(), "second.y = ", second.getY()); //####
+        anchors.addLineSegment(Line<float>(anchorPos, first), thickness);
+        anchors.addLineSegment(Line<float>(anchorPos, second), thickness);
+    }
+    ODL_EXIT(); //####
+} // addTargetAnchor
+
+/*! @brief Determine the anchor points for a connection between entries.
+ @param[in] source The originating entry.
+ @param[in] destination The terminating entry.
+ @param[in] isBidirectional @c true if the connection is to a service and @c false otherwise.
+ @param[out] sourceAnchor The side of the originating entry to which the connection is attached.
+ @param[out] destinationAnchor The side of the terminating entry to which the connection is
+ attached.
+ @param[out] startPoint The beginning of the connection.
+ @param[out] endPoint The end of the connection.
+ @param[out] sourceCentre The centre of the originating entry.
+ @param[out] destinationCentre The centre of the terminating entry. */
+static void
+calculateConnectionAnchors(const ChannelEntry * source,
+                           const ChannelEntry * destination,
+                           const bool           isBidirectional,
+                           AnchorSide &         sourceAnchor,
+                           AnchorSide &         destinationAnchor,
+                           Position &           startPoint,
+                           Position &           endPoint,
+                           Position &           sourceCentre,
+                           Position &           destinationCentre)
+{
+    ODL_ENTER(); //####
+    ODL_P4("source = ", source, "destination = ", destination, "startPoint = ", //####
+           &startPoint, "endPoint = ", &endPoint); //####
+    ODL_B1("isBidirectional = ", isBidirectional); //####
+    Position sourcePosition(source->getPositionInPanel());
+    Position destinationPosition(destination->getPositionInPanel());
+
+    sourceCentre = source->getCentre() + sourcePosition;
+    destinationCentre = destination->getCentre() + destinationPosition;
+    ODL_D4("sourcePosition.x = ", sourcePosition.getX(), "sourcePosition.y = ", //####
+           sourcePosition.getY(), "destinationPosition.x = ", //####
+           destinationPosition.getX(), "destinationPosition.y = ", //####
+           destinationPosition.getY()); //####
+    ODL_D4("sourceCentre.x = ", sourceCentre.getX(), "sourceCentre.y = ", //####
+           sourceCentre.getY(), "destinationCentre.x = ", destinationCentre.getX(), //####
+           "destinationCentre.y = ", destinationCentre.getY()); //####
+    // Check if the destination is above the source, in which case we determine the anchors in the
+    // reverse order.
+    if (sourceCentre.getY() < destinationCentre.getY())
+    {
+        sourceAnchor = source->calculateClosestAnchor(startPoint, ! isBidirectional, false,
+                                                      destinationCentre);
+        destinationAnchor = destination->calculateClosestAnchor(endPoint, false,
+                                                                kAnchorBottomCentre == sourceAnchor,
+                                                                sourceCentre);
+    }
+    else
+    {
+        destinationAnchor = destination->calculateClosestAnchor(endPoint, false, false,
+                                                                sourceCentre);
+        sourceAnchor = source->calculateClosestAnchor(startPoint, ! isBidirectional,
+                                                      kAnchorBottomCentre == destinationAnchor,
+                                                      destinationCentre);
+    }
+    ODL_D4("startPoint.x <- ", startPoint.getX(), "startPoint.y <- ", startPoint.getY(), //####
+           "endPoint.x <- ", endPoint.getX(), "endPoint.y <- ", endPoint.getY()); //####
+    ODL_EXIT(); //####
+} // calculateConnectionAnchors
+
 /*! @brief Determine if a new point is closer to a reference point than the previous point.
  @param[in,out] distanceSoFar On input, the closest distance so far and on output, the new closest
  distance.
@@ -223,141 +440,59 @@ calculateAnchorForPoint(Position &       newCentre,
     return anchor;
 } // calculateAnchorForPoint
 
-/*! @brief Displays an anchor leaving the given location.
- @param[in,out] gg The graphics context in which to draw.
- @param[in] anchor The side to which the anchor is attached.
- @param[in] anchorPos The coordinates of the anchor point.
- @param[in] thickness The line thickness to be used. */
+/*! @brief Close up the connections that are marked as removed in a set of connections,
+ preserving the order of the remaining connections.
+ @param[in,out] connections The set of connections.
+ @param[in,out] index The positions of the connections, by the name of the other port.
+ @param[in,out] removed The number of connections that are marked as removed. */
 static void
-drawSourceAnchor(Graphics &       gg,
-                 const AnchorSide anchor,
-                 const Position & anchorPos,
-                 const float      thickness)
+compactConnections(ChannelConnections &     connections,
+                   ChannelConnectionIndex & index,
+                   size_t &                 removed)
 {
     ODL_ENTER(); //####
-    ODL_P2("gg = ", &gg, "anchorPos = ", &anchorPos); //####
-    ODL_I1("anchor = ", static_cast<int>(anchor)); //####
-    ODL_D1("thickness = ", thickness); //####
-    Position first;
-    Position second;
-
-    switch (anchor)
+    ODL_P3("connections = ", &connections, "index = ", &index, "removed = ", &removed); //####
+    if (0 < removed)
     {
-        case kAnchorLeft :
-            first = anchorPos + Position(kArrowSize, -kArrowSize);
-            second = anchorPos + Position(kArrowSize, kArrowSize);
-            break;
+        size_t kept = 0;
 
-        case kAnchorRight :
-            first = anchorPos + Position(-kArrowSize, -kArrowSize);
-            second = anchorPos + Position(-kArrowSize, kArrowSize);
-            break;
-
-        case kAnchorBottomCentre :
-            first = anchorPos + Position(-kArrowSize, -kArrowSize);
-            second = anchorPos + Position(kArrowSize, -kArrowSize);
-            break;
-
-        case kAnchorTopCentre :
-            first = anchorPos + Position(-kArrowSize, kArrowSize);
-            second = anchorPos + Position(kArrowSize, kArrowSize);
-            break;
-
-        default :
-            break;
-
-    }
-    if (kAnchorUnknown != anchor)
-    {
-        ODL_D4("anchor.x = ", anchorPos.getX(), "anchor.y = ", anchorPos.getY(), //####
-               "first.x = ", first.getX(), "first.y = ", first.getY()); //####
-        ODL_D2("second.x = ", second.getX(), "second.y = ", second.getY()); //####
-        gg.drawLine(anchorPos.getX(), anchorPos.getY(), first.getX(), first.getY(), thickness);
-        gg.drawLine(anchorPos.getX(), anchorPos.getY(), second.getX(), second.getY(), thickness);
-    }
-    ODL_EXIT(); //####
-} // drawSourceAnchor
-
-/*! @brief Displays an anchor arriving at the given location.
- @param[in,out] gg The graphics context in which to draw.
- @param[in] anchor The side to which the anchor is attached.
- @param[in] anchorPos The coordinates of the anchor point.
- @param[in] thickness The line thickness to be used. */
-static void
-drawTargetAnchor(Graphics &       gg,
-                 const AnchorSide anchor,
-                 const Position & anchorPos,
-                 const float      thickness)
-{
-    ODL_ENTER(); //####
-    ODL_P2("gg = ", &gg, "anchorPos = ", &anchorPos); //####
-    ODL_I1("anchor = ", static_cast<int>(anchor)); //####
-    ODL_D1("thickness = ", thickness); //####
-    Position first;
-    Position second;
-
-    switch (anchor)
-    {
-        case kAnchorLeft :
-            first = anchorPos + Position(-kArrowSize, -kArrowSize);
-            second = anchorPos + Position(-kArrowSize, kArrowSize);
-            break;
-
-        case kAnchorRight :
-            first = anchorPos + Position(kArrowSize, -kArrowSize);
-            second = anchorPos + Position(kArrowSize, kArrowSize);
-            break;
-
-        case kAnchorBottomCentre :
-            first = anchorPos + Position(-kArrowSize, kArrowSize);
-            second = anchorPos + Position(kArrowSize, kArrowSize);
-            break;
-
-        case kAnchorTopCentre :
-            first = anchorPos + Position(-kArrowSize, -kArrowSize);
-            second = anchorPos + Position(kArrowSize, -kArrowSize);
-            break;
-
-        default :
-            break;
-
-    }
-    if (kAnchorUnknown != anchor)
-    {
-        ODL_D4("anchor.x = ", anchorPos.getX(), "anchor.y = ", anchorPos.getY(), //####
-               "first.x = ", first.getX(), "first.y = ", first.getY()); //####
-        ODL_D2("second.x = ", second.getX(), "second.y = ", second.getY()); //####
-        gg.drawLine(anchorPos.getX(), anchorPos.getY(), first.getX(), first.getY(), thickness);
-        gg.drawLine(anchorPos.getX(), anchorPos.getY(), second.getX(), second.getY(), thickness);
+        for (size_t ii = 0, mm = connections.size(); mm > ii; ++ii)
+        {
+            if (connections[ii]._otherChannel)
+            {
+                if (kept != ii)
+                {
+                    connections[kept] = connections[ii];
+                    index[connections[kept]._otherChannel->getPortName()] = kept;
+                }
+                ++kept;
+            }
+        }
+        connections.resize(kept);
+        removed = 0;
     }
     ODL_EXIT(); //####
-} // drawTargetAnchor
+} // compactConnections
 
-/*! @brief Draw a bezier curve between two points.
- @param[in,out] gg The graphics context in which to draw.
+/*! @brief Create a bezier curve between two points.
+ @param[out] bezPath The curve.
  @param[in] startPoint The beginning of the curve.
  @param[in] endPoint The end of the curve.
  @param[in] startCentre A reference point for the beginning of the curve, used to calculate the
  beginning tangent.
  @param[in] endCentre A reference point for the end of the curve, used to calculate the ending
- tangent.
- @param[in] thickness The line thickness to be used.
- @param[in] isDashed @c true if the line should be dashed and @c false otherwise. */
+ tangent. */
 static void
-drawBezier(Graphics &       gg,
-           const Position & startPoint,
-           const Position & endPoint,
-           const Position & startCentre,
-           const Position & endCentre,
-           const float      thickness,
-           const bool       isDashed)
+createBezierPath(Path &           bezPath,
+                 const Position & startPoint,
+                 const Position & endPoint,
+                 const Position & startCentre,
+                 const Position & endCentre)
 {
     ODL_ENTER(); //####
-    ODL_P4("gg = ", &gg, "startPoint = ", &startPoint, "endPoint = ", &endPoint, //####
+    ODL_P4("bezPath = ", &bezPath, "startPoint = ", &startPoint, "endPoint = ", &endPoint, //####
            "startCentre = ", &startCentre); //####
     ODL_P1("endCentre = ", &endCentre); //####
-    ODL_D1("thickness = ", thickness); //####
-    Path     bezPath;
     float    controlLength = (startPoint.getDistanceFrom(endPoint) * kControlLengthScale);
     float    startAngle = atan2(startPoint.getY() - startCentre.getY(),
                                 startPoint.getX() - startCentre.getX());
@@ -366,8 +501,27 @@ drawBezier(Graphics &       gg,
     Position controlPoint1(controlLength * cos(startAngle), controlLength * sin(startAngle));
     Position controlPoint2(controlLength * cos(endAngle), controlLength * sin(endAngle));
 
+    bezPath.clear();
     bezPath.startNewSubPath(startPoint);
     bezPath.cubicTo(startPoint + controlPoint1, endPoint + controlPoint2, endPoint);
+    ODL_EXIT(); //####
+} // createBezierPath
+
+/*! @brief Calculate the outline of a connection curve.
+ @param[out] outline The outline of the curve, ready to be filled.
+ @param[in] centreline The curve.
+ @param[in] thickness The line thickness to be used.
+ @param[in] isDashed @c true if the line should be dashed and @c false otherwise. */
+static void
+createCurveOutline(Path &       outline,
+                   const Path & centreline,
+                   const float  thickness,
+                   const bool   isDashed)
+{
+    ODL_ENTER(); //####
+    ODL_P2("outline = ", &outline, "centreline = ", &centreline); //####
+    ODL_D1("thickness = ", thickness); //####
+    ODL_B1("isDashed = ", isDashed); //####
     if (isDashed)
     {
         float          newThickness = sqrt(thickness);
@@ -376,118 +530,202 @@ drawBezier(Graphics &       gg,
         const int      numDashes = (sizeof(dashes) / sizeof(*dashes));
         Path           strokedPath;
 
-        strokeType.createDashedStroke(strokedPath, bezPath, dashes, numDashes);
-        gg.strokePath(strokedPath, PathStrokeType(newThickness));
+        strokeType.createDashedStroke(strokedPath, centreline, dashes, numDashes);
+        strokeType.createStrokedPath(outline, strokedPath);
     }
     else
     {
-        gg.strokePath(bezPath, PathStrokeType(thickness));
+        PathStrokeType(thickness).createStrokedPath(outline, centreline);
     }
     ODL_EXIT(); //####
-} // drawBezier
+} // createCurveOutline
 
-/*! @brief Draw a connection between entries.
- @param[in,out] gg The graphics context in which to draw.
+/*! @brief Calculate the appearance of a connection between entries.
+ @param[out] geometry The appearance of the connection.
  @param[in] source The originating entry.
  @param[in] destination The terminating entry.
- @param[in] mode The kind of connection.
- @param[in] forced @c true if the protocols were overridden and @c false otherwise. */
+ @param[in] forced @c true if the protocols were overridden and @c false otherwise.
+ @param[in] highlighted @c true if the connection is to be emphasized and @c false otherwise.
+ @param[in] trafficWidth The thickness of the connection, as determined by its traffic, or zero
+ if the thickness is determined by the kind of connection. */
 static void
-drawConnection(Graphics &                gg,
-               ChannelEntry *            source,
-               ChannelEntry *            destination,
-               const Common::ChannelMode mode,
-               const bool                forced)
+createConnectionGeometry(ConnectionGeometry & geometry,
+                         const ChannelEntry * source,
+                         const ChannelEntry * destination,
+                         const bool           forced,
+                         const bool           highlighted,
+                         const float          trafficWidth)
 {
     ODL_ENTER(); //####
-    ODL_P3("gg = ", &gg, "source = ", source, "destination = ", destination); //####
-    ODL_I1("mode = ", static_cast<int>(mode)); //####
-    ODL_B1("forced = ", forced); //####
-    if (source && destination)
-    {
-        AnchorSide sourceAnchor;
-        AnchorSide destinationAnchor;
-        bool       isBidirectional = false;
-        Position   sourcePosition(source->getPositionInPanel());
-        Position   destinationPosition(destination->getPositionInPanel());
-        Position   sourceCentre(source->getCentre() + sourcePosition);
-        Position   destinationCentre(destination->getCentre() + destinationPosition);
-        Position   startPoint;
-        Position   endPoint;
-        float      thickness;
-
-        ODL_D4("sourcePosition.x = ", sourcePosition.getX(), "sourcePosition.y = ", //####
-               sourcePosition.getY(), "destinationPosition.x = ", //####
-               destinationPosition.getX(), "destinationPosition.y = ", //####
-               destinationPosition.getY()); //####
-        ODL_D4("sourceCentre.x = ", sourceCentre.getX(), "sourceCentre.y = ", //####
-               sourceCentre.getY(), "destinationCentre.x = ", destinationCentre.getX(), //####
-               "destinationCentre.y = ", destinationCentre.getY()); //####
-        if (destination->isService())
-        {
-            isBidirectional = true;
-            thickness = kServiceConnectionWidth;
-        }
-        else if (destination->isInputOutput())
-        {
-            thickness = kInputOutputConnectionWidth;
-        }
-        else
-        {
-            thickness = kNormalConnectionWidth;
-        }
-        ODL_B1("isBidirectional <- ", isBidirectional); //####
-        ODL_D1("thickness <- ", thickness); //####
-        // Check if the destination is above the source, in which case we determine the anchors in
-        // the reverse order.
-        if (sourceCentre.getY() < destinationCentre.getY())
-        {
-            sourceAnchor = source->calculateClosestAnchor(startPoint, ! isBidirectional, false,
-                                                          destinationCentre);
-            destinationAnchor = destination->calculateClosestAnchor(endPoint, false,
-                                                                kAnchorBottomCentre == sourceAnchor,
-                                                                    sourceCentre);
-        }
-        else
-        {
-            destinationAnchor = destination->calculateClosestAnchor(endPoint, false, false,
-                                                                    sourceCentre);
-            sourceAnchor = source->calculateClosestAnchor(startPoint, ! isBidirectional,
-                                                          kAnchorBottomCentre == destinationAnchor,
-                                                          destinationCentre);
-        }
-        ODL_D4("startPoint.x <- ", startPoint.getX(), "startPoint.y <- ", //####
-               startPoint.getY(), "endPoint.x <- ", endPoint.getX(), "endPoint.y <- ", //####
-               endPoint.getY()); //####
-        switch (mode)
+    ODL_P3("geometry = ", &geometry, "source = ", source, "destination = ", //####
+           destination); //####
+    ODL_B2("forced = ", forced, "highlighted = ", highlighted); //####
+    ODL_D1("trafficWidth = ", trafficWidth); //####
+    AnchorSide sourceAnchor;
+    AnchorSide destinationAnchor;
+    bool       isBidirectional = false;
+    Position   sourceCentre;
+    Position   destinationCentre;
+    Position   startPoint;
+    Position   endPoint;
+    float      thickness;
+
+    if (destination->isService())
+    {
+        isBidirectional = true;
+        thickness = kServiceConnectionWidth;
+    }
+    else if (destination->isInputOutput())
+    {
+        thickness = kInputOutputConnectionWidth;
+    }
+    else
+    {
+        thickness = kNormalConnectionWidth;
+    }
+    if (0 < trafficWidth)
+    {
+        thickness = trafficWidth;
+    }
+    if (highlighted)
+    {
+        thickness += kHighlightExtraWidth;
+    }
+    ODL_B1("isBidirectional <- ", isBidirectional); //####
+    ODL_D1("thickness <- ", thickness); //####
+    calculateConnectionAnchors(source, destination, isBidirectional, sourceAnchor,
+                               destinationAnchor, startPoint, endPoint, sourceCentre,
+                               destinationCentre);
+    createBezierPath(geometry._centreline, startPoint, endPoint, sourceCentre, destinationCentre);
+    createCurveOutline(geometry._curve, geometry._centreline, thickness, forced);
+    geometry._anchors.clear();
+    if (isBidirectional)
+    {
+        addTargetAnchor(geometry._anchors, sourceAnchor, startPoint, 1);
+    }
+    else
+    {
+        addSourceAnchor(geometry._anchors, sourceAnchor, startPoint, 1);
+    }
+    addTargetAnchor(geometry._anchors, destinationAnchor, endPoint, 1);
+    geometry._bounds = geometry._curve.getBounds().getUnion(geometry._anchors.getBounds());
+    geometry._valid = true;
+    ODL_EXIT(); //####
+} // createConnectionGeometry
+
+/*! @brief Return the area of the activity marker of a port entry.
+ @param[in] area The area of the port entry.
+ @return The area of the activity marker, at the right end of the port entry. */
+static juce::Rectangle<float>
+getActivityMarkerArea(const juce::Rectangle<float> & area)
+{
+    ODL_ENTER(); //####
+    ODL_P1("area = ", &area); //####
+    float                  side = area.getHeight() - (2 * kActivityInset);
+    juce::Rectangle<float> result(area.getRight() - (side + kActivityInset),
+                                  area.getY() + kActivityInset, side, side);
+
+    ODL_EXIT(); //####
+    return result;
+} // getActivityMarkerArea
+
+/*! @brief Return the area of the anomaly badge of a port entry.
+ @param[in] area The area of the port entry.
+ @return The area of the anomaly badge, just to the left of the activity marker. */
+static juce::Rectangle<float>
+getAnomalyBadgeArea(const juce::Rectangle<float> & area)
+{
+    ODL_ENTER(); //####
+    ODL_P1("area = ", &area); //####
+    juce::Rectangle<float> result(getActivityMarkerArea(area));
+
+    result.translate(- (result.getWidth() + kActivityInset), 0);
+    ODL_EXIT(); //####
+    return result;
+} // getAnomalyBadgeArea
+
+/*! @brief Return the colour to use for a connection.
+ @param[in] connection The connection of interest.
+ @return The colour to use for the connection. */
+static Colour
+getConnectionColour(const ChannelInfo & connection)
+{
+    ODL_ENTER(); //####
+    ODL_P1("connection = ", &connection); //####
+    Colour result;
+
+    // Connections that aren't being coloured by their traffic are coloured by their kind.
+    if (! connection._trafficColour.isTransparent())
+    {
+        result = connection._trafficColour;
+    }
+    else
+    {
+        switch (connection._connectionMode)
         {
             case Common::kChannelModeTCP :
-                gg.setColour(kTcpConnectionColour);
+                result = kTcpConnectionColour;
                 break;
 
             case Common::kChannelModeUDP :
-                gg.setColour(kUdpConnectionColour);
+                result = kUdpConnectionColour;
                 break;
 
             default :
-                gg.setColour(kOtherConnectionColour);
+                result = kOtherConnectionColour;
                 break;
 
         }
-        drawBezier(gg, startPoint, endPoint, sourceCentre, destinationCentre, thickness, forced);
-        if (isBidirectional)
-        {
-            drawTargetAnchor(gg, sourceAnchor, startPoint, 1);
-        }
-        else
-        {
-            drawSourceAnchor(gg, sourceAnchor, startPoint, 1);
-        }
-        drawTargetAnchor(gg, destinationAnchor, endPoint, 1);
     }
     ODL_EXIT(); //####
+    return result;
+} // getConnectionColour
+
+/*! @brief Draw a connection between entries.
+ @param[in,out] gg The graphics context in which to draw.
+ @param[in] geometry The appearance of the connection.
+ @param[in] baseColour The colour of the connection.
+ @param[in] highlighted @c true if the connection is to be emphasized and @c false otherwise. */
+static void
+drawConnection(Graphics &                 gg,
+               const ConnectionGeometry & geometry,
+               const Colour &             baseColour,
+               const bool                 highlighted)
+{
+    ODL_ENTER(); //####
+    ODL_P3("gg = ", &gg, "geometry = ", &geometry, "baseColour = ", &baseColour); //####
+    ODL_B1("highlighted = ", highlighted); //####
+    Colour lineColour(baseColour);
+
+    if (highlighted)
+    {
+        lineColour = lineColour.brighter();
+    }
+    gg.setColour(lineColour);
+    gg.fillPath(geometry._curve);
+    gg.fillPath(geometry._anchors);
+    ODL_EXIT(); //####
 } // drawConnection
 
+/*! @brief Return the appearance of a connection, recalculating it if an end has moved.
+ @param[in,out] connection The connection of interest.
+ @param[in] source The originating entry.
+ @return The appearance of the connection. */
+static const ConnectionGeometry &
+getCurrentGeometry(ChannelInfo &        connection,
+                   const ChannelEntry * source)
+{
+    ODL_ENTER(); //####
+    ODL_P2("connection = ", &connection, "source = ", source); //####
+    if (! connection._geometry._valid)
+    {
+        createConnectionGeometry(connection._geometry, source, connection._otherChannel,
+                                 connection._forced, false, connection._trafficWidth);
+    }
+    ODL_EXIT_P(&connection._geometry); //####
+    return connection._geometry;
+} // getCurrentGeometry
+
 /*! @brief Determine whether a connection can be made, based on the port protocols.
  @param[in] sourceProtocol The protocol of the source port.
  @param[in] destinationProtocol The protocol of the destination port.
@@ -521,6 +759,40 @@ protocolsMatch(const YarpString & sourceProtocol,
     return result;
 } // protocolsMatch
 
+/*! @brief Remove a connection from a set of connections, preserving the order of the remaining
+ connections.
+
+ The connection is only marked as removed, so that the remaining connections don't have to be
+ moved; the gaps are closed up the next time that the set is walked, or when half of the set has
+ been marked.
+ @param[in,out] connections The set of connections.
+ @param[in,out] index The positions of the connections, by the name of the other port.
+ @param[in,out] removed The number of connections that are marked as removed.
+ @param[in] other The port that is to be disconnected. */
+static void
+removeConnection(ChannelConnections &     connections,
+                 ChannelConnectionIndex & index,
+                 size_t &                 removed,
+                 ChannelEntry *           other)
+{
+    ODL_ENTER(); //####
+    ODL_P4("connections = ", &connections, "index = ", &index, "removed = ", &removed, //####
+           "other = ", other); //####
+    ChannelConnectionIndex::iterator match(index.find(other->getPortName()));
+
+    if ((index.end() != match) && (connections[match->second]._otherChannel == other))
+    {
+        connections[match->second]._otherChannel = NULL;
+        index.erase(match);
+        ++removed;
+        if (connections.size() < (removed * 2))
+        {
+            compactConnections(connections, index, removed);
+        }
+    }
+    ODL_EXIT(); //####
+} // removeConnection
+
 #if defined(__APPLE__)
 # pragma mark Class methods
 #endif // defined(__APPLE__)
@@ -537,9 +809,11 @@ ChannelEntry::ChannelEntry(ChannelContainer *  parent,
                            const PortUsage     portKind,
                            const PortDirection direction) :
     inherited(), _portName(portName), _portPortNumber(portNumber), _portProtocol(portProtocol),
-    _protocolDescription(protocolDescription), _parent(parent), _direction(direction),
-    _usage(portKind), _beingMonitored(false), _drawActivityMarker(false), _drawConnectMarker(false),
-    _drawDisconnectMarker(false), _isLastPort(true), _wasUdp(false)
+    _protocolDescription(protocolDescription), _parent(parent), _inputRemoved(0),
+    _outputRemoved(0), _anomaly(kAnomalyNone),
+    _direction(direction), _usage(portKind), _titleLayoutWidth(-1), _beingMonitored(false),
+    _drawActivityMarker(false), _drawConnectMarker(false), _drawDisconnectMarker(false),
+    _isLastPort(true), _wasUdp(false)
 {
     ODL_ENTER(); //####
     ODL_P1("parent = ", parent); //####
@@ -600,36 +874,7 @@ ChannelEntry::addInputConnection(ChannelEntry *            other,
     ODL_B1("wasOverridden = ", wasOverridden); //####
     if (other)
     {
-        bool canAdd = true;
-
-        for (ChannelConnections::iterator walker(_inputConnections.begin());
-             _inputConnections.end() != walker; ++walker)
-        {
-            ChannelInfo * candidate(&*walker);
-
-            if (candidate)
-            {
-                if ((candidate->_otherChannel == other) ||
-                    (candidate->_otherChannel->getPortName() == other->getPortName()))
-                {
-                    ODL_LOG("already present"); //####
-                    candidate->_valid = true;
-                    canAdd = false;
-                    break;
-                }
-
-            }
-        }
-        if (canAdd)
-        {
-            ChannelInfo newConnection;
-
-            newConnection._otherChannel = other;
-            newConnection._connectionMode = mode;
-            newConnection._forced = wasOverridden;
-            newConnection._valid = true;
-            _inputConnections.push_back(newConnection);
-        }
+        addConnection(_inputConnections, _inputIndex, other, mode, wasOverridden);
     }
     ODL_OBJEXIT(); //####
 } // ChannelEntry::addInputConnection
@@ -644,40 +889,22 @@ ChannelEntry::addOutputConnection(ChannelEntry *            other,
     ODL_B1("wasOverridden = ", wasOverridden); //####
     if (other)
     {
-        bool canAdd = true;
-
-        for (ChannelConnections::iterator walker(_outputConnections.begin());
-             _outputConnections.end() != walker; ++walker)
-        {
-            ChannelInfo * candidate(&*walker);
-
-            if (candidate)
-            {
-                if ((candidate->_otherChannel == other) ||
-                    (candidate->_otherChannel->getPortName() == other->getPortName()))
-                {
-                    ODL_LOG("already present"); //####
-                    candidate->_valid = true;
-                    canAdd = false;
-                    break;
-                }
-
-            }
-        }
-        if (canAdd)
-        {
-            ChannelInfo newConnection;
-
-            newConnection._otherChannel = other;
-            newConnection._connectionMode = mode;
-            newConnection._forced = wasOverridden;
-            newConnection._valid = true;
-            _outputConnections.push_back(newConnection);
-        }
+        addConnection(_outputConnections, _outputIndex, other, mode, wasOverridden);
     }
     ODL_OBJEXIT(); //####
 } // ChannelEntry::addOutputConnection
 
+void
+ChannelEntry::addScrollingMonitor(void)
+{
+    ODL_OBJENTER(); //####
+    if (! getOwningPanel().getActivitySampler().startMonitoring(getPortName()))
+    {
+        ODL_LOG("(! getOwningPanel().getActivitySampler().startMonitoring(getPortName()))"); //####
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::addScrollingMonitor
+
 AnchorSide
 ChannelEntry::calculateClosestAnchor(Position &       result,
                                      const bool       isSource,
@@ -753,6 +980,19 @@ ChannelEntry::checkConnection(ChannelInfo & otherEnd,
     return result;
 } // ChannelEntry::checkConnection
 
+void
+ChannelEntry::clearActivityMarker(void)
+{
+    ODL_OBJENTER(); //####
+    _beingMonitored = false;
+    if (_drawActivityMarker)
+    {
+        _drawActivityMarker = false;
+        repaintActivityMarker();
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::clearActivityMarker
+
 void
 ChannelEntry::clearConnectMarker(void)
 {
@@ -782,9 +1022,11 @@ ChannelEntry::displayAndProcessPopupMenu(void)
     switch (result)
     {
         case kPopupAddScrollingMonitor :
+            addScrollingMonitor();
             break;
 
         case kPopupAddSimpleMonitor :
+            toggleActivityIndicator();
             break;
 
         case kPopupDetailedDisplayPortInfo :
@@ -810,31 +1052,22 @@ void
 ChannelEntry::displayChannelMetrics(void)
 {
     ODL_ENTER(); //####
-    StringArray metricsArray;
+    ServiceMetrics metrics;
 
-    if (_parent)
+    if (_parent && _parent->getMetrics(metrics))
     {
-        metricsArray = _parent->getMetrics();
-        // Find our line and prepare it.
-        int numRows = metricsArray.size();
-
-        for (int ii = 0; ii < numRows; ++ii)
+        // Find our channel and prepare it.
+        for (ChannelMetricsList::const_iterator walker(metrics._channels.begin());
+             metrics._channels.end() != walker; ++walker)
         {
-            const String & aRow = metricsArray[ii];
-            int            firstTab = aRow.indexOfChar('\t');
-
-            if (0 < firstTab)
+            if (walker->_channelName == getPortName())
             {
-                String channelName(aRow.substring(0, firstTab));
-
-                if (channelName == getPortName().c_str())
-                {
-                    DisplayInformationPanel(this, _parent->formatMetricRow(aRow) + "\n",
-                                            String("Metrics for ") + getPortName().c_str());
-                    break;
-                }
-
+                DisplayInformationPanel(this,
+                                        ChannelContainer::formatChannelMetrics(*walker) + "\n",
+                                        String("Metrics for ") + getPortName().c_str());
+                break;
             }
+
         }
     }
     ODL_EXIT(); //####
@@ -890,29 +1123,100 @@ ChannelEntry::displayInformation(const bool isChannel,
             prefix = "Standard";
             break;
 
-        default :
-            break;
+        default :
+            break;
+
+    }
+    if (0 < getProtocol().length())
+    {
+        suffix = YarpString("\n\nProtocol = '") + getProtocol() + "'";
+        if (moreDetails)
+        {
+            if (0 < getProtocolDescription().length())
+            {
+                suffix += "\n";
+                suffix += getProtocolDescription().c_str();
+            }
+        }
+    }
+    YarpString bodyText("Port: ");
+
+    bodyText += getPortNumber() + "\n";
+    bodyText += prefix + dirText + (isChannel ? " channel" : " port") + suffix;
+    if (kAnomalyNone != _anomaly)
+    {
+        bodyText += "\n\n";
+        bodyText += AnomalyDetector::getAnomalyDescription(_anomaly).toStdString();
+    }
+    DisplayInformationPanel(this, bodyText.c_str(), getPortName().c_str());
+    ODL_EXIT(); //####
+} // ChannelEntry::displayInformation
+
+void
+ChannelEntry::drawContent(Graphics &                     gg,
+                          const juce::Rectangle<float> & area)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("gg = ", &gg, "area = ", &area); //####
+    ODL_D4("x <- ", area.getX(), "y <- ", area.getY(), "w <- ",area.getWidth(), "h <- ", //####
+           area.getHeight()); //####
+    gg.setColour(kEntryBackgroundColour);
+    gg.fillRect(area);
+    // When zoomed out, the text and markers wouldn't be legible.
+    if (getOwningPanel().isDetailVisible())
+    {
+        juce::Rectangle<float> textArea(area);
+
+        textArea.setLeft(area.getX() + _parent->getTextInset());
+        // The title doesn't change, so the text only needs to be arranged again if the space for it
+        // has changed.
+        if (_titleLayoutWidth != textArea.getWidth())
+        {
+            AttributedString as;
+
+            as.setJustification(Justification::left);
+            as.append(_title.c_str(), getOwningPanel().getNormalFont(), kEntryTextColour);
+            _titleLayout.createLayout(as, textArea.getWidth());
+            _titleLayoutWidth = textArea.getWidth();
+        }
+        if (gg.clipRegionIntersects(textArea.getSmallestIntegerContainer()))
+        {
+            _titleLayout.draw(gg, textArea);
+        }
+        if (_drawConnectMarker)
+        {
+            Position markerPos(area.getCentre() - Position(kMarkerSide / 2, kMarkerSide / 2));
+
+            gg.setColour(kMarkerColour);
+            gg.fillEllipse(markerPos.getX(), markerPos.getY(), kMarkerSide, kMarkerSide);
+        }
+        else if (_drawDisconnectMarker)
+        {
+            Position markerPos(area.getCentre() - Position(kMarkerSide / 2, kMarkerSide / 2));
 
-    }
-    if (0 < getProtocol().length())
-    {
-        suffix = YarpString("\n\nProtocol = '") + getProtocol() + "'";
-        if (moreDetails)
+            gg.setColour(kMarkerColour);
+            gg.drawEllipse(markerPos.getX(), markerPos.getY(), kMarkerSide, kMarkerSide, 2);
+        }
+        if (_drawActivityMarker)
         {
-            if (0 < getProtocolDescription().length())
-            {
-                suffix += "\n";
-                suffix += getProtocolDescription().c_str();
-            }
+            juce::Rectangle<float> markerArea(getActivityMarkerArea(area));
+            Position               markerCentre(markerArea.getCentre());
+            ColourGradient         theGradient(kFirstActivityMarkerColour, markerCentre.getX(),
+                                               markerCentre.getY(), kSecondActivityMarkerColour,
+                                               markerArea.getRight(), markerCentre.getY(), true);
+            FillType               theMarkerFill(theGradient);
+
+            gg.setFillType(theMarkerFill);
+            gg.fillEllipse(markerArea);
+        }
+        if (kAnomalyNone != _anomaly)
+        {
+            gg.setColour(AnomalyDetector::getAnomalyColour(_anomaly));
+            gg.fillEllipse(getAnomalyBadgeArea(area));
         }
     }
-    YarpString bodyText("Port: ");
-
-    bodyText += getPortNumber() + "\n";
-    bodyText += prefix + dirText + (isChannel ? " channel" : " port") + suffix;
-    DisplayInformationPanel(this, bodyText.c_str(), getPortName().c_str());
-    ODL_EXIT(); //####
-} // ChannelEntry::displayInformation
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::drawContent
 
 void
 ChannelEntry::drawDragLine(Graphics &       gg,
@@ -924,6 +1228,9 @@ ChannelEntry::drawDragLine(Graphics &       gg,
     ODL_B2("isUDP = ", isUDP, "isForced = ", isForced); //####
     AnchorSide sourceAnchor;
     AnchorSide destinationAnchor;
+    Path       anchors;
+    Path       centreline;
+    Path       curve;
     Position   sourceCentre(getCentre() + getPositionInPanel());
     Position   startPoint;
     Position   destinationCentre;
@@ -955,13 +1262,80 @@ ChannelEntry::drawDragLine(Graphics &       gg,
     {
         gg.setColour(kTcpConnectionColour);
     }
-    drawBezier(gg, startPoint, position, sourceCentre, destinationCentre, kNormalConnectionWidth,
-               isForced);
-    drawSourceAnchor(gg, sourceAnchor, startPoint, 1);
-    drawTargetAnchor(gg, destinationAnchor, position, 1);
+    createBezierPath(centreline, startPoint, position, sourceCentre, destinationCentre);
+    createCurveOutline(curve, centreline, kNormalConnectionWidth, isForced);
+    addSourceAnchor(anchors, sourceAnchor, startPoint, 1);
+    addTargetAnchor(anchors, destinationAnchor, position, 1);
+    gg.fillPath(curve);
+    gg.fillPath(anchors);
     ODL_EXIT(); //####
 } // ChannelEntry::drawDragLine
 
+void
+ChannelEntry::drawOutgoingConnection(Graphics &     gg,
+                                     ChannelEntry * destination,
+                                     const bool     highlighted)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("gg = ", &gg, "destination = ", destination); //####
+    ODL_B1("highlighted = ", highlighted); //####
+    if (destination && _parent->isVisible() && destination->_parent->isVisible())
+    {
+        ChannelConnectionIndex::const_iterator match(_outputIndex.find(destination->getPortName()));
+
+        if (_outputIndex.end() != match)
+        {
+            ChannelInfo & candidate = _outputConnections[match->second];
+            Colour        lineColour(getConnectionColour(candidate));
+
+            if (highlighted)
+            {
+                ConnectionGeometry emphasized;
+
+                // Only one connection is highlighted at a time, so it's not worth caching.
+                createConnectionGeometry(emphasized, this, destination, candidate._forced, true,
+                                         candidate._trafficWidth);
+                drawConnection(gg, emphasized, lineColour, true);
+            }
+            else
+            {
+                drawConnection(gg, getCurrentGeometry(candidate, this), lineColour, false);
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::drawOutgoingConnection
+
+void
+ChannelEntry::drawSimplifiedConnection(Graphics &     gg,
+                                       ChannelEntry * destination,
+                                       const float    lineWidth)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("gg = ", &gg, "destination = ", destination); //####
+    ODL_D1("lineWidth = ", lineWidth); //####
+    if (destination && _parent->isVisible() && destination->_parent->isVisible())
+    {
+        ChannelConnectionIndex::const_iterator match(_outputIndex.find(destination->getPortName()));
+
+        if (_outputIndex.end() != match)
+        {
+            const ChannelInfo & candidate = _outputConnections[match->second];
+            Position            startPoint(getCentre() + getPositionInPanel());
+            Position            endPoint(destination->getCentre() +
+                                         destination->getPositionInPanel());
+
+            // Connections that would be shorter than a pixel aren't visible.
+            if (startPoint.getDistanceFrom(endPoint) >= lineWidth)
+            {
+                gg.setColour(getConnectionColour(candidate));
+                gg.drawLine(Line<float>(startPoint, endPoint), lineWidth);
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::drawSimplifiedConnection
+
 void
 ChannelEntry::drawOutgoingConnections(Graphics & gg)
 {
@@ -969,10 +1343,11 @@ ChannelEntry::drawOutgoingConnections(Graphics & gg)
     ODL_P1("gg = ", &gg); //####
     bool selfIsVisible = _parent->isVisible();
 
-    for (ChannelConnections::const_iterator walker(_outputConnections.begin());
+    compactConnections(_outputConnections, _outputIndex, _outputRemoved);
+    for (ChannelConnections::iterator walker(_outputConnections.begin());
          _outputConnections.end() != walker; ++walker)
     {
-        const ChannelInfo * candidate(&*walker);
+        ChannelInfo * candidate(&*walker);
 
         if (candidate)
         {
@@ -981,8 +1356,8 @@ ChannelEntry::drawOutgoingConnections(Graphics & gg)
 
             if (selfIsVisible && otherIsVisible)
             {
-                drawConnection(gg, this, candidate->_otherChannel, candidate->_connectionMode,
-                               candidate->_forced);
+                drawConnection(gg, getCurrentGeometry(*candidate, this),
+                               getConnectionColour(*candidate), false);
             }
         }
     }
@@ -1000,6 +1375,90 @@ const
     return outer.getCentre();
 } // ChannelEntry::getCentre
 
+juce::Rectangle<float>
+ChannelEntry::getConnectionBounds(const ChannelEntry * destination)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("destination = ", destination); //####
+    juce::Rectangle<float> sourceBounds(getPositionInPanel(), getPositionInPanel() +
+                                        Position(static_cast<float>(getWidth()),
+                                                 static_cast<float>(getHeight())));
+    juce::Rectangle<float> result(sourceBounds);
+
+    if (destination)
+    {
+        Position               destinationPosition(destination->getPositionInPanel());
+        juce::Rectangle<float> destinationBounds(destinationPosition, destinationPosition +
+                                            Position(static_cast<float>(destination->getWidth()),
+                                                static_cast<float>(destination->getHeight())));
+        float                  controlLength;
+
+        // The anchors are on the edges of the entries, offset by at most the arrow size, and the
+        // bezier control points are no further from the anchors than the scaled distance between
+        // them, so the curve lies within the expanded union of the two entries.
+        result = sourceBounds.getUnion(destinationBounds).expanded(kArrowSize);
+        controlLength = (result.getTopLeft().getDistanceFrom(result.getBottomRight()) *
+                         kControlLengthScale);
+        result = result.expanded(controlLength + kServiceConnectionWidth);
+    }
+    ODL_OBJEXIT(); //####
+    return result;
+} // ChannelEntry::getConnectionBounds
+
+juce::Rectangle<float>
+ChannelEntry::getConnectionDrawingBounds(const ChannelEntry * destination)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("destination = ", destination); //####
+    juce::Rectangle<float> result;
+
+    if (destination)
+    {
+        EntitiesPanel &                        owningPanel = getOwningPanel();
+        ChannelConnectionIndex::const_iterator match(_outputIndex.find(destination->getPortName()));
+
+        if (_outputIndex.end() == match)
+        {
+            result = getConnectionBounds(destination);
+        }
+        else if (owningPanel.isDetailVisible())
+        {
+            result = getCurrentGeometry(_outputConnections[match->second], this)._bounds;
+        }
+        else
+        {
+            // When zoomed out, the connection is drawn as a straight line between the centres of
+            // the entries, one screen pixel wide, which can reach outside the bounds of the curve.
+            Position startPoint(getCentre() + getPositionInPanel());
+            Position endPoint(destination->getCentre() + destination->getPositionInPanel());
+
+            result = juce::Rectangle<float>(startPoint,
+                                            endPoint).expanded(1 / owningPanel.getZoomLevel());
+        }
+    }
+    ODL_OBJEXIT(); //####
+    return result;
+} // ChannelEntry::getConnectionDrawingBounds
+
+const ChannelConnections &
+ChannelEntry::getInputConnections(void)
+{
+    ODL_OBJENTER(); //####
+    compactConnections(_inputConnections, _inputIndex, _inputRemoved);
+    ODL_OBJEXIT_P(&_inputConnections); //####
+    return _inputConnections;
+} // ChannelEntry::getInputConnections
+
+const ChannelConnections &
+ChannelEntry::getOutputConnections(void)
+{
+    ODL_OBJENTER(); //####
+    compactConnections(_outputConnections, _outputIndex, _outputRemoved);
+    ODL_OBJEXIT_P(&_outputConnections); //####
+    return _outputConnections;
+} // ChannelEntry::getOutputConnections
+
 EntitiesPanel &
 ChannelEntry::getOwningPanel(void)
 const
@@ -1028,24 +1487,54 @@ const
 {
     ODL_OBJENTER(); //####
     ODL_S1s("otherPort = ", otherPort); //####
-    bool result = false;
+    bool result = (_outputIndex.end() != _outputIndex.find(otherPort));
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ChannelEntry::hasOutgoingConnectionTo
+
+bool
+ChannelEntry::hitTest(int x,
+                      int y)
+{
+    ODL_OBJENTER(); //####
+    ODL_I2("x = ", x, "y = ", y); //####
+    // An entry that is too small to be seen passes the mouse events on to its entity.
+    bool result = ((! getOwningPanel().isTooSmallToSee(getLocalBounds().toFloat())) &&
+                   inherited::hitTest(x, y));
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ChannelEntry::hitTest
 
-    for (ChannelConnections::const_iterator walker(_outputConnections.begin());
+void
+ChannelEntry::invalidateConnectionGeometry(void)
+{
+    ODL_OBJENTER(); //####
+    for (ChannelConnections::iterator walker(_outputConnections.begin());
          _outputConnections.end() != walker; ++walker)
     {
-        const ChannelInfo * candidate(&*walker);
+        walker->_geometry._valid = false;
+    }
+    // The appearance of an incoming connection is held by the port at the other end.
+    for (ChannelConnections::const_iterator walker(_inputConnections.begin());
+         _inputConnections.end() != walker; ++walker)
+    {
+        ChannelEntry * otherPort = walker->_otherChannel;
 
-        if (candidate && candidate->_otherChannel &&
-            (candidate->_otherChannel->getPortName() == otherPort))
+        if (otherPort)
         {
-            result = true;
-            break;
-        }
+            ChannelConnectionIndex &               otherIndex = otherPort->_outputIndex;
+            ChannelConnectionIndex::const_iterator match(otherIndex.find(getPortName()));
 
+            if (otherIndex.end() != match)
+            {
+                otherPort->_outputConnections[match->second]._geometry._valid = false;
+            }
+        }
     }
-    ODL_OBJEXIT_B(result); //####
-    return result;
-} // ChannelEntry::hasOutgoingConnectionTo
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::invalidateConnectionGeometry
 
 void
 ChannelEntry::invalidateConnections(void)
@@ -1074,6 +1563,14 @@ ChannelEntry::invalidateConnections(void)
     ODL_OBJEXIT(); //####
 } // ChannelEntry::invalidateConnections
 
+void
+ChannelEntry::invalidateTitleLayout(void)
+{
+    ODL_OBJENTER(); //####
+    _titleLayoutWidth = -1;
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::invalidateTitleLayout
+
 bool
 ChannelEntry::isChannel(void)
 const
@@ -1094,6 +1591,34 @@ const
     return result;
 } // ChannelEntry::isChannel
 
+bool
+ChannelEntry::isNearConnection(const ChannelEntry * destination,
+                               const Position &     location,
+                               const float          tolerance)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("destination = ", destination, "location = ", &location); //####
+    ODL_D1("tolerance = ", tolerance); //####
+    bool result = false;
+
+    if (destination)
+    {
+        ChannelConnectionIndex::const_iterator match(_outputIndex.find(destination->getPortName()));
+
+        if (_outputIndex.end() != match)
+        {
+            ChannelInfo &              candidate = _outputConnections[match->second];
+            const ConnectionGeometry & geometry = getCurrentGeometry(candidate, this);
+            Position                   nearestPoint;
+
+            geometry._centreline.getNearestPoint(location, nearestPoint);
+            result = (location.getDistanceFrom(nearestPoint) <= tolerance);
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ChannelEntry::isNearConnection
+
 void
 ChannelEntry::mouseDown(const MouseEvent & ee)
 {
@@ -1125,6 +1650,7 @@ ChannelEntry::mouseDown(const MouseEvent & ee)
                 {
                     firstRemovePort->removeOutputConnection(this);
                     removeInputConnection(firstRemovePort);
+                    owningPanel.invalidateSpatialIndex();
                     owningPanel.skipScan();
                     owningPanel.repaint();
                 }
@@ -1160,6 +1686,7 @@ ChannelEntry::mouseDown(const MouseEvent & ee)
 
                     firstAddPort->addOutputConnection(this, mode, protocolsOverridden);
                     addInputConnection(firstAddPort, mode, protocolsOverridden);
+                    owningPanel.invalidateSpatialIndex();
                     owningPanel.skipScan();
                     owningPanel.repaint();
                 }
@@ -1188,7 +1715,7 @@ ChannelEntry::mouseDown(const MouseEvent & ee)
         {
             // Check if Remove is OK for this entry.
             if ((kPortDirectionInput != _direction) && (kPortUsageClient != _usage) &&
-                (0 < _outputConnections.size()))
+                (_outputRemoved < _outputConnections.size()))
             {
                 owningPanel.rememberConnectionStartPoint(this, false);
                 setDisconnectMarker();
@@ -1282,6 +1809,7 @@ ChannelEntry::mouseUp(const MouseEvent & ee)
 
                         addOutputConnection(endEntry, mode, protocolsOverridden);
                         endEntry->addInputConnection(this, mode, protocolsOverridden);
+                        owningPanel.invalidateSpatialIndex();
                         owningPanel.skipScan();
                     }
                 }
@@ -1308,46 +1836,10 @@ ChannelEntry::paint(Graphics & gg)
 {
     ODL_OBJENTER(); //####
     ODL_P1("gg = ", &gg); //####
-    AttributedString as;
-
-    as.setJustification(Justification::left);
-    as.append(_title.c_str(), getOwningPanel().getNormalFont(), kEntryTextColour);
-    juce::Rectangle<float> area(getLocalBounds().toFloat());
-
-    ODL_D4("x <- ", area.getX(), "y <- ", area.getY(), "w <- ",area.getWidth(), "h <- ", //####
-           area.getHeight()); //####
-    gg.setColour(kEntryBackgroundColour);
-    gg.fillRect(area);
-    area.setLeft(area.getX() + _parent->getTextInset());
-    as.draw(gg, area);
-    if (_drawConnectMarker)
-    {
-        Position markerPos(getCentre() - Position(kMarkerSide / 2, kMarkerSide / 2));
-
-        gg.setColour(kMarkerColour);
-        gg.fillEllipse(markerPos.getX(), markerPos.getY(), kMarkerSide, kMarkerSide);
-    }
-    else if (_drawDisconnectMarker)
-    {
-        Position markerPos(getCentre() - Position(kMarkerSide / 2, kMarkerSide / 2));
-
-        gg.setColour(kMarkerColour);
-        gg.drawEllipse(markerPos.getX(), markerPos.getY(), kMarkerSide, kMarkerSide, 2);
-    }
-    if (_drawActivityMarker)
+    // The entity fills the space behind an entry that is too small to be seen.
+    if (! getOwningPanel().isTooSmallToSee(getLocalBounds().toFloat()))
     {
-        float          hh = getHeight() - (2 * kActivityInset);
-        float          halfSize = static_cast<float>(hh / 2);
-        Position       markerPos(getWidth() - static_cast<float>(hh + kActivityInset),
-                                 kActivityInset);
-        Position       markerCentre(markerPos + Position(halfSize, halfSize));
-        ColourGradient theGradient(kFirstActivityMarkerColour, markerCentre.getX(),
-                                   markerCentre.getY(), kSecondActivityMarkerColour,
-                                   markerCentre.getX() + halfSize, markerCentre.getY(), true);
-        FillType       theMarkerFill(theGradient);
-
-        gg.setFillType(theMarkerFill);
-        gg.fillEllipse(markerPos.getX(), markerPos.getY(), hh, hh);
+        drawContent(gg, getLocalBounds().toFloat());
     }
     ODL_OBJEXIT(); //####
 } // ChannelEntry::paint
@@ -1367,6 +1859,8 @@ ChannelEntry::removeAllConnections(void)
         }
     }
     _inputConnections.clear();
+    _inputIndex.clear();
+    _inputRemoved = 0;
     for (ChannelConnections::iterator walker(_outputConnections.begin());
          _outputConnections.end() != walker; ++walker)
     {
@@ -1378,6 +1872,8 @@ ChannelEntry::removeAllConnections(void)
         }
     }
     _outputConnections.clear();
+    _outputIndex.clear();
+    _outputRemoved = 0;
     ODL_EXIT(); //####
 } // ChannelEntry::removeAllConnections
 
@@ -1388,22 +1884,7 @@ ChannelEntry::removeInputConnection(ChannelEntry * other)
     ODL_P1("other = ", other); //####
     if (other)
     {
-        ChannelConnections::iterator walker(_inputConnections.begin());
-
-        for ( ; _inputConnections.end() != walker; ++walker)
-        {
-            ChannelInfo * candidate(&*walker);
-
-            if (candidate && (candidate->_otherChannel == other))
-            {
-                break;
-            }
-
-        }
-        if (_inputConnections.end() != walker)
-        {
-            _inputConnections.erase(walker);
-        }
+        removeConnection(_inputConnections, _inputIndex, _inputRemoved, other);
     }
     ODL_OBJEXIT(); //####
 } // ChannelEntry::removeInputConnection
@@ -1412,69 +1893,51 @@ void
 ChannelEntry::removeInvalidConnections(void)
 {
     ODL_OBJENTER(); //####
-    bool keepGoing;
-
-    do
-    {
-        ChannelConnections::iterator walker(_inputConnections.begin());
+    removeInvalidConnections(_inputConnections, _inputIndex, _inputRemoved, false);
+    removeInvalidConnections(_outputConnections, _outputIndex, _outputRemoved, true);
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::removeInvalidConnections
 
-        keepGoing = false;
-        for ( ; _inputConnections.end() != walker; ++walker)
-        {
-            ChannelInfo * candidate(&*walker);
+void
+ChannelEntry::removeInvalidConnections(ChannelConnections &     connections,
+                                       ChannelConnectionIndex & index,
+                                       size_t &                 removed,
+                                       const bool               isOutgoing)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("connections = ", &connections, "index = ", &index, "removed = ", &removed); //####
+    ODL_B1("isOutgoing = ", isOutgoing); //####
+    size_t kept = 0;
 
-            if (candidate && (! candidate->_valid))
-            {
-                break;
-            }
+    // Compact the surviving connections in a single pass, so that the drawing order is preserved.
+    for (size_t ii = 0, mm = connections.size(); mm > ii; ++ii)
+    {
+        ChannelInfo & candidate = connections[ii];
 
-        }
-        if (_inputConnections.end() != walker)
+        // Double-check the connection - if YARP says it's still there, don't delete it!
+        // Connections that are marked as removed are dropped.
+        if (candidate._otherChannel &&
+            (candidate._valid || checkConnection(candidate, isOutgoing)))
         {
-            // Double-check the connection - if YARP says it's still there, don't delete it!
-            if (checkConnection(*walker, false))
-            {
-                walker->_valid = true;
-            }
-            else
+            candidate._valid = true;
+            if (kept != ii)
             {
-                _inputConnections.erase(walker);
+                connections[kept] = candidate;
             }
-            keepGoing = true;
+            ++kept;
         }
     }
-    while (keepGoing);
-    do
+    removed = 0;
+    if (connections.size() != kept)
     {
-        ChannelConnections::iterator walker(_outputConnections.begin());
-
-        keepGoing = false;
-        for ( ; _outputConnections.end() != walker; ++walker)
-        {
-            ChannelInfo * candidate(&*walker);
-
-            if (candidate && (! candidate->_valid))
-            {
-                break;
-            }
-
-        }
-        if (_outputConnections.end() != walker)
+        connections.resize(kept);
+        index.clear();
+        for (size_t ii = 0; kept > ii; ++ii)
         {
-            // Double-check the connection - if YARP says it's still there, don't delete it!
-            if (checkConnection(*walker, true))
-            {
-                walker->_valid = true;
-            }
-            else
-            {
-                _outputConnections.erase(walker);
-            }
-            keepGoing = true;
+            index[connections[ii]._otherChannel->getPortName()] = ii;
         }
     }
-    while (keepGoing);
-    ODL_EXIT(); //####
+    ODL_OBJEXIT(); //####
 } // ChannelEntry::removeInvalidConnections
 
 void
@@ -1484,25 +1947,43 @@ ChannelEntry::removeOutputConnection(ChannelEntry * other)
     ODL_P1("other = ", other); //####
     if (other)
     {
-        ChannelConnections::iterator walker(_outputConnections.begin());
+        removeConnection(_outputConnections, _outputIndex, _outputRemoved, other);
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::removeOutputConnection
 
-        for ( ; _outputConnections.end() != walker; ++walker)
-        {
-            const ChannelInfo * candidate(&*walker);
+void
+ChannelEntry::repaintActivityMarker(void)
+{
+    ODL_OBJENTER(); //####
+    EntitiesPanel &        owningPanel = getOwningPanel();
+    juce::Rectangle<float> entryArea(getLocalBounds().toFloat());
 
-            if (candidate && (candidate->_otherChannel == other))
-            {
-                break;
-            }
+    // When the panel draws the entries itself, the entries have nothing to repaint.
+    if (owningPanel.isDrawingEntitiesDirectly())
+    {
+        juce::Rectangle<float> markerArea(getActivityMarkerArea(entryArea + getPositionInPanel()));
 
-        }
-        if (_outputConnections.end() != walker)
-        {
-            _outputConnections.erase(walker);
-        }
+        owningPanel.repaint(markerArea.getSmallestIntegerContainer());
+    }
+    else
+    {
+        repaint(getActivityMarkerArea(entryArea).getSmallestIntegerContainer());
     }
     ODL_OBJEXIT(); //####
-} // ChannelEntry::removeOutputConnection
+} // ChannelEntry::repaintActivityMarker
+
+bool
+ChannelEntry::setAnomaly(const AnomalyKind newAnomaly)
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("newAnomaly = ", newAnomaly); //####
+    bool changed = (newAnomaly != _anomaly);
+
+    _anomaly = newAnomaly;
+    ODL_OBJEXIT_B(changed); //####
+    return changed;
+} // ChannelEntry::setAnomaly
 
 void
 ChannelEntry::setAsLastPort(void)
@@ -1528,6 +2009,24 @@ ChannelEntry::setDisconnectMarker(void)
     ODL_OBJEXIT(); //####
 } // ChannelEntry::setDisconnectMarker
 
+void
+ChannelEntry::toggleActivityIndicator(void)
+{
+    ODL_OBJENTER(); //####
+    ActivitySampler & sampler = getOwningPanel().getActivitySampler();
+
+    if (sampler.isWatching(getPortName()))
+    {
+        sampler.stopWatching(getPortName());
+        clearActivityMarker();
+    }
+    else
+    {
+        _beingMonitored = sampler.startWatching(getPortName());
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::toggleActivityIndicator
+
 void
 ChannelEntry::unsetAsLastPort(void)
 {
@@ -1536,6 +2035,58 @@ ChannelEntry::unsetAsLastPort(void)
     ODL_OBJEXIT(); //####
 } // ChannelEntry::unsetAsLastPort
 
+void
+ChannelEntry::updateActivityMarker(const bool sawActivity)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("sawActivity = ", sawActivity); //####
+    // Flipping the marker, rather than just showing it, makes continuing traffic visible.
+    bool newState = (sawActivity && (! _drawActivityMarker));
+
+    // The entry might have been recreated by a scan since the channel started being watched.
+    _beingMonitored = true;
+    if (newState != _drawActivityMarker)
+    {
+        _drawActivityMarker = newState;
+        repaintActivityMarker();
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::updateActivityMarker
+
+bool
+ChannelEntry::updateConnectionTraffic(const TrafficHeatMap & heatMap,
+                                      ConnectionEndsList &   widthChanged)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("heatMap = ", &heatMap, "widthChanged = ", &widthChanged); //####
+    bool result = false;
+
+    for (ChannelConnections::iterator walker(_outputConnections.begin());
+         _outputConnections.end() != walker; ++walker)
+    {
+        ChannelEntry * otherPort = walker->_otherChannel;
+
+        if (otherPort)
+        {
+            Colour trafficColour;
+            float  trafficWidth;
+
+            heatMap.getAppearance(getPortName(), otherPort->getPortName(), trafficColour,
+                                  trafficWidth);
+            walker->_trafficColour = trafficColour;
+            if (trafficWidth != walker->_trafficWidth)
+            {
+                walker->_trafficWidth = trafficWidth;
+                walker->_geometry._valid = false;
+                widthChanged.push_back(ConnectionEnds(this, otherPort));
+                result = true;
+            }
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ChannelEntry::updateConnectionTraffic
+
 #if defined(__APPLE__)
 # pragma mark Global functions
 #endif // defined(__APPLE__)
@@ -57,6 +57,7 @@ namespace MPlusM_Manager
 {
     class ChannelContainer;
     class EntitiesPanel;
+    class TrafficHeatMap;
 
     /*! @brief A port or channel. */
     class ChannelEntry : public Component
@@ -112,6 +113,11 @@ namespace MPlusM_Manager
                             const MplusM::Common::ChannelMode mode,
                             const bool                        wasOverridden);
 
+        /*! @brief Open a scrolling monitor of the traffic on the channel, or bring its monitor to
+         the front if it already has one. */
+        void
+        addScrollingMonitor(void);
+
         /*! @brief Determine the anchor point that is the minimum distance from a given point.
          @param[in,out] result The coordinates of the anchor point.
          @param[in] isSource @c true if the anchor is for an outgoing line and @c false otherwise.
@@ -143,6 +149,11 @@ namespace MPlusM_Manager
                                const Position & pp)
         const;
 
+        /*! @brief Stop displaying the activity marker, as the channel is no longer being watched
+         for activity. */
+        void
+        clearActivityMarker(void);
+
         /*! @brief Stop displaying the connect marker. */
         void
         clearConnectMarker(void);
@@ -162,6 +173,14 @@ namespace MPlusM_Manager
         displayInformation(const bool isChannel,
                            const bool moreDetails);
 
+        /*! @brief Draw the entry into an area, which is its own bounds when it is painted as a
+         component and its location in the panel when the panel draws the entities itself.
+         @param[in,out] gg The graphics context in which to draw.
+         @param[in] area The area to draw the entry into. */
+        void
+        drawContent(Graphics &                     gg,
+                    const juce::Rectangle<float> & area);
+
         /*! @brief Draw a drag line from an entry.
          @param[in,out] gg The graphics context in which to draw.
          @param[in] position The coordinates of the drag line endpoint.
@@ -173,17 +192,56 @@ namespace MPlusM_Manager
                      const bool       isUDP,
                      const bool       isForced);
 
+        /*! @brief Display a connection to another port.
+         @param[in,out] gg The graphics context in which to draw.
+         @param[in] destination The port at the other end of the connection.
+         @param[in] highlighted @c true if the connection is to be emphasized and @c false
+         otherwise. */
+        void
+        drawOutgoingConnection(Graphics &     gg,
+                               ChannelEntry * destination,
+                               const bool     highlighted);
+
         /*! @brief Display the connections between containers.
          @param[in,out] gg The graphics context in which to draw. */
         void
         drawOutgoingConnections(Graphics & gg);
 
+        /*! @brief Display a connection to another port as a straight line, for when the details
+         of the connection would not be legible.
+         @param[in,out] gg The graphics context in which to draw.
+         @param[in] destination The port at the other end of the connection.
+         @param[in] lineWidth The width of the line. */
+        void
+        drawSimplifiedConnection(Graphics &     gg,
+                                 ChannelEntry * destination,
+                                 const float    lineWidth);
+
         /*! @brief Return the location of the centre of the port entry.
          @return The location of the centre of the port entry. */
         Position
         getCentre(void)
         const;
 
+        /*! @brief Return an area that encloses a connection to another port, including the
+         anchors.
+         @param[in] destination The port at the other end of the connection.
+         @return An area that encloses the connection, in the coordinates of the containing
+         panel. */
+        juce::Rectangle<float>
+        getConnectionBounds(const ChannelEntry * destination)
+        const;
+
+        /*! @brief Return the area covered by the drawing of a connection to another port.
+
+         Unlike getConnectionBounds, this is based on the cached appearance of the connection, or
+         on the straight line that replaces it when the panel is zoomed out, and is therefore as
+         small as possible.
+         @param[in] destination The port at the other end of the connection.
+         @return The area covered by the connection, in the coordinates of the containing panel. */
+        juce::Rectangle<float>
+        getConnectionDrawingBounds(const ChannelEntry * destination);
+
         /*! @brief Return the direction of the port entry.
          @return The direction of the port entry. */
         inline PortDirection
@@ -195,21 +253,13 @@ namespace MPlusM_Manager
 
         /*! @brief Return the set of input connections to the port.
          @return The set of input connections to the port. */
-        inline const ChannelConnections &
-        getInputConnections(void)
-        const
-        {
-            return _inputConnections;
-        } // getInputConnections
+        const ChannelConnections &
+        getInputConnections(void);
 
         /*! @brief Return the set of output connections to the port.
          @return The set of output connections to the port. */
-        inline const ChannelConnections &
-        getOutputConnections(void)
-        const
-        {
-            return _outputConnections;
-        } // getOutputConnections
+        const ChannelConnections &
+        getOutputConnections(void);
 
         /*! @brief Return the panel which contains the entry.
          @return The panel which contains the entry. */
@@ -284,10 +334,28 @@ namespace MPlusM_Manager
         hasOutgoingConnectionTo(const YarpString & otherPort)
         const;
 
+        /*! @brief Determine whether a point is within the entry, for mouse events.
+         @param[in] x The horizontal coordinate of the point, relative to the entry.
+         @param[in] y The vertical coordinate of the point, relative to the entry.
+         @return @c true if the point is within the entry and the entry can be seen and @c false
+         otherwise. */
+        virtual bool
+        hitTest(int x,
+                int y);
+
+        /*! @brief Mark the appearance of all the connections to and from the port as needing to be
+         recalculated, after the port has moved. */
+        void
+        invalidateConnectionGeometry(void);
+
         /*! @brief Mark all the connections as invalid. */
         void
         invalidateConnections(void);
 
+        /*! @brief Mark the arrangement of the text of the entry as needing to be recalculated. */
+        void
+        invalidateTitleLayout(void);
+
         /*! @brief Returns @c true if the channel is being monitored and @c false otherwise.
          @return @c true if the channel is being monitored and @c false otherwise. */
         inline bool
@@ -303,6 +371,17 @@ namespace MPlusM_Manager
         isChannel(void)
         const;
 
+        /*! @brief Returns @c true if a location is close to the connection to another port.
+         @param[in] destination The port at the other end of the connection.
+         @param[in] location The coordinates to check, in the coordinates of the containing panel.
+         @param[in] tolerance The maximum distance from the connection.
+         @return @c true if the location is within the given distance of the connection and
+         @c false otherwise. */
+        bool
+        isNearConnection(const ChannelEntry * destination,
+                         const Position &     location,
+                         const float          tolerance);
+
         /*! @brief Returns @c true if the port entry is a secondary port of a service and @c false
          otherwise.
          @return @c true if the port is a secondary port of a service and @c false otherwise. */
@@ -343,6 +422,21 @@ namespace MPlusM_Manager
             return (kPortUsageService == _usage);
         } // isService
 
+        /*! @brief Called when a mouse button is pressed.
+         @param[in] ee Details about the position and status of the mouse event. */
+        virtual void
+        mouseDown(const MouseEvent & ee);
+
+        /*! @brief Called when the mouse is moved while a button is held down.
+         @param[in] ee Details about the position and status of the mouse event. */
+        virtual void
+        mouseDrag(const MouseEvent & ee);
+
+        /*! @brief Called when a mouse button is released.
+         @param[in] ee Details about the position and status of the mouse event. */
+        virtual void
+        mouseUp(const MouseEvent & ee);
+
         /*! @brief Remove an input connection from a port.
          @param[in] other The port that is to be disconnected. */
         void
@@ -357,6 +451,12 @@ namespace MPlusM_Manager
         void
         removeOutputConnection(ChannelEntry * other);
 
+        /*! @brief Set the anomaly seen in the metrics of the channel.
+         @param[in] newAnomaly The anomaly seen in the metrics of the channel.
+         @return @c true if the anomaly has changed and @c false otherwise. */
+        bool
+        setAnomaly(const AnomalyKind newAnomaly);
+
         /*! @brief Mark the port entry as the bottom-most (last) port entry in a panel. */
         void
         setAsLastPort(void);
@@ -369,10 +469,31 @@ namespace MPlusM_Manager
         void
         setDisconnectMarker(void);
 
+        /*! @brief Start or stop watching the channel for activity. */
+        void
+        toggleActivityIndicator(void);
+
         /*! @brief Mark the port entry as not being the bottom-most port entry in a panel. */
         void
         unsetAsLastPort(void);
 
+        /*! @brief Update the activity marker from the most recent sample of the channel.
+
+         The marker flips while data is arriving and is removed when the channel is idle.
+         @param[in] sawActivity @c true if data arrived since the previous sample and @c false
+         otherwise. */
+        void
+        updateActivityMarker(const bool sawActivity);
+
+        /*! @brief Update the traffic appearance of the outgoing connections.
+         @param[in] heatMap The source of the traffic appearance.
+         @param[in,out] widthChanged The connections whose thickness changed, which are added to
+         the end of the list.
+         @return @c true if the thickness of any connection changed and @c false otherwise. */
+        bool
+        updateConnectionTraffic(const TrafficHeatMap & heatMap,
+                                ConnectionEndsList &   widthChanged);
+
         /*! @brief Return @c true if the current connection request was UDP and @c false
          otherwise.
          @return @c true if the current connection request was UDP and @c false otherwise. */
@@ -399,21 +520,6 @@ namespace MPlusM_Manager
         void
         displayAndProcessPopupMenu(void);
 
-        /*! @brief Called when a mouse button is pressed.
-         @param[in] ee Details about the position and status of the mouse event. */
-        virtual void
-        mouseDown(const MouseEvent & ee);
-
-        /*! @brief Called when the mouse is moved while a button is held down.
-         @param[in] ee Details about the position and status of the mouse event. */
-        virtual void
-        mouseDrag(const MouseEvent & ee);
-
-        /*! @brief Called when a mouse button is released.
-         @param[in] ee Details about the position and status of the mouse event. */
-        virtual void
-        mouseUp(const MouseEvent & ee);
-
         /*! @brief Draw the content of the component.
          @param[in,out] gg The graphics context in which to draw. */
         virtual void
@@ -423,6 +529,21 @@ namespace MPlusM_Manager
         void
         removeAllConnections(void);
 
+        /*! @brief Redraw just the area of the activity marker. */
+        void
+        repaintActivityMarker(void);
+
+        /*! @brief Remove the invalid connections from a set of connections.
+         @param[in,out] connections The set of connections.
+         @param[in,out] index The positions of the connections, by the name of the other port.
+         @param[in,out] removed The number of connections that are marked as removed.
+         @param[in] isOutgoing @c true if the connections are outgoing and @c false otherwise. */
+        void
+        removeInvalidConnections(ChannelConnections &     connections,
+                                 ChannelConnectionIndex & index,
+                                 size_t &                 removed,
+                                 const bool               isOutgoing);
+
     public :
 
     protected :
@@ -435,6 +556,12 @@ namespace MPlusM_Manager
         /*! @brief The connections to the port. */
         ChannelConnections _outputConnections;
 
+        /*! @brief The positions of the input connections, by the name of the other port. */
+        ChannelConnectionIndex _inputIndex;
+
+        /*! @brief The positions of the output connections, by the name of the other port. */
+        ChannelConnectionIndex _outputIndex;
+
         /*! @brief The name of the associated port. */
         YarpString _portName;
 
@@ -450,15 +577,31 @@ namespace MPlusM_Manager
         /*! @brief The text to be displayed for the channel entry. */
         YarpString _title;
 
+        /*! @brief The arrangement of the text to be displayed for the channel entry. */
+        TextLayout _titleLayout;
+
         /*! @brief The container in which this is embedded. */
         ChannelContainer * _parent;
 
+        /*! @brief The number of input connections that are marked as removed. */
+        size_t _inputRemoved;
+
+        /*! @brief The number of output connections that are marked as removed. */
+        size_t _outputRemoved;
+
+        /*! @brief The anomaly seen in the metrics of the channel. */
+        AnomalyKind _anomaly;
+
         /*! @brief The primary direction for connections to the port. */
         PortDirection _direction;
 
         /*! @brief The primary usage for the port. */
         PortUsage _usage;
 
+        /*! @brief The width used for the arrangement of the text, or a negative value if the text
+         has not been arranged. */
+        float _titleLayoutWidth;
+
         /*! @brief @c true if activity on the channel is being monitored and @c false otherwise. */
         bool _beingMonitored;
 
@@ -38,34 +38,31 @@
 //--------------------------------------------------------------------------------------------------
 
 #include "m+mContentPanel.hpp"
+#include "m+mAnomalyDetector.hpp"
 #include "m+mChannelContainer.hpp"
 #include "m+mChannelEntry.hpp"
 #include "m+mEntitiesPanel.hpp"
+#include "m+mEntityCluster.hpp"
 #include "m+mEntityData.hpp"
+#include "m+mFlightRecorder.hpp"
+#include "m+mLayoutThread.hpp"
 #include "m+mManagerApplication.hpp"
+#include "m+mMetricsExporter.hpp"
+#include "m+mMetricsPoller.hpp"
+#include "m+mMetricsStateChanger.hpp"
 #include "m+mPortData.hpp"
+#include "m+mPositionStore.hpp"
+#include "m+mReplayBar.hpp"
 #include "m+mScannerThread.hpp"
+#include "m+mServiceStateCache.hpp"
+#include "m+mTimingOverlay.hpp"
+#include "m+mTimingRecorder.hpp"
+#include "m+mTrafficHeatMap.hpp"
+#include "m+mTrafficLegend.hpp"
 
 //#include <odlEnable.h>
 #include <odlInclude.h>
 
-#if defined(USE_OGDF_POSITIONING_)
-# if MAC_OR_LINUX_
-#  pragma clang diagnostic push
-#  pragma clang diagnostic ignored "-Wunused-parameter"
-# else // ! MAC_OR_LINUX_
-#  pragma warning(push)
-#  pragma warning(disable: 4100)
-# endif // ! MAC_OR_LINUX_
-# include <ogdf/basic/GraphAttributes.h>
-# include <ogdf/energybased/FMMMLayout.h>
-# if MAC_OR_LINUX_
-#  pragma clang diagnostic pop
-# else // ! MAC_OR_LINUX_
-#  pragma warning(pop)
-# endif // ! MAC_OR_LINUX_
-#endif // defined(USE_OGDF_POSITIONING_)
-
 #if defined(__APPLE__)
 # pragma clang diagnostic push
 # pragma clang diagnostic ignored "-Wunknown-pragmas"
@@ -95,6 +92,9 @@ using namespace std;
 # pragma mark Private structures, constants and variables
 #endif // defined(__APPLE__)
 
+/*! @brief A mapping from entities to the indices of their layout nodes. */
+typedef std::map<ChannelContainer *, size_t> LayoutIndexMap;
+
 /*! @brief The colour to be used for the dialog background. */
 static const Colour & kDialogBackgroundColour(Colours::whitesmoke);
 
@@ -116,6 +116,24 @@ static const float kSelectionOffset = 4;
 /*! @brief The thickness of the selection rectangle. */
 static const float kSelectionThickness = 2;
 
+/*! @brief The change in scale for each zoom in or zoom out command. */
+static const float kZoomStepFactor = 1.25;
+
+/*! @brief The number of milliseconds between rounds of polling for the metrics of the services,
+ unless overridden by the environment. */
+static const int kDefaultMetricsPollInterval = 1000;
+
+/*! @brief The number of megabytes to be used by the metrics history, unless overridden by the
+ environment. */
+static const int kDefaultMetricsHistoryBudget = 64;
+
+/*! @brief The number of days that a remembered position is kept after its entity was last seen,
+ unless overridden by the environment. */
+static const int kDefaultPositionLifetime = 30;
+
+/*! @brief The default number of days that a flight recording is kept. */
+static const int kDefaultRecordingLifetime = 7;
+
 /*! @brief The initial thickness of the horizontal and vertical scrollbars. */
 static const int kDefaultScrollbarThickness = 16;
 
@@ -125,6 +143,52 @@ static const int kDefaultSingleStepSize = 10;
 /*! @brief After width to be added to display panels. */
 static const int kExtraDisplayWidth = 32;
 
+/*! @brief The time, in milliseconds, to wait after the entities have stopped moving before their
+ positions are written to the settings file. */
+static const int kPositionSaveDelay = 2000;
+
+/*! @brief The time, in milliseconds, to wait for the layout thread to stop. */
+static const int kThreadKillTime = 3000;
+
+/*! @brief The smallest number of milliseconds between rounds of polling for the metrics of the
+ services. */
+static const int kMinimumMetricsPollInterval = 100;
+
+/*! @brief The distance between the timing overlay and the edges of the panel. */
+static const int kTimingOverlayMargin = 8;
+
+/*! @brief The distance between the traffic legend and the edges of the panel. */
+static const int kTrafficLegendMargin = 8;
+
+/*! @brief The number of timing samples that are kept. */
+static const size_t kTimingSampleCapacity = 4096;
+
+/*! @brief The maximum number of remembered positions that are kept. */
+static const size_t kMaximumRememberedPositions = 100000;
+
+/*! @brief The environment variable that holds the local port on which the metrics are served;
+ if it is not set, the metrics aren't served. */
+static const char * kMetricsExportPortVariable = "MPM_MANAGER_METRICS_PORT";
+
+/*! @brief The environment variable that holds the number of megabytes to be used by the metrics
+ history. */
+static const char * kMetricsHistoryBudgetVariable = "MPM_MANAGER_METRICS_MEMORY";
+
+/*! @brief The environment variable that holds the number of milliseconds between rounds of
+ polling for the metrics of the services. */
+static const char * kMetricsPollIntervalVariable = "MPM_MANAGER_METRICS_INTERVAL";
+
+/*! @brief The environment variable that holds the number of days that a remembered position is
+ kept after its entity was last seen, where zero means that positions are kept indefinitely. */
+static const char * kPositionLifetimeVariable = "MPM_MANAGER_POSITION_LIFETIME";
+
+/*! @brief The environment variable that holds the number of days that a flight recording is
+ kept, where zero means that the network isn't recorded. */
+static const char * kRecordingLifetimeVariable = "MPM_MANAGER_RECORDING_LIFETIME";
+
+/*! @brief The wildcard pattern for the names of flight recordings. */
+static const char * kRecordingPattern = "*.mpmrec";
+
 #if defined(__APPLE__)
 # pragma mark Global constants and variables
 #endif // defined(__APPLE__)
@@ -133,6 +197,60 @@ static const int kExtraDisplayWidth = 32;
 # pragma mark Local functions
 #endif // defined(__APPLE__)
 
+/*! @brief Returns the number of bytes to be used by the metrics history.
+ @return The number of bytes to be used by the metrics history. */
+static size_t
+getMetricsHistoryBudget(void)
+{
+    String budgetAsString(ManagerApplication::getEnvironmentVar(kMetricsHistoryBudgetVariable));
+    int64  budgetInMegabytes;
+
+    if (budgetAsString.isEmpty())
+    {
+        budgetInMegabytes = kDefaultMetricsHistoryBudget;
+    }
+    else
+    {
+        budgetInMegabytes = jmax(static_cast<int64>(0), budgetAsString.getLargeIntValue());
+    }
+    return static_cast<size_t>(budgetInMegabytes * 1024 * 1024);
+} // getMetricsHistoryBudget
+
+/*! @brief Returns the local port on which the metrics are to be served.
+ @return The port on which the metrics are to be served, or zero if they aren't to be served. */
+static int
+getMetricsExportPort(void)
+{
+    String portAsString(ManagerApplication::getEnvironmentVar(kMetricsExportPortVariable));
+    int    port = portAsString.getIntValue();
+
+    if ((0 >= port) || (65535 < port))
+    {
+        port = 0;
+    }
+    return port;
+} // getMetricsExportPort
+
+/*! @brief Returns the number of milliseconds between rounds of polling for the metrics of the
+ services.
+ @return The number of milliseconds between rounds of polling. */
+static int
+getMetricsPollInterval(void)
+{
+    String intervalAsString(ManagerApplication::getEnvironmentVar(kMetricsPollIntervalVariable));
+    int    interval;
+
+    if (intervalAsString.isEmpty())
+    {
+        interval = kDefaultMetricsPollInterval;
+    }
+    else
+    {
+        interval = jmax(kMinimumMetricsPollInterval, intervalAsString.getIntValue());
+    }
+    return interval;
+} // getMetricsPollInterval
+
 /*! @brief Returns the absolute path to the settings file.
  @return The absolute path to the settings file. */
 static String
@@ -145,6 +263,57 @@ getPathToSettingsFile(void)
     return settingsDir + "settings.txt";
 } // getPathToSettingsFile
 
+/*! @brief Returns the number of seconds that a remembered position is kept after its entity was
+ last seen.
+ @return The number of seconds that a remembered position is kept, or zero if positions are kept
+ indefinitely. */
+static int64
+getRememberedPositionLifetime(void)
+{
+    String lifetimeAsString(ManagerApplication::getEnvironmentVar(kPositionLifetimeVariable));
+    int64  lifetimeInDays;
+
+    if (lifetimeAsString.isEmpty())
+    {
+        lifetimeInDays = kDefaultPositionLifetime;
+    }
+    else
+    {
+        lifetimeInDays = jmax(static_cast<int64>(0), lifetimeAsString.getLargeIntValue());
+    }
+    return lifetimeInDays * 24 * 60 * 60;
+} // getRememberedPositionLifetime
+
+/*! @brief Returns the number of days that a flight recording is kept.
+ @return The number of days that a flight recording is kept, or zero if the network isn't to be
+ recorded. */
+static int
+getRecordingLifetime(void)
+{
+    String lifetimeAsString(ManagerApplication::getEnvironmentVar(kRecordingLifetimeVariable));
+    int    lifetimeInDays;
+
+    if (lifetimeAsString.isEmpty())
+    {
+        lifetimeInDays = kDefaultRecordingLifetime;
+    }
+    else
+    {
+        lifetimeInDays = jmax(0, lifetimeAsString.getIntValue());
+    }
+    return lifetimeInDays;
+} // getRecordingLifetime
+
+/*! @brief Returns the directory that holds the flight recordings.
+ @return The directory that holds the flight recordings. */
+static File
+getRecordingsDirectory(void)
+{
+    File baseDir = File::getSpecialLocation(File::userApplicationDataDirectory);
+
+    return baseDir.getChildFile("m+m manager").getChildFile("Recordings");
+} // getRecordingsDirectory
+
 #if defined(__APPLE__)
 # pragma mark Class methods
 #endif // defined(__APPLE__)
@@ -154,19 +323,67 @@ getPathToSettingsFile(void)
 #endif // defined(__APPLE__)
 
 ContentPanel::ContentPanel(ManagerWindow * containingWindow) :
-    inherited1(), inherited2(), inherited3(), _entitiesPanel(new EntitiesPanel(this)),
-    _menuBar(new MenuBarComponent(this)), _containingWindow(containingWindow),
-    _selectedChannel(NULL), _selectedContainer(NULL), _channelClicked(false),
-    _containerClicked(false),
-#if (defined(USE_OGDF_POSITIONING_) && defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_))
-    _initialPositioningDone(false),
-#endif // defined(USE_OGDF_POSITIONING_) && defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_)
-    _invertBackground(false), _skipNextScan(false), _whiteBackground(false)
+    inherited1(), inherited2(), inherited3(), inherited4(),
+    _entitiesPanel(new EntitiesPanel(this)), _flightRecorder(), _flightRecording(),
+    _layoutThread(new LayoutThread(*this)), _menuBar(new MenuBarComponent(this)),
+    _metricsExporter(), _metricsPoller(),
+    _positionStore(new PositionStore(getRememberedPositionLifetime(),
+                                     kMaximumRememberedPositions)), _replayBar(),
+    _serviceStateCache(),
+    _timingOverlay(), _timingRecorder(new TimingRecorder(kTimingSampleCapacity)),
+    _trafficLegend(), _containingWindow(containingWindow), _selectedChannel(NULL),
+    _selectedContainer(NULL), _frameStartTime(-1), _channelClicked(false), _containerClicked(false),
+    _invertBackground(false), _scanShownInFrame(false), _skipNextScan(false),
+    _whiteBackground(false)
 {
     ODL_ENTER(); //####
+    _layoutThread->startThread();
     addAndMakeVisible(_menuBar);
-    _entitiesPanel->setSize(_entitiesPanel->getWidth(),
-                            _entitiesPanel->getHeight() - _containingWindow->getTitleBarHeight());
+    _timingOverlay = new TimingOverlay(*_timingRecorder);
+    addChildComponent(_timingOverlay);
+    _trafficLegend = new TrafficLegend(_entitiesPanel->getTrafficHeatMap());
+    addChildComponent(_trafficLegend);
+    _replayBar = new ReplayBar(*this);
+    addChildComponent(_replayBar);
+    if (_containingWindow)
+    {
+        int exportPort = getMetricsExportPort();
+        int recordingLifetime = getRecordingLifetime();
+
+        _metricsPoller = new MetricsPoller(getMetricsPollInterval(), getMetricsHistoryBudget());
+        _entitiesPanel->getAnomalyDetector().setMetricsPoller(_metricsPoller);
+        _entitiesPanel->getTrafficHeatMap().setMetricsPoller(_metricsPoller);
+        _metricsPoller->startThread();
+        if (0 < exportPort)
+        {
+            _metricsExporter = new MetricsExporter(*this, *_metricsPoller);
+            if (! _metricsExporter->startExporting(exportPort))
+            {
+                ODL_LOG("(! _metricsExporter->startExporting(exportPort))"); //####
+                _metricsExporter = NULL;
+            }
+        }
+        if (0 < recordingLifetime)
+        {
+            File   recordingsDir(getRecordingsDirectory());
+            String recordingName(Time::getCurrentTime().formatted("flight-%Y%m%d-%H%M%S.mpmrec"));
+
+            FlightRecorder::removeOldRecordings(recordingsDir, kRecordingPattern,
+                                                recordingLifetime);
+            _flightRecorder = new FlightRecorder(recordingsDir.getChildFile(recordingName),
+                                                 _metricsPoller);
+            if (! _flightRecorder->isRecording())
+            {
+                ODL_LOG("(! _flightRecorder->isRecording())"); //####
+                _flightRecorder = NULL;
+            }
+        }
+        _entitiesPanel->setSize(_entitiesPanel->getWidth(),
+                                _entitiesPanel->getHeight() -
+                                _containingWindow->getTitleBarHeight());
+    }
+    _serviceStateCache = new ServiceStateCache(_metricsPoller);
+    _serviceStateCache->startThread();
     setSize(_entitiesPanel->getWidth(), _entitiesPanel->getHeight());
     setScrollBarsShown(true, true);
     setScrollBarThickness(kDefaultScrollbarThickness);
@@ -179,6 +396,19 @@ ContentPanel::~ContentPanel(void)
 {
     ODL_OBJENTER(); //####
     PopupMenu::dismissAllActiveMenus();
+    stopTimer();
+    _layoutThread->stopThread(kThreadKillTime);
+    _entitiesPanel->getAnomalyDetector().setMetricsPoller(NULL);
+    _entitiesPanel->getTrafficHeatMap().setMetricsPoller(NULL);
+    // The exporter, the cache and the recorder listen to the poller, so they have to stop first.
+    _metricsExporter = NULL;
+    _serviceStateCache = NULL;
+    _flightRecorder = NULL;
+    _metricsPoller = NULL;
+    _flightRecording = NULL;
+    _replayBar = NULL;
+    _timingOverlay = NULL;
+    _trafficLegend = NULL;
     ODL_OBJEXIT(); //####
 } // ContentPanel::~ContentPanel
 
@@ -186,6 +416,239 @@ ContentPanel::~ContentPanel(void)
 # pragma mark Actions and Accessors
 #endif // defined(__APPLE__)
 
+bool
+ContentPanel::applyCompletedLayout(void)
+{
+    ODL_OBJENTER(); //####
+    LayoutNodes layoutResults;
+    bool        result = _layoutThread->checkAndClearIfLayoutIsComplete(layoutResults);
+
+    // Check if the layout thread has placed any new entities.
+    if (result)
+    {
+        ODL_LOG("(result)"); //####
+        applyLayoutResults(layoutResults);
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ContentPanel::applyCompletedLayout
+
+void
+ContentPanel::applyLayoutResults(const LayoutNodes & results)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("results = ", &results); //####
+    bool changeSeen = false;
+
+    for (LayoutNodes::const_iterator walker(results.begin()); results.end() != walker; ++walker)
+    {
+        PositionMap::iterator pending(_provisionalPositions.find(walker->_name));
+
+        if (_provisionalPositions.end() != pending)
+        {
+            ChannelContainer * aContainer = _entitiesPanel->findKnownEntity(walker->_name);
+
+            // Leave the entity alone if it was moved while the layout was being calculated.
+            if (aContainer && (aContainer->getPosition().toFloat() == pending->second))
+            {
+                aContainer->setTopLeftPosition(static_cast<int>(walker->_x),
+                                               static_cast<int>(walker->_y));
+                rememberPositionOfEntity(aContainer);
+                changeSeen = true;
+            }
+            _provisionalPositions.erase(pending);
+        }
+    }
+    if (changeSeen)
+    {
+        ODL_LOG("(changeSeen)"); //####
+        _entitiesPanel->adjustSize(false);
+        _entitiesPanel->repaint();
+        scheduleEntityPositionSave();
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::applyLayoutResults
+
+void
+ContentPanel::changeSelectedMetricsState(const bool newState)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("newState = ", newState); //####
+    ContainerList       selected;
+    MetricsStateChanges changes;
+
+    _entitiesPanel->getSelectedEntities(selected);
+    for (ContainerList::const_iterator it(selected.begin()); selected.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
+
+        if (anEntity)
+        {
+            MetricsStateChange aChange;
+
+            aChange._servicePortName = anEntity->getServicePortName();
+            if (0 < aChange._servicePortName.length())
+            {
+                aChange._entityName = anEntity->getName();
+                aChange._attempted = aChange._succeeded = false;
+                changes.push_back(aChange);
+            }
+        }
+    }
+    if (changes.empty())
+    {
+        AlertWindow::showMessageBox(AlertWindow::InfoIcon, "Metrics collection",
+                                    "None of the selected entities are services.", String::empty,
+                                    this);
+    }
+    else
+    {
+        MetricsStateChanger changer(changes, newState, this);
+        size_t              numSucceeded = 0;
+        String              failures;
+
+        changer.runThread();
+        for (MetricsStateChanges::const_iterator walker(changes.begin()); changes.end() != walker;
+             ++walker)
+        {
+            if (walker->_succeeded)
+            {
+                ++numSucceeded;
+                _serviceStateCache->noteMetricsState(walker->_servicePortName, newState);
+            }
+            else
+            {
+                failures += String("\n  ") + walker->_entityName + " [" +
+                            walker->_servicePortName.c_str() + "]: " +
+                            (walker->_attempted ? "no response or refused" : "cancelled");
+            }
+        }
+        // The poller has to see the changes before its snapshot is correct again.
+        if (_metricsPoller)
+        {
+            _metricsPoller->pollSoon();
+        }
+        DisplayInformationPanel(this, String("Metrics collection was ") +
+                                (newState ? "enabled" : "disabled") + " for " +
+                                String(static_cast<int>(numSucceeded)) + " of " +
+                                String(static_cast<int>(changes.size())) + " services." +
+                                (failures.isEmpty() ? "" : "\n\nNot changed:") + failures,
+                                "Metrics collection");
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::changeSelectedMetricsState
+
+void
+ContentPanel::collectLayoutInput(LayoutNodes &            nodes,
+                                 LayoutEdges &            edges,
+                                 juce::Rectangle<float> & area)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("nodes = ", &nodes, "edges = ", &edges, "area = ", &area); //####
+    LayoutIndexMap nodeIndices;
+
+    for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
+    {
+        ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
+
+        if (aContainer && aContainer->isVisible())
+        {
+            LayoutNode             aNode;
+            YarpString             entityName(aContainer->getName().toStdString());
+            PositionMap::iterator  pending(_provisionalPositions.find(entityName));
+            juce::Rectangle<float> entityShape(aContainer->getBounds().toFloat());
+
+            aNode._name = entityName;
+            aNode._x = entityShape.getX();
+            aNode._y = entityShape.getY();
+            aNode._width = entityShape.getWidth();
+            aNode._height = entityShape.getHeight();
+            aNode._pinned = true;
+            if (_provisionalPositions.end() != pending)
+            {
+                // An entity that has been moved since it was first shown stays where it is.
+                if (entityShape.getPosition() == pending->second)
+                {
+                    aNode._pinned = false;
+                }
+                else
+                {
+                    _provisionalPositions.erase(pending);
+                }
+            }
+            nodeIndices[aContainer] = nodes.size();
+            nodes.push_back(aNode);
+        }
+    }
+    // A collapsed group stands in for all of its members, so that the cost of the layout depends
+    // on the number of groups rather than the number of entities.
+    for (size_t ii = 0, mm = _entitiesPanel->getNumberOfClusters(); mm > ii; ++ii)
+    {
+        EntityCluster * aCluster = _entitiesPanel->getCluster(ii);
+
+        if (aCluster && aCluster->isCollapsed())
+        {
+            LayoutNode             aNode;
+            const ContainerList &  members = aCluster->getMembers();
+            juce::Rectangle<float> clusterShape(aCluster->getBounds().toFloat());
+
+            aNode._name = aCluster->getName().toStdString();
+            aNode._x = clusterShape.getX();
+            aNode._y = clusterShape.getY();
+            aNode._width = clusterShape.getWidth();
+            aNode._height = clusterShape.getHeight();
+            aNode._pinned = true;
+            for (ContainerList::const_iterator walker(members.begin()); members.end() != walker;
+                 ++walker)
+            {
+                nodeIndices[*walker] = nodes.size();
+            }
+            nodes.push_back(aNode);
+        }
+    }
+    // Set up the edges (connections).
+    for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
+    {
+        ChannelContainer *             aContainer = _entitiesPanel->getEntity(ii);
+        LayoutIndexMap::const_iterator thisNode(nodeIndices.find(aContainer));
+
+        if (nodeIndices.end() != thisNode)
+        {
+            // Add edges between entities that are connected via their entries.
+            for (int jj = 0, nn = aContainer->getNumPorts(); nn > jj; ++jj)
+            {
+                ChannelEntry * aChannel = aContainer->getPort(jj);
+
+                if (aChannel)
+                {
+                    const ChannelConnections & outputs = aChannel->getOutputConnections();
+
+                    for (size_t kk = 0, ll = outputs.size(); ll > kk; ++kk)
+                    {
+                        ChannelEntry * otherChannel = outputs[kk]._otherChannel;
+
+                        if (otherChannel)
+                        {
+                            LayoutIndexMap::const_iterator otherNode =
+                                                        nodeIndices.find(otherChannel->getParent());
+
+                            // Connections within a collapsed group don't affect the layout.
+                            if ((nodeIndices.end() != otherNode) &&
+                                (thisNode->second != otherNode->second))
+                            {
+                                edges.push_back(LayoutEdge(thisNode->second, otherNode->second));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    area.setBounds(static_cast<float>(getX()), static_cast<float>(getY()),
+                   static_cast<float>(getWidth()), static_cast<float>(getHeight()));
+    ODL_OBJEXIT(); //####
+} // ContentPanel::collectLayoutInput
+
 void
 ContentPanel::getAllCommands(Array<CommandID> & commands)
 {
@@ -198,7 +661,23 @@ ContentPanel::getAllCommands(Array<CommandID> & commands)
         ManagerWindow::kCommandClearSelection,
         ManagerWindow::kCommandUnhideEntities,
         ManagerWindow::kCommandLaunchRegistryService,
-        ManagerWindow::kCommandLaunchExecutables
+        ManagerWindow::kCommandLaunchExecutables,
+        ManagerWindow::kCommandZoomIn,
+        ManagerWindow::kCommandZoomOut,
+        ManagerWindow::kCommandZoomToActualSize,
+        ManagerWindow::kCommandGroupByAddress,
+        ManagerWindow::kCommandGroupByBehaviour,
+        ManagerWindow::kCommandUngroupEntities,
+        ManagerWindow::kCommandDrawEntitiesDirectly,
+        ManagerWindow::kCommandShowTimingOverlay,
+        ManagerWindow::kCommandSaveTimingSamples,
+        ManagerWindow::kCommandColourByTraffic,
+        ManagerWindow::kCommandThickenByTraffic,
+        ManagerWindow::kCommandLogarithmicTrafficScale,
+        ManagerWindow::kCommandSelectMatchingServices,
+        ManagerWindow::kCommandEnableSelectedMetrics,
+        ManagerWindow::kCommandDisableSelectedMetrics,
+        ManagerWindow::kCommandReplayRecording
     };
 
     commands.addArray(ids, numElementsInArray(ids));
@@ -211,7 +690,9 @@ ContentPanel::getCommandInfo(CommandID                commandID,
 {
     ODL_OBJENTER(); //####
     ManagerApplication * ourApp = ManagerApplication::getApp();
+    ContainerList        selected;
 
+    _entitiesPanel->getSelectedEntities(selected);
     switch (commandID)
     {
         case ManagerWindow::kCommandDoRepaint :
@@ -234,7 +715,8 @@ ContentPanel::getCommandInfo(CommandID                commandID,
         case ManagerWindow::kCommandClearSelection :
             result.setInfo("Clear selection", "Deselect any selected entities", "View", 0);
             result.addDefaultKeypress('C', ModifierKeys::commandModifier);
-            result.setActive((NULL != _selectedContainer) || (NULL != _selectedChannel));
+            result.setActive((NULL != _selectedContainer) || (NULL != _selectedChannel) ||
+                             (0 < selected.size()));
             break;
 
         case ManagerWindow::kCommandUnhideEntities :
@@ -256,6 +738,110 @@ ContentPanel::getCommandInfo(CommandID                commandID,
                              (0 < ourApp->getCountOfApplications()));
             break;
 
+        case ManagerWindow::kCommandZoomIn :
+            result.setInfo("Zoom in", "Display the entities at a larger scale", "View", 0);
+            result.addDefaultKeypress('=', ModifierKeys::commandModifier);
+            result.setActive(1 > _entitiesPanel->getZoomLevel());
+            break;
+
+        case ManagerWindow::kCommandZoomOut :
+            result.setInfo("Zoom out", "Display the entities at a smaller scale", "View", 0);
+            result.addDefaultKeypress('-', ModifierKeys::commandModifier);
+            break;
+
+        case ManagerWindow::kCommandZoomToActualSize :
+            result.setInfo("Actual size", "Display the entities at their actual size", "View", 0);
+            result.addDefaultKeypress('0', ModifierKeys::commandModifier);
+            result.setActive(1 > _entitiesPanel->getZoomLevel());
+            break;
+
+        case ManagerWindow::kCommandGroupByAddress :
+            result.setInfo("Group by host", "Group the entities by the IP address of their host",
+                           "View", 0);
+            result.addDefaultKeypress('G', ModifierKeys::commandModifier);
+            result.setTicked(kClusterModeByAddress == _entitiesPanel->getClusterMode());
+            break;
+
+        case ManagerWindow::kCommandGroupByBehaviour :
+            result.setInfo("Group by behaviour", "Group the entities by their behavioural model",
+                           "View", 0);
+            result.addDefaultKeypress('B', ModifierKeys::commandModifier);
+            result.setTicked(kClusterModeByBehaviour == _entitiesPanel->getClusterMode());
+            break;
+
+        case ManagerWindow::kCommandUngroupEntities :
+            result.setInfo("Ungroup", "Display the entities without grouping", "View", 0);
+            result.addDefaultKeypress('G', ModifierKeys::commandModifier |
+                                      ModifierKeys::shiftModifier);
+            result.setActive(kClusterModeNone != _entitiesPanel->getClusterMode());
+            break;
+
+        case ManagerWindow::kCommandDrawEntitiesDirectly :
+            result.setInfo("Draw entities directly",
+                           "Draw the entities from a compact list rather than as components",
+                           "View", 0);
+            result.addDefaultKeypress('D', ModifierKeys::commandModifier);
+            result.setTicked(_entitiesPanel->isDrawingEntitiesDirectly());
+            break;
+
+        case ManagerWindow::kCommandShowTimingOverlay :
+            result.setInfo("Show timing", "Show the time taken to draw and update the display",
+                           "View", 0);
+            result.addDefaultKeypress('T', ModifierKeys::commandModifier);
+            result.setTicked(_timingOverlay->isVisible());
+            break;
+
+        case ManagerWindow::kCommandSaveTimingSamples :
+            result.setInfo("Save timing ...", "Save the recent timing samples to a file", "View",
+                           0);
+            break;
+
+        case ManagerWindow::kCommandColourByTraffic :
+            result.setInfo("Colour connections by traffic",
+                           "Colour the connections by their measured traffic", "View", 0);
+            result.setTicked(_entitiesPanel->getTrafficHeatMap().isColouring());
+            result.setActive(NULL != _metricsPoller);
+            break;
+
+        case ManagerWindow::kCommandThickenByTraffic :
+            result.setInfo("Thicken connections by traffic",
+                           "Thicken the connections by their measured traffic", "View", 0);
+            result.setTicked(_entitiesPanel->getTrafficHeatMap().isThickening());
+            result.setActive(NULL != _metricsPoller);
+            break;
+
+        case ManagerWindow::kCommandLogarithmicTrafficScale :
+            result.setInfo("Logarithmic traffic scale",
+                           "Use a logarithmic scale for the measured traffic", "View", 0);
+            result.setTicked(_entitiesPanel->getTrafficHeatMap().isLogarithmic());
+            result.setActive(NULL != _metricsPoller);
+            break;
+
+        case ManagerWindow::kCommandSelectMatchingServices :
+            result.setInfo("Select services ...", "Select the services whose names match a pattern",
+                           "Operation", 0);
+            result.setActive(0 < _entitiesPanel->getNumberOfEntities());
+            break;
+
+        case ManagerWindow::kCommandEnableSelectedMetrics :
+            result.setInfo("Enable metrics for selection",
+                           "Enable metrics collection for the selected services", "Operation", 0);
+            result.setActive((0 < selected.size()) && (! _flightRecording));
+            break;
+
+        case ManagerWindow::kCommandDisableSelectedMetrics :
+            result.setInfo("Disable metrics for selection",
+                           "Disable metrics collection for the selected services", "Operation", 0);
+            result.setActive((0 < selected.size()) && (! _flightRecording));
+            break;
+
+        case ManagerWindow::kCommandReplayRecording :
+            result.setInfo("Replay recording ...",
+                           "Replay a recording of the network, or return to the live network",
+                           "View", 0);
+            result.setTicked(NULL != _flightRecording);
+            break;
+
         default :
             break;
 
@@ -316,6 +902,10 @@ ContentPanel::getMenuForIndex(int            menuIndex,
                 setUpContainerMenu(menu, *_selectedContainer);
                 menu.addSeparator();
             }
+            menu.addCommandItem(commandManager, ManagerWindow::kCommandSelectMatchingServices);
+            menu.addCommandItem(commandManager, ManagerWindow::kCommandEnableSelectedMetrics);
+            menu.addCommandItem(commandManager, ManagerWindow::kCommandDisableSelectedMetrics);
+            menu.addSeparator();
             menu.addCommandItem(commandManager, ManagerWindow::kCommandLaunchRegistryService);
             menu.addCommandItem(commandManager, ManagerWindow::kCommandLaunchExecutables);
             break;
@@ -340,6 +930,35 @@ ContentPanel::getNextCommandTarget(void)
     return nextOne;
 } // ContentPanel::getNextCommandTarget
 
+void
+ContentPanel::layOutEntities(const ContainerList & entities)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("entities = ", &entities); //####
+    bool layoutNeeded = false;
+
+    for (ContainerList::const_iterator walker(entities.begin()); entities.end() != walker;
+         ++walker)
+    {
+        ChannelContainer * anEntity = *walker;
+
+        // Entities that aren't visible aren't part of the layout.
+        if (anEntity && anEntity->isVisible())
+        {
+            // The entities are treated as if they were new, so that only they are moved.
+            _provisionalPositions[anEntity->getName().toStdString()] =
+                                                                anEntity->getPosition().toFloat();
+            layoutNeeded = true;
+        }
+    }
+    if (layoutNeeded)
+    {
+        ODL_LOG("(layoutNeeded)"); //####
+        requestEntityLayout();
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::layOutEntities
+
 #if (! MAC_OR_LINUX_)
 # pragma warning(push)
 # pragma warning(disable: 4100)
@@ -365,12 +984,20 @@ ContentPanel::menuItemSelected(int menuItemID,
     switch (menuItemID)
     {
             // Container menu items
+        case kPopupCollapseGroup :
+            _entitiesPanel->collapseCluster(_selectedContainer->getCluster());
+            break;
+
         case kPopupConfigureService :
             //TBD!!!
             break;
 
-        case kPopupDisplayChangeServiceMetrics :
-            _selectedContainer->setMetricsState(! _selectedContainer->getMetricsState());
+        case kPopupDisableServiceMetrics :
+            _selectedContainer->setMetricsState(false);
+            break;
+
+        case kPopupEnableServiceMetrics :
+            _selectedContainer->setMetricsState(true);
             break;
 
         case kPopupDisplayEntityInfo :
@@ -403,9 +1030,11 @@ ContentPanel::menuItemSelected(int menuItemID,
 
             // Channel menu items
         case kPopupAddScrollingMonitor :
+            _selectedChannel->addScrollingMonitor();
             break;
 
         case kPopupAddSimpleMonitor :
+            _selectedChannel->toggleActivityIndicator();
             break;
 
         case kPopupDetailedDisplayPortInfo :
@@ -437,41 +1066,17 @@ ContentPanel::paint(Graphics & gg)
     ODL_P1("gg = ", &gg); //####
     ChannelContainer * ofInterest;
 
-    if (_whiteBackground)
+    _frameStartTime = _timingRecorder->getCurrentTime();
+    // The background only changes when the size or the background settings change.
+    if ((! _backgroundLayer.isValid()) || (_backgroundLayer.getWidth() != getWidth()) ||
+        (_backgroundLayer.getHeight() != getHeight()))
     {
-        gg.setFillType(_invertBackground ? kFirstBackgroundColour : kSecondBackgroundColour);
+        renderBackgroundLayer();
     }
-    else
+    if (_backgroundLayer.isValid())
     {
-        // Set up a gradient background, using a radial gradient from the centre to the furthest
-        // edge.
-        int   hh = getHeight();
-        int   ww = getWidth();
-        float halfH = static_cast<float>(hh / 2.0);
-        float halfW = static_cast<float>(ww / 2.0);
-
-        if (_invertBackground)
-        {
-            ColourGradient theGradient2(kFirstBackgroundColour, halfW, halfH,
-                                        kSecondBackgroundColour,
-                                        static_cast<float>((hh > ww) ? 0 : ww),
-                                        static_cast<float>((hh > ww) ? hh : 0), true);
-            FillType       theBackgroundFill2(theGradient2);
-
-            gg.setFillType(theBackgroundFill2);
-        }
-        else
-        {
-            ColourGradient theGradient1(kSecondBackgroundColour, halfW, halfH,
-                                        kFirstBackgroundColour,
-                                        static_cast<float>((hh > ww) ? 0 : ww),
-                                        static_cast<float>((hh > ww) ? hh : 0), true);
-            FillType       theBackgroundFill1(theGradient1);
-
-            gg.setFillType(theBackgroundFill1);
-        }
+        gg.drawImageAt(_backgroundLayer, 0, 0);
     }
-    gg.fillAll();
     _channelClicked = _containerClicked = false;
     ODL_B2("_channelClicked <- ", _channelClicked, "_containerClicked <- ", //####
            _containerClicked); //####
@@ -505,8 +1110,10 @@ ContentPanel::paint(Graphics & gg)
             {
                 selectionRectangle = _selectedContainer->getBounds().toFloat();
             }
-            // Correct for any active scrolling:
+            // Correct for any active scrolling and zooming:
             selectionRectangle.translate(- viewOffsetX, - viewOffsetY);
+            selectionRectangle =
+                    selectionRectangle.transformedBy(_entitiesPanel->getTransform());
             selectionRectangle.expand(kSelectionOffset, kSelectionOffset);
             Point<float> topLeft(selectionRectangle.getTopLeft());
             Point<float> topRight(selectionRectangle.getTopRight());
@@ -537,7 +1144,7 @@ ContentPanel::paint(Graphics & gg)
             gg.drawDashedLine(line4, dashes, numDashes, kSelectionThickness);
         }
     }
-    ScannerThread * scanner = _containingWindow->getScannerThread();
+    ScannerThread * scanner = (_containingWindow ? _containingWindow->getScannerThread() : NULL);
 
     if (scanner)
     {
@@ -549,36 +1156,101 @@ ContentPanel::paint(Graphics & gg)
             ODL_LOG("(scanDataReady)"); //####
             // At this point the background scanning thread is, basically, idle, and we can use its
             // data.
+            if (_flightRecorder)
+            {
+                _flightRecorder->recordTopology(scanner->getEntitiesData());
+            }
             if (_skipNextScan)
             {
                 _skipNextScan = false;
                 scanner->doScanSoon();
             }
-            else
+            else if (! _flightRecording)
             {
+                double startTime = _timingRecorder->getCurrentTime();
+
                 updatePanels(*scanner);
+                _timingRecorder->addSample(kTimingKindUpdatePanels, startTime);
+                _entitiesPanel->updateClusters();
+                startTime = _timingRecorder->getCurrentTime();
                 setEntityPositions();
+                _timingRecorder->addSample(kTimingKindSetEntityPositions, startTime);
+                _scanShownInFrame = true;
+                // The exported counts and timings follow the scan, but the page isn't rebuilt
+                // while drawing.
+                if (_metricsExporter)
+                {
+                    _metricsExporter->renderSoon();
+                }
             }
             // Indicate that the scan data has been processed.
             scanner->scanCanProceed();
         }
     }
+    applyCompletedLayout();
     ODL_OBJEXIT(); //####
 } // ContentPanel::paint
 
-bool
-ContentPanel::perform(const InvocationInfo & info)
+#if (! MAC_OR_LINUX_)
+# pragma warning(push)
+# pragma warning(disable: 4100)
+#endif // ! MAC_OR_LINUX_
+void
+ContentPanel::paintOverChildren(Graphics & gg)
 {
+#if (! defined(ODL_ENABLE_LOGGING_))
+# if MAC_OR_LINUX_
+#  pragma unused(gg)
+# endif // MAC_OR_LINUX_
+#endif // ! defined(ODL_ENABLE_LOGGING_)
     ODL_OBJENTER(); //####
-    bool                 wasProcessed = false;
-    ManagerApplication * ourApp = ManagerApplication::getApp();
-
-    switch (info.commandID)
+    ODL_P1("gg = ", &gg); //####
+    // Refreshing the overlay by itself doesn't draw the panel, and isn't counted as a frame.
+    if (0 <= _frameStartTime)
     {
-        case ManagerWindow::kCommandDoRepaint :
-            if (ourApp)
-            {
-                ourApp->doCleanupSoon();
+        TimingSample frame;
+
+        frame._startTime = _frameStartTime;
+        frame._duration = _timingRecorder->getCurrentTime() - _frameStartTime;
+        frame._kind = kTimingKindPaint;
+        // Counting the visible items takes time, so it's only done when they will be shown.
+        if (_timingOverlay->isVisible())
+        {
+            _entitiesPanel->countVisibleItems(frame);
+        }
+        else
+        {
+            frame._entitiesDrawn = frame._entitiesCulled = 0;
+            frame._connectionsDrawn = frame._connectionsCulled = 0;
+        }
+        _timingRecorder->addSample(frame);
+        if (_scanShownInFrame)
+        {
+            _timingRecorder->noteScanShown();
+            _scanShownInFrame = false;
+        }
+        _frameStartTime = -1;
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::paintOverChildren
+#if (! MAC_OR_LINUX_)
+# pragma warning(pop)
+#endif // ! MAC_OR_LINUX_
+
+bool
+ContentPanel::perform(const InvocationInfo & info)
+{
+    ODL_OBJENTER(); //####
+    bool                 wasProcessed = false;
+    ManagerApplication * ourApp = ManagerApplication::getApp();
+    TrafficHeatMap &     heatMap = _entitiesPanel->getTrafficHeatMap();
+
+    switch (info.commandID)
+    {
+        case ManagerWindow::kCommandDoRepaint :
+            if (ourApp)
+            {
+                ourApp->doCleanupSoon();
             }
             requestWindowRepaint();
             wasProcessed = true;
@@ -599,6 +1271,7 @@ ContentPanel::perform(const InvocationInfo & info)
         case ManagerWindow::kCommandClearSelection :
             setChannelOfInterest(NULL);
             setContainerOfInterest(NULL);
+            _entitiesPanel->clearSelection();
             wasProcessed = true;
             break;
 
@@ -624,6 +1297,86 @@ ContentPanel::perform(const InvocationInfo & info)
             wasProcessed = true;
             break;
 
+        case ManagerWindow::kCommandZoomIn :
+            _entitiesPanel->setZoomLevel(_entitiesPanel->getZoomLevel() * kZoomStepFactor);
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandZoomOut :
+            _entitiesPanel->setZoomLevel(_entitiesPanel->getZoomLevel() / kZoomStepFactor);
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandZoomToActualSize :
+            _entitiesPanel->setZoomLevel(1);
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandGroupByAddress :
+            _entitiesPanel->setClusterMode(kClusterModeByAddress);
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandGroupByBehaviour :
+            _entitiesPanel->setClusterMode(kClusterModeByBehaviour);
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandUngroupEntities :
+            _entitiesPanel->setClusterMode(kClusterModeNone);
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandDrawEntitiesDirectly :
+            _entitiesPanel->setDrawEntitiesDirectly(! _entitiesPanel->isDrawingEntitiesDirectly());
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandShowTimingOverlay :
+            _timingOverlay->setVisible(! _timingOverlay->isVisible());
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandSaveTimingSamples :
+            saveTimingSamples();
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandColourByTraffic :
+            heatMap.setColouring(! heatMap.isColouring());
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandThickenByTraffic :
+            heatMap.setThickening(! heatMap.isThickening());
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandLogarithmicTrafficScale :
+            heatMap.setLogarithmic(! heatMap.isLogarithmic());
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandSelectMatchingServices :
+            selectMatchingServices();
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandEnableSelectedMetrics :
+            changeSelectedMetricsState(true);
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandDisableSelectedMetrics :
+            changeSelectedMetricsState(false);
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandReplayRecording :
+            replayRecording();
+            wasProcessed = true;
+            break;
+
         default :
             break;
 
@@ -636,55 +1389,157 @@ void
 ContentPanel::recallEntityPositions(void)
 {
     ODL_OBJENTER(); //####
-    String filePath = getPathToSettingsFile();
-    File   settingsFile(filePath);
+    File settingsFile(getPathToSettingsFile());
 
     if (settingsFile.existsAsFile())
     {
         ODL_LOG("(settingsFile.existsAsFile())"); //####
-        StringArray stuffFromFile;
+        _positionStore->load(settingsFile);
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::recallEntityPositions
 
-        settingsFile.readLines(stuffFromFile);
-        for (int ii = 0, maxs = stuffFromFile.size(); maxs > ii; ++ii)
+void
+ContentPanel::rememberPositionOfEntity(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    _positionStore->remember(anEntity->getName().toStdString(), anEntity->getPositionInPanel());
+    ODL_OBJEXIT(); //####
+} // ContentPanel::rememberPositionOfEntity
+
+void
+ContentPanel::renderBackgroundLayer(void)
+{
+    ODL_OBJENTER(); //####
+    if ((0 < getWidth()) && (0 < getHeight()))
+    {
+        _backgroundLayer = Image(Image::RGB, getWidth(), getHeight(), false);
+        Graphics gg(_backgroundLayer);
+
+        if (_whiteBackground)
         {
-            String aLine = stuffFromFile[ii];
+            gg.setFillType(_invertBackground ? kFirstBackgroundColour : kSecondBackgroundColour);
+        }
+        else
+        {
+            // Set up a gradient background, using a radial gradient from the centre to the furthest
+            // edge.
+            int   hh = getHeight();
+            int   ww = getWidth();
+            float halfH = static_cast<float>(hh / 2.0);
+            float halfW = static_cast<float>(ww / 2.0);
+
+            if (_invertBackground)
+            {
+                ColourGradient theGradient2(kFirstBackgroundColour, halfW, halfH,
+                                            kSecondBackgroundColour,
+                                            static_cast<float>((hh > ww) ? 0 : ww),
+                                            static_cast<float>((hh > ww) ? hh : 0), true);
+                FillType       theBackgroundFill2(theGradient2);
 
-            if (0 < aLine.length())
+                gg.setFillType(theBackgroundFill2);
+            }
+            else
             {
-                StringArray asPieces;
+                ColourGradient theGradient1(kSecondBackgroundColour, halfW, halfH,
+                                            kFirstBackgroundColour,
+                                            static_cast<float>((hh > ww) ? 0 : ww),
+                                            static_cast<float>((hh > ww) ? hh : 0), true);
+                FillType       theBackgroundFill1(theGradient1);
 
-                asPieces.addTokens(aLine, "\t", "");
-                if (3 == asPieces.size())
-                {
-                    String tag = asPieces[0];
-                    String xPosString = asPieces[1];
-                    String yPosString = asPieces[2];
+                gg.setFillType(theBackgroundFill1);
+            }
+        }
+        gg.fillAll();
+    }
+    else
+    {
+        _backgroundLayer = Image();
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::renderBackgroundLayer
 
-                    _rememberedPositions[tag.toStdString()] = Position(xPosString.getFloatValue(),
-                                                                       yPosString.getFloatValue());
-                }
+void
+ContentPanel::replayRecording(void)
+{
+    ODL_OBJENTER(); //####
+    ScannerThread * scanner = (_containingWindow ? _containingWindow->getScannerThread() : NULL);
+
+    // The selected entities might not exist in the other network.
+    setChannelOfInterest(NULL);
+    setContainerOfInterest(NULL);
+    _entitiesPanel->clearSelection();
+    if (_flightRecording)
+    {
+        ODL_LOG("(_flightRecording)"); //####
+        _flightRecording = NULL;
+        _replayBar->setVisible(false);
+        resized();
+        _entitiesPanel->getAnomalyDetector().setMetricsPoller(_metricsPoller);
+        _entitiesPanel->getTrafficHeatMap().setMetricsPoller(_metricsPoller);
+        _entitiesPanel->getTrafficHeatMap().refresh();
+        // The next scan brings the display back to the live network.
+        if (scanner)
+        {
+            scanner->doScanSoon();
+        }
+    }
+    else
+    {
+        File        recordingsDir(getRecordingsDirectory());
+        FileChooser fc("Choose a recording to replay...", recordingsDir, kRecordingPattern, true);
+
+        if (fc.browseForFileToOpen())
+        {
+            File                           chosenFile = fc.getResult();
+            ScopedPointer<FlightRecording> aRecording(new FlightRecording(chosenFile));
+
+            if (aRecording->isValid())
+            {
+                _flightRecording = aRecording.release();
+                // The live metrics don't describe the recorded network, so the traffic and the
+                // anomalies aren't shown until the live network is shown again.
+                _entitiesPanel->getAnomalyDetector().setMetricsPoller(NULL);
+                _entitiesPanel->getTrafficHeatMap().setMetricsPoller(NULL);
+                _entitiesPanel->getTrafficHeatMap().refresh();
+                _replayBar->setVisible(true);
+                resized();
+                _replayBar->setTimeRange(_flightRecording->getStartTime(),
+                                         _flightRecording->getEndTime());
+            }
+            else
+            {
+                AlertWindow::showMessageBox(AlertWindow::WarningIcon, "Replay recording",
+                                            String("Could not read a recording from ") +
+                                            chosenFile.getFullPathName(), String::empty, this);
             }
         }
     }
     ODL_OBJEXIT(); //####
-} // ContentPanel::recallEntityPositions
+} // ContentPanel::replayRecording
 
 void
-ContentPanel::rememberPositionOfEntity(ChannelContainer * anEntity)
+ContentPanel::requestEntityLayout(void)
 {
     ODL_OBJENTER(); //####
-    ODL_P1("anEntity = ", anEntity); //####
-    YarpString entityName(anEntity->getName().toStdString());
+    juce::Rectangle<float> area;
+    LayoutEdges            edges;
+    LayoutNodes            nodes;
 
-    _rememberedPositions[entityName] = anEntity->getPositionInPanel();
+    collectLayoutInput(nodes, edges, area);
+    _layoutThread->requestLayout(nodes, edges, area);
     ODL_OBJEXIT(); //####
-} // ContentPanel::rememberPositionOfEntity
+} // ContentPanel::requestEntityLayout
 
 void
 ContentPanel::requestWindowRepaint(void)
 {
     ODL_OBJENTER(); //####
-    _containingWindow->repaint();
+    if (_containingWindow)
+    {
+        _containingWindow->repaint();
+    }
     ODL_OBJEXIT(); //####
 } // ContentPanel::requestWindowRepaint
 
@@ -697,6 +1552,22 @@ ContentPanel::resized(void)
 
     _menuBar->setBounds(area.removeFromTop(offset));
     _entitiesPanel->setBounds(area);
+    _timingOverlay->setTopLeftPosition(area.getRight() - (_timingOverlay->getWidth() +
+                                                          kTimingOverlayMargin +
+                                                          getScrollBarThickness()),
+                                       area.getY() + kTimingOverlayMargin);
+    if (_replayBar->isVisible())
+    {
+        _replayBar->setBounds(area.getX(),
+                              area.getBottom() - (_replayBar->getHeight() +
+                                                  getScrollBarThickness()),
+                              area.getWidth() - getScrollBarThickness(), _replayBar->getHeight());
+        area.removeFromBottom(_replayBar->getHeight());
+    }
+    _trafficLegend->setTopLeftPosition(area.getX() + kTrafficLegendMargin,
+                                       area.getBottom() - (_trafficLegend->getHeight() +
+                                                           kTrafficLegendMargin +
+                                                           getScrollBarThickness()));
     ODL_OBJEXIT(); //####
 } // ContentPanel::resized
 
@@ -704,28 +1575,80 @@ void
 ContentPanel::saveEntityPositions(void)
 {
     ODL_OBJENTER(); //####
-    String filePath = getPathToSettingsFile();
-    File   settingsFile(filePath);
+    // A save that was waiting for the entities to stop moving is no longer needed.
+    stopTimer();
+    if (_positionStore->isDirty())
+    {
+        ODL_LOG("(_positionStore->isDirty())"); //####
+        _positionStore->save(File(getPathToSettingsFile()));
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::saveEntityPositions
+
+void
+ContentPanel::saveTimingSamples(void)
+{
+    ODL_OBJENTER(); //####
+    File        baseDir = File::getSpecialLocation(File::userDocumentsDirectory);
+    FileChooser fc("Choose a file to write the timing samples to...",
+                   baseDir.getChildFile("m+m manager timing.csv"), "*.csv", true);
+
+    if (fc.browseForFileToSave(true))
+    {
+        File chosenFile = fc.getResult();
+
+        if (! _timingRecorder->writeToFile(chosenFile))
+        {
+            AlertWindow::showMessageBox(AlertWindow::WarningIcon, "Save timing",
+                                        String("Could not write to ") +
+                                        chosenFile.getFullPathName(), String::empty, this);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::saveTimingSamples
+
+void
+ContentPanel::scheduleEntityPositionSave(void)
+{
+    ODL_OBJENTER(); //####
+    // Restarting the timer means that a series of moves results in a single save. A panel that
+    // isn't in a window, such as the one used for measurements, has nothing worth saving.
+    if (_containingWindow)
+    {
+        startTimer(kPositionSaveDelay);
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::scheduleEntityPositionSave
 
-    if (settingsFile.create().wasOk())
+void
+ContentPanel::selectMatchingServices(void)
+{
+    ODL_OBJENTER(); //####
+    AlertWindow ww("Select services", "Enter a pattern, such as *Filter* or /$service/*, to select "
+                   "the services whose names or service ports match it.",
+                   AlertWindow::NoIcon, this);
+
+    ww.addTextEditor("Pattern", "*", "Pattern:");
+    ww.addButton("OK", 1, KeyPress(KeyPress::returnKey, 0, 0));
+    ww.addButton("Cancel", 0, KeyPress(KeyPress::escapeKey, 0, 0));
+    if (1 == ww.runModalLoop())
     {
-        ODL_LOG("(settingsFile.create().wasOk())"); //####
-        // Make sure that the file is empty before adding lines to it!
-        settingsFile.replaceWithText("");
-        for (PositionMap::const_iterator walker(_rememberedPositions.begin());
-             _rememberedPositions.end() != walker; ++walker)
+        String pattern(ww.getTextEditorContents("Pattern").trim());
+
+        if (pattern.isNotEmpty())
         {
-            std::stringstream buff;
-            YarpString        tag = walker->first;
-            Position          where = walker->second;
+            size_t count = _entitiesPanel->selectServicesMatching(pattern);
 
-            buff << "\t" << where.x << "\t" << where.y << std::endl;
-            settingsFile.appendText(tag.c_str());
-            settingsFile.appendText(buff.str());
+            if (0 == count)
+            {
+                AlertWindow::showMessageBox(AlertWindow::InfoIcon, "Select services",
+                                            String("No services match ") + pattern,
+                                            String::empty, this);
+            }
         }
     }
     ODL_OBJEXIT(); //####
-} // ContentPanel::saveEntityPositions
+} // ContentPanel::selectMatchingServices
 
 void
 ContentPanel::setChannelOfInterest(ChannelEntry * aChannel)
@@ -765,263 +1688,47 @@ void
 ContentPanel::setEntityPositions(void)
 {
     ODL_OBJENTER(); //####
-    float         offsetX = static_cast<float>(getX());
-    float         offsetY = static_cast<float>(getY());
-    float         maxX = static_cast<float>(getWidth());
-    float         maxY = static_cast<float>(getHeight());
-    Random        randomizer(Time::currentTimeMillis());
-#if defined(USE_OGDF_POSITIONING_)
-    ogdf::Graph * gg;
-#endif // defined(USE_OGDF_POSITIONING_)
-
-#if defined(USE_OGDF_POSITIONING_)
-# if defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_)
-    if (_initialPositioningDone)
-    {
-        gg = NULL;
-    }
-    else
-    {
-        _initialPositioningDone = true;
-        gg = new ogdf::Graph;
-    }
-# else // ! defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_)
-    gg = new ogdf::Graph;
-# endif // ! defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_)
-    if (gg)
-    {
-        ScopedPointer<ogdf::GraphAttributes> ga(new ogdf::GraphAttributes(*gg));
-
-        if (ga)
-        {
-            bool       positionsNeedUpdate = false;
-            ogdf::node phantomNode = gg->newNode();
-
-            ga->setDirected(true);
-            // If nodes are not connected, OGDF will pile them all at the origin; by adding a
-            // 'phantom' node that is connected to every other node, we force OGDF to spread the
-            // nodes out.
-            ga->width(phantomNode) = 1;
-            ga->height(phantomNode) = 1;
-            ga->x(phantomNode) = offsetX + (randomizer.nextFloat() * maxX);
-            ga->y(phantomNode) = offsetY + (randomizer.nextFloat() * maxY);
-            _entitiesPanel->clearNodeValues();
-            for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
-            {
-                ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
-
-                if (aContainer)
-                {
-                    float                  newX;
-                    float                  newY;
-                    juce::Rectangle<float> entityShape(aContainer->getLocalBounds().toFloat());
-                    ogdf::node             aNode = gg->newNode();
-                    float                  hh = entityShape.getHeight();
-                    float                  ww = entityShape.getWidth();
-
-                    ga->width(aNode) = ww;
-                    ga->height(aNode) = hh;
-                    aContainer->setNode(aNode);
-                    if (aContainer->isNew() || aContainer->wasHidden())
-                    {
-                        ODL_LOG("(aContainer->isNew() || aContainer->wasHidden())"); //####
-                        // Check if the position was already known.
-                        YarpString                  entityName(aContainer->getName().toStdString());
-                        PositionMap::const_iterator match(_rememberedPositions.find(entityName));
-
-                        if (_rememberedPositions.end() == match)
-                        {
-                            newX = offsetX + (randomizer.nextFloat() * (maxX - ww));
-                            newY = offsetY + (randomizer.nextFloat() * (maxY - hh));
-                            positionsNeedUpdate = true;
-                        }
-                        else
-                        {
-                            newX = match->second.x;
-                            newY = match->second.y;
-                        }
-                        aContainer->setTopLeftPosition(static_cast<int>(newX),
-                                                       static_cast<int>(newY));
-                    }
-                    else
-                    {
-                        newX = entityShape.getX();
-                        newY = entityShape.getY();
-                    }
-                    ga->x(aNode) = newX;
-                    ga->y(aNode) = newY;
-                }
-            }
-            if (positionsNeedUpdate)
-            {
-                ODL_LOG("(positionsNeedUpdate)"); //####
-                // Set up the edges (connections).
-                for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
-                {
-                    ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
-
-                    if (aContainer)
-                    {
-                        ogdf::node thisNode = aContainer->getNode();
-
-                        if (thisNode)
-                        {
-                            bool wasConnected = false;
-
-                            // Add edges between entities that are connected via their entries.
-                            for (int jj = 0, nn = aContainer->getNumPorts(); nn > jj; ++jj)
-                            {
-                                ChannelEntry * aChannel = aContainer->getPort(jj);
-
-                                if (aChannel)
-                                {
-                                    const ChannelConnections & outputs =
-                                    aChannel->getOutputConnections();
-
-                                    for (size_t kk = 0, ll = outputs.size(); ll > kk; ++kk)
-                                    {
-                                        ChannelEntry * otherChannel = outputs[kk]._otherChannel;
-
-                                        if (otherChannel)
-                                        {
-                                            ChannelContainer * otherEntity =
-                                                                        otherChannel->getParent();
-
-                                            if (otherEntity)
-                                            {
-                                                ogdf::node otherNode = otherEntity->getNode();
-
-                                                if (otherNode && (thisNode != otherNode))
-                                                {
-                                                    /*ogdf::edge ee =*/ gg->newEdge(thisNode,
-                                                                                    otherNode);
-
-                                                    wasConnected = true;
-                                                }
-                                            }
-                                        }
-                                    }
-                                    const ChannelConnections & inputs =
-                                    aChannel->getInputConnections();
-
-                                    if (0 < inputs.size())
-                                    {
-                                        wasConnected = true;
-                                    }
-                                }
-                            }
-                            if (! wasConnected)
-                            {
-                                /*ogdf::edge phantomNodeToThis =*/ gg->newEdge(phantomNode,
-                                                                               thisNode);
+    float  offsetX = static_cast<float>(getX());
+    float  offsetY = static_cast<float>(getY());
+    float  maxX = static_cast<float>(getWidth());
+    float  maxY = static_cast<float>(getHeight());
+    bool   layoutNeeded = false;
+    Random randomizer(Time::currentTimeMillis());
 
-                            }
-                        }
-                    }
-                }
-                // Apply an energy-based layout.
-                ScopedPointer<ogdf::FMMMLayout> fmmm(new ogdf::FMMMLayout);
-
-                if (fmmm)
-                {
-                    fmmm->useHighLevelOptions(true);
-                    fmmm->newInitialPlacement(false); //true);
-                    fmmm->qualityVersusSpeed(ogdf::FMMMLayout::qvsGorgeousAndEfficient);
-                    fmmm->allowedPositions(ogdf::FMMMLayout::apAll);
-                    fmmm->initialPlacementMult(ogdf::FMMMLayout::ipmAdvanced);
-                    fmmm->initialPlacementForces(ogdf::FMMMLayout::ipfKeepPositions);
-                    fmmm->repForcesStrength(2);
-                    fmmm->call(*ga);
-                    for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
-                    {
-                        ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
-
-                        if (aContainer && (aContainer->isNew() || aContainer->wasHidden()))
-                        {
-                            ogdf::node aNode = aContainer->getNode();
-
-                            if (aNode)
-                            {
-                                // Check if the position was already known.
-                                YarpString entityName(aContainer->getName().toStdString());
-
-                                if (_rememberedPositions.end() ==
-                                    _rememberedPositions.find(entityName))
-                                {
-                                    aContainer->setTopLeftPosition(static_cast<int>(ga->x(aNode)),
-                                                                   static_cast<int>(ga->y(aNode)));
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        delete gg;
-    }
-    else
-    {
-        for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
-        {
-            ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
-
-            if (aContainer && (aContainer->isNew() || aContainer->wasHidden()))
-            {
-                ODL_LOG("(aContainer && (aContainer->isNew() || aContainer->wasHidden()))"); //####
-                float                       newX;
-                float                       newY;
-                juce::Rectangle<float>      entityShape(aContainer->getLocalBounds().toFloat());
-                float                       hh = entityShape.getHeight();
-                float                       ww = entityShape.getWidth();
-                YarpString                  entityName(aContainer->getName().toStdString());
-                PositionMap::const_iterator match(_rememberedPositions.find(entityName));
-
-                if (_rememberedPositions.end() == match)
-                {
-                    newX = offsetX + (randomizer.nextFloat() * (maxX - ww));
-                    newY = offsetY + (randomizer.nextFloat() * (maxY - hh));
-                }
-                else
-                {
-                    newX = match->second.x;
-                    newY = match->second.y;
-                }
-                aContainer->setTopLeftPosition(static_cast<int>(newX), static_cast<int>(newY));
-                if (! aContainer->isVisible())
-                {
-                    aContainer->setVisible(true);
-                    aContainer->clearHidden();
-                }
-            }
-        }
-    }
-#else // ! defined(USE_OGDF_POSITIONING_)
     for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
     {
         ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
 
-        if (aContainer && (aContainer->isNew() || aContainer->wasHidden()))
+        // The members of a collapsed group are placed when the group is expanded.
+        if (aContainer && (aContainer->isNew() || aContainer->wasHidden()) &&
+            (! aContainer->isInCollapsedCluster()))
         {
-            ODL_LOG("(aContainer && (aContainer->isNew() || aContainer->wasHidden()))"); //####
-            float                       newX;
-            float                       newY;
-            juce::Rectangle<float>      entityShape(aContainer->getLocalBounds().toFloat());
-            float                       hh = entityShape.getHeight();
-            float                       ww = entityShape.getWidth();
-            YarpString                  entityName(aContainer->getName().toStdString());
-            PositionMap::const_iterator match(_rememberedPositions.find(entityName));
-
-            if (_rememberedPositions.end() == match)
+            ODL_LOG("(aContainer && (aContainer->isNew() || aContainer->wasHidden()) && " //####
+                    "(! aContainer->isInCollapsedCluster()))"); //####
+            YarpString             entityName(aContainer->getName().toStdString());
+            float                  newX;
+            float                  newY;
+            juce::Rectangle<float> entityShape(aContainer->getLocalBounds().toFloat());
+            float                  hh = entityShape.getHeight();
+            float                  ww = entityShape.getWidth();
+            Position               rememberedPosition;
+
+            if (! _positionStore->find(entityName, rememberedPosition))
             {
+                // Show the entity at a random position until the layout thread has found a better
+                // one for it.
                 newX = offsetX + (randomizer.nextFloat() * (maxX - ww));
                 newY = offsetY + (randomizer.nextFloat() * (maxY - hh));
+                aContainer->setTopLeftPosition(static_cast<int>(newX), static_cast<int>(newY));
+                _provisionalPositions[entityName] = aContainer->getPosition().toFloat();
+                layoutNeeded = true;
             }
             else
             {
-                newX = match->second.x;
-                newY = match->second.y;
+                newX = rememberedPosition.x;
+                newY = rememberedPosition.y;
+                aContainer->setTopLeftPosition(static_cast<int>(newX), static_cast<int>(newY));
             }
-            aContainer->setTopLeftPosition(static_cast<int>(newX), static_cast<int>(newY));
             if (! aContainer->isVisible())
             {
                 aContainer->setVisible(true);
@@ -1029,7 +1736,11 @@ ContentPanel::setEntityPositions(void)
             }
         }
     }
-#endif // ! defined(USE_OGDF_POSITIONING_)
+    if (layoutNeeded)
+    {
+        ODL_LOG("(layoutNeeded)"); //####
+        requestEntityLayout();
+    }
     ODL_OBJEXIT(); //####
 } // ContentPanel::setEntityPositions
 
@@ -1040,12 +1751,15 @@ ContentPanel::setUpChannelMenu(PopupMenu &    aMenu,
     ODL_OBJENTER(); //####
     ODL_P2("aMenu = ", &aMenu, "aChannel = ", &aChannel); //####
     bool               isChannel = aChannel.isChannel();
+    bool               live = (! _flightRecording);
     bool               showMetrics = false;
     ChannelContainer * theParent = aChannel.getParent();
+    ServiceState       state;
 
-    if (isChannel)
+    // The channels of a recording might no longer exist, so they aren't asked for anything.
+    if (isChannel && live && theParent->getServiceState(state, false))
     {
-        showMetrics = theParent->getMetricsState();
+        showMetrics = state._metricsEnabled;
     }
     aMenu.addItem(kPopupDisplayPortInfo, isChannel ? "Display channel information" :
                   "Display port information");
@@ -1060,8 +1774,9 @@ ContentPanel::setUpChannelMenu(PopupMenu &    aMenu,
         (kPortUsageClient != aChannel.getUsage()))
     {
         aMenu.addSeparator();
-        aMenu.addItem(kPopupAddSimpleMonitor, "Enable activity indicator", false);
-        aMenu.addItem(kPopupAddScrollingMonitor, "Add scrolling monitor", false);
+        aMenu.addItem(kPopupAddSimpleMonitor, aChannel.isBeingMonitored() ?
+                      "Disable activity indicator" : "Enable activity indicator", live);
+        aMenu.addItem(kPopupAddScrollingMonitor, "Add scrolling monitor", live);
     }
     ODL_OBJEXIT(); //####
 } // ContentPanel::setUpChannelMenu
@@ -1072,10 +1787,13 @@ ContentPanel::setUpContainerMenu(PopupMenu &        aMenu,
 {
     ODL_OBJENTER(); //####
     ODL_P2("aMenu = ", &aMenu, "aContainer = ", &aContainer); //####
-    bool   configurable = false;
-    bool   restartable = false;
-    bool   serviceLike;
-    String kindOfContainer;
+    bool         configurable = false;
+    bool         live = (! _flightRecording);
+    bool         metricsEnabled = false;
+    bool         restartable = false;
+    bool         serviceLike;
+    ServiceState state;
+    String       kindOfContainer;
 
     switch (aContainer.getKind())
     {
@@ -1100,16 +1818,38 @@ ContentPanel::setUpContainerMenu(PopupMenu &        aMenu,
                   " information");
     if (serviceLike)
     {
-        bool metricsEnabled = aContainer.getMetricsState();
-
         aMenu.addSeparator();
-        aMenu.addItem(kPopupDisplayChangeServiceMetrics,
-                      String(metricsEnabled ? "Disable " : "Enable ") + kindOfContainer +
-                      " metrics collection");
+        // The services of a recording might no longer exist, so they aren't asked for anything.
+        if (! live)
+        {
+            aMenu.addItem(kPopupEnableServiceMetrics, String("Change the ") + kindOfContainer +
+                          " metrics collection", false);
+        }
+        // The menu is built from the last known state, so that a slow service doesn't keep it
+        // from appearing; the cache asks the service again if the state is out of date.
+        else if (aContainer.getServiceState(state, false) && (0 <= state._metricsStateTime))
+        {
+            metricsEnabled = state._metricsEnabled;
+            // The item carries the state that was shown, so that the choice isn't reversed if the
+            // state changes while the menu is open.
+            aMenu.addItem(metricsEnabled ? kPopupDisableServiceMetrics : kPopupEnableServiceMetrics,
+                          String(metricsEnabled ? "Disable " : "Enable ") +
+                          kindOfContainer + " metrics collection" +
+                          (state._metricsStateIsStale ? " (last known state)" : ""));
+        }
+        else
+        {
+            aMenu.addItem(kPopupEnableServiceMetrics, String("Checking the ") +
+                          kindOfContainer + " metrics collection...", false);
+        }
         aMenu.addItem(kPopupDisplayServiceMetrics, String("Display ") + kindOfContainer +
                       " metrics", metricsEnabled);
     }
     aMenu.addItem(kPopupHideEntity, String("Hide the ") + kindOfContainer);
+    if (aContainer.getCluster())
+    {
+        aMenu.addItem(kPopupCollapseGroup, "Collapse the group");
+    }
     if (serviceLike)
     {
         switch (Utilities::MapStringToServiceKind(aContainer.getBehaviour()))
@@ -1130,9 +1870,10 @@ ContentPanel::setUpContainerMenu(PopupMenu &        aMenu,
         }
         aMenu.addSeparator();
         aMenu.addItem(kPopupConfigureService, String("Configure the ") + kindOfContainer,
-                      configurable);
-        aMenu.addItem(kPopupRestartService, String("Restart the ") + kindOfContainer, restartable);
-        aMenu.addItem(kPopupStopService, String("Stop the ") + kindOfContainer);
+                      configurable && live);
+        aMenu.addItem(kPopupRestartService, String("Restart the ") + kindOfContainer,
+                      restartable && live);
+        aMenu.addItem(kPopupStopService, String("Stop the ") + kindOfContainer, live);
     }
     ODL_OBJEXIT(); //####
 } // ContentPanel::setUpContainerMenu
@@ -1159,11 +1900,86 @@ ContentPanel::setUpViewMenu(PopupMenu & aMenu)
     aMenu.addCommandItem(commandManager, ManagerWindow::kCommandInvertBackground);
     aMenu.addCommandItem(commandManager, ManagerWindow::kCommandWhiteBackground);
     aMenu.addSeparator();
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandZoomIn);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandZoomOut);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandZoomToActualSize);
+    aMenu.addSeparator();
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandGroupByAddress);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandGroupByBehaviour);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandUngroupEntities);
+    aMenu.addSeparator();
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandDrawEntitiesDirectly);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandShowTimingOverlay);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandSaveTimingSamples);
+    aMenu.addSeparator();
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandColourByTraffic);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandThickenByTraffic);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandLogarithmicTrafficScale);
+    aMenu.addSeparator();
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandReplayRecording);
+    aMenu.addSeparator();
     aMenu.addCommandItem(commandManager, ManagerWindow::kCommandClearSelection);
     aMenu.addCommandItem(commandManager, ManagerWindow::kCommandUnhideEntities);
     ODL_OBJEXIT(); //####
 } // ContentPanel::setUpViewMenu
 
+String
+ContentPanel::showRecordedState(const int64 when)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL1("when = ", when); //####
+    EntitiesData      workingData;
+    ServiceMetricsMap services;
+    int64             metricsTime;
+    int64             topologyTime;
+    String            result;
+
+    if (_flightRecording && _flightRecording->getTopologyAt(when, workingData, topologyTime))
+    {
+        ODL_LOG("(_flightRecording && _flightRecording->getTopologyAt(when, " //####
+                "workingData, topologyTime))"); //####
+        updatePanels(workingData);
+        _entitiesPanel->updateClusters();
+        setEntityPositions();
+        result = Time(topologyTime).toString(true, true) + ": " +
+                 String(static_cast<int>(workingData.getNumberOfEntities())) + " entities, " +
+                 String(static_cast<int>(workingData.getConnections().size())) + " connections";
+        if (_flightRecording->getMetricsAt(when, services, metricsTime))
+        {
+            int   reportingCount = 0;
+            int64 inBytes = 0;
+            int64 outBytes = 0;
+
+            for (ServiceMetricsMap::const_iterator walker(services.begin());
+                 services.end() != walker; ++walker)
+            {
+                if (walker->second._enabled && walker->second._valid)
+                {
+                    const ChannelMetricsList & channels = walker->second._channels;
+
+                    ++reportingCount;
+                    for (ChannelMetricsList::const_iterator channelWalker(channels.begin());
+                         channels.end() != channelWalker; ++channelWalker)
+                    {
+                        inBytes += channelWalker->_inBytes;
+                        outBytes += channelWalker->_outBytes;
+                    }
+                }
+            }
+            result += String("; as of ") + Time(metricsTime).formatted("%H:%M:%S") + ", " +
+                      String(reportingCount) + " services reporting, " + String(inBytes) +
+                      " bytes in, " + String(outBytes) + " bytes out";
+        }
+        requestWindowRepaint();
+    }
+    else
+    {
+        result = String("Nothing was recorded before ") + Time(when).toString(true, true);
+    }
+    ODL_OBJEXIT_s(result.toStdString()); //####
+    return result;
+} // ContentPanel::showRecordedState
+
 void
 ContentPanel::skipScan(void)
 {
@@ -1173,12 +1989,20 @@ ContentPanel::skipScan(void)
 } // ContentPanel::skipScan
 
 void
-ContentPanel::updatePanels(ScannerThread & scanner)
+ContentPanel::timerCallback(void)
 {
     ODL_OBJENTER(); //####
-    ODL_P1("scanner = ", &scanner); //####
-    bool                 changeSeen = false;
-    const EntitiesData & workingData(scanner.getEntitiesData());
+    saveEntityPositions();
+    ODL_OBJEXIT(); //####
+} // ContentPanel::timerCallback
+
+bool
+ContentPanel::updatePanels(const EntitiesData & workingData)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("workingData = ", &workingData); //####
+    bool             changeSeen = false;
+    YarpStringVector servicePortNames;
 
     // Retrieve each entity from our new list; if it is known already, ignore it but mark the
     // old entity as known.
@@ -1268,9 +2092,45 @@ ContentPanel::updatePanels(ScannerThread & scanner)
         changeSeen = true;
     }
     _entitiesPanel->removeInvalidConnections();
+    for (size_t ii = 0, mm = workingData.getNumberOfEntities(); mm > ii; ++ii)
+    {
+        EntityData * anEntity = workingData.getEntity(ii);
+
+        if (anEntity)
+        {
+            for (int jj = 0, nn = anEntity->getNumPorts(); nn > jj; ++jj)
+            {
+                PortData * aPort = anEntity->getPort(jj);
+
+                if (aPort && aPort->isService())
+                {
+                    servicePortNames.push_back(aPort->getPortName());
+                }
+            }
+        }
+    }
+    // The services of a recording might no longer exist, so only the live services are polled.
+    if (! _flightRecording)
+    {
+        if (_metricsPoller)
+        {
+            ODL_LOG("(_metricsPoller)"); //####
+            _metricsPoller->setServices(servicePortNames);
+        }
+        _serviceStateCache->setServices(servicePortNames);
+    }
     ODL_LOG("about to call adjustSize()"); //####
     _entitiesPanel->adjustSize(false);
-    if (changeSeen)
+    ODL_OBJEXIT_B(changeSeen); //####
+    return changeSeen;
+} // ContentPanel::updatePanels
+
+void
+ContentPanel::updatePanels(ScannerThread & scanner)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("scanner = ", &scanner); //####
+    if (updatePanels(scanner.getEntitiesData()))
     {
         scanner.doScanSoon();
     }
@@ -61,14 +61,27 @@
 
 namespace MPlusM_Manager
 {
+    class EntitiesData;
     class EntitiesPanel;
+    class FlightRecorder;
+    class FlightRecording;
+    class LayoutThread;
     class ManagerWindow;
+    class MetricsExporter;
+    class MetricsPoller;
+    class PositionStore;
+    class ReplayBar;
     class ScannerThread;
+    class ServiceStateCache;
+    class TimingOverlay;
+    class TimingRecorder;
+    class TrafficLegend;
 
     /*! @brief The content area of the main window of the application. */
     class ContentPanel : public ApplicationCommandTarget,
                          public MenuBarModel,
-                         public Viewport
+                         public Viewport,
+                         private Timer
     {
     public :
 
@@ -85,10 +98,14 @@ namespace MPlusM_Manager
         /*! @brief The third class that this class is derived from. */
         typedef Viewport inherited3;
 
+        /*! @brief The fourth class that this class is derived from. */
+        typedef Timer inherited4;
+
     public :
 
         /*! @brief The constructor.
-         @param[in] containingWindow The window in which the panel is embedded. */
+         @param[in] containingWindow The window in which the panel is embedded, or @c NULL if the
+         panel is not being displayed, such as when it is used for measurements. */
         explicit
         ContentPanel(ManagerWindow * containingWindow);
 
@@ -96,6 +113,11 @@ namespace MPlusM_Manager
         virtual
         ~ContentPanel(void);
 
+        /*! @brief Move the entities that were positioned by the layout thread, if it has finished.
+         @return @c true if the layout thread had finished and @c false otherwise. */
+        bool
+        applyCompletedLayout(void);
+
         /*! @brief Returns @c true if the background is inverted.
          @return @c true if the background is inverted. */
         inline bool
@@ -119,13 +141,25 @@ namespace MPlusM_Manager
         changeBackgroundColour(void)
         {
             _whiteBackground = ! _whiteBackground;
+            _backgroundLayer = Image();
         } // changeBackgroundColour
 
+        /*! @brief Gather the entities and connections that are to be laid out.
+         @param[out] nodes The entities that are to be laid out, with the entities that are not to
+         be moved marked as pinned.
+         @param[out] edges The connections between the entities.
+         @param[out] area The area in which unconnected entities are to be placed. */
+        void
+        collectLayoutInput(LayoutNodes &            nodes,
+                           LayoutEdges &            edges,
+                           juce::Rectangle<float> & area);
+
         /*! @brief Change the background inversion state. */
         inline void
         flipBackground(void)
         {
             _invertBackground = ! _invertBackground;
+            _backgroundLayer = Image();
         } // flipBackground
 
         /*! @brief Returns the entities panel.
@@ -137,11 +171,45 @@ namespace MPlusM_Manager
             return *_entitiesPanel;
         } // getEntitiesPanel
 
+        /*! @brief Returns the background collector of the metrics of the services.
+         @return The background collector of the metrics of the services, or @c NULL if the panel
+         is not displayed in a window. */
+        inline MetricsPoller *
+        getMetricsPoller(void)
+        const
+        {
+            return _metricsPoller;
+        } // getMetricsPoller
+
+        /*! @brief Returns the last known states of the services.
+         @return The last known states of the services. */
+        inline ServiceStateCache &
+        getServiceStateCache(void)
+        const
+        {
+            return *_serviceStateCache;
+        } // getServiceStateCache
+
+        /*! @brief Returns the recorder of timing samples.
+         @return The recorder of timing samples. */
+        inline TimingRecorder &
+        getTimingRecorder(void)
+        const
+        {
+            return *_timingRecorder;
+        } // getTimingRecorder
+
+        /*! @brief Find new positions for some of the entities, leaving the others where they are.
+         @param[in] entities The entities to be positioned. */
+        void
+        layOutEntities(const ContainerList & entities);
+
         /*! @brief Restore the positions of all the entities in the panel. */
         void
         recallEntityPositions(void);
 
-        /*! @brief Record the position of an entity before it is removed from the panel. */
+        /*! @brief Record the position of an entity, such as before it is removed from the panel.
+         @param[in] anEntity The entity whose position is to be recorded. */
         void
         rememberPositionOfEntity(ChannelContainer * anEntity);
 
@@ -149,10 +217,15 @@ namespace MPlusM_Manager
         void
         requestWindowRepaint(void);
 
-        /*! @brief Record the positions of all the entities in the panel. */
+        /*! @brief Write the remembered positions to the settings file, if they have changed. */
         void
         saveEntityPositions(void);
 
+        /*! @brief Arrange for the remembered positions to be written to the settings file once the
+         entities have stopped moving. */
+        void
+        scheduleEntityPositionSave(void);
+
         /*! @brief Record the ChannelEntry that is selected. */
         void
         setChannelOfInterest(ChannelEntry * aChannel);
@@ -161,6 +234,10 @@ namespace MPlusM_Manager
         void
         setContainerOfInterest(ChannelContainer * aContainer);
 
+        /*! @brief Set the entity positions, based on the scanned entities. */
+        void
+        setEntityPositions(void);
+
         /*! @brief Prepare the channel menu for use.
          @param[in,out] aMenu The popup menu to be configured.
          @param[in] aChannel The selected channel. */
@@ -180,14 +257,39 @@ namespace MPlusM_Manager
         void
         setUpViewMenu(PopupMenu & aMenu);
 
+        /*! @brief Show the topology of the flight recording that is being replayed, as it was at
+         a given time.
+         @param[in] when The time of interest, in milliseconds since the epoch.
+         @return A description of the state that is shown. */
+        String
+        showRecordedState(const int64 when);
+
         /*! @brief Ignore the result of the next scan. */
         void
         skipScan(void);
 
+        /*! @brief Refresh the displayed entities and connections from a set of scanned entities.
+         @param[in] workingData The scanned entities and connections.
+         @return @c true if entities were added or removed and @c false otherwise. */
+        bool
+        updatePanels(const EntitiesData & workingData);
+
     protected :
 
     private :
 
+        /*! @brief Move the entities that were positioned by the layout thread.
+         @param[in] results The entities that were positioned by the layout thread. */
+        void
+        applyLayoutResults(const LayoutNodes & results);
+
+        /*! @brief Change the state of metrics collection for all the selected services at once and
+         report the outcome.
+         @param[in] newState @c true if metrics collection is to be enabled and @c false
+         otherwise. */
+        void
+        changeSelectedMetricsState(const bool newState);
+
         /*! @brief Return a list of commands that this target can handle.
          @param[in,out] commands The list of commands to be added to. */
         virtual void
@@ -231,6 +333,25 @@ namespace MPlusM_Manager
         virtual void
         paint(Graphics & gg);
 
+        /*! @brief Called after the children of the component have been drawn, to finish the
+         timing of the frame.
+         @param[in,out] gg The graphics context in which to draw. */
+        virtual void
+        paintOverChildren(Graphics & gg);
+
+        /*! @brief Draw the background into the cached image of the background. */
+        void
+        renderBackgroundLayer(void);
+
+        /*! @brief Ask the user for a flight recording and start replaying it, or stop replaying
+         the current one and return to the live network. */
+        void
+        replayRecording(void);
+
+        /*! @brief Ask the layout thread to position the entities that are waiting to be placed. */
+        void
+        requestEntityLayout(void);
+
         /*! @brief Perform the specified command.
          @param[in] info The details for the command.
          @return @c true if the command was handled and @c false if it was not. */
@@ -241,15 +362,23 @@ namespace MPlusM_Manager
         virtual void
         resized(void);
 
-        /*! @brief Set the entity positions, based on the scanned entities. */
+        /*! @brief Ask the user for a file and write the timing samples to it. */
         void
-        setEntityPositions(void);
+        saveTimingSamples(void);
+
+        /*! @brief Ask the user for a pattern and select the services whose names match it. */
+        void
+        selectMatchingServices(void);
 
         /*! @brief Prepare the main menu for use.
          @param[in,out] aMenu The popup menu to be configured. */
         void
         setUpMainMenu(PopupMenu & aMenu);
 
+        /*! @brief Called when the timer fires. */
+        virtual void
+        timerCallback(void);
+
         /*! @brief Refresh the displayed entities and connections, based on the scanned entities.
          @param[in] scanner The background scanning thread. */
         void
@@ -266,15 +395,53 @@ namespace MPlusM_Manager
 
     private :
 
-        /*! @brief The positions that entities were last seen at. */
-        PositionMap _rememberedPositions;
+        /*! @brief The positions that new entities were first shown at, while they are waiting to
+         be placed by the layout thread. */
+        PositionMap _provisionalPositions;
+
+        /*! @brief The cached image of the background. */
+        Image _backgroundLayer;
 
         /*! @brief The entities panel. */
         ScopedPointer<EntitiesPanel> _entitiesPanel;
 
+        /*! @brief The recorder of the topology and metrics of the network. */
+        ScopedPointer<FlightRecorder> _flightRecorder;
+
+        /*! @brief The flight recording that is being replayed, or @c NULL if the live network is
+         being shown. */
+        ScopedPointer<FlightRecording> _flightRecording;
+
+        /*! @brief The background thread that positions new entities. */
+        ScopedPointer<LayoutThread> _layoutThread;
+
         /*! @brief The menubar for the panel. */
         ScopedPointer<MenuBarComponent> _menuBar;
 
+        /*! @brief The server for the metrics, if they are being exported. */
+        ScopedPointer<MetricsExporter> _metricsExporter;
+
+        /*! @brief The background collector of the metrics of the services. */
+        ScopedPointer<MetricsPoller> _metricsPoller;
+
+        /*! @brief The positions that entities were last seen at. */
+        ScopedPointer<PositionStore> _positionStore;
+
+        /*! @brief The control used to move through a flight recording. */
+        ScopedPointer<ReplayBar> _replayBar;
+
+        /*! @brief The last known states of the services. */
+        ScopedPointer<ServiceStateCache> _serviceStateCache;
+
+        /*! @brief The display of the most recent timing samples. */
+        ScopedPointer<TimingOverlay> _timingOverlay;
+
+        /*! @brief The recorder of timing samples. */
+        ScopedPointer<TimingRecorder> _timingRecorder;
+
+        /*! @brief The legend for the colouring of the connections by their traffic. */
+        ScopedPointer<TrafficLegend> _trafficLegend;
+
         /*! @brief The window in which the panel is embedded. */
         ManagerWindow * _containingWindow;
 
@@ -284,19 +451,23 @@ namespace MPlusM_Manager
         /*! @brief The selected container. */
         ChannelContainer * _selectedContainer;
 
+        /*! @brief The time at which drawing of the current frame started, or a negative value if
+         the panel itself isn't being drawn. */
+        double _frameStartTime;
+
         /*! @brief @c true if a channel was clicked and @c false otherwise. */
         bool _channelClicked;
 
         /*! @brief @c true if a container was clicked and @c false otherwise. */
         bool _containerClicked;
 
-# if (defined(USE_OGDF_POSITIONING_) && defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_))
-        bool _initialPositioningDone;
-# endif // defined(USE_OGDF_POSITIONING_) && defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_)
-
         /*! @brief @c true if the background is inverted and @c false otherwise. */
         bool _invertBackground;
 
+        /*! @brief @c true if the current frame shows the results of a scan and @c false
+         otherwise. */
+        bool _scanShownInFrame;
+
         /*! @brief @c true if the next scan result is to be ignored and @c false otherwise. */
         bool _skipNextScan;
 
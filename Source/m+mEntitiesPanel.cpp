@@ -38,11 +38,16 @@
 //--------------------------------------------------------------------------------------------------
 
 #include "m+mEntitiesPanel.hpp"
+#include "m+mActivitySampler.hpp"
+#include "m+mAnomalyDetector.hpp"
 #include "m+mChannelContainer.hpp"
 #include "m+mChannelEntry.hpp"
 #include "m+mContentPanel.hpp"
+#include "m+mEntityCluster.hpp"
 #include "m+mFormField.hpp"
 #include "m+mManagerWindow.hpp"
+#include "m+mSpatialIndex.hpp"
+#include "m+mTrafficHeatMap.hpp"
 
 //#include <odlEnable.h>
 #include <odlInclude.h>
@@ -97,9 +102,39 @@ using namespace std;
 # pragma mark Private structures, constants and variables
 #endif // defined(__APPLE__)
 
+/*! @brief A mapping from the values shared by the members of groups to the groups. */
+typedef std::map<YarpString, EntityCluster *> ClusterIndexMap;
+
+/*! @brief A mapping from the values shared by the members of groups to the entities that are not
+ yet in a group. */
+typedef std::map<YarpString, ContainerList> GroupingMap;
+
 /*! @brief The name of the font to be used for text. */
 static const char * kFontName = "Courier New";
 
+/*! @brief The colour to be used for the combined connections of a collapsed group. */
+static const Colour & kClusterConnectionColour(Colours::lightgrey);
+
+/*! @brief The distance from the centre of a group that is added, for each member, to the area
+ that the members are spread over when the group is expanded. */
+static const float kClusterSpreadPerMember = 40;
+
+/*! @brief The widest line used for a combined connection. */
+static const float kMaximumClusterConnectionWidth = 8;
+
+/*! @brief The smallest number of entities that are grouped together. */
+static const size_t kMinimumClusterSize = 2;
+
+/*! @brief The maximum distance from a connection for the mouse to be considered over it. */
+static const float kConnectionHitTolerance = 4;
+
+/*! @brief The smallest scale at which text and the details of connections are drawn. */
+static const float kDetailZoomThreshold = 0.5;
+
+/*! @brief The extra space around an entity that is repainted when it is moved, to cover the
+ selection outline and highlighted connections. */
+static const float kDirtyRegionMargin = 8;
+
 /*! @brief The outer 'gutter' for the entities. */
 static const int kGutter = 10;
 
@@ -109,6 +144,22 @@ static const int kInitialPanelHeight = 768;
 /*! @brief The initial width of the displayed region. */
 static const int kInitialPanelWidth = 1024;
 
+/*! @brief The fraction of the visible area to add on each side of the cached image of the
+ connections. */
+static const float kLayerMargin = 0.25;
+
+/*! @brief The largest scale at which the panel can be displayed. */
+static const float kMaximumZoomLevel = 1;
+
+/*! @brief The smallest scale at which the panel can be displayed. */
+static const float kMinimumZoomLevel = 0.05f;
+
+/*! @brief The width and height of a cell in the spatial index. */
+static const float kSpatialIndexCellSize = 256;
+
+/*! @brief The change in scale for each step of the mouse wheel. */
+static const float kZoomWheelFactor = 0.5;
+
 #if defined(__APPLE__)
 # pragma mark Global constants and variables
 #endif // defined(__APPLE__)
@@ -117,6 +168,94 @@ static const int kInitialPanelWidth = 1024;
 # pragma mark Local functions
 #endif // defined(__APPLE__)
 
+/*! @brief Return the value that determines which group an entity belongs to.
+ @param[in] anEntity The entity of interest.
+ @param[in] mode How the entities are grouped.
+ @return The value shared by the members of the group, or an empty string if the entity isn't
+ grouped. */
+static YarpString
+getClusterKey(const ChannelContainer * anEntity,
+              const ClusterMode        mode)
+{
+    YarpString result;
+
+    switch (mode)
+    {
+        case kClusterModeByAddress :
+            result = anEntity->getIPAddress();
+            break;
+
+        case kClusterModeByBehaviour :
+            result = anEntity->getBehaviour();
+            if (0 == result.length())
+            {
+                // Entities without a behavioural model are grouped by what kind of entity they
+                // are.
+                switch (anEntity->getKind())
+                {
+                    case kContainerKindAdapter :
+                        result = "Adapters";
+                        break;
+
+                    case kContainerKindService :
+                        result = "Services";
+                        break;
+
+                    default :
+                        result = "Ports";
+                        break;
+
+                }
+            }
+            break;
+
+        default :
+            break;
+
+    }
+    return result;
+} // getClusterKey
+
+/*! @brief Return the item that is drawn by the entities panel for an entity heading or entry.
+ @param[in] anEntity The entity that is, or holds, the item.
+ @param[in] aPort The entry, or @c NULL if the item is the heading of the entity.
+ @return The item for the entity heading or entry. */
+static FlyweightItem
+makeFlyweightItem(ChannelContainer * anEntity,
+                  ChannelEntry *     aPort)
+{
+    FlyweightItem result;
+
+    result._container = anEntity;
+    result._entry = aPort;
+    if (aPort)
+    {
+        result._bounds = aPort->getBounds() + anEntity->getPosition();
+    }
+    else
+    {
+        result._bounds = anEntity->getBounds();
+    }
+    return result;
+} // makeFlyweightItem
+
+/*! @brief Return the title to be displayed for a group.
+ @param[in] key The value shared by the members of the group.
+ @param[in] mode How the entities are grouped.
+ @return The title to be displayed for the group. */
+static String
+getClusterTitle(const YarpString & key,
+                const ClusterMode  mode)
+{
+    String result(key.c_str());
+
+    if (kClusterModeByAddress == mode)
+    {
+        result = String("Host ") + result;
+    }
+    return result;
+} // getClusterTitle
+
 #if defined(__APPLE__)
 # pragma mark Class methods
 #endif // defined(__APPLE__)
@@ -128,13 +267,24 @@ static const int kInitialPanelWidth = 1024;
 EntitiesPanel::EntitiesPanel(ContentPanel * theContainer,
                              const int      startingWidth,
                              const int      startingHeight) :
-    inherited(), _knownPorts(), _knownEntities(), _defaultBoldFont(), _defaultNormalFont(),
-    _firstAddPoint(NULL), _firstRemovePoint(NULL), _container(theContainer),
-    _dragConnectionActive(false), _dragIsForced(false)
+    inherited(), _knownPorts(), _knownEntities(), _clusters(), _clusterConnections(),
+    _flyweightItems(), _flyweightIndex(), _activitySampler(), _anomalyDetector(),
+    _defaultBoldFont(), _defaultNormalFont(), _spatialIndex(), _trafficHeatMap(),
+    _hoverConnection(NULL, NULL), _pressOffset(), _firstAddPoint(NULL), _firstRemovePoint(NULL),
+    _connectionsLayer(), _connectionsLayerArea(), _container(theContainer),
+    _movingCluster(NULL), _movingEntity(NULL), _pressedContainer(NULL), _pressedEntry(NULL),
+    _zoomLevel(1), _clusterMode(kClusterModeNone),
+    _clusterConnectionsAreStale(true), _clustersAreStale(false), _connectionsLayerIsStale(true),
+    _drawEntitiesDirectly(false), _dragConnectionActive(false), _dragIsForced(false),
+    _flyweightItemsAreStale(true), _spatialIndexIsStale(true)
 {
     ODL_ENTER(); //####
+    _activitySampler = new ActivitySampler(*this);
+    _anomalyDetector = new AnomalyDetector(*this);
     _defaultBoldFont = new Font(kFontName, FormField::kFontSize - 1, Font::bold);
     _defaultNormalFont = new Font(kFontName, FormField::kFontSize - 1, Font::plain);
+    _spatialIndex = new SpatialIndex(kSpatialIndexCellSize);
+    _trafficHeatMap = new TrafficHeatMap(*this);
     setSize(startingWidth ? startingWidth : kInitialPanelWidth,
             startingHeight ? startingHeight : kInitialPanelHeight);
     setVisible(true);
@@ -144,9 +294,14 @@ EntitiesPanel::EntitiesPanel(ContentPanel * theContainer,
 EntitiesPanel::~EntitiesPanel(void)
 {
     ODL_OBJENTER(); //####
+    // The sampler refers to the channels, so it has to stop before they are discarded.
+    _activitySampler = NULL;
     clearOutData();
     _defaultBoldFont = NULL;
     _defaultNormalFont = NULL;
+    _spatialIndex = NULL;
+    _anomalyDetector = NULL;
+    _trafficHeatMap = NULL;
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::~EntitiesPanel
 
@@ -165,7 +320,14 @@ EntitiesPanel::addEntity(ChannelContainer * anEntity)
     Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
     std::cerr << buffer1 << " " << buffer2 << " Adding entity " << anEntity->getName() << std::endl;
     _knownEntities.push_back(anEntity);
-    addChildComponent(anEntity);
+    // When the panel draws the entities itself, they aren't attached to it.
+    if (! _drawEntitiesDirectly)
+    {
+        addChildComponent(anEntity);
+    }
+    invalidateSpatialIndex();
+    // The new entity might belong to a group.
+    _clustersAreStale = (kClusterModeNone != _clusterMode);
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::addEntity
 
@@ -180,8 +342,9 @@ EntitiesPanel::adjustSize(const bool andRepaint)
     if (within)
     {
         ODL_LOG("(within)"); //####
-        int  outerW = within->getMaximumVisibleWidth();
-        int  outerH = within->getMaximumVisibleHeight();
+        // When zoomed out, the visible area covers more of the panel.
+        int  outerW = static_cast<int>(within->getMaximumVisibleWidth() / _zoomLevel);
+        int  outerH = static_cast<int>(within->getMaximumVisibleHeight() / _zoomLevel);
         int  outerL = within->getViewPositionX();
         int  outerT = within->getViewPositionY();
         int  minX = -1;
@@ -228,6 +391,21 @@ EntitiesPanel::adjustSize(const bool andRepaint)
         if (haveValues)
         {
             ODL_LOG("(haveValues)"); //####
+            // A collapsed group can be dragged away from its members.
+            for (ClusterList::const_iterator it(_clusters.begin()); _clusters.end() != it; ++it)
+            {
+                EntityCluster * aCluster = *it;
+
+                if (aCluster && aCluster->isVisible())
+                {
+                    juce::Rectangle<int> clusterBounds(aCluster->getBounds());
+
+                    minX = jmin(minX, clusterBounds.getX());
+                    maxX = jmax(maxX, clusterBounds.getRight());
+                    minY = jmin(minY, clusterBounds.getY());
+                    maxY = jmax(maxY, clusterBounds.getBottom());
+                }
+            }
             ODL_I4("minX = ", minX, "maxX = ", maxX, "minY = ", minY, "maxY = ", maxY); //####
             juce::Rectangle<int> oldBounds(getBounds());
             int                  minLeft = jmin(0, minX);
@@ -297,6 +475,34 @@ EntitiesPanel::adjustSize(const bool andRepaint)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::adjustSize
 
+void
+EntitiesPanel::beginMovingCluster(EntityCluster * aCluster)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("aCluster = ", aCluster); //####
+    if (aCluster != _movingCluster)
+    {
+        // The combined connections of the group must be removed from the cached image.
+        _movingCluster = aCluster;
+        _connectionsLayerIsStale = true;
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::beginMovingCluster
+
+void
+EntitiesPanel::beginMovingEntity(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    if (anEntity != _movingEntity)
+    {
+        // The connections of the entity must be removed from the cached image.
+        _movingEntity = anEntity;
+        _connectionsLayerIsStale = true;
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::beginMovingEntity
+
 void
 EntitiesPanel::clearAllNewlyCreatedFlags(void)
 {
@@ -357,43 +563,180 @@ EntitiesPanel::clearMarkers(void)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::clearMarkers
 
-#if defined(USE_OGDF_POSITIONING_)
 void
-EntitiesPanel::clearNodeValues(void)
+EntitiesPanel::clearOutData(void)
 {
     ODL_OBJENTER(); //####
+    // The groups refer to their members, so they must be released first.
+    _movingCluster = NULL;
+    for (ClusterList::const_iterator it(_clusters.begin()); _clusters.end() != it; ++it)
+    {
+        EntityCluster * aCluster = *it;
+
+        if (aCluster)
+        {
+            delete aCluster;
+        }
+    }
+    _clusters.clear();
+    _clusterConnections.clear();
     for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
     {
         ChannelContainer * anEntity = *it;
 
         if (anEntity)
         {
-            anEntity->setNode(NULL);
+            delete anEntity;
         }
     }
+    removeAllChildren();
+    _knownPorts.clear();
+    _knownEntities.clear();
+    _movingEntity = NULL;
+    _pressedContainer = NULL;
+    _pressedEntry = NULL;
+    invalidateSpatialIndex();
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::clearOutData
+
+void
+EntitiesPanel::clearSelection(void)
+{
+    ODL_OBJENTER(); //####
+    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
 
+        if (anEntity && anEntity->isSelected())
+        {
+            anEntity->deselect();
+            anEntity->repaint();
+        }
+    }
+    repaint();
     ODL_OBJEXIT(); //####
-} // EntitiesPanel::clearNodeValues
-#endif // defined(USE_OGDF_POSITIONING_)
+} // EntitiesPanel::clearSelection
 
 void
-EntitiesPanel::clearOutData(void)
+EntitiesPanel::clusterMoved(EntityCluster * aCluster)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("aCluster = ", aCluster); //####
+    // The combined connections of a group being dragged are drawn over the cached image.
+    if (aCluster != _movingCluster)
+    {
+        _connectionsLayerIsStale = true;
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::clusterMoved
+
+void
+EntitiesPanel::collapseCluster(EntityCluster * aCluster)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("aCluster = ", aCluster); //####
+    if (aCluster && (! aCluster->isCollapsed()))
+    {
+        const ContainerList & members = aCluster->getMembers();
+        juce::Rectangle<int>  membersArea;
+        bool                  haveArea = false;
+
+        for (ContainerList::const_iterator it(members.begin()); members.end() != it; ++it)
+        {
+            ChannelContainer * anEntity = *it;
+
+            if (anEntity)
+            {
+                // Entities that haven't been placed yet don't have a meaningful position.
+                if (anEntity->isVisible() && (! anEntity->isNew()))
+                {
+                    if (haveArea)
+                    {
+                        membersArea = membersArea.getUnion(anEntity->getBounds());
+                    }
+                    else
+                    {
+                        membersArea = anEntity->getBounds();
+                        haveArea = true;
+                    }
+                }
+                anEntity->setVisible(false);
+            }
+        }
+        if (! haveArea)
+        {
+            membersArea = getVisiblePanelArea().getSmallestIntegerContainer();
+        }
+        aCluster->setCentrePosition(membersArea.getCentreX(), membersArea.getCentreY());
+        aCluster->setCollapsed(true);
+        _clusterConnectionsAreStale = _connectionsLayerIsStale = true;
+        if (_container)
+        {
+            // The selected entity might no longer be visible.
+            _container->setChannelOfInterest(NULL);
+            _container->setContainerOfInterest(NULL);
+        }
+        repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::collapseCluster
+
+void
+EntitiesPanel::countVisibleItems(TimingSample & sample)
 {
     ODL_OBJENTER(); //####
+    ODL_P1("sample = ", &sample); //####
+    juce::Rectangle<float> visibleArea(getVisiblePanelArea());
+
+    sample._entitiesDrawn = sample._entitiesCulled = 0;
+    sample._connectionsDrawn = sample._connectionsCulled = 0;
     for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
     {
         ChannelContainer * anEntity = *it;
 
         if (anEntity)
         {
-            delete anEntity;
+            juce::Rectangle<float> entityBounds(anEntity->getBounds().toFloat());
+
+            if (anEntity->isVisible() && visibleArea.intersects(entityBounds) &&
+                (! isTooSmallToSee(entityBounds)))
+            {
+                ++sample._entitiesDrawn;
+            }
+            else
+            {
+                ++sample._entitiesCulled;
+            }
+            for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+            {
+                ChannelEntry * aPort = anEntity->getPort(ii);
+
+                if (aPort)
+                {
+                    const ChannelConnections & outputs(aPort->getOutputConnections());
+
+                    for (ChannelConnections::const_iterator walker(outputs.begin());
+                         outputs.end() != walker; ++walker)
+                    {
+                        ChannelEntry * otherPort = walker->_otherChannel;
+
+                        if (otherPort && anEntity->isVisible() &&
+                            otherPort->getParent()->isVisible() &&
+                            visibleArea.intersects(aPort->getConnectionBounds(otherPort)))
+                        {
+                            ++sample._connectionsDrawn;
+                        }
+                        else
+                        {
+                            ++sample._connectionsCulled;
+                        }
+                    }
+                }
+            }
         }
     }
-    removeAllChildren();
-    _knownPorts.clear();
-    _knownEntities.clear();
     ODL_OBJEXIT(); //####
-} // EntitiesPanel::clearOutData
+} // EntitiesPanel::countVisibleItems
 
 void
 EntitiesPanel::displayAndProcessPopupMenu(void)
@@ -407,6 +750,10 @@ EntitiesPanel::displayAndProcessPopupMenu(void)
         mm.setLookAndFeel(&getLookAndFeel());
         _container->setUpViewMenu(mm);
         mm.addSeparator();
+        mm.addCommandItem(commandManager, ManagerWindow::kCommandSelectMatchingServices);
+        mm.addCommandItem(commandManager, ManagerWindow::kCommandEnableSelectedMetrics);
+        mm.addCommandItem(commandManager, ManagerWindow::kCommandDisableSelectedMetrics);
+        mm.addSeparator();
         mm.addCommandItem(commandManager, ManagerWindow::kCommandLaunchRegistryService);
         mm.addCommandItem(commandManager, ManagerWindow::kCommandLaunchExecutables);
         // Note that all the menu items are commands, so they are handled by the content panel.
@@ -415,21 +762,119 @@ EntitiesPanel::displayAndProcessPopupMenu(void)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::displayAndProcessPopupMenu
 
+void
+EntitiesPanel::drawClusterConnections(Graphics & gg,
+                                      const bool forMovingEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    ODL_B1("forMovingEntity = ", forMovingEntity); //####
+    bool                   detailVisible = isDetailVisible();
+    juce::Rectangle<float> clipArea(gg.getClipBounds().toFloat());
+
+    gg.setColour(kClusterConnectionColour);
+    gg.setFont(*_defaultBoldFont);
+    for (ClusterConnectionMap::const_iterator walker(_clusterConnections.begin());
+         _clusterConnections.end() != walker; ++walker)
+    {
+        Component * firstEnd = walker->first.first;
+        Component * secondEnd = walker->first.second;
+        bool        isMoving = ((_movingEntity && ((firstEnd == _movingEntity) ||
+                                                   (secondEnd == _movingEntity))) ||
+                                (_movingCluster && ((firstEnd == _movingCluster) ||
+                                                    (secondEnd == _movingCluster))));
+
+        if (forMovingEntity == isMoving)
+        {
+            Line<float> aLine(firstEnd->getBounds().getCentre().toFloat(),
+                              secondEnd->getBounds().getCentre().toFloat());
+
+            if (clipArea.intersects(juce::Rectangle<float>(aLine.getStart(), aLine.getEnd())
+                                    .expanded(kMaximumClusterConnectionWidth)))
+            {
+                if (detailVisible)
+                {
+                    // The width of the line reflects the number of connections that it represents.
+                    float                  lineWidth =
+                                    jmin(kMaximumClusterConnectionWidth,
+                                         1 + log(static_cast<float>(walker->second)));
+                    String                 countText(walker->second);
+                    Position               midPoint(aLine.getPointAlongLineProportionally(0.5));
+                    float                  textWidth =
+                                        _defaultBoldFont->getStringWidthFloat(countText + " ");
+                    float                  textHeight = _defaultBoldFont->getHeight();
+                    juce::Rectangle<float> textArea(midPoint.x - (textWidth / 2),
+                                                    midPoint.y - (textHeight / 2), textWidth,
+                                                    textHeight);
+
+                    gg.drawLine(aLine, lineWidth);
+                    gg.drawText(countText, textArea, Justification::centred, false);
+                }
+                else
+                {
+                    // A line this wide in the panel is one pixel wide on the screen.
+                    gg.drawLine(aLine, 1 / _zoomLevel);
+                }
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::drawClusterConnections
+
 void
 EntitiesPanel::drawConnections(Graphics & gg)
 {
     ODL_OBJENTER(); //####
     ODL_P1("gg = ", &gg); //####
-    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
+    ConnectionEndsSet      liveConnections;
+    juce::Rectangle<float> clipArea(gg.getClipBounds().toFloat());
+    juce::Rectangle<float> visibleArea(getVisiblePanelArea());
+
+    if (_spatialIndexIsStale)
     {
-        ChannelContainer * anEntity = *it;
+        rebuildSpatialIndex();
+    }
+    if (_clusterConnectionsAreStale)
+    {
+        rebuildClusterConnections();
+    }
+    // The cached image extends past the visible area, so that scrolling a short distance doesn't
+    // require it to be redrawn.
+    if (_connectionsLayerIsStale || (! _connectionsLayerArea.contains(visibleArea)))
+    {
+        renderConnectionsLayer(visibleArea.expanded(visibleArea.getWidth() * kLayerMargin,
+                                                    visibleArea.getHeight() * kLayerMargin));
+    }
+    if (_connectionsLayer.isValid())
+    {
+        Position layerOrigin(_connectionsLayerArea.getPosition());
 
-        if (anEntity)
+        gg.drawImageTransformed(_connectionsLayer,
+                                AffineTransform::scale(1 / _zoomLevel).translated(layerOrigin));
+    }
+    // The connections of the entity being dragged change with every step, and the highlighted
+    // connection is drawn differently, so these are drawn over the cached image.
+    if (_movingEntity)
+    {
+        getConnectionsOfEntity(_movingEntity, liveConnections);
+    }
+    if (_hoverConnection.first && _hoverConnection.second)
+    {
+        liveConnections.insert(_hoverConnection);
+    }
+    for (ConnectionEndsSet::const_iterator walker(liveConnections.begin());
+         liveConnections.end() != walker; ++walker)
+    {
+        if (clipArea.intersects(walker->first->getConnectionBounds(walker->second)))
         {
-            anEntity->drawOutgoingConnections(gg);
+            drawOneConnection(gg, *walker, _hoverConnection == *walker);
         }
     }
-    if (_dragConnectionActive && _firstAddPoint)
+    if (_movingEntity || _movingCluster)
+    {
+        drawClusterConnections(gg, true);
+    }
+    if (isDetailVisible() && _dragConnectionActive && _firstAddPoint)
     {
         _firstAddPoint->drawDragLine(gg, _dragPosition, _firstAddPoint->wasUdpConnectionRequest(),
                                      _dragIsForced);
@@ -437,6 +882,117 @@ EntitiesPanel::drawConnections(Graphics & gg)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::drawConnections
 
+void
+EntitiesPanel::drawEntities(Graphics & gg)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    juce::Rectangle<int> clipArea(gg.getClipBounds());
+
+    if (_flyweightItemsAreStale)
+    {
+        rebuildFlyweightItems();
+    }
+    // The items are in the order that the entities were added, so later entities are drawn over
+    // earlier ones, as they would be if they were components. Items that would cover less than a
+    // pixel are left out; an entity fills the space behind its entries.
+    for (FlyweightItems::const_iterator walker(_flyweightItems.begin());
+         _flyweightItems.end() != walker; ++walker)
+    {
+        ChannelContainer * anEntity = walker->_container;
+
+        if (anEntity && anEntity->isVisible() && clipArea.intersects(walker->_bounds) &&
+            (! isTooSmallToSee(walker->_bounds.toFloat())))
+        {
+            if (walker->_entry)
+            {
+                walker->_entry->drawContent(gg, walker->_bounds.toFloat());
+            }
+            else
+            {
+                anEntity->drawContent(gg, walker->_bounds);
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::drawEntities
+
+void
+EntitiesPanel::drawOneConnection(Graphics &             gg,
+                                 const ConnectionEnds & ends,
+                                 const bool             highlighted)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("gg = ", &gg, "ends = ", &ends); //####
+    ODL_B1("highlighted = ", highlighted); //####
+    if (isDetailVisible())
+    {
+        ends.first->drawOutgoingConnection(gg, ends.second, highlighted);
+    }
+    else
+    {
+        // A line this wide in the panel is one pixel wide on the screen.
+        ends.first->drawSimplifiedConnection(gg, ends.second, 1 / _zoomLevel);
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::drawOneConnection
+
+void
+EntitiesPanel::endMovingCluster(void)
+{
+    ODL_OBJENTER(); //####
+    if (_movingCluster)
+    {
+        juce::Rectangle<float> dirtyArea(getClusterDrawingArea(_movingCluster));
+
+        // The combined connections of the group must be returned to the cached image.
+        _movingCluster = NULL;
+        _connectionsLayerIsStale = true;
+        repaint(dirtyArea.getSmallestIntegerContainer());
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::endMovingCluster
+
+void
+EntitiesPanel::endMovingEntity(void)
+{
+    ODL_OBJENTER(); //####
+    if (_movingEntity)
+    {
+        if (_container)
+        {
+            _container->rememberPositionOfEntity(_movingEntity);
+            _container->scheduleEntityPositionSave();
+        }
+        // The connections of the entity must be returned to the cached image.
+        _movingEntity = NULL;
+        _connectionsLayerIsStale = true;
+        repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::endMovingEntity
+
+void
+EntitiesPanel::expandCluster(EntityCluster * aCluster)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("aCluster = ", aCluster); //####
+    if (aCluster && aCluster->isCollapsed())
+    {
+        ContainerList shown;
+
+        openCluster(aCluster, shown);
+        // Only the members of the group are laid out; everything else stays where it is.
+        if (_container)
+        {
+            _container->layOutEntities(shown);
+        }
+        adjustSize(false);
+        repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::expandCluster
+
 ChannelContainer *
 EntitiesPanel::findKnownEntity(const YarpString & name)
 {
@@ -515,17 +1071,17 @@ EntitiesPanel::forgetPort(ChannelEntry * aPort)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::forgetPort
 
-ChannelContainer *
-EntitiesPanel::getEntity(const size_t index)
+EntityCluster *
+EntitiesPanel::getCluster(const size_t index)
 const
 {
     ODL_OBJENTER(); //####
     ODL_I1("index = ", index); //####
-    ChannelContainer * result;
+    EntityCluster * result;
 
-    if (_knownEntities.size() > index)
+    if (_clusters.size() > index)
     {
-        result = _knownEntities.at(index);
+        result = _clusters.at(index);
     }
     else
     {
@@ -533,31 +1089,169 @@ const
     }
     ODL_OBJEXIT_P(result); //####
     return result;
-} // EntitiesPanel::getEntity
+} // EntitiesPanel::getCluster
 
-size_t
-EntitiesPanel::getNumberOfEntities(void)
-const
+juce::Rectangle<float>
+EntitiesPanel::getClusterDrawingArea(EntityCluster * aCluster)
 {
     ODL_OBJENTER(); //####
-    size_t result = _knownEntities.size();
+    ODL_P1("aCluster = ", aCluster); //####
+    juce::Rectangle<float> result;
 
-    ODL_OBJEXIT_I(result); //####
+    if (aCluster)
+    {
+        // A line this wide in the panel is one pixel wide on the screen.
+        float lineMargin = jmax(kMaximumClusterConnectionWidth, 1 / _zoomLevel);
+
+        if (_clusterConnectionsAreStale)
+        {
+            rebuildClusterConnections();
+        }
+        result = aCluster->getBounds().toFloat();
+        for (ClusterConnectionMap::const_iterator walker(_clusterConnections.begin());
+             _clusterConnections.end() != walker; ++walker)
+        {
+            Component * firstEnd = walker->first.first;
+            Component * secondEnd = walker->first.second;
+
+            if ((firstEnd == aCluster) || (secondEnd == aCluster))
+            {
+                Line<float>            aLine(firstEnd->getBounds().getCentre().toFloat(),
+                                             secondEnd->getBounds().getCentre().toFloat());
+                String                 countText(walker->second);
+                Position               midPoint(aLine.getPointAlongLineProportionally(0.5));
+                float                  textWidth =
+                                        _defaultBoldFont->getStringWidthFloat(countText + " ");
+                float                  textHeight = _defaultBoldFont->getHeight();
+                juce::Rectangle<float> textArea(midPoint.x - (textWidth / 2),
+                                                midPoint.y - (textHeight / 2), textWidth,
+                                                textHeight);
+
+                result = result.getUnion(juce::Rectangle<float>(aLine.getStart(),
+                                                                aLine.getEnd())
+                                         .expanded(lineMargin)).getUnion(textArea);
+            }
+        }
+        result.expand(kDirtyRegionMargin, kDirtyRegionMargin);
+    }
+    ODL_OBJEXIT(); //####
     return result;
-} // EntitiesPanel::getNumberOfEntities
+} // EntitiesPanel::getClusterDrawingArea
 
-size_t
-EntitiesPanel::getNumberOfHiddenEntities(void)
+void
+EntitiesPanel::getConnectionsOfEntity(ChannelContainer *  anEntity,
+                                      ConnectionEndsSet & result)
 const
 {
     ODL_OBJENTER(); //####
-    size_t count = 0;
-
-    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
+    ODL_P2("anEntity = ", anEntity, "result = ", &result); //####
+    for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+    {
+        ChannelEntry * aPort = anEntity->getPort(ii);
+
+        if (aPort)
+        {
+            const ChannelConnections & inputs(aPort->getInputConnections());
+            const ChannelConnections & outputs(aPort->getOutputConnections());
+
+            for (ChannelConnections::const_iterator walker(inputs.begin());
+                 inputs.end() != walker; ++walker)
+            {
+                ChannelEntry * otherPort = walker->_otherChannel;
+
+                if (otherPort)
+                {
+                    result.insert(ConnectionEnds(otherPort, aPort));
+                }
+            }
+            for (ChannelConnections::const_iterator walker(outputs.begin());
+                 outputs.end() != walker; ++walker)
+            {
+                ChannelEntry * otherPort = walker->_otherChannel;
+
+                if (otherPort)
+                {
+                    result.insert(ConnectionEnds(aPort, otherPort));
+                }
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::getConnectionsOfEntity
+
+ChannelContainer *
+EntitiesPanel::getEntity(const size_t index)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("index = ", index); //####
+    ChannelContainer * result;
+
+    if (_knownEntities.size() > index)
+    {
+        result = _knownEntities.at(index);
+    }
+    else
+    {
+        result = NULL;
+    }
+    ODL_OBJEXIT_P(result); //####
+    return result;
+} // EntitiesPanel::getEntity
+
+juce::Rectangle<float>
+EntitiesPanel::getEntityDrawingArea(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    juce::Rectangle<float> result;
+
+    if (anEntity)
+    {
+        ConnectionEndsSet connections;
+
+        result = anEntity->getBounds().toFloat();
+        getConnectionsOfEntity(anEntity, connections);
+        for (ConnectionEndsSet::const_iterator walker(connections.begin());
+             connections.end() != walker; ++walker)
+        {
+            ChannelEntry * source = walker->first;
+
+            if (source)
+            {
+                result = result.getUnion(source->getConnectionDrawingBounds(walker->second));
+            }
+        }
+        result.expand(kDirtyRegionMargin, kDirtyRegionMargin);
+    }
+    ODL_OBJEXIT(); //####
+    return result;
+} // EntitiesPanel::getEntityDrawingArea
+
+size_t
+EntitiesPanel::getNumberOfEntities(void)
+const
+{
+    ODL_OBJENTER(); //####
+    size_t result = _knownEntities.size();
+
+    ODL_OBJEXIT_I(result); //####
+    return result;
+} // EntitiesPanel::getNumberOfEntities
+
+size_t
+EntitiesPanel::getNumberOfHiddenEntities(void)
+const
+{
+    ODL_OBJENTER(); //####
+    size_t count = 0;
+
+    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
     {
         ChannelContainer * anEntity = *it;
 
-        if (anEntity && (! anEntity->isVisible()))
+        // The members of a collapsed group aren't hidden, just displayed as the group.
+        if (anEntity && (! anEntity->isVisible()) && (! anEntity->isInCollapsedCluster()))
         {
             ++count;
         }
@@ -566,6 +1260,44 @@ const
     return count;
 } // EntitiesPanel::getNumberOfHiddenEntities
 
+void
+EntitiesPanel::getSelectedEntities(ContainerList & result)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("result = ", &result); //####
+    result.clear();
+    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
+
+        if (anEntity && anEntity->isSelected())
+        {
+            result.push_back(anEntity);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::getSelectedEntities
+
+juce::Rectangle<float>
+EntitiesPanel::getVisiblePanelArea(void)
+const
+{
+    ODL_OBJENTER(); //####
+    juce::Rectangle<float> result(getLocalBounds().toFloat());
+
+    if (_container)
+    {
+        // When zoomed out, the visible area covers more of the panel.
+        result = juce::Rectangle<float>(static_cast<float>(_container->getViewPositionX()),
+                                        static_cast<float>(_container->getViewPositionY()),
+                                        _container->getMaximumVisibleWidth() / _zoomLevel,
+                                        _container->getMaximumVisibleHeight() / _zoomLevel);
+    }
+    ODL_OBJEXIT(); //####
+    return result;
+} // EntitiesPanel::getVisiblePanelArea
+
 void
 EntitiesPanel::invalidateAllConnections(void)
 {
@@ -582,21 +1314,183 @@ EntitiesPanel::invalidateAllConnections(void)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::invalidateAllConnections
 
+void
+EntitiesPanel::invalidateConnectionsLayer(void)
+{
+    ODL_OBJENTER(); //####
+    _connectionsLayerIsStale = true;
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::invalidateConnectionsLayer
+
+void
+EntitiesPanel::invalidateSpatialIndex(void)
+{
+    ODL_OBJENTER(); //####
+    _spatialIndexIsStale = true;
+    _clusterConnectionsAreStale = true;
+    _connectionsLayerIsStale = true;
+    _flyweightItemsAreStale = true;
+    // The connection that the mouse was over might no longer exist.
+    _hoverConnection = ConnectionEnds(NULL, NULL);
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::invalidateSpatialIndex
+
+bool
+EntitiesPanel::locateConnection(const Position & location,
+                                ConnectionEnds & result)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("location = ", &location, "result = ", &result); //####
+    bool                   found = false;
+    ConnectionEndsList     candidates;
+    juce::Rectangle<float> area(location, location);
+
+    if (_spatialIndexIsStale)
+    {
+        rebuildSpatialIndex();
+    }
+    _spatialIndex->findConnections(area.expanded(kConnectionHitTolerance), candidates);
+    for (ConnectionEndsList::const_iterator walker(candidates.begin());
+         (! found) && (candidates.end() != walker); ++walker)
+    {
+        ChannelEntry * source = walker->first;
+
+        if (source && source->getParent()->isVisible() && walker->second->getParent()->isVisible()
+            && source->isNearConnection(walker->second, location, kConnectionHitTolerance))
+        {
+            result = *walker;
+            found = true;
+        }
+    }
+    ODL_OBJEXIT_B(found); //####
+    return found;
+} // EntitiesPanel::locateConnection
+
+bool
+EntitiesPanel::isDetailVisible(void)
+const
+{
+    ODL_OBJENTER(); //####
+    bool result = (kDetailZoomThreshold <= _zoomLevel);
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // EntitiesPanel::isDetailVisible
+
+bool
+EntitiesPanel::isTooSmallToSee(const juce::Rectangle<float> & area)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("area = ", &area); //####
+    bool result = ((1 > (area.getWidth() * _zoomLevel)) || (1 > (area.getHeight() * _zoomLevel)));
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // EntitiesPanel::isTooSmallToSee
+
+ChannelContainer *
+EntitiesPanel::locateContainer(const Position & location)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("location = ", &location); //####
+    ChannelContainer *     result = NULL;
+    ContainerList          candidates;
+    juce::Rectangle<float> area(location, location);
+    Point<int>             where(location.toInt());
+    size_t                 topmost = 0;
+
+    if (_spatialIndexIsStale)
+    {
+        rebuildSpatialIndex();
+    }
+    if (_flyweightItemsAreStale)
+    {
+        rebuildFlyweightItems();
+    }
+    // Only the containers that overlap the location need to be checked; where they overlap each
+    // other, the one drawn last is the one that is seen.
+    _spatialIndex->findContainers(area.expanded(1), candidates);
+    for (ContainerList::const_iterator it(candidates.begin()); candidates.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
+
+        if (anEntity && anEntity->isVisible())
+        {
+            FlyweightIndexMap::const_iterator match(_flyweightIndex.find(anEntity));
+
+            if (_flyweightIndex.end() != match)
+            {
+                size_t index = match->second;
+
+                const juce::Rectangle<int> & itemBounds = _flyweightItems[index]._bounds;
+
+                if (itemBounds.contains(where) && (! isTooSmallToSee(itemBounds.toFloat())) &&
+                    ((! result) || (topmost < index)))
+                {
+                    result = anEntity;
+                    topmost = index;
+                }
+            }
+        }
+    }
+    ODL_OBJEXIT_P(result); //####
+    return result;
+} // EntitiesPanel::locateContainer
+
 ChannelEntry *
 EntitiesPanel::locateEntry(const Position & location)
 const
 {
     ODL_OBJENTER(); //####
+    ODL_P1("location = ", &location); //####
     ChannelEntry * result = NULL;
 
-    for (ContainerList::const_iterator it(_knownEntities.begin());
-         (! result) && (_knownEntities.end() != it); ++it)
+    if (_drawEntitiesDirectly)
     {
-        ChannelContainer * anEntity = *it;
+        // The entries aren't attached to the panel, so the components can't do the hit testing.
+        ChannelContainer * anEntity = locateContainer(location);
 
         if (anEntity)
         {
-            result = anEntity->locateEntry(location);
+            // locateContainer() only returns entities that have a heading in the items.
+            FlyweightIndexMap::const_iterator match(_flyweightIndex.find(anEntity));
+            Point<int>                        where(location.toInt());
+
+            for (size_t ii = match->second + 1, mm = _flyweightItems.size();
+                 (! result) && (mm > ii) && (_flyweightItems[ii]._container == anEntity); ++ii)
+            {
+                const juce::Rectangle<int> & itemBounds = _flyweightItems[ii]._bounds;
+
+                if (itemBounds.contains(where) && (! isTooSmallToSee(itemBounds.toFloat())))
+                {
+                    result = _flyweightItems[ii]._entry;
+                }
+            }
+        }
+    }
+    else
+    {
+        ContainerList          candidates;
+        juce::Rectangle<float> area(location, location);
+
+        if (_spatialIndexIsStale)
+        {
+            rebuildSpatialIndex();
+        }
+        // Only the containers that overlap the location need to be checked; they are checked in
+        // the same order as the known entities.
+        _spatialIndex->findContainers(area.expanded(1), candidates);
+        for (ContainerList::const_iterator it(candidates.begin());
+             (! result) && (candidates.end() != it); ++it)
+        {
+            ChannelContainer * anEntity = *it;
+
+            if (anEntity && anEntity->isVisible())
+            {
+                result = anEntity->locateEntry(location);
+            }
         }
     }
     ODL_OBJEXIT_P(result); //####
@@ -617,10 +1511,40 @@ EntitiesPanel::mouseDown(const MouseEvent & ee)
 #endif // ! defined(ODL_ENABLE_LOGGING_)
     ODL_OBJENTER(); //####
     ODL_P1("ee = ", &ee); //####
-    _container->setChannelOfInterest(NULL);
-    _container->setContainerOfInterest(NULL);
-    rememberConnectionStartPoint();
-    clearMarkers();
+    _pressedContainer = NULL;
+    _pressedEntry = NULL;
+    if (_drawEntitiesDirectly)
+    {
+        _pressedContainer = locateContainer(ee.position);
+    }
+    if (_pressedContainer)
+    {
+        // Pass the event on, as if the entity or entry had been clicked directly.
+        _pressOffset = ee.position - _pressedContainer->getPositionInPanel();
+        _pressedEntry = locateEntry(ee.position);
+        if (_pressedEntry)
+        {
+            _pressedEntry->mouseDown(ee.withNewPosition(ee.position -
+                                                        _pressedEntry->getPositionInPanel()));
+        }
+        else
+        {
+            _pressedContainer->mouseDown(ee.withNewPosition(_pressOffset));
+        }
+    }
+    else
+    {
+        _container->setChannelOfInterest(NULL);
+        _container->setContainerOfInterest(NULL);
+        rememberConnectionStartPoint();
+        clearMarkers();
+        // Shift-clicking the background keeps the selection, as shift-clicking an entity adds to
+        // it.
+        if (! ee.mods.isShiftDown())
+        {
+            clearSelection();
+        }
+    }
     repaint();
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::mouseDown
@@ -628,48 +1552,371 @@ EntitiesPanel::mouseDown(const MouseEvent & ee)
 # pragma warning(pop)
 #endif // ! MAC_OR_LINUX_
 
-#if (! MAC_OR_LINUX_)
-# pragma warning(push)
-# pragma warning(disable: 4100)
-#endif // ! MAC_OR_LINUX_
 void
-EntitiesPanel::mouseUp(const MouseEvent & ee)
+EntitiesPanel::mouseDrag(const MouseEvent & ee)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("ee = ", &ee); //####
+    if (_pressedEntry && ee.mods.isAltDown())
+    {
+        _pressedEntry->mouseDrag(ee.withNewPosition(ee.position -
+                                                    _pressedEntry->getPositionInPanel()));
+    }
+    else if (_pressedContainer && (! ee.mods.isAltDown()) && (! ee.mods.isCommandDown()) &&
+             (! ee.mods.isPopupMenu()))
+    {
+        // Only the areas that the entity and its connections covered before and after the move
+        // need to be redrawn.
+        juce::Rectangle<float> dirtyArea(getEntityDrawingArea(_pressedContainer));
+        Position               newPosition(ee.position - _pressOffset);
+
+        beginMovingEntity(_pressedContainer);
+        _pressedContainer->setTopLeftPosition(jmax(0, static_cast<int>(newPosition.x)),
+                                              jmax(0, static_cast<int>(newPosition.y)));
+        dirtyArea = dirtyArea.getUnion(getEntityDrawingArea(_pressedContainer));
+        repaint(dirtyArea.getSmallestIntegerContainer());
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::mouseDrag
+
+#if (! MAC_OR_LINUX_)
+# pragma warning(push)
+# pragma warning(disable: 4100)
+#endif // ! MAC_OR_LINUX_
+void
+EntitiesPanel::mouseExit(const MouseEvent & ee)
+{
+#if (! defined(ODL_ENABLE_LOGGING_))
+# if MAC_OR_LINUX_
+#  pragma unused(ee)
+# endif // MAC_OR_LINUX_
+#endif // ! defined(ODL_ENABLE_LOGGING_)
+    ODL_OBJENTER(); //####
+    ODL_P1("ee = ", &ee); //####
+    setHoverConnection(ConnectionEnds(NULL, NULL));
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::mouseExit
+#if (! MAC_OR_LINUX_)
+# pragma warning(pop)
+#endif // ! MAC_OR_LINUX_
+
+void
+EntitiesPanel::mouseMove(const MouseEvent & ee)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("ee = ", &ee); //####
+    ConnectionEnds newHover(NULL, NULL);
+
+    // Entities are drawn over the connections, so a connection under an entity can't be pointed
+    // at.
+    if ((! _dragConnectionActive) &&
+        ((! _drawEntitiesDirectly) || (! locateContainer(ee.position))))
+    {
+        locateConnection(ee.position, newHover);
+    }
+    setHoverConnection(newHover);
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::mouseMove
+
+#if (! MAC_OR_LINUX_)
+# pragma warning(push)
+# pragma warning(disable: 4100)
+#endif // ! MAC_OR_LINUX_
+void
+EntitiesPanel::mouseUp(const MouseEvent & ee)
+{
+#if (! defined(ODL_ENABLE_LOGGING_))
+# if MAC_OR_LINUX_
+#  pragma unused(ee)
+# endif // MAC_OR_LINUX_
+#endif // ! defined(ODL_ENABLE_LOGGING_)
+    ODL_OBJENTER(); //####
+    ODL_P1("ee = ", &ee); //####
+    if (_pressedEntry)
+    {
+        _pressedEntry->mouseUp(ee.withNewPosition(ee.position -
+                                                  _pressedEntry->getPositionInPanel()));
+        repaint();
+    }
+    else if (_pressedContainer)
+    {
+        _pressedContainer->mouseUp(ee.withNewPosition(ee.position -
+                                                      _pressedContainer->getPositionInPanel()));
+        repaint();
+    }
+    else
+    {
+        rememberConnectionStartPoint();
+        clearMarkers();
+        if (ee.mods.isPopupMenu())
+        {
+            displayAndProcessPopupMenu();
+        }
+    }
+    _pressedContainer = NULL;
+    _pressedEntry = NULL;
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::mouseUp
+#if (! MAC_OR_LINUX_)
+# pragma warning(pop)
+#endif // ! MAC_OR_LINUX_
+
+void
+EntitiesPanel::mouseWheelMove(const MouseEvent &       ee,
+                              const MouseWheelDetails & wheel)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("ee = ", &ee, "wheel = ", &wheel); //####
+    if (ee.mods.isCommandDown())
+    {
+        setZoomLevel(_zoomLevel * (1 + (wheel.deltaY * kZoomWheelFactor)));
+    }
+    else
+    {
+        inherited::mouseWheelMove(ee, wheel);
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::mouseWheelMove
+
+void
+EntitiesPanel::openCluster(EntityCluster * aCluster,
+                           ContainerList & shown)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("aCluster = ", aCluster, "shown = ", &shown); //####
+    const ContainerList & members = aCluster->getMembers();
+    Position              centre(aCluster->getBounds().getCentre().toFloat());
+    float                 spread = (kClusterSpreadPerMember *
+                                    sqrt(static_cast<float>(members.size())));
+    Random                randomizer(Time::currentTimeMillis());
+
+    aCluster->setCollapsed(false);
+    for (ContainerList::const_iterator it(members.begin()); members.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
+
+        if (anEntity)
+        {
+            // Start the members close to where the group was, so that the layout keeps them
+            // together.
+            float angle = randomizer.nextFloat() * 2 * float_Pi;
+            float distance = randomizer.nextFloat() * spread;
+
+            anEntity->setCentrePosition(static_cast<int>(centre.x + (cos(angle) * distance)),
+                                        static_cast<int>(centre.y + (sin(angle) * distance)));
+            anEntity->setVisible(true);
+            anEntity->clearHidden();
+            shown.push_back(anEntity);
+        }
+    }
+    _clusterConnectionsAreStale = _connectionsLayerIsStale = true;
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::openCluster
+
+void
+EntitiesPanel::paint(Graphics & gg)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    drawConnections(gg);
+    if (_drawEntitiesDirectly)
+    {
+        drawEntities(gg);
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::paint
+
+void
+EntitiesPanel::recallPositions(void)
+{
+    ODL_OBJENTER(); //####
+    _container->recallEntityPositions();
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::recallPositions
+
+void
+EntitiesPanel::rebuildClusterConnections(void)
+{
+    ODL_OBJENTER(); //####
+    _clusterConnections.clear();
+    // Without any groups, all the connections are drawn individually.
+    if (! _clusters.empty())
+    {
+        for (ContainerList::const_iterator it(_knownEntities.begin());
+             _knownEntities.end() != it; ++it)
+        {
+            ChannelContainer * anEntity = *it;
+            Component *        thisEnd = NULL;
+
+            if (anEntity)
+            {
+                if (anEntity->isInCollapsedCluster())
+                {
+                    thisEnd = anEntity->getCluster();
+                }
+                else if (anEntity->isVisible())
+                {
+                    thisEnd = anEntity;
+                }
+            }
+            for (int ii = 0, mm = (thisEnd ? anEntity->getNumPorts() : 0); mm > ii; ++ii)
+            {
+                ChannelEntry * aPort = anEntity->getPort(ii);
+
+                if (aPort)
+                {
+                    const ChannelConnections & outputs(aPort->getOutputConnections());
+
+                    for (ChannelConnections::const_iterator walker(outputs.begin());
+                         outputs.end() != walker; ++walker)
+                    {
+                        ChannelEntry *     otherPort = walker->_otherChannel;
+                        ChannelContainer * otherEntity = (otherPort ? otherPort->getParent() :
+                                                          NULL);
+                        Component *        otherEnd = NULL;
+
+                        if (otherEntity)
+                        {
+                            if (otherEntity->isInCollapsedCluster())
+                            {
+                                otherEnd = otherEntity->getCluster();
+                            }
+                            else if (otherEntity->isVisible())
+                            {
+                                otherEnd = otherEntity;
+                            }
+                        }
+                        // Connections between visible entities are drawn individually, and
+                        // connections within a group aren't drawn at all.
+                        if (otherEnd && (thisEnd != otherEnd) &&
+                            ((thisEnd != anEntity) || (otherEnd != otherEntity)))
+                        {
+                            ClusterConnectionEnds ends((thisEnd < otherEnd) ? thisEnd : otherEnd,
+                                                       (thisEnd < otherEnd) ? otherEnd : thisEnd);
+
+                            ++_clusterConnections[ends];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    _clusterConnectionsAreStale = false;
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::rebuildClusterConnections
+
+void
+EntitiesPanel::rebuildFlyweightItems(void)
+const
 {
-#if (! defined(ODL_ENABLE_LOGGING_))
-# if MAC_OR_LINUX_
-#  pragma unused(ee)
-# endif // MAC_OR_LINUX_
-#endif // ! defined(ODL_ENABLE_LOGGING_)
     ODL_OBJENTER(); //####
-    ODL_P1("ee = ", &ee); //####
-    rememberConnectionStartPoint();
-    clearMarkers();
-    if (ee.mods.isPopupMenu())
+    _flyweightItems.clear();
+    _flyweightIndex.clear();
+    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
     {
-        displayAndProcessPopupMenu();
+        ChannelContainer * anEntity = *it;
+
+        if (anEntity)
+        {
+            _flyweightIndex[anEntity] = _flyweightItems.size();
+            _flyweightItems.push_back(makeFlyweightItem(anEntity, NULL));
+            for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+            {
+                ChannelEntry * aPort = anEntity->getPort(ii);
+
+                if (aPort)
+                {
+                    _flyweightItems.push_back(makeFlyweightItem(anEntity, aPort));
+                }
+            }
+        }
     }
+    _flyweightItemsAreStale = false;
     ODL_OBJEXIT(); //####
-} // EntitiesPanel::mouseUp
-#if (! MAC_OR_LINUX_)
-# pragma warning(pop)
-#endif // ! MAC_OR_LINUX_
+} // EntitiesPanel::rebuildFlyweightItems
 
 void
-EntitiesPanel::paint(Graphics & gg)
+EntitiesPanel::rebuildSpatialIndex(void)
+const
 {
     ODL_OBJENTER(); //####
-    ODL_P1("gg = ", &gg); //####
-    drawConnections(gg);
+    _spatialIndex->clear();
+    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
+
+        if (anEntity)
+        {
+            _spatialIndex->insertContainer(anEntity, anEntity->getBounds().toFloat());
+            for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+            {
+                ChannelEntry * aPort = anEntity->getPort(ii);
+
+                if (aPort)
+                {
+                    const ChannelConnections & outputs(aPort->getOutputConnections());
+
+                    for (ChannelConnections::const_iterator walker(outputs.begin());
+                         outputs.end() != walker; ++walker)
+                    {
+                        ChannelEntry * otherPort = walker->_otherChannel;
+
+                        if (otherPort)
+                        {
+                            _spatialIndex->insertConnection(ConnectionEnds(aPort, otherPort),
+                                                            aPort->getConnectionBounds(otherPort));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    _spatialIndexIsStale = false;
     ODL_OBJEXIT(); //####
-} // EntitiesPanel::paint
+} // EntitiesPanel::rebuildSpatialIndex
 
 void
-EntitiesPanel::recallPositions(void)
+EntitiesPanel::renderConnectionsLayer(const juce::Rectangle<float> & area)
 {
     ODL_OBJENTER(); //####
-    _container->recallEntityPositions();
+    ODL_P1("area = ", &area); //####
+    // The image is at screen resolution, rather than panel resolution.
+    int imageWidth = static_cast<int>(ceil(area.getWidth() * _zoomLevel));
+    int imageHeight = static_cast<int>(ceil(area.getHeight() * _zoomLevel));
+
+    _connectionsLayerArea = area;
+    _connectionsLayerIsStale = false;
+    if ((0 < imageWidth) && (0 < imageHeight))
+    {
+        ConnectionEndsSet  movingConnections;
+        ConnectionEndsList visibleConnections;
+
+        _connectionsLayer = Image(Image::ARGB, imageWidth, imageHeight, true);
+        Graphics layerContext(_connectionsLayer);
+
+        layerContext.addTransform(AffineTransform::translation(- area.getX(),
+                                                               - area.getY()).scaled(_zoomLevel));
+        if (_movingEntity)
+        {
+            getConnectionsOfEntity(_movingEntity, movingConnections);
+        }
+        _spatialIndex->findConnections(area, visibleConnections);
+        for (ConnectionEndsList::const_iterator walker(visibleConnections.begin());
+             visibleConnections.end() != walker; ++walker)
+        {
+            if (movingConnections.end() == movingConnections.find(*walker))
+            {
+                drawOneConnection(layerContext, *walker, false);
+            }
+        }
+        drawClusterConnections(layerContext, false);
+    }
+    else
+    {
+        _connectionsLayer = Image();
+    }
     ODL_OBJEXIT(); //####
-} // EntitiesPanel::recallPositions
+} // EntitiesPanel::renderConnectionsLayer
 
 void
 EntitiesPanel::rememberConnectionStartPoint(ChannelEntry * aPort,
@@ -720,6 +1967,46 @@ EntitiesPanel::rememberPositions(void)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::rememberPositions
 
+void
+EntitiesPanel::removeFromCluster(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    EntityCluster * aCluster = anEntity->getCluster();
+
+    if (aCluster)
+    {
+        aCluster->removeMember(anEntity);
+        // A group with a single member isn't worth keeping.
+        if (kMinimumClusterSize > aCluster->getNumMembers())
+        {
+            ContainerList         shown;
+            ClusterList::iterator match(std::find(_clusters.begin(), _clusters.end(), aCluster));
+
+            if (aCluster->isCollapsed())
+            {
+                openCluster(aCluster, shown);
+                if (_container)
+                {
+                    _container->layOutEntities(shown);
+                }
+            }
+            if (_clusters.end() != match)
+            {
+                _clusters.erase(match);
+            }
+            if (aCluster == _movingCluster)
+            {
+                _movingCluster = NULL;
+            }
+            removeChildComponent(aCluster);
+            delete aCluster;
+        }
+        _clusterConnectionsAreStale = _connectionsLayerIsStale = true;
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::removeFromCluster
+
 void
 EntitiesPanel::removeInvalidConnections(void)
 {
@@ -733,6 +2020,7 @@ EntitiesPanel::removeInvalidConnections(void)
             anEntity->removeInvalidConnections();
         }
     }
+    invalidateSpatialIndex();
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::removeInvalidConnections
 
@@ -768,6 +2056,19 @@ EntitiesPanel::removeUnvisitedEntities(void)
         {
             ODL_LOG("((_knownEntities.end() != walker) && anEntity)"); //####
             _container->rememberPositionOfEntity(anEntity);
+            // A press or a drag of the entity ends with it, but one of any other entity carries
+            // on, so that its position is still remembered when it is let go.
+            if (anEntity == _movingEntity)
+            {
+                _movingEntity = NULL;
+            }
+            if ((anEntity == _pressedContainer) ||
+                (_pressedEntry && (anEntity == _pressedEntry->getParent())))
+            {
+                _pressedContainer = NULL;
+                _pressedEntry = NULL;
+            }
+            removeFromCluster(anEntity);
             removeChildComponent(anEntity);
             delete anEntity;
             _knownEntities.erase(walker);
@@ -775,6 +2076,10 @@ EntitiesPanel::removeUnvisitedEntities(void)
         }
     }
     while (keepGoing);
+    if (didRemove)
+    {
+        invalidateSpatialIndex();
+    }
     ODL_OBJEXIT_B(didRemove); //####
     return didRemove;
 } // EntitiesPanel::removeUnvisitedEntities
@@ -788,6 +2093,84 @@ EntitiesPanel::resized(void)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::resized
 
+size_t
+EntitiesPanel::selectServicesMatching(const String & pattern)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("pattern = ", pattern.toStdString()); //####
+    size_t count = 0;
+
+    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
+
+        // Hidden entities are left alone, but the members of a collapsed group are not hidden.
+        if (anEntity && (anEntity->isVisible() || anEntity->isInCollapsedCluster()))
+        {
+            String servicePortName(anEntity->getServicePortName().c_str());
+
+            if (servicePortName.isNotEmpty() &&
+                (anEntity->getName().matchesWildcard(pattern, true) ||
+                 servicePortName.matchesWildcard(pattern, true)))
+            {
+                if (! anEntity->isSelected())
+                {
+                    anEntity->select();
+                    anEntity->repaint();
+                }
+                ++count;
+            }
+        }
+    }
+    repaint();
+    ODL_OBJEXIT_I(count); //####
+    return count;
+} // EntitiesPanel::selectServicesMatching
+
+void
+EntitiesPanel::setClusterMode(const ClusterMode newMode)
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("newMode = ", newMode); //####
+    if (newMode != _clusterMode)
+    {
+        ContainerList shown;
+
+        // Release the existing groups, showing their members where the groups were.
+        _movingCluster = NULL;
+        for (ClusterList::const_iterator it(_clusters.begin()); _clusters.end() != it; ++it)
+        {
+            EntityCluster * aCluster = *it;
+
+            if (aCluster)
+            {
+                if (aCluster->isCollapsed())
+                {
+                    openCluster(aCluster, shown);
+                }
+                removeChildComponent(aCluster);
+                delete aCluster;
+            }
+        }
+        _clusters.clear();
+        _clusterMode = newMode;
+        _clustersAreStale = true;
+        updateClusters();
+        // Any released members that weren't put into a new group are laid out together.
+        if (_container)
+        {
+            _container->layOutEntities(shown);
+        }
+        _clusterConnectionsAreStale = _connectionsLayerIsStale = true;
+        adjustSize(false);
+        if (_container)
+        {
+            _container->requestWindowRepaint();
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::setClusterMode
+
 void
 EntitiesPanel::setDragInfo(const Position position,
                            const bool     isForced)
@@ -803,6 +2186,96 @@ EntitiesPanel::setDragInfo(const Position position,
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::setDragInfo
 
+void
+EntitiesPanel::setDrawEntitiesDirectly(const bool drawDirectly)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("drawDirectly = ", drawDirectly); //####
+    if (drawDirectly != _drawEntitiesDirectly)
+    {
+        _drawEntitiesDirectly = drawDirectly;
+        for (ContainerList::const_iterator it(_knownEntities.begin());
+             _knownEntities.end() != it; ++it)
+        {
+            ChannelContainer * anEntity = *it;
+
+            if (anEntity)
+            {
+                if (_drawEntitiesDirectly)
+                {
+                    removeChildComponent(anEntity);
+                }
+                else
+                {
+                    addChildComponent(anEntity);
+                }
+            }
+        }
+        if (! _drawEntitiesDirectly)
+        {
+            // The groups must stay in front of the entities.
+            for (ClusterList::const_iterator it(_clusters.begin()); _clusters.end() != it; ++it)
+            {
+                EntityCluster * aCluster = *it;
+
+                if (aCluster)
+                {
+                    aCluster->toFront(false);
+                }
+            }
+        }
+        _flyweightItemsAreStale = true;
+        _pressedContainer = NULL;
+        _pressedEntry = NULL;
+        repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::setDrawEntitiesDirectly
+
+void
+EntitiesPanel::setHoverConnection(const ConnectionEnds & newHover)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("newHover = ", &newHover); //####
+    if (newHover != _hoverConnection)
+    {
+        // Only the areas covered by the previous and new connections need to be redrawn.
+        if (_hoverConnection.first && _hoverConnection.second)
+        {
+            repaint(_hoverConnection.first->getConnectionBounds(_hoverConnection.second)
+                    .getSmallestIntegerContainer());
+        }
+        if (newHover.first && newHover.second)
+        {
+            repaint(newHover.first->getConnectionBounds(newHover.second)
+                    .getSmallestIntegerContainer());
+        }
+        _hoverConnection = newHover;
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::setHoverConnection
+
+void
+EntitiesPanel::setZoomLevel(const float newLevel)
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("newLevel = ", newLevel); //####
+    float actualLevel = jlimit(kMinimumZoomLevel, kMaximumZoomLevel, newLevel);
+
+    if (actualLevel != _zoomLevel)
+    {
+        _zoomLevel = actualLevel;
+        _connectionsLayerIsStale = true;
+        setTransform(AffineTransform::scale(_zoomLevel));
+        adjustSize(false);
+        if (_container)
+        {
+            _container->requestWindowRepaint();
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::setZoomLevel
+
 void
 EntitiesPanel::skipScan(void)
 {
@@ -822,7 +2295,7 @@ EntitiesPanel::unhideEntities(void)
     {
         ChannelContainer * anEntity = *it;
 
-        if (anEntity && (! anEntity->isVisible()))
+        if (anEntity && (! anEntity->isVisible()) && (! anEntity->isInCollapsedCluster()))
         {
             anEntity->setHidden();
         }
@@ -831,6 +2304,167 @@ EntitiesPanel::unhideEntities(void)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::unhideEntities
 
+void
+EntitiesPanel::updateClusters(void)
+{
+    ODL_OBJENTER(); //####
+    if (_clustersAreStale && (kClusterModeNone != _clusterMode))
+    {
+        ClusterIndexMap existingClusters;
+        GroupingMap     ungroupedEntities;
+
+        for (ClusterList::const_iterator it(_clusters.begin()); _clusters.end() != it; ++it)
+        {
+            EntityCluster * aCluster = *it;
+
+            if (aCluster)
+            {
+                existingClusters[aCluster->getKey()] = aCluster;
+            }
+        }
+        for (ContainerList::const_iterator it(_knownEntities.begin());
+             _knownEntities.end() != it; ++it)
+        {
+            ChannelContainer * anEntity = *it;
+
+            if (anEntity && (! anEntity->getCluster()))
+            {
+                YarpString key(getClusterKey(anEntity, _clusterMode));
+
+                if (0 < key.length())
+                {
+                    ungroupedEntities[key].push_back(anEntity);
+                }
+            }
+        }
+        for (GroupingMap::const_iterator walker(ungroupedEntities.begin());
+             ungroupedEntities.end() != walker; ++walker)
+        {
+            const ContainerList &           members = walker->second;
+            ClusterIndexMap::const_iterator match(existingClusters.find(walker->first));
+
+            if (existingClusters.end() != match)
+            {
+                EntityCluster * aCluster = match->second;
+
+                for (ContainerList::const_iterator it(members.begin()); members.end() != it; ++it)
+                {
+                    aCluster->addMember(*it);
+                    if (aCluster->isCollapsed())
+                    {
+                        (*it)->setVisible(false);
+                    }
+                }
+                aCluster->repaint();
+            }
+            else if (kMinimumClusterSize <= members.size())
+            {
+                EntityCluster * aCluster = new EntityCluster(walker->first,
+                                                             getClusterTitle(walker->first,
+                                                                             _clusterMode),
+                                                             *this);
+
+                for (ContainerList::const_iterator it(members.begin()); members.end() != it; ++it)
+                {
+                    aCluster->addMember(*it);
+                }
+                _clusters.push_back(aCluster);
+                addChildComponent(aCluster);
+                // New groups start out collapsed.
+                collapseCluster(aCluster);
+            }
+        }
+        _clusterConnectionsAreStale = _connectionsLayerIsStale = true;
+    }
+    _clustersAreStale = false;
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::updateClusters
+
+void
+EntitiesPanel::updateFlyweightItems(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    if (anEntity && (! _flyweightItemsAreStale))
+    {
+        FlyweightIndexMap::const_iterator match(_flyweightIndex.find(anEntity));
+
+        if (_flyweightIndex.end() == match)
+        {
+            _flyweightItemsAreStale = true;
+        }
+        else
+        {
+            // The items can be updated in place, unless entries have been added to the entity.
+            size_t first = match->second;
+            size_t last = first + anEntity->getNumPorts();
+
+            if ((_flyweightItems.size() > last) && (_flyweightItems[last]._container == anEntity)
+                && ((_flyweightItems.size() == (last + 1)) ||
+                    (_flyweightItems[last + 1]._container != anEntity)))
+            {
+                for (size_t ii = first; last >= ii; ++ii)
+                {
+                    _flyweightItems[ii] = makeFlyweightItem(anEntity, _flyweightItems[ii]._entry);
+                }
+            }
+            else
+            {
+                _flyweightItemsAreStale = true;
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::updateFlyweightItems
+
+void
+EntitiesPanel::updateSpatialIndex(const ConnectionEndsList & connections)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("connections = ", &connections); //####
+    _connectionsLayerIsStale = true;
+    // If the index is going to be rebuilt anyways, there's nothing to do.
+    if (! _spatialIndexIsStale)
+    {
+        for (ConnectionEndsList::const_iterator walker(connections.begin());
+             connections.end() != walker; ++walker)
+        {
+            _spatialIndex->insertConnection(*walker,
+                                            walker->first->getConnectionBounds(walker->second));
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::updateSpatialIndex
+
+void
+EntitiesPanel::updateSpatialIndex(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    // Only the connections of an entity being dragged are drawn outside the cached image.
+    if (anEntity != _movingEntity)
+    {
+        _connectionsLayerIsStale = true;
+    }
+    // If the index is going to be rebuilt anyways, or the entity hasn't been added to the panel
+    // yet, there's nothing to do.
+    updateFlyweightItems(anEntity);
+    if (anEntity && (! _spatialIndexIsStale) && _spatialIndex->hasContainer(anEntity))
+    {
+        ConnectionEndsSet connections;
+
+        _spatialIndex->insertContainer(anEntity, anEntity->getBounds().toFloat());
+        getConnectionsOfEntity(anEntity, connections);
+        for (ConnectionEndsSet::const_iterator walker(connections.begin());
+             connections.end() != walker; ++walker)
+        {
+            _spatialIndex->insertConnection(*walker,
+                                            walker->first->getConnectionBounds(walker->second));
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::updateSpatialIndex
+
 #if defined(__APPLE__)
 # pragma mark Global functions
 #endif // defined(__APPLE__)
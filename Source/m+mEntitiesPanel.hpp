@@ -57,9 +57,14 @@
 
 namespace MPlusM_Manager
 {
+    class ActivitySampler;
+    class AnomalyDetector;
     class ChannelContainer;
     class ChannelEntry;
     class ContentPanel;
+    class EntityCluster;
+    class SpatialIndex;
+    class TrafficHeatMap;
 
     /*! @brief The entities layer of the main window of the application. */
     class EntitiesPanel : public Component
@@ -93,6 +98,18 @@ namespace MPlusM_Manager
         void
         addEntity(ChannelContainer * anEntity);
 
+        /*! @brief Record that a group is being dragged, so that its combined connections are
+         drawn separately from the cached connections.
+         @param[in] aCluster The group being dragged. */
+        void
+        beginMovingCluster(EntityCluster * aCluster);
+
+        /*! @brief Record that an entity is being dragged, so that its connections are drawn
+         separately from the cached connections.
+         @param[in] anEntity The entity being dragged. */
+        void
+        beginMovingEntity(ChannelContainer * anEntity);
+
         /*! @brief Recalculate size based on entities present.
          @param[in] andRepaint @c true if a repaint should be performed as well, and @c false if
          not. */
@@ -115,16 +132,44 @@ namespace MPlusM_Manager
         void
         clearMarkers(void);
 
-# if defined(USE_OGDF_POSITIONING_)
-        /*! @brief Clear any node values. */
-        void
-        clearNodeValues(void);
-# endif // defined(USE_OGDF_POSITIONING_)
-
         /*! @brief Release all data held by the panel. */
         void
         clearOutData(void);
 
+        /*! @brief Deselect all the selected entities. */
+        void
+        clearSelection(void);
+
+        /*! @brief Count the entities and connections that are inside and outside the visible area.
+         @param[in,out] sample The timing sample that receives the counts. */
+        void
+        countVisibleItems(TimingSample & sample);
+
+        /*! @brief Display a group in place of its members.
+         @param[in] aCluster The group to be collapsed. */
+        void
+        collapseCluster(EntityCluster * aCluster);
+
+        /*! @brief Note that a group has changed position, so that the cached connections are
+         redrawn if they include its combined connections.
+         @param[in] aCluster The group that was moved. */
+        void
+        clusterMoved(EntityCluster * aCluster);
+
+        /*! @brief Record that no group is being dragged. */
+        void
+        endMovingCluster(void);
+
+        /*! @brief Record that no entity is being dragged, arranging for the new position of the
+         entity that was being dragged to be saved. */
+        void
+        endMovingEntity(void);
+
+        /*! @brief Display the members of a group in place of the group, and lay out the members.
+         @param[in] aCluster The group to be expanded. */
+        void
+        expandCluster(EntityCluster * aCluster);
+
         /*! @brief Find an entity in the currently-displayed list by name.
          @param[in] name The name of the entity.
          @return @c NULL if the entity cannot be found and non-@c NULL if it is found. */
@@ -142,6 +187,22 @@ namespace MPlusM_Manager
         void
         forgetPort(ChannelEntry * aPort);
 
+        /*! @brief Return the sampler for the activity indicators of the channels.
+         @return The sampler for the activity indicators of the channels. */
+        inline ActivitySampler &
+        getActivitySampler(void)
+        {
+            return *_activitySampler;
+        } // getActivitySampler
+
+        /*! @brief Return the detector of anomalies in the metrics of the channels.
+         @return The detector of anomalies in the metrics of the channels. */
+        inline AnomalyDetector &
+        getAnomalyDetector(void)
+        {
+            return *_anomalyDetector;
+        } // getAnomalyDetector
+
         /*! @brief Return the font to be used for bold text.
          @return The font to be used for bold text. */
         inline Font &
@@ -150,6 +211,28 @@ namespace MPlusM_Manager
             return *_defaultBoldFont;
         } // getBoldFont
 
+        /*! @brief Return a group by index.
+         @param[in] index The zero-origin index of the group.
+         @return The group if the index is within range and @c NULL otherwise. */
+        EntityCluster *
+        getCluster(const size_t index)
+        const;
+
+        /*! @brief Return the area covered by the drawing of a group and its combined connections.
+         @param[in] aCluster The group of interest.
+         @return The area covered by the drawing of the group and its combined connections. */
+        juce::Rectangle<float>
+        getClusterDrawingArea(EntityCluster * aCluster);
+
+        /*! @brief Return how the entities are grouped.
+         @return How the entities are grouped. */
+        inline ClusterMode
+        getClusterMode(void)
+        const
+        {
+            return _clusterMode;
+        } // getClusterMode
+
         /*! @brief Return the container in which the panel is embedded.
          @return The container in which the panel is embedded. */
         inline ContentPanel *
@@ -166,6 +249,12 @@ namespace MPlusM_Manager
         getEntity(const size_t index)
         const;
 
+        /*! @brief Return the area covered by the drawing of an entity and all of its connections.
+         @param[in] anEntity The entity of interest.
+         @return The area covered by the drawing of the entity and its connections. */
+        juce::Rectangle<float>
+        getEntityDrawingArea(ChannelContainer * anEntity);
+
         /*! @brief Return the starting point for a connection being added.
          @return The starting point for a connection being added. */
         inline ChannelEntry *
@@ -192,6 +281,15 @@ namespace MPlusM_Manager
             return *_defaultNormalFont;
         } // getNormalFont
 
+        /*! @brief Return the number of groups.
+         @return The number of groups. */
+        inline size_t
+        getNumberOfClusters(void)
+        const
+        {
+            return _clusters.size();
+        } // getNumberOfClusters
+
         /*! @brief Return the number of entities.
          @return The number of entities. */
         size_t
@@ -204,10 +302,68 @@ namespace MPlusM_Manager
         getNumberOfHiddenEntities(void)
         const;
 
+        /*! @brief Return the selected entities.
+         @param[out] result The selected entities. */
+        void
+        getSelectedEntities(ContainerList & result)
+        const;
+
+        /*! @brief Return the colouring of the connections by their traffic.
+         @return The colouring of the connections by their traffic. */
+        inline TrafficHeatMap &
+        getTrafficHeatMap(void)
+        const
+        {
+            return *_trafficHeatMap;
+        } // getTrafficHeatMap
+
+        /*! @brief Return the scale at which the panel is displayed.
+         @return The scale at which the panel is displayed, where @c 1 is actual size. */
+        inline float
+        getZoomLevel(void)
+        const
+        {
+            return _zoomLevel;
+        } // getZoomLevel
+
         /*! @brief Mark all connections as invalid. */
         void
         invalidateAllConnections(void);
 
+        /*! @brief Mark the cached image of the connections as needing to be redrawn. */
+        void
+        invalidateConnectionsLayer(void);
+
+        /*! @brief Mark the spatial index as needing to be rebuilt, after entities or connections
+         have been added or removed. */
+        void
+        invalidateSpatialIndex(void);
+
+        /*! @brief Return @c true if the panel is displayed at a scale where text and the details of
+         connections are legible and @c false if only the outlines should be drawn.
+         @return @c true if details should be drawn and @c false otherwise. */
+        bool
+        isDetailVisible(void)
+        const;
+
+        /*! @brief Return @c true if an area of the panel would be less than one pixel across or
+         high on the screen at the current scale and @c false otherwise.
+         @param[in] area The area of interest, in panel coordinates.
+         @return @c true if the area is too small to be seen and @c false otherwise. */
+        bool
+        isTooSmallToSee(const juce::Rectangle<float> & area)
+        const;
+
+        /*! @brief Return @c true if the panel draws the entities itself and @c false if each entity
+         and entry is drawn by its own component.
+         @return @c true if the panel draws the entities itself and @c false otherwise. */
+        inline bool
+        isDrawingEntitiesDirectly(void)
+        const
+        {
+            return _drawEntitiesDirectly;
+        } // isDrawingEntitiesDirectly
+
         /*! @brief Return @c true if dragging a connection and @c false otherwise.
          @return @c true if dragging a connection and @c false otherwise. */
         inline bool
@@ -217,6 +373,14 @@ namespace MPlusM_Manager
             return _dragConnectionActive;
         } // isDragActive
 
+        /*! @brief Returns the connection passing near the given location, if it exists.
+         @param[in] location The coordinates to check.
+         @param[out] result The source and destination of the connection at the given location.
+         @return @c true if there is a connection at the given location and @c false otherwise. */
+        bool
+        locateConnection(const Position & location,
+                         ConnectionEnds & result);
+
         /*! @brief Returns an entry at the given location, if it exists.
          @param[in] location The coordinates to check.
          @return A pointer to the entry at the given location, or @c NULL if there is none. */
@@ -254,6 +418,17 @@ namespace MPlusM_Manager
         bool
         removeUnvisitedEntities(void);
 
+        /*! @brief Select the services whose names or service port names match a pattern.
+         @param[in] pattern The wildcard pattern to match against.
+         @return The number of services that were selected. */
+        size_t
+        selectServicesMatching(const String & pattern);
+
+        /*! @brief Change how the entities are grouped.
+         @param[in] newMode How the entities are to be grouped. */
+        void
+        setClusterMode(const ClusterMode newMode);
+
         /*! @brief Update the dragging information.
          @param[in] position The location of the dragging connection.
          @param[in] isForced @c true if the drag line should show a forced connection and @c false
@@ -262,6 +437,17 @@ namespace MPlusM_Manager
         setDragInfo(const Position position,
                     const bool     isForced);
 
+        /*! @brief Change whether the panel draws the entities itself.
+         @param[in] drawDirectly @c true if the panel is to draw the entities itself and @c false if
+         each entity and entry is to be drawn by its own component. */
+        void
+        setDrawEntitiesDirectly(const bool drawDirectly);
+
+        /*! @brief Change the scale at which the panel is displayed.
+         @param[in] newLevel The requested scale, where @c 1 is actual size. */
+        void
+        setZoomLevel(const float newLevel);
+
         /*! @brief Ignore the result of the next scan. */
         void
         skipScan(void);
@@ -270,6 +456,24 @@ namespace MPlusM_Manager
         void
         unhideEntities(void);
 
+        /*! @brief Put any entities that were added since the last update into groups. */
+        void
+        updateClusters(void);
+
+        /*! @brief Update the spatial index for connections whose bounds have changed, such as
+         when their thickness reflects their traffic.
+
+         Unlike invalidateSpatialIndex(), this doesn't disturb a drag or the highlighted
+         connection, since no entity or connection has gone away.
+         @param[in] connections The connections that have changed. */
+        void
+        updateSpatialIndex(const ConnectionEndsList & connections);
+
+        /*! @brief Update the spatial index for an entity that has been moved or resized.
+         @param[in] anEntity The entity that has changed. */
+        void
+        updateSpatialIndex(ChannelContainer * anEntity);
+
     protected :
 
     private :
@@ -278,30 +482,139 @@ namespace MPlusM_Manager
         void
         displayAndProcessPopupMenu(void);
 
+        /*! @brief Display the combined connections of the collapsed groups.
+         @param[in,out] gg The graphics context in which to draw.
+         @param[in] forMovingEntity @c true if only the connections of the entity being dragged are
+         to be drawn and @c false if only the other connections are to be drawn. */
+        void
+        drawClusterConnections(Graphics & gg,
+                               const bool forMovingEntity);
+
         /*! @brief Display the connections between containers.
          @param[in,out] gg The graphics context in which to draw. */
         void
         drawConnections(Graphics & gg);
 
+        /*! @brief Display the entities, when the panel draws them itself.
+         @param[in,out] gg The graphics context in which to draw. */
+        void
+        drawEntities(Graphics & gg);
+
+        /*! @brief Display a single connection, with the level of detail suited to the scale.
+         @param[in,out] gg The graphics context in which to draw.
+         @param[in] ends The source and destination of the connection.
+         @param[in] highlighted @c true if the connection is to be emphasized and @c false
+         otherwise. */
+        void
+        drawOneConnection(Graphics &             gg,
+                          const ConnectionEnds & ends,
+                          const bool             highlighted);
+
+        /*! @brief Collect the connections to and from the ports of an entity.
+         @param[in] anEntity The entity of interest.
+         @param[in,out] result The connections of the entity. */
+        void
+        getConnectionsOfEntity(ChannelContainer *  anEntity,
+                               ConnectionEndsSet & result)
+        const;
+
+        /*! @brief Return the area of the panel that is visible in the containing viewport.
+         @return The area of the panel that is visible. */
+        juce::Rectangle<float>
+        getVisiblePanelArea(void)
+        const;
+
+        /*! @brief Returns the visible entity at the given location, if it exists.
+         @param[in] location The coordinates to check.
+         @return A pointer to the entity at the given location, or @c NULL if there is none. */
+        ChannelContainer *
+        locateContainer(const Position & location)
+        const;
+
         /*! @brief Called when a mouse button is pressed.
          @param[in] ee Details about the position and status of the mouse event. */
         virtual void
         mouseDown(const MouseEvent & ee);
 
+        /*! @brief Called when the mouse is moved while a button is held down.
+         @param[in] ee Details about the position and status of the mouse event. */
+        virtual void
+        mouseDrag(const MouseEvent & ee);
+
+        /*! @brief Called when the mouse leaves the component.
+         @param[in] ee Details about the position and status of the mouse event. */
+        virtual void
+        mouseExit(const MouseEvent & ee);
+
+        /*! @brief Called when the mouse moves over the component with no buttons pressed.
+         @param[in] ee Details about the position and status of the mouse event. */
+        virtual void
+        mouseMove(const MouseEvent & ee);
+
         /*! @brief Called when a mouse button is released.
          @param[in] ee Details about the position and status of the mouse event. */
         virtual void
         mouseUp(const MouseEvent& ee);
 
+        /*! @brief Called when the mouse wheel is moved.
+         @param[in] ee Details about the position and status of the mouse event.
+         @param[in] wheel Details about the mouse wheel movement. */
+        virtual void
+        mouseWheelMove(const MouseEvent &       ee,
+                       const MouseWheelDetails & wheel);
+
+        /*! @brief Display the members of a group in place of the group, without laying them out.
+         @param[in] aCluster The group to be expanded.
+         @param[in,out] shown The members that were displayed. */
+        void
+        openCluster(EntityCluster * aCluster,
+                    ContainerList & shown);
+
         /*! @brief Draw the content of the component.
          @param[in,out] gg The graphics context in which to draw. */
         virtual void
         paint(Graphics & gg);
 
+        /*! @brief Recalculate the combined connections of the collapsed groups. */
+        void
+        rebuildClusterConnections(void);
+
+        /*! @brief Rebuild the set of items that are drawn by the panel from the known entities. */
+        void
+        rebuildFlyweightItems(void)
+        const;
+
+        /*! @brief Rebuild the spatial index from the known entities and their connections. */
+        void
+        rebuildSpatialIndex(void)
+        const;
+
+        /*! @brief Draw the connections that are not attached to a moving entity into the cached
+         image of the connections.
+         @param[in] area The area of the panel to be covered by the image. */
+        void
+        renderConnectionsLayer(const juce::Rectangle<float> & area);
+
+        /*! @brief Remove an entity from its group, releasing the group if it is too small.
+         @param[in] anEntity The entity to be removed. */
+        void
+        removeFromCluster(ChannelContainer * anEntity);
+
         /*! @brief Called when the component size has been changed. */
         virtual void
         resized(void);
 
+        /*! @brief Change the connection that the mouse is over, repainting as needed.
+         @param[in] newHover The source and destination of the connection that the mouse is over,
+         or @c NULL values if the mouse is not over a connection. */
+        void
+        setHoverConnection(const ConnectionEnds & newHover);
+
+        /*! @brief Update the items that are drawn by the panel for an entity that has been moved.
+         @param[in] anEntity The entity that has changed. */
+        void
+        updateFlyweightItems(ChannelContainer * anEntity);
+
     public :
 
     protected :
@@ -314,15 +627,53 @@ namespace MPlusM_Manager
         /*! @brief A collection of known services and ports. */
         ContainerList _knownEntities;
 
+        /*! @brief The groups of entities. */
+        ClusterList _clusters;
+
+        /*! @brief The combined connections of the collapsed groups. */
+        ClusterConnectionMap _clusterConnections;
+
+        /*! @brief The entity headings and entries that are drawn by the panel itself; rebuilt on
+         demand, including by the hit tests. */
+        mutable FlyweightItems _flyweightItems;
+
+        /*! @brief The positions of the entity headings in the items drawn by the panel. */
+        mutable FlyweightIndexMap _flyweightIndex;
+
+        /*! @brief The sampler for the activity indicators of the channels. */
+        ScopedPointer<ActivitySampler> _activitySampler;
+
+        /*! @brief The detector of anomalies in the metrics of the channels. */
+        ScopedPointer<AnomalyDetector> _anomalyDetector;
+
         /*! @brief The bold font to be used. */
         ScopedPointer<Font> _defaultBoldFont;
 
         /*! @brief The normal font to be used. */
         ScopedPointer<Font> _defaultNormalFont;
 
+        /*! @brief The bounds of the entities and connections, for culling and hit testing; rebuilt
+         on demand, including by the hit tests. */
+        mutable ScopedPointer<SpatialIndex> _spatialIndex;
+
+        /*! @brief The colouring of the connections by their traffic. */
+        ScopedPointer<TrafficHeatMap> _trafficHeatMap;
+
+        /*! @brief The cached image of the connections that are not attached to a moving entity. */
+        Image _connectionsLayer;
+
+        /*! @brief The area of the panel covered by the cached image of the connections. */
+        juce::Rectangle<float> _connectionsLayerArea;
+
+        /*! @brief The connection that the mouse is over. */
+        ConnectionEnds _hoverConnection;
+
         /*! @brief The coordinates of the drag-connection operation. */
         Position _dragPosition;
 
+        /*! @brief The offset of the mouse from the top-left corner of the pressed entity. */
+        Position _pressOffset;
+
         /*! @brief The starting port for a connection being added. */
         ChannelEntry * _firstAddPoint;
 
@@ -332,21 +683,50 @@ namespace MPlusM_Manager
         /*! @brief The container in which the panel is embedded. */
         ContentPanel * _container;
 
+        /*! @brief The group that is being dragged. */
+        EntityCluster * _movingCluster;
+
+        /*! @brief The entity that is being dragged. */
+        ChannelContainer * _movingEntity;
+
+        /*! @brief The entity that was pressed, when the panel draws the entities itself. */
+        ChannelContainer * _pressedContainer;
+
+        /*! @brief The entry that was pressed, when the panel draws the entities itself. */
+        ChannelEntry * _pressedEntry;
+
+        /*! @brief The scale at which the panel is displayed. */
+        float _zoomLevel;
+
+        /*! @brief How the entities are grouped. */
+        ClusterMode _clusterMode;
+
+        /*! @brief @c true if the combined connections of the collapsed groups must be recalculated
+         before they are used. */
+        bool _clusterConnectionsAreStale;
+
+        /*! @brief @c true if entities have been added since the groups were last updated. */
+        bool _clustersAreStale;
+
+        /*! @brief @c true if the cached image of the connections must be redrawn before it is
+         used. */
+        bool _connectionsLayerIsStale;
+
+        /*! @brief @c true if the panel draws the entities itself and @c false if each entity and
+         entry is drawn by its own component. */
+        bool _drawEntitiesDirectly;
+
         /*! @brief @c true if a drag-connection operation is active. */
         bool _dragConnectionActive;
 
         /*! @brief @c true if the drag operation is for a forced connection. */
         bool _dragIsForced;
 
-# if defined(__APPLE__)
-#  pragma clang diagnostic push
-#  pragma clang diagnostic ignored "-Wunused-private-field"
-# endif // defined(__APPLE__)
-        /*! @brief Filler to pad to alignment boundary */
-        char _filler[7];
-# if defined(__APPLE__)
-#  pragma clang diagnostic pop
-# endif // defined(__APPLE__)
+        /*! @brief @c true if the items drawn by the panel must be rebuilt before they are used. */
+        mutable bool _flyweightItemsAreStale;
+
+        /*! @brief @c true if the spatial index must be rebuilt before it is used. */
+        mutable bool _spatialIndexIsStale;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EntitiesPanel)
 
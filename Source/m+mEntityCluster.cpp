@@ -0,0 +1,327 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mEntityCluster.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for a visible group of entities that share a host or a
+//              behaviour.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mEntityCluster.hpp"
+#include "m+mChannelContainer.hpp"
+#include "m+mEntitiesPanel.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for a visible group of entities that share a host or a behaviour. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The colour to be used for the body of the group. */
+static const Colour & kClusterBackgroundColour(Colours::darkslategrey);
+
+/*! @brief The colour to be used for the outline of the group. */
+static const Colour & kClusterOutlineColour(Colours::lightgrey);
+
+/*! @brief The colour to be used for text in the group. */
+static const Colour & kClusterTextColour(Colours::white);
+
+/*! @brief The radius of the corners of the group. */
+static const float kCornerSize = 6;
+
+/*! @brief The thickness of the outline of the group. */
+static const float kOutlineThickness = 2;
+
+/*! @brief The amount of space around the text being displayed. */
+static const float kTextInset = 6;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+EntityCluster::EntityCluster(const YarpString & key,
+                             const String &     title,
+                             EntitiesPanel &    owner) :
+    inherited(title), _members(), _key(key), _title(title), _owner(owner), _collapsed(false)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("key = ", key); //####
+    ODL_S1s("title = ", title.toStdString()); //####
+    updateSize();
+    setVisible(false);
+    ODL_EXIT_P(this); //####
+} // EntityCluster::EntityCluster
+
+EntityCluster::~EntityCluster(void)
+{
+    ODL_OBJENTER(); //####
+    // The members belong to the entities panel, so they are only detached from the group.
+    for (ContainerList::const_iterator it(_members.begin()); _members.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
+
+        if (anEntity && (this == anEntity->getCluster()))
+        {
+            anEntity->setCluster(NULL);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntityCluster::~EntityCluster
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+EntityCluster::addMember(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    if (anEntity)
+    {
+        _members.push_back(anEntity);
+        anEntity->setCluster(this);
+        updateSize();
+    }
+    ODL_OBJEXIT(); //####
+} // EntityCluster::addMember
+
+void
+EntityCluster::displayAndProcessPopupMenu(void)
+{
+    ODL_OBJENTER(); //####
+    PopupMenu mm;
+
+    mm.setLookAndFeel(&getLookAndFeel());
+    mm.addItem(kPopupExpandGroup, String("Expand the group"));
+    int result = mm.show();
+
+    switch (result)
+    {
+        case kPopupExpandGroup :
+            _owner.expandCluster(this);
+            break;
+
+        default :
+            break;
+
+    }
+    ODL_OBJEXIT(); //####
+} // EntityCluster::displayAndProcessPopupMenu
+
+#if (! MAC_OR_LINUX_)
+# pragma warning(push)
+# pragma warning(disable: 4100)
+#endif // ! MAC_OR_LINUX_
+void
+EntityCluster::mouseDoubleClick(const MouseEvent & ee)
+{
+#if (! defined(ODL_ENABLE_LOGGING_))
+# if MAC_OR_LINUX_
+#  pragma unused(ee)
+# endif // MAC_OR_LINUX_
+#endif // ! defined(ODL_ENABLE_LOGGING_)
+    ODL_OBJENTER(); //####
+    ODL_P1("ee = ", &ee); //####
+    _owner.expandCluster(this);
+    ODL_OBJEXIT(); //####
+} // EntityCluster::mouseDoubleClick
+#if (! MAC_OR_LINUX_)
+# pragma warning(pop)
+#endif // ! MAC_OR_LINUX_
+
+void
+EntityCluster::mouseDown(const MouseEvent & ee)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("ee = ", &ee); //####
+    if (ee.mods.isPopupMenu())
+    {
+        displayAndProcessPopupMenu();
+    }
+    else if (! (ee.mods.isAltDown() || ee.mods.isCommandDown()))
+    {
+        _dragger.startDraggingComponent(this, ee);
+    }
+    ODL_OBJEXIT(); //####
+} // EntityCluster::mouseDown
+
+void
+EntityCluster::mouseDrag(const MouseEvent & ee)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("ee = ", &ee); //####
+    if (! (ee.mods.isAltDown() || ee.mods.isCommandDown() || ee.mods.isPopupMenu()))
+    {
+        juce::Rectangle<float> dirtyArea(_owner.getClusterDrawingArea(this));
+
+        // The combined connections of the group are drawn over the cached image while it is
+        // being dragged, so only the areas that the group covered and now covers are redrawn.
+        _owner.beginMovingCluster(this);
+        _dragger.dragComponent(this, ee, &_constrainer);
+        dirtyArea = dirtyArea.getUnion(_owner.getClusterDrawingArea(this));
+        _owner.repaint(dirtyArea.getSmallestIntegerContainer());
+    }
+    ODL_OBJEXIT(); //####
+} // EntityCluster::mouseDrag
+
+void
+EntityCluster::mouseUp(const MouseEvent & ee)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("ee = ", &ee); //####
+    _owner.endMovingCluster();
+    ODL_OBJEXIT(); //####
+} // EntityCluster::mouseUp
+
+void
+EntityCluster::moved(void)
+{
+    ODL_OBJENTER(); //####
+    _owner.clusterMoved(this);
+    ODL_OBJEXIT(); //####
+} // EntityCluster::moved
+
+void
+EntityCluster::paint(Graphics & gg)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    juce::Rectangle<float> area(getLocalBounds().toFloat().reduced(kOutlineThickness / 2));
+
+    gg.setColour(kClusterBackgroundColour);
+    gg.fillRoundedRectangle(area, kCornerSize);
+    gg.setColour(kClusterOutlineColour);
+    gg.drawRoundedRectangle(area, kCornerSize, kOutlineThickness);
+    // When zoomed out, the text wouldn't be legible.
+    if (_owner.isDetailVisible())
+    {
+        Font &               boldFont = _owner.getBoldFont();
+        Font &               normalFont = _owner.getNormalFont();
+        int                  titleHeight = static_cast<int>(boldFont.getHeight());
+        juce::Rectangle<int> textArea(getLocalBounds().reduced(static_cast<int>(kTextInset)));
+        juce::Rectangle<int> titleArea(textArea.removeFromTop(titleHeight));
+
+        gg.setColour(kClusterTextColour);
+        gg.setFont(boldFont);
+        gg.drawText(_title, titleArea, Justification::centredLeft, true);
+        gg.setFont(normalFont);
+        gg.drawText(String(static_cast<int>(_members.size())) + " entities", textArea,
+                    Justification::centredLeft, true);
+    }
+    ODL_OBJEXIT(); //####
+} // EntityCluster::paint
+
+void
+EntityCluster::removeMember(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    ContainerList::iterator match(std::find(_members.begin(), _members.end(), anEntity));
+
+    if (_members.end() != match)
+    {
+        _members.erase(match);
+        if (anEntity && (this == anEntity->getCluster()))
+        {
+            anEntity->setCluster(NULL);
+        }
+        updateSize();
+        repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // EntityCluster::removeMember
+
+void
+EntityCluster::setCollapsed(const bool collapsed)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("collapsed = ", collapsed); //####
+    _collapsed = collapsed;
+    setVisible(collapsed);
+    ODL_OBJEXIT(); //####
+} // EntityCluster::setCollapsed
+
+void
+EntityCluster::updateSize(void)
+{
+    ODL_OBJENTER(); //####
+    Font & boldFont = _owner.getBoldFont();
+    Font & normalFont = _owner.getNormalFont();
+    String countText(String(static_cast<int>(_members.size())) + " entities");
+    float  textWidth = jmax(boldFont.getStringWidthFloat(_title + " "),
+                            normalFont.getStringWidthFloat(countText + " "));
+    float  textHeight = boldFont.getHeight() + normalFont.getHeight();
+
+    setSize(static_cast<int>(textWidth + (2 * kTextInset)),
+            static_cast<int>(textHeight + (2 * kTextInset)));
+    ODL_OBJEXIT(); //####
+} // EntityCluster::updateSize
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,226 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mEntityCluster.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for a visible group of entities that share a host or a
+//              behaviour.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmEntityCluster_HPP_))
+# define mpmEntityCluster_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for a visible group of entities that share a host or a behaviour. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class EntitiesPanel;
+
+    /*! @brief A group of entities that is displayed as a single entity when it is collapsed. */
+    class EntityCluster : public Component
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef Component inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] key The host or behaviour that the members of the group share.
+         @param[in] title The title of the group.
+         @param[in] owner The owner of the group. */
+        EntityCluster(const YarpString & key,
+                      const String &     title,
+                      EntitiesPanel &    owner);
+
+        /*! @brief The destructor. */
+        virtual
+        ~EntityCluster(void);
+
+        /*! @brief Add an entity to the group.
+         @param[in] anEntity The entity to be added. */
+        void
+        addMember(ChannelContainer * anEntity);
+
+        /*! @brief Return the host or behaviour that the members of the group share.
+         @return The host or behaviour that the members of the group share. */
+        inline const YarpString &
+        getKey(void)
+        const
+        {
+            return _key;
+        } // getKey
+
+        /*! @brief Return the members of the group.
+         @return The members of the group. */
+        inline const ContainerList &
+        getMembers(void)
+        const
+        {
+            return _members;
+        } // getMembers
+
+        /*! @brief Return the number of members of the group.
+         @return The number of members of the group. */
+        inline size_t
+        getNumMembers(void)
+        const
+        {
+            return _members.size();
+        } // getNumMembers
+
+        /*! @brief Return @c true if the group is displayed in place of its members.
+         @return @c true if the group is displayed in place of its members and @c false if the
+         members are displayed. */
+        inline bool
+        isCollapsed(void)
+        const
+        {
+            return _collapsed;
+        } // isCollapsed
+
+        /*! @brief Called when a mouse button is double-clicked.
+         @param[in] ee Details about the position and status of the mouse event. */
+        virtual void
+        mouseDoubleClick(const MouseEvent & ee);
+
+        /*! @brief Called when a mouse button is pressed.
+         @param[in] ee Details about the position and status of the mouse event. */
+        virtual void
+        mouseDown(const MouseEvent & ee);
+
+        /*! @brief Called when the mouse is moved while a button is held down.
+         @param[in] ee Details about the position and status of the mouse event. */
+        virtual void
+        mouseDrag(const MouseEvent & ee);
+
+        /*! @brief Called when a mouse button is released.
+         @param[in] ee Details about the position and status of the mouse event. */
+        virtual void
+        mouseUp(const MouseEvent & ee);
+
+        /*! @brief Called when the component position has been changed. */
+        virtual void
+        moved(void);
+
+        /*! @brief Remove an entity from the group.
+         @param[in] anEntity The entity to be removed. */
+        void
+        removeMember(ChannelContainer * anEntity);
+
+        /*! @brief Record whether the group is displayed in place of its members.
+         @param[in] collapsed @c true if the group is displayed in place of its members and
+         @c false if the members are displayed. */
+        void
+        setCollapsed(const bool collapsed);
+
+    protected :
+
+    private :
+
+        /*! @brief Respond to a request for a popup menu. */
+        void
+        displayAndProcessPopupMenu(void);
+
+        /*! @brief Draw the content of the component.
+         @param[in,out] gg The graphics context in which to draw. */
+        virtual void
+        paint(Graphics & gg);
+
+        /*! @brief Recalculate the size of the group, based on its title and number of members. */
+        void
+        updateSize(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief Restrictions on the components size or position. */
+        ComponentBoundsConstrainer _constrainer;
+
+        /*! @brief Used to take care of the logic for dragging the component. */
+        ComponentDragger _dragger;
+
+        /*! @brief The members of the group. */
+        ContainerList _members;
+
+        /*! @brief The host or behaviour that the members of the group share. */
+        YarpString _key;
+
+        /*! @brief The title of the group. */
+        String _title;
+
+        /*! @brief The owner of the group. */
+        EntitiesPanel & _owner;
+
+        /*! @brief @c true if the group is displayed in place of its members and @c false
+         otherwise. */
+        bool _collapsed;
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[7];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EntityCluster)
+
+    }; // EntityCluster
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmEntityCluster_HPP_)
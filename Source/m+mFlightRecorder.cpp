@@ -0,0 +1,873 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mFlightRecorder.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definitions for the recording and replaying of the topology and metrics of
+//              the network.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mFlightRecorder.hpp"
+#include "m+mEntitiesData.hpp"
+#include "m+mEntityData.hpp"
+#include "m+mMetricsPoller.hpp"
+#include "m+mPortData.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definitions for the recording and replaying of the topology and metrics of the
+ network. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The number of milliseconds between keyframes. */
+static const int64 kKeyframeInterval = 5 * 60 * 1000;
+
+/*! @brief The smallest number of milliseconds between records of the metrics. */
+static const int64 kMetricsRecordInterval = 10 * 1000;
+
+/*! @brief The marker at the start of a recording. */
+static const char kRecordingMagic[] = "m+mFR001";
+
+/*! @brief The number of bytes in the marker at the start of a recording. */
+static const size_t kRecordingMagicSize = sizeof(kRecordingMagic) - 1;
+
+/*! @brief The number of bytes in the header of a record, which holds the size of the
+ compressed contents, the kind of record and the time of the record. */
+static const size_t kRecordHeaderSize = 16;
+
+/*! @brief The time, in milliseconds, to wait for the records that are waiting to be written when
+ the recorder is destroyed. */
+static const int kThreadKillTime = 10000;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Apply the changes in a topology record to a topology.
+ @param[in] contents The contents of the record.
+ @param[in,out] entities The encoded entities of the topology.
+ @param[in,out] connections The connections of the topology. */
+static void
+applyTopologyChanges(const MemoryBlock &   contents,
+                     FlightEntityMap &     entities,
+                     FlightConnectionMap & connections)
+{
+    ODL_ENTER(); //####
+    ODL_P3("contents = ", &contents, "entities = ", &entities, "connections = ", //####
+           &connections); //####
+    MemoryInputStream stream(contents, false);
+
+    for (int ii = 0, mm = stream.readInt(); (mm > ii) && (! stream.isExhausted()); ++ii)
+    {
+        entities.erase(stream.readString().toStdString());
+    }
+    for (int ii = 0, mm = stream.readInt(); (mm > ii) && (! stream.isExhausted()); ++ii)
+    {
+        YarpString  name(stream.readString().toStdString());
+        int         encodedSize = stream.readInt();
+        MemoryBlock encoded;
+
+        if (0 < encodedSize)
+        {
+            stream.readIntoMemoryBlock(encoded, encodedSize);
+        }
+        entities[name] = encoded;
+    }
+    for (int ii = 0, mm = stream.readInt(); (mm > ii) && (! stream.isExhausted()); ++ii)
+    {
+        YarpString outName(stream.readString().toStdString());
+        YarpString inName(stream.readString().toStdString());
+
+        connections.erase(make_pair(outName, inName));
+    }
+    for (int ii = 0, mm = stream.readInt(); (mm > ii) && (! stream.isExhausted()); ++ii)
+    {
+        YarpString outName(stream.readString().toStdString());
+        YarpString inName(stream.readString().toStdString());
+        int        mode = stream.readInt();
+
+        connections[make_pair(outName, inName)] = static_cast<Common::ChannelMode>(mode);
+    }
+    ODL_EXIT(); //####
+} // applyTopologyChanges
+
+/*! @brief Compare a time with the time of a record, for searching the records in order.
+ @param[in] when The time of interest.
+ @param[in] entry The record to compare with.
+ @return @c true if the time is before the time of the record and @c false otherwise. */
+static bool
+compareTimeWithRecord(const int64               when,
+                      const FlightRecordEntry & entry)
+{
+    return (when < entry._time);
+} // compareTimeWithRecord
+
+/*! @brief Create an entity from its encoded description.
+ @param[in] encoded The encoded description of the entity.
+ @return The newly-created entity. */
+static EntityData *
+decodeEntity(const MemoryBlock & encoded)
+{
+    ODL_ENTER(); //####
+    ODL_P1("encoded = ", &encoded); //####
+    MemoryInputStream stream(encoded, false);
+    ContainerKind     kind = static_cast<ContainerKind>(stream.readInt());
+    YarpString        name(stream.readString().toStdString());
+    YarpString        address(stream.readString().toStdString());
+    YarpString        behaviour(stream.readString().toStdString());
+    YarpString        description(stream.readString().toStdString());
+    YarpString        extraInfo(stream.readString().toStdString());
+    YarpString        requests(stream.readString().toStdString());
+    EntityData *      result = new EntityData(kind, name, behaviour, description, extraInfo,
+                                              requests);
+
+    result->setIPAddress(address);
+    for (int ii = 0, mm = stream.readInt(); (mm > ii) && (! stream.isExhausted()); ++ii)
+    {
+        YarpString    portName(stream.readString().toStdString());
+        YarpString    portNumber(stream.readString().toStdString());
+        YarpString    protocol(stream.readString().toStdString());
+        YarpString    protocolDescription(stream.readString().toStdString());
+        PortUsage     usage = static_cast<PortUsage>(stream.readInt());
+        PortDirection direction = static_cast<PortDirection>(stream.readInt());
+        PortData *    aPort = result->addPort(portName, protocol, protocolDescription, usage,
+                                              direction);
+
+        if (aPort)
+        {
+            aPort->setPortNumber(portNumber);
+        }
+    }
+    ODL_EXIT_P(result); //####
+    return result;
+} // decodeEntity
+
+/*! @brief Encode the description of an entity, so that it can be compared and recorded.
+ @param[in] anEntity The entity to be encoded.
+ @param[out] encoded The encoded description of the entity. */
+static void
+encodeEntity(EntityData &  anEntity,
+             MemoryBlock & encoded)
+{
+    ODL_ENTER(); //####
+    ODL_P2("anEntity = ", &anEntity, "encoded = ", &encoded); //####
+    MemoryOutputStream stream;
+
+    stream.writeInt(anEntity.getKind());
+    stream.writeString(anEntity.getName().c_str());
+    stream.writeString(anEntity.getIPAddress().c_str());
+    stream.writeString(anEntity.getBehaviour().c_str());
+    stream.writeString(anEntity.getDescription().c_str());
+    stream.writeString(anEntity.getExtraInformation().c_str());
+    stream.writeString(anEntity.getRequests().c_str());
+    stream.writeInt(anEntity.getNumPorts());
+    for (int ii = 0, mm = anEntity.getNumPorts(); mm > ii; ++ii)
+    {
+        PortData * aPort = anEntity.getPort(ii);
+
+        // The count has already been written, so a missing port is recorded as an empty one.
+        if (aPort)
+        {
+            stream.writeString(aPort->getPortName().c_str());
+            stream.writeString(aPort->getPortNumber().c_str());
+            stream.writeString(aPort->getProtocol().c_str());
+            stream.writeString(aPort->getProtocolDescription().c_str());
+            stream.writeInt(aPort->getUsage());
+            stream.writeInt(aPort->getDirection());
+        }
+        else
+        {
+            stream.writeString("");
+            stream.writeString("");
+            stream.writeString("");
+            stream.writeString("");
+            stream.writeInt(kPortUsageOther);
+            stream.writeInt(kPortDirectionInputOutput);
+        }
+    }
+    encoded = stream.getMemoryBlock();
+    ODL_EXIT(); //####
+} // encodeEntity
+
+/*! @brief Collect the encoded entities and the connections that were found by a scan.
+ @param[in] workingData The entities and connections that were found by the scan.
+ @param[out] entities The encoded entities.
+ @param[out] connections The connections. */
+static void
+gatherTopology(const EntitiesData &  workingData,
+               FlightEntityMap &     entities,
+               FlightConnectionMap & connections)
+{
+    ODL_ENTER(); //####
+    ODL_P3("workingData = ", &workingData, "entities = ", &entities, "connections = ", //####
+           &connections); //####
+    const ConnectionList & scannedConnections(workingData.getConnections());
+
+    entities.clear();
+    connections.clear();
+    for (size_t ii = 0, mm = workingData.getNumberOfEntities(); mm > ii; ++ii)
+    {
+        EntityData * anEntity = workingData.getEntity(ii);
+
+        if (anEntity)
+        {
+            encodeEntity(*anEntity, entities[anEntity->getName()]);
+        }
+    }
+    for (ConnectionList::const_iterator walker(scannedConnections.begin());
+         scannedConnections.end() != walker; ++walker)
+    {
+        connections[make_pair(walker->_outPortName, walker->_inPortName)] = walker->_mode;
+    }
+    ODL_EXIT(); //####
+} // gatherTopology
+
+/*! @brief Write the changes between two topologies.
+ @param[in,out] stream The stream to be written to.
+ @param[in] oldEntities The encoded entities of the earlier topology.
+ @param[in] newEntities The encoded entities of the later topology.
+ @param[in] oldConnections The connections of the earlier topology.
+ @param[in] newConnections The connections of the later topology.
+ @return @c true if the topologies are different and @c false otherwise. */
+static bool
+writeTopologyChanges(MemoryOutputStream &        stream,
+                     const FlightEntityMap &     oldEntities,
+                     const FlightEntityMap &     newEntities,
+                     const FlightConnectionMap & oldConnections,
+                     const FlightConnectionMap & newConnections)
+{
+    ODL_ENTER(); //####
+    ODL_P4("stream = ", &stream, "oldEntities = ", &oldEntities, "newEntities = ", //####
+           &newEntities, "oldConnections = ", &oldConnections); //####
+    ODL_P1("newConnections = ", &newConnections); //####
+    YarpStringVector                            removedEntities;
+    vector<FlightEntityMap::const_iterator>     changedEntities;
+    vector<FlightConnectionMap::const_iterator> removedConnections;
+    vector<FlightConnectionMap::const_iterator> addedConnections;
+    bool                                        result;
+
+    for (FlightEntityMap::const_iterator walker(oldEntities.begin());
+         oldEntities.end() != walker; ++walker)
+    {
+        if (newEntities.end() == newEntities.find(walker->first))
+        {
+            removedEntities.push_back(walker->first);
+        }
+    }
+    for (FlightEntityMap::const_iterator walker(newEntities.begin());
+         newEntities.end() != walker; ++walker)
+    {
+        FlightEntityMap::const_iterator match(oldEntities.find(walker->first));
+
+        if ((oldEntities.end() == match) || (match->second != walker->second))
+        {
+            changedEntities.push_back(walker);
+        }
+    }
+    for (FlightConnectionMap::const_iterator walker(oldConnections.begin());
+         oldConnections.end() != walker; ++walker)
+    {
+        if (newConnections.end() == newConnections.find(walker->first))
+        {
+            removedConnections.push_back(walker);
+        }
+    }
+    for (FlightConnectionMap::const_iterator walker(newConnections.begin());
+         newConnections.end() != walker; ++walker)
+    {
+        FlightConnectionMap::const_iterator match(oldConnections.find(walker->first));
+
+        if ((oldConnections.end() == match) || (match->second != walker->second))
+        {
+            addedConnections.push_back(walker);
+        }
+    }
+    stream.writeInt(static_cast<int>(removedEntities.size()));
+    for (size_t ii = 0, mm = removedEntities.size(); mm > ii; ++ii)
+    {
+        stream.writeString(removedEntities[ii].c_str());
+    }
+    stream.writeInt(static_cast<int>(changedEntities.size()));
+    for (size_t ii = 0, mm = changedEntities.size(); mm > ii; ++ii)
+    {
+        const MemoryBlock & encoded = changedEntities[ii]->second;
+
+        stream.writeString(changedEntities[ii]->first.c_str());
+        stream.writeInt(static_cast<int>(encoded.getSize()));
+        stream.write(encoded.getData(), encoded.getSize());
+    }
+    stream.writeInt(static_cast<int>(removedConnections.size()));
+    for (size_t ii = 0, mm = removedConnections.size(); mm > ii; ++ii)
+    {
+        stream.writeString(removedConnections[ii]->first.first.c_str());
+        stream.writeString(removedConnections[ii]->first.second.c_str());
+    }
+    stream.writeInt(static_cast<int>(addedConnections.size()));
+    for (size_t ii = 0, mm = addedConnections.size(); mm > ii; ++ii)
+    {
+        stream.writeString(addedConnections[ii]->first.first.c_str());
+        stream.writeString(addedConnections[ii]->first.second.c_str());
+        stream.writeInt(addedConnections[ii]->second);
+    }
+    result = ((0 < removedEntities.size()) || (0 < changedEntities.size()) ||
+              (0 < removedConnections.size()) || (0 < addedConnections.size()));
+    ODL_EXIT_B(result); //####
+    return result;
+} // writeTopologyChanges
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+FlightRecorder::FlightRecorder(const File &    recordingFile,
+                               MetricsPoller * poller) :
+    inherited1("Flight recorder"), inherited2(), _lastConnections(), _lastEntities(),
+    _recordingFile(recordingFile), _stream(), _poller(poller), _pendingLock(),
+    _pendingTopologies(), _pendingMetrics(), _pendingMetricsTime(0), _lastKeyframeTime(-1),
+    _lastMetricsTime(-1)
+{
+    ODL_ENTER(); //####
+    ODL_P1("poller = ", poller); //####
+    if (_recordingFile.getParentDirectory().createDirectory().wasOk())
+    {
+        // An existing recording is added to, rather than replaced.
+        _stream = new FileOutputStream(_recordingFile);
+        if (_stream->failedToOpen())
+        {
+            ODL_LOG("(_stream->failedToOpen())"); //####
+            _stream = NULL;
+        }
+        else if (0 == _stream->getPosition())
+        {
+            _stream->write(kRecordingMagic, kRecordingMagicSize);
+            _stream->flush();
+        }
+    }
+    if (_stream)
+    {
+        startThread();
+    }
+    if (_poller)
+    {
+        _poller->addChangeListener(this);
+    }
+    ODL_EXIT_P(this); //####
+} // FlightRecorder::FlightRecorder
+
+FlightRecorder::~FlightRecorder(void)
+{
+    ODL_OBJENTER(); //####
+    if (_poller)
+    {
+        _poller->removeChangeListener(this);
+    }
+    // The thread writes whatever is waiting before it stops.
+    signalThreadShouldExit();
+    notify();
+    stopThread(kThreadKillTime);
+    _stream = NULL;
+    ODL_OBJEXIT(); //####
+} // FlightRecorder::~FlightRecorder
+
+FlightRecording::FlightRecording(const File & recordingFile) :
+    _connections(), _entities(), _metricsRecords(), _topologyRecords(),
+    _mappedFile(new MemoryMappedFile(recordingFile, MemoryMappedFile::readOnly)),
+    _appliedRecord(-1)
+{
+    ODL_ENTER(); //####
+    indexRecords();
+    ODL_EXIT_P(this); //####
+} // FlightRecording::FlightRecording
+
+FlightRecording::~FlightRecording(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // FlightRecording::~FlightRecording
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+FlightRecorder::changeListenerCallback(ChangeBroadcaster * source)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("source = ", source); //####
+    int64 now = Time::currentTimeMillis();
+
+    // The metrics change more slowly than they are polled, so not every round is recorded.
+    if (_stream && ((0 > _lastMetricsTime) || (kMetricsRecordInterval <= (now - _lastMetricsTime))))
+    {
+        MetricsSnapshot::Ptr snapshot(_poller->getSnapshot());
+
+        if (snapshot)
+        {
+            MemoryOutputStream        contents;
+            const ServiceMetricsMap & services = snapshot->getServices();
+
+            contents.writeInt(static_cast<int>(services.size()));
+            for (ServiceMetricsMap::const_iterator walker(services.begin());
+                 services.end() != walker; ++walker)
+            {
+                const ChannelMetricsList & channels = walker->second._channels;
+
+                contents.writeString(walker->first.c_str());
+                contents.writeBool(walker->second._enabled);
+                contents.writeBool(walker->second._valid);
+                contents.writeInt(static_cast<int>(channels.size()));
+                for (ChannelMetricsList::const_iterator channelWalker(channels.begin());
+                     channels.end() != channelWalker; ++channelWalker)
+                {
+                    contents.writeString(channelWalker->_channelName.c_str());
+                    contents.writeInt64(channelWalker->_inBytes);
+                    contents.writeInt64(channelWalker->_inMessages);
+                    contents.writeInt64(channelWalker->_outBytes);
+                    contents.writeInt64(channelWalker->_outMessages);
+                }
+            }
+            // Only the most recent metrics are kept for the thread, as older ones that it hasn't
+            // reached yet would be recorded too closely together.
+            {
+                const ScopedLock lock(_pendingLock);
+
+                _pendingMetrics = contents.getMemoryBlock();
+                _pendingMetricsTime = now;
+            }
+            notify();
+            _lastMetricsTime = now;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // FlightRecorder::changeListenerCallback
+
+int64
+FlightRecording::getEndTime(void)
+const
+{
+    ODL_OBJENTER(); //####
+    int64 result = 0;
+
+    if (! _topologyRecords.empty())
+    {
+        result = _topologyRecords.back()._time;
+    }
+    if ((! _metricsRecords.empty()) && (result < _metricsRecords.back()._time))
+    {
+        result = _metricsRecords.back()._time;
+    }
+    ODL_OBJEXIT_LL(result); //####
+    return result;
+} // FlightRecording::getEndTime
+
+bool
+FlightRecording::getMetricsAt(const int64         when,
+                              ServiceMetricsMap & services,
+                              int64 &             sampleTime)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_LL1("when = ", when); //####
+    ODL_P2("services = ", &services, "sampleTime = ", &sampleTime); //####
+    bool                                okSoFar = false;
+    FlightRecordEntries::const_iterator after(upper_bound(_metricsRecords.begin(),
+                                                          _metricsRecords.end(), when,
+                                                          compareTimeWithRecord));
+
+    services.clear();
+    if (_metricsRecords.begin() != after)
+    {
+        const FlightRecordEntry & entry = *(after - 1);
+        MemoryBlock               contents;
+
+        if (readRecord(entry, contents))
+        {
+            MemoryInputStream stream(contents, false);
+
+            for (int ii = 0, mm = stream.readInt(); (mm > ii) && (! stream.isExhausted()); ++ii)
+            {
+                YarpString       servicePortName(stream.readString().toStdString());
+                ServiceMetrics & aService = services[servicePortName];
+
+                aService._sampleTime = static_cast<double>(entry._time);
+                aService._enabled = stream.readBool();
+                aService._valid = stream.readBool();
+                for (int jj = 0, nn = stream.readInt(); (nn > jj) && (! stream.isExhausted());
+                     ++jj)
+                {
+                    ChannelMetrics aChannel;
+
+                    aChannel._channelName = stream.readString().toStdString();
+                    aChannel._inBytes = stream.readInt64();
+                    aChannel._inMessages = stream.readInt64();
+                    aChannel._outBytes = stream.readInt64();
+                    aChannel._outMessages = stream.readInt64();
+                    aService._channels.push_back(aChannel);
+                }
+            }
+            sampleTime = entry._time;
+            okSoFar = true;
+        }
+    }
+    ODL_OBJEXIT_B(okSoFar); //####
+    return okSoFar;
+} // FlightRecording::getMetricsAt
+
+int64
+FlightRecording::getStartTime(void)
+const
+{
+    ODL_OBJENTER(); //####
+    int64 result = 0;
+
+    if (! _topologyRecords.empty())
+    {
+        result = _topologyRecords.front()._time;
+    }
+    ODL_OBJEXIT_LL(result); //####
+    return result;
+} // FlightRecording::getStartTime
+
+bool
+FlightRecording::getTopologyAt(const int64    when,
+                               EntitiesData & result,
+                               int64 &        sampleTime)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL1("when = ", when); //####
+    ODL_P2("result = ", &result, "sampleTime = ", &sampleTime); //####
+    bool                                okSoFar = false;
+    FlightRecordEntries::const_iterator after(upper_bound(_topologyRecords.begin(),
+                                                          _topologyRecords.end(), when,
+                                                          compareTimeWithRecord));
+
+    result.clearOutData();
+    if (_topologyRecords.begin() != after)
+    {
+        int64 target = static_cast<int64>(after - _topologyRecords.begin()) - 1;
+        int64 keyframe = target;
+        int64 start;
+
+        // The records before the first keyframe of a recording can't be rebuilt.
+        while ((0 <= keyframe) &&
+               (kFlightRecordKeyframe != _topologyRecords[static_cast<size_t>(keyframe)]._kind))
+        {
+            --keyframe;
+        }
+        if (0 <= keyframe)
+        {
+            // Continue from the topology that was last rebuilt, if it is on the way; otherwise,
+            // start again from the keyframe.
+            if ((keyframe <= _appliedRecord) && (target >= _appliedRecord))
+            {
+                start = _appliedRecord + 1;
+            }
+            else
+            {
+                start = keyframe;
+            }
+            for (int64 ii = start; target >= ii; ++ii)
+            {
+                const FlightRecordEntry & entry = _topologyRecords[static_cast<size_t>(ii)];
+                MemoryBlock               contents;
+
+                if (kFlightRecordKeyframe == entry._kind)
+                {
+                    _entities.clear();
+                    _connections.clear();
+                }
+                if (readRecord(entry, contents))
+                {
+                    applyTopologyChanges(contents, _entities, _connections);
+                }
+            }
+            _appliedRecord = target;
+            for (FlightEntityMap::const_iterator walker(_entities.begin());
+                 _entities.end() != walker; ++walker)
+            {
+                result.addEntity(decodeEntity(walker->second));
+            }
+            for (FlightConnectionMap::const_iterator walker(_connections.begin());
+                 _connections.end() != walker; ++walker)
+            {
+                result.addConnection(walker->first.second, walker->first.first, walker->second);
+            }
+            sampleTime = _topologyRecords[static_cast<size_t>(target)]._time;
+            okSoFar = true;
+        }
+    }
+    ODL_OBJEXIT_B(okSoFar); //####
+    return okSoFar;
+} // FlightRecording::getTopologyAt
+
+void
+FlightRecording::indexRecords(void)
+{
+    ODL_OBJENTER(); //####
+    const char * data = static_cast<const char *>(_mappedFile->getData());
+    size_t       dataSize = _mappedFile->getSize();
+
+    if (data && (kRecordingMagicSize <= dataSize) &&
+        (0 == memcmp(data, kRecordingMagic, kRecordingMagicSize)))
+    {
+        // A record that was cut short, such as by a crash while it was being written, ends the
+        // recording.
+        for (size_t offset = kRecordingMagicSize; dataSize >= (offset + kRecordHeaderSize); )
+        {
+            int               contentsSize = static_cast<int>(ByteOrder::littleEndianInt(data +
+                                                                                      offset));
+            int               kind = static_cast<int>(ByteOrder::littleEndianInt(data + offset +
+                                                                                 4));
+            FlightRecordEntry entry;
+
+            if ((0 > contentsSize) ||
+                (dataSize < (offset + kRecordHeaderSize + static_cast<size_t>(contentsSize))))
+            {
+                break;
+            }
+
+            entry._offset = offset + kRecordHeaderSize;
+            entry._size = static_cast<size_t>(contentsSize);
+            entry._time = static_cast<int64>(ByteOrder::littleEndianInt64(data + offset + 8));
+            entry._kind = static_cast<FlightRecordKind>(kind);
+            switch (entry._kind)
+            {
+                case kFlightRecordKeyframe :
+                case kFlightRecordDelta :
+                    _topologyRecords.push_back(entry);
+                    break;
+
+                case kFlightRecordMetrics :
+                    _metricsRecords.push_back(entry);
+                    break;
+
+                default :
+                    break;
+
+            }
+            offset = entry._offset + entry._size;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // FlightRecording::indexRecords
+
+bool
+FlightRecording::readRecord(const FlightRecordEntry & entry,
+                            MemoryBlock &             contents)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("entry = ", &entry, "contents = ", &contents); //####
+    const char *      data = static_cast<const char *>(_mappedFile->getData());
+    MemoryInputStream source(data + entry._offset, entry._size, false);
+    bool              okSoFar;
+
+    {
+        GZIPDecompressorInputStream unzipper(source);
+
+        contents.reset();
+        unzipper.readIntoMemoryBlock(contents);
+    }
+    okSoFar = (0 < contents.getSize());
+    ODL_OBJEXIT_B(okSoFar); //####
+    return okSoFar;
+} // FlightRecording::readRecord
+
+void
+FlightRecorder::recordChanges(FlightTopology & aTopology)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("aTopology = ", &aTopology); //####
+    MemoryOutputStream contents;
+
+    if ((0 > _lastKeyframeTime) || (kKeyframeInterval <= (aTopology._time - _lastKeyframeTime)))
+    {
+        writeTopologyChanges(contents, FlightEntityMap(), aTopology._entities,
+                             FlightConnectionMap(), aTopology._connections);
+        writeRecord(kFlightRecordKeyframe, contents.getMemoryBlock(), aTopology._time);
+        _lastKeyframeTime = aTopology._time;
+    }
+    else if (writeTopologyChanges(contents, _lastEntities, aTopology._entities, _lastConnections,
+                                  aTopology._connections))
+    {
+        // Scans that found nothing new aren't recorded, as the topology carries forward.
+        writeRecord(kFlightRecordDelta, contents.getMemoryBlock(), aTopology._time);
+    }
+    _lastEntities.swap(aTopology._entities);
+    _lastConnections.swap(aTopology._connections);
+    ODL_OBJEXIT(); //####
+} // FlightRecorder::recordChanges
+
+void
+FlightRecorder::recordTopology(const EntitiesData & workingData)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("workingData = ", &workingData); //####
+    if (_stream)
+    {
+        // The scan data is only valid until the scanner is allowed to proceed, so it is copied
+        // here; the copy is built outside the lock and then moved into the queue.
+        FlightTopologyQueue newTopology(1);
+        FlightTopology &    aTopology = newTopology.front();
+
+        aTopology._time = Time::currentTimeMillis();
+        gatherTopology(workingData, aTopology._entities, aTopology._connections);
+        {
+            const ScopedLock lock(_pendingLock);
+
+            _pendingTopologies.splice(_pendingTopologies.end(), newTopology);
+        }
+        notify();
+    }
+    ODL_OBJEXIT(); //####
+} // FlightRecorder::recordTopology
+
+void
+FlightRecorder::removeOldRecordings(const File &   directory,
+                                    const String & pattern,
+                                    const int      lifetimeInDays)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("pattern = ", pattern.toStdString()); //####
+    ODL_I1("lifetimeInDays = ", lifetimeInDays); //####
+    Array<File> recordings;
+    Time        oldest(Time::getCurrentTime() - RelativeTime::days(lifetimeInDays));
+
+    directory.findChildFiles(recordings, File::findFiles, false, pattern);
+    for (int ii = 0, mm = recordings.size(); mm > ii; ++ii)
+    {
+        if (recordings[ii].getLastModificationTime() < oldest)
+        {
+            recordings[ii].deleteFile();
+        }
+    }
+    ODL_EXIT(); //####
+} // FlightRecorder::removeOldRecordings
+
+void
+FlightRecorder::run(void)
+{
+    ODL_OBJENTER(); //####
+    for ( ; ; )
+    {
+        FlightTopologyQueue topologies;
+        MemoryBlock         metrics;
+        int64               metricsTime;
+
+        {
+            const ScopedLock lock(_pendingLock);
+
+            topologies.swap(_pendingTopologies);
+            metrics.swapWith(_pendingMetrics);
+            metricsTime = _pendingMetricsTime;
+        }
+        for (FlightTopologyQueue::iterator walker(topologies.begin());
+             topologies.end() != walker; ++walker)
+        {
+            recordChanges(*walker);
+        }
+        if (0 < metrics.getSize())
+        {
+            writeRecord(kFlightRecordMetrics, metrics, metricsTime);
+        }
+        // The records that were waiting when the recorder was destroyed have been written.
+        if (threadShouldExit())
+        {
+            break;
+        }
+
+        wait(-1);
+    }
+    ODL_OBJEXIT(); //####
+} // FlightRecorder::run
+
+void
+FlightRecorder::writeRecord(const FlightRecordKind kind,
+                            const MemoryBlock &    contents,
+                            const int64            when)
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("kind = ", kind); //####
+    ODL_P1("contents = ", &contents); //####
+    ODL_LL1("when = ", when); //####
+    MemoryOutputStream compressed;
+
+    {
+        GZIPCompressorOutputStream zipper(&compressed);
+
+        zipper.write(contents.getData(), contents.getSize());
+    }
+    // The header is written with the contents, so that a partial record can be detected when the
+    // recording is read.
+    _stream->writeInt(static_cast<int>(compressed.getDataSize()));
+    _stream->writeInt(kind);
+    _stream->writeInt64(when);
+    _stream->write(compressed.getData(), compressed.getDataSize());
+    _stream->flush();
+    ODL_OBJEXIT(); //####
+} // FlightRecorder::writeRecord
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,327 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mFlightRecorder.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declarations for the recording and replaying of the topology and metrics
+//              of the network.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmFlightRecorder_HPP_))
+# define mpmFlightRecorder_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declarations for the recording and replaying of the topology and metrics of
+ the network. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class EntitiesData;
+    class MetricsPoller;
+
+    /*! @brief An append-only recording of the topology of the network and the metrics of the
+     services.
+
+     Each record is compressed on its own, so that it can be read without reading the records
+     before it. The topology is recorded as the changes since the previous scan, with the complete
+     topology recorded periodically as a keyframe, so that the topology at any time can be
+     rebuilt from the nearest keyframe before it. The message thread only copies the scans and
+     the metrics; a background thread works out the changes and compresses and writes the
+     records, so that the disk is never waited on while drawing. */
+    class FlightRecorder : public Thread,
+                           private ChangeListener
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The first class that this class is derived from. */
+        typedef Thread inherited1;
+
+        /*! @brief The second class that this class is derived from. */
+        typedef ChangeListener inherited2;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] recordingFile The file that the records are to be added to.
+         @param[in] poller The source of the metrics of the services, or @c NULL if there is
+         none. */
+        FlightRecorder(const File &    recordingFile,
+                       MetricsPoller * poller);
+
+        /*! @brief The destructor. */
+        virtual
+        ~FlightRecorder(void);
+
+        /*! @brief Return the file that the records are being added to.
+         @return The file that the records are being added to. */
+        inline const File &
+        getRecordingFile(void)
+        const
+        {
+            return _recordingFile;
+        } // getRecordingFile
+
+        /*! @brief Return @c true if the records are being written and @c false otherwise.
+         @return @c true if the records are being written and @c false otherwise. */
+        inline bool
+        isRecording(void)
+        const
+        {
+            return (NULL != _stream);
+        } // isRecording
+
+        /*! @brief Copy the topology that was found by a scan, to be recorded in the background.
+         @param[in] workingData The entities and connections that were found by the scan. */
+        void
+        recordTopology(const EntitiesData & workingData);
+
+        /*! @brief Remove the recordings in a directory that are older than a given age.
+         @param[in] directory The directory holding the recordings.
+         @param[in] pattern The wildcard pattern for the names of the recordings.
+         @param[in] lifetimeInDays The number of days that a recording is kept. */
+        static void
+        removeOldRecordings(const File &   directory,
+                            const String & pattern,
+                            const int      lifetimeInDays);
+
+    protected :
+
+    private :
+
+        /*! @brief Called when the metrics poller has new metrics.
+         @param[in] source The metrics poller. */
+        virtual void
+        changeListenerCallback(ChangeBroadcaster * source);
+
+        /*! @brief Record the changes in the topology since the last recorded scan, or all of the
+         topology if a keyframe is due.
+         @param[in,out] aTopology The topology found by a scan, which is moved into the
+         recorder. */
+        void
+        recordChanges(FlightTopology & aTopology);
+
+        /*! @brief Write the records that are waiting, until the recorder is destroyed. */
+        virtual void
+        run(void);
+
+        /*! @brief Compress and append a record to the recording.
+         @param[in] kind The kind of record.
+         @param[in] contents The contents of the record, before compression.
+         @param[in] when When the record was made, in milliseconds since the epoch. */
+        void
+        writeRecord(const FlightRecordKind kind,
+                    const MemoryBlock &    contents,
+                    const int64            when);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The connections as of the last recorded scan. */
+        FlightConnectionMap _lastConnections;
+
+        /*! @brief The encoded entities as of the last recorded scan. */
+        FlightEntityMap _lastEntities;
+
+        /*! @brief The file that the records are added to. */
+        File _recordingFile;
+
+        /*! @brief The stream that the records are written to. */
+        ScopedPointer<FileOutputStream> _stream;
+
+        /*! @brief The source of the metrics of the services. */
+        MetricsPoller * _poller;
+
+        /*! @brief A lock to manage access to the records that are waiting to be written. */
+        CriticalSection _pendingLock;
+
+        /*! @brief The topologies that are waiting to be recorded. */
+        FlightTopologyQueue _pendingTopologies;
+
+        /*! @brief The encoded metrics that are waiting to be recorded, or an empty block if there
+         are none. */
+        MemoryBlock _pendingMetrics;
+
+        /*! @brief When the metrics that are waiting were collected, in milliseconds since the
+         epoch. */
+        int64 _pendingMetricsTime;
+
+        /*! @brief When the last keyframe was recorded, in milliseconds since the epoch, or a
+         negative value if none has been recorded. */
+        int64 _lastKeyframeTime;
+
+        /*! @brief When the metrics were last recorded, in milliseconds since the epoch, or a
+         negative value if they haven't been recorded. */
+        int64 _lastMetricsTime;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FlightRecorder)
+
+    }; // FlightRecorder
+
+    /*! @brief A flight recording that is being replayed.
+
+     The recording is memory-mapped and only the locations of its records are read when it is
+     opened, so that a long recording can be opened quickly. The most recently rebuilt topology is
+     kept, so that moving forward in time only applies the changes since then; moving backward
+     starts again from the nearest keyframe. */
+    class FlightRecording
+    {
+    public :
+
+    protected :
+
+    private :
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] recordingFile The file holding the recording. */
+        explicit
+        FlightRecording(const File & recordingFile);
+
+        /*! @brief The destructor. */
+        virtual
+        ~FlightRecording(void);
+
+        /*! @brief Return the time of the last record.
+         @return The time of the last record, in milliseconds since the epoch. */
+        int64
+        getEndTime(void)
+        const;
+
+        /*! @brief Retrieve the most recent metrics that were recorded at or before a given time.
+         @param[in] when The time of interest, in milliseconds since the epoch.
+         @param[out] services The metrics of the services.
+         @param[out] sampleTime When the metrics were recorded, in milliseconds since the epoch.
+         @return @c true if metrics were recorded at or before the given time and @c false
+         otherwise. */
+        bool
+        getMetricsAt(const int64         when,
+                     ServiceMetricsMap & services,
+                     int64 &             sampleTime)
+        const;
+
+        /*! @brief Return the time of the first record.
+         @return The time of the first record, in milliseconds since the epoch. */
+        int64
+        getStartTime(void)
+        const;
+
+        /*! @brief Rebuild the topology as it was at a given time.
+         @param[in] when The time of interest, in milliseconds since the epoch.
+         @param[out] result The entities and connections as of the given time.
+         @param[out] sampleTime When the topology was recorded, in milliseconds since the epoch.
+         @return @c true if the topology was recorded at or before the given time and @c false
+         otherwise. */
+        bool
+        getTopologyAt(const int64    when,
+                      EntitiesData & result,
+                      int64 &        sampleTime);
+
+        /*! @brief Return @c true if the recording could be read and holds a topology.
+         @return @c true if the recording could be read and holds a topology and @c false
+         otherwise. */
+        inline bool
+        isValid(void)
+        const
+        {
+            return (! _topologyRecords.empty());
+        } // isValid
+
+    protected :
+
+    private :
+
+        /*! @brief Record the locations of the complete records in the recording. */
+        void
+        indexRecords(void);
+
+        /*! @brief Read and decompress the contents of a record.
+         @param[in] entry The location of the record.
+         @param[out] contents The contents of the record.
+         @return @c true if the record could be read and @c false otherwise. */
+        bool
+        readRecord(const FlightRecordEntry & entry,
+                   MemoryBlock &             contents)
+        const;
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The connections as of the most recently applied record. */
+        FlightConnectionMap _connections;
+
+        /*! @brief The encoded entities as of the most recently applied record. */
+        FlightEntityMap _entities;
+
+        /*! @brief The locations of the metrics records. */
+        FlightRecordEntries _metricsRecords;
+
+        /*! @brief The locations of the topology records. */
+        FlightRecordEntries _topologyRecords;
+
+        /*! @brief The memory-mapped recording. */
+        ScopedPointer<MemoryMappedFile> _mappedFile;
+
+        /*! @brief The index of the most recently applied topology record, or a negative value if
+         none has been applied. */
+        int64 _appliedRecord;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FlightRecording)
+
+    }; // FlightRecording
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmFlightRecorder_HPP_)
@@ -0,0 +1,581 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mForceLayout.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the built-in force-directed layout of the entities
+//              displayed by the m+m manager application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mForceLayout.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the built-in force-directed layout of the entities displayed by
+ the m+m manager application. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The ratio of cell size to distance below which a cell of the quadtree is treated as a
+ single mass. */
+static const float kBarnesHutTheta = 0.8f;
+
+/*! @brief The largest movement of any entity in a step, below which the layout is considered to
+ have settled before it has fully cooled. */
+static const float kConvergenceThreshold = 0.5;
+
+/*! @brief The fraction of the temperature that remains after each step. */
+static const float kCoolingFactor = 0.95f;
+
+/*! @brief The strength of the pull towards the centre of the entities, which keeps unconnected
+ groups of entities from drifting apart. */
+static const float kGravity = 1;
+
+/*! @brief The preferred distance between the centres of connected entities. */
+static const float kIdealEdgeLength = 150;
+
+/*! @brief The smallest gap between entities that is used when calculating their repulsion. */
+static const float kMinimumGap = 1;
+
+/*! @brief The largest distance that an entity can move in one step, once the layout has cooled;
+ the layout stops at this point. */
+static const float kMinimumTemperature = 1;
+
+/*! @brief The largest number of steps used to settle the entities. */
+static const int kMaximumIterationCount = 300;
+
+/*! @brief The deepest that the quadtree can be; entities that are closer together than the cells
+ at this depth are treated as a single mass. */
+static const int kMaximumTreeDepth = 24;
+
+/*! @brief The number of layout nodes handled by each job when the forces are calculated on
+ several threads. */
+static const size_t kNodesPerJob = 1024;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ForceLayoutJob::ForceLayoutJob(ForceLayout & owner,
+                               const size_t  begin,
+                               const size_t  end) :
+    inherited("Force layout"), _owner(owner), _begin(begin), _end(end)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    ODL_I2("begin = ", begin, "end = ", end); //####
+    ODL_EXIT_P(this); //####
+} // ForceLayoutJob::ForceLayoutJob
+
+ForceLayoutJob::~ForceLayoutJob(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ForceLayoutJob::~ForceLayoutJob
+
+ForceLayout::ForceLayout(void) :
+    _pool(), _tree(), _neighbourStarts(), _neighbours(), _centreX(), _centreY(), _forceX(),
+    _forceY(), _radius(), _pinned()
+{
+    ODL_ENTER(); //####
+    ODL_EXIT_P(this); //####
+} // ForceLayout::ForceLayout
+
+ForceLayout::~ForceLayout(void)
+{
+    ODL_OBJENTER(); //####
+    if (_pool)
+    {
+        _pool->removeAllJobs(true, -1);
+    }
+    ODL_OBJEXIT(); //####
+} // ForceLayout::~ForceLayout
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+ThreadPoolJob::JobStatus
+ForceLayoutJob::runJob(void)
+{
+    ODL_OBJENTER(); //####
+    _owner.computeForces(_begin, _end);
+    ODL_OBJEXIT(); //####
+    return jobHasFinished;
+} // ForceLayoutJob::runJob
+
+void
+ForceLayout::addRepulsion(const size_t index,
+                          float &      forceX,
+                          float &      forceY)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("index = ", index); //####
+    ODL_P2("forceX = ", &forceX, "forceY = ", &forceY); //####
+    // Each cell that is opened replaces itself with four children, so the number of cells waiting
+    // to be examined is limited by the depth of the tree.
+    int   pending[(3 * kMaximumTreeDepth) + 4];
+    int   numPending = 0;
+    int   self = static_cast<int>(index);
+    float thisX = _centreX[index];
+    float thisY = _centreY[index];
+
+    pending[numPending++] = 0;
+    for ( ; 0 < numPending; )
+    {
+        const QuadCell & aCell = _tree[pending[--numPending]];
+
+        if ((0 < aCell._mass) && (self != aCell._body))
+        {
+            float deltaX = thisX - aCell._centreX;
+            float deltaY = thisY - aCell._centreY;
+            float distance = sqrt((deltaX * deltaX) + (deltaY * deltaY));
+
+            if (0 <= aCell._body)
+            {
+                // A single entity, so allow for the sizes of both entities.
+                if (kMinimumGap > distance)
+                {
+                    // Separate entities that are on top of each other in a consistent direction.
+                    deltaX = ((self < aCell._body) ? -1.0f : 1.0f);
+                    deltaY = 0;
+                    distance = 1;
+                }
+                float gap = jmax(distance - (_radius[index] + _radius[aCell._body]), kMinimumGap);
+                float scale = ((kIdealEdgeLength * kIdealEdgeLength) / (gap * distance));
+
+                forceX += (deltaX * scale);
+                forceY += (deltaY * scale);
+            }
+            else if ((0 > aCell._firstChild) ||
+                     ((kMinimumGap <= distance) && (kBarnesHutTheta > (aCell._size / distance))))
+            {
+                // A distant group of entities, or entities that were too close together to be
+                // separated, so treat them as a single mass.
+                if (kMinimumGap <= distance)
+                {
+                    float scale = ((kIdealEdgeLength * kIdealEdgeLength * aCell._mass) /
+                                   (distance * distance));
+
+                    forceX += (deltaX * scale);
+                    forceY += (deltaY * scale);
+                }
+            }
+            else
+            {
+                for (int ii = 0; 4 > ii; ++ii)
+                {
+                    pending[numPending++] = aCell._firstChild + ii;
+                }
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ForceLayout::addRepulsion
+
+void
+ForceLayout::addToTree(const int index)
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("index = ", index); //####
+    float xx = _centreX[index];
+    float yy = _centreY[index];
+    int   cell = 0;
+    bool  done = false;
+
+    for (int depth = 0; ! done; ++depth)
+    {
+        float newMass = _tree[cell]._mass + 1;
+
+        _tree[cell]._centreX += ((xx - _tree[cell]._centreX) / newMass);
+        _tree[cell]._centreY += ((yy - _tree[cell]._centreY) / newMass);
+        _tree[cell]._mass = newMass;
+        if (0 > _tree[cell]._firstChild)
+        {
+            if (1 == newMass)
+            {
+                _tree[cell]._body = index;
+                done = true;
+            }
+            else if (kMaximumTreeDepth <= depth)
+            {
+                _tree[cell]._body = -1;
+                done = true;
+            }
+            else
+            {
+                // Move the entity that was in the cell down into one of the new children.
+                int previous = _tree[cell]._body;
+
+                splitCell(cell);
+                _tree[cell]._body = -1;
+                if (0 <= previous)
+                {
+                    QuadCell & child = _tree[getChildCell(cell, _centreX[previous],
+                                                          _centreY[previous])];
+
+                    child._centreX = _centreX[previous];
+                    child._centreY = _centreY[previous];
+                    child._mass = 1;
+                    child._body = previous;
+                }
+            }
+        }
+        if (! done)
+        {
+            cell = getChildCell(cell, xx, yy);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ForceLayout::addToTree
+
+void
+ForceLayout::buildTree(void)
+{
+    ODL_OBJENTER(); //####
+    size_t   count = _centreX.size();
+    QuadCell root;
+
+    _tree.clear();
+    root._left = root._top = 0;
+    root._size = 1;
+    if (0 < count)
+    {
+        float minX = _centreX[0];
+        float maxX = minX;
+        float minY = _centreY[0];
+        float maxY = minY;
+
+        for (size_t ii = 1; count > ii; ++ii)
+        {
+            minX = jmin(minX, _centreX[ii]);
+            maxX = jmax(maxX, _centreX[ii]);
+            minY = jmin(minY, _centreY[ii]);
+            maxY = jmax(maxY, _centreY[ii]);
+        }
+        root._left = minX;
+        root._top = minY;
+        root._size = jmax(maxX - minX, maxY - minY) + 1;
+    }
+    root._centreX = root._left;
+    root._centreY = root._top;
+    root._mass = 0;
+    root._firstChild = root._body = -1;
+    _tree.push_back(root);
+    for (size_t ii = 0; count > ii; ++ii)
+    {
+        addToTree(static_cast<int>(ii));
+    }
+    ODL_OBJEXIT(); //####
+} // ForceLayout::buildTree
+
+void
+ForceLayout::computeForces(const size_t begin,
+                           const size_t end)
+{
+    ODL_OBJENTER(); //####
+    ODL_I2("begin = ", begin, "end = ", end); //####
+    const QuadCell & root = _tree[0];
+
+    for (size_t ii = begin; end > ii; ++ii)
+    {
+        float forceX = 0;
+        float forceY = 0;
+
+        if (! _pinned[ii])
+        {
+            float thisX = _centreX[ii];
+            float thisY = _centreY[ii];
+
+            addRepulsion(ii, forceX, forceY);
+            for (size_t jj = _neighbourStarts[ii], mm = _neighbourStarts[ii + 1]; mm > jj; ++jj)
+            {
+                size_t other = _neighbours[jj];
+                float  deltaX = _centreX[other] - thisX;
+                float  deltaY = _centreY[other] - thisY;
+                float  distance = sqrt((deltaX * deltaX) + (deltaY * deltaY));
+
+                forceX += ((deltaX * distance) / kIdealEdgeLength);
+                forceY += ((deltaY * distance) / kIdealEdgeLength);
+            }
+            forceX += ((root._centreX - thisX) * kGravity);
+            forceY += ((root._centreY - thisY) * kGravity);
+        }
+        _forceX[ii] = forceX;
+        _forceY[ii] = forceY;
+    }
+    ODL_OBJEXIT(); //####
+} // ForceLayout::computeForces
+
+int
+ForceLayout::getChildCell(const int   parent,
+                          const float xx,
+                          const float yy)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("parent = ", parent); //####
+    ODL_D2("xx = ", xx, "yy = ", yy); //####
+    const QuadCell & aCell = _tree[parent];
+    float            half = (aCell._size / 2);
+    int              result = aCell._firstChild;
+
+    if ((aCell._left + half) <= xx)
+    {
+        result += 1;
+    }
+    if ((aCell._top + half) <= yy)
+    {
+        result += 2;
+    }
+    ODL_OBJEXIT_I(result); //####
+    return result;
+} // ForceLayout::getChildCell
+
+bool
+ForceLayout::layOut(LayoutNodes &                  nodes,
+                    const LayoutEdges &            edges,
+                    const juce::Rectangle<float> & area,
+                    MplusM::Common::CheckFunction  checker,
+                    void *                         checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_P4("nodes = ", &nodes, "edges = ", &edges, "area = ", &area, "checkStuff = ", //####
+           checkStuff); //####
+    bool   result = true;
+    bool   anyPinned = false;
+    size_t count = nodes.size();
+    float  temperature = (kIdealEdgeLength * jmax(1.0f, sqrt(static_cast<float>(count)) / 4));
+
+    _centreX.resize(count);
+    _centreY.resize(count);
+    _forceX.resize(count);
+    _forceY.resize(count);
+    _radius.resize(count);
+    _pinned.resize(count);
+    for (size_t ii = 0; count > ii; ++ii)
+    {
+        const LayoutNode & aNode = nodes[ii];
+
+        // Start from the current positions, rather than from scratch.
+        _centreX[ii] = aNode._x + (aNode._width / 2);
+        _centreY[ii] = aNode._y + (aNode._height / 2);
+        _radius[ii] = (jmax(aNode._width, aNode._height) / 2);
+        _pinned[ii] = (aNode._pinned ? 1 : 0);
+        if (aNode._pinned)
+        {
+            anyPinned = true;
+        }
+    }
+    // Gather the neighbours of each layout node into one array.
+    _neighbourStarts.assign(count + 1, 0);
+    for (LayoutEdges::const_iterator walker(edges.begin()); edges.end() != walker; ++walker)
+    {
+        if ((walker->first != walker->second) && (count > walker->first) &&
+            (count > walker->second))
+        {
+            ++_neighbourStarts[walker->first + 1];
+            ++_neighbourStarts[walker->second + 1];
+        }
+    }
+    for (size_t ii = 0; count > ii; ++ii)
+    {
+        _neighbourStarts[ii + 1] += _neighbourStarts[ii];
+    }
+    std::vector<size_t> fillPoints(_neighbourStarts.begin(), _neighbourStarts.end() - 1);
+
+    _neighbours.resize(_neighbourStarts[count]);
+    for (LayoutEdges::const_iterator walker(edges.begin()); edges.end() != walker; ++walker)
+    {
+        if ((walker->first != walker->second) && (count > walker->first) &&
+            (count > walker->second))
+        {
+            _neighbours[fillPoints[walker->first]++] = walker->second;
+            _neighbours[fillPoints[walker->second]++] = walker->first;
+        }
+    }
+    for (int ii = 0; result && (kMaximumIterationCount > ii); ++ii)
+    {
+        if (checker && checker(checkStuff))
+        {
+            result = false;
+        }
+        else
+        {
+            float maxDisplacement = 0;
+
+            buildTree();
+            if ((2 * kNodesPerJob) <= count)
+            {
+                OwnedArray<ForceLayoutJob> jobs;
+
+                // Most layouts are too small to need the threads, so they aren't started until a
+                // large one comes along.
+                if (! _pool)
+                {
+                    _pool = new ThreadPool(SystemStats::getNumCpus());
+                }
+                for (size_t begin = 0; count > begin; begin += kNodesPerJob)
+                {
+                    ForceLayoutJob * aJob = new ForceLayoutJob(*this, begin,
+                                                               jmin(begin + kNodesPerJob, count));
+
+                    jobs.add(aJob);
+                    _pool->addJob(aJob, false);
+                }
+                for (int jj = 0, mm = jobs.size(); mm > jj; ++jj)
+                {
+                    _pool->waitForJobToFinish(jobs[jj], -1);
+                }
+            }
+            else
+            {
+                computeForces(0, count);
+            }
+            for (size_t jj = 0; count > jj; ++jj)
+            {
+                float magnitude = sqrt((_forceX[jj] * _forceX[jj]) + (_forceY[jj] * _forceY[jj]));
+
+                if (0 < magnitude)
+                {
+                    float step = jmin(magnitude, temperature);
+
+                    _centreX[jj] += ((_forceX[jj] * step) / magnitude);
+                    _centreY[jj] += ((_forceY[jj] * step) / magnitude);
+                    maxDisplacement = jmax(maxDisplacement, step);
+                }
+            }
+            temperature *= kCoolingFactor;
+            if ((kMinimumTemperature > temperature) || (kConvergenceThreshold > maxDisplacement))
+            {
+                break;
+            }
+        }
+    }
+    if (result)
+    {
+        float offsetX = 0;
+        float offsetY = 0;
+
+        if ((! anyPinned) && (0 < count))
+        {
+            // Move the whole layout so that it starts at the top-left of the area.
+            float minX = _centreX[0] - (nodes[0]._width / 2);
+            float minY = _centreY[0] - (nodes[0]._height / 2);
+
+            for (size_t ii = 1; count > ii; ++ii)
+            {
+                minX = jmin(minX, _centreX[ii] - (nodes[ii]._width / 2));
+                minY = jmin(minY, _centreY[ii] - (nodes[ii]._height / 2));
+            }
+            offsetX = area.getX() - minX;
+            offsetY = area.getY() - minY;
+        }
+        for (size_t ii = 0; count > ii; ++ii)
+        {
+            LayoutNode & aNode = nodes[ii];
+
+            if (! aNode._pinned)
+            {
+                aNode._x = _centreX[ii] - (aNode._width / 2) + offsetX;
+                aNode._y = _centreY[ii] - (aNode._height / 2) + offsetY;
+            }
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ForceLayout::layOut
+
+void
+ForceLayout::splitCell(const int parent)
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("parent = ", parent); //####
+    float half = (_tree[parent]._size / 2);
+    int   firstChild = static_cast<int>(_tree.size());
+
+    for (int ii = 0; 4 > ii; ++ii)
+    {
+        QuadCell child;
+
+        child._left = _tree[parent]._left + ((ii & 1) ? half : 0);
+        child._top = _tree[parent]._top + ((ii & 2) ? half : 0);
+        child._size = half;
+        child._centreX = child._left + (half / 2);
+        child._centreY = child._top + (half / 2);
+        child._mass = 0;
+        child._firstChild = child._body = -1;
+        _tree.push_back(child);
+    }
+    _tree[parent]._firstChild = firstChild;
+    ODL_OBJEXIT(); //####
+} // ForceLayout::splitCell
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
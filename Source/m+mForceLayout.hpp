@@ -0,0 +1,278 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mForceLayout.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the built-in force-directed layout of the entities
+//              displayed by the m+m manager application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmForceLayout_HPP_))
+# define mpmForceLayout_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the built-in force-directed layout of the entities displayed by
+ the m+m manager application. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class ForceLayout;
+
+    /*! @brief A job that calculates the forces on a range of the layout nodes. */
+    class ForceLayoutJob : public ThreadPoolJob
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef ThreadPoolJob inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in,out] owner The layout that the forces are being calculated for.
+         @param[in] begin The index of the first layout node to be processed.
+         @param[in] end The index after the last layout node to be processed. */
+        ForceLayoutJob(ForceLayout & owner,
+                       const size_t  begin,
+                       const size_t  end);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ForceLayoutJob(void);
+
+    protected :
+
+    private :
+
+        /*! @brief Calculate the forces on the layout nodes.
+         @return @c jobHasFinished, since the job is always completed. */
+        virtual JobStatus
+        runJob(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The layout that the forces are being calculated for. */
+        ForceLayout & _owner;
+
+        /*! @brief The index of the first layout node to be processed. */
+        size_t _begin;
+
+        /*! @brief The index after the last layout node to be processed. */
+        size_t _end;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ForceLayoutJob)
+
+    }; // ForceLayoutJob
+
+    /*! @brief A force-directed layout of entities and their connections.
+
+     Entities repel each other and connections pull entities together. The repulsion is calculated
+     with a Barnes-Hut quadtree, so each step costs O(n log n) rather than O(n^2), and large graphs
+     have their forces calculated on several threads. The layout starts from the existing positions
+     of the entities. The per-node values are kept in separate arrays, so that the inner loops
+     touch contiguous memory. */
+    class ForceLayout
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief A cell of the quadtree that is used to approximate the repulsion. */
+        struct QuadCell
+        {
+            /*! @brief The horizontal position of the centre of mass of the cell. */
+            float _centreX;
+
+            /*! @brief The vertical position of the centre of mass of the cell. */
+            float _centreY;
+
+            /*! @brief The left edge of the cell. */
+            float _left;
+
+            /*! @brief The top edge of the cell. */
+            float _top;
+
+            /*! @brief The width and height of the cell. */
+            float _size;
+
+            /*! @brief The number of layout nodes within the cell. */
+            float _mass;
+
+            /*! @brief The index of the first of the four child cells, or @c -1 if the cell has
+             no children. */
+            int _firstChild;
+
+            /*! @brief The index of the layout node in the cell, or @c -1 if the cell is empty or
+             holds more than one layout node. */
+            int _body;
+
+        }; // QuadCell
+
+    public :
+
+        /*! @brief The constructor. */
+        ForceLayout(void);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ForceLayout(void);
+
+        /*! @brief Calculate the forces on a range of the layout nodes.
+
+         This can be called from several threads at once, as long as the ranges don't overlap.
+         @param[in] begin The index of the first layout node to be processed.
+         @param[in] end The index after the last layout node to be processed. */
+        void
+        computeForces(const size_t begin,
+                      const size_t end);
+
+        /*! @brief Position the entities that are not pinned.
+         @param[in,out] nodes The entities to be laid out.
+         @param[in] edges The connections between the entities.
+         @param[in] area The area where the entities are to be placed, if none are pinned.
+         @param[in] checker A function that provides for early exit from loops.
+         @param[in] checkStuff The private data for the early exit function.
+         @return @c true if the layout was completed and @c false if it was abandoned. */
+        bool
+        layOut(LayoutNodes &                  nodes,
+               const LayoutEdges &            edges,
+               const juce::Rectangle<float> & area,
+               MplusM::Common::CheckFunction  checker = NULL,
+               void *                         checkStuff = NULL);
+
+    protected :
+
+    private :
+
+        /*! @brief Add the repulsion from all the other layout nodes.
+         @param[in] index The index of the layout node.
+         @param[in,out] forceX The horizontal force on the layout node.
+         @param[in,out] forceY The vertical force on the layout node. */
+        void
+        addRepulsion(const size_t index,
+                     float &      forceX,
+                     float &      forceY)
+        const;
+
+        /*! @brief Add a layout node to the quadtree.
+         @param[in] index The index of the layout node. */
+        void
+        addToTree(const int index);
+
+        /*! @brief Build the quadtree from the current positions of the layout nodes. */
+        void
+        buildTree(void);
+
+        /*! @brief Return the child cell of a cell of the quadtree that contains a position.
+         @param[in] parent The index of the cell that has been split.
+         @param[in] xx The horizontal position.
+         @param[in] yy The vertical position.
+         @return The index of the child cell that contains the position. */
+        int
+        getChildCell(const int   parent,
+                     const float xx,
+                     const float yy)
+        const;
+
+        /*! @brief Add four empty child cells to a cell of the quadtree.
+         @param[in] parent The index of the cell to be split. */
+        void
+        splitCell(const int parent);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The threads that calculate the forces for large graphs; created when the first
+         large graph is laid out. */
+        ScopedPointer<ThreadPool> _pool;
+
+        /*! @brief The cells of the quadtree. */
+        std::vector<QuadCell> _tree;
+
+        /*! @brief The starting positions, in _neighbours, of the neighbours of each layout node;
+         there is one more entry than there are layout nodes. */
+        std::vector<size_t> _neighbourStarts;
+
+        /*! @brief The neighbours of all the layout nodes. */
+        std::vector<size_t> _neighbours;
+
+        /*! @brief The horizontal positions of the centres of the layout nodes. */
+        std::vector<float> _centreX;
+
+        /*! @brief The vertical positions of the centres of the layout nodes. */
+        std::vector<float> _centreY;
+
+        /*! @brief The horizontal forces on the layout nodes. */
+        std::vector<float> _forceX;
+
+        /*! @brief The vertical forces on the layout nodes. */
+        std::vector<float> _forceY;
+
+        /*! @brief The approximate radii of the layout nodes. */
+        std::vector<float> _radius;
+
+        /*! @brief Non-zero for the layout nodes that must not be moved. */
+        std::vector<char> _pinned;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ForceLayout)
+
+    }; // ForceLayout
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmForceLayout_HPP_)
@@ -0,0 +1,695 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mLayoutThread.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the background layout of the entities displayed by the m+m
+//              manager application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mLayoutThread.hpp"
+#include "m+mContentPanel.hpp"
+#include "m+mEntitiesPanel.hpp"
+#include "m+mForceLayout.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(USE_OGDF_POSITIONING_)
+# if MAC_OR_LINUX_
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-parameter"
+# else // ! MAC_OR_LINUX_
+#  pragma warning(push)
+#  pragma warning(disable: 4100)
+#  pragma warning(disable: 4512)
+# endif // ! MAC_OR_LINUX_
+# include <ogdf/basic/GraphAttributes.h>
+# include <ogdf/energybased/FMMMLayout.h>
+# if MAC_OR_LINUX_
+#  pragma clang diagnostic pop
+# else // ! MAC_OR_LINUX_
+#  pragma warning(pop)
+# endif // ! MAC_OR_LINUX_
+#endif // defined(USE_OGDF_POSITIONING_)
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the background layout of the entities displayed by the m+m
+ manager application. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief A mapping from grid cells to the layout nodes whose centres lie within them. */
+typedef std::unordered_map<int64, std::vector<size_t> > NodeCellMap;
+
+/*! @brief The preferred distance between the centres of connected entities. */
+static const float kIdealEdgeLength = 150;
+
+/*! @brief The number of steps used to settle the positions of the new entities. */
+static const int kIterationCount = 60;
+
+#if defined(USE_OGDF_POSITIONING_)
+/*! @brief The largest number of entities that are laid out by OGDF; larger graphs are laid out by
+ the built-in force-directed layout, which is much faster. */
+static const size_t kMaximumOgdfNodes = 1000;
+#endif // defined(USE_OGDF_POSITIONING_)
+
+/*! @brief The smallest gap between entities that is used when calculating their repulsion. */
+static const float kMinimumGap = 1;
+
+/*! @brief The smallest distance that an entity can move in one step, once the layout has cooled. */
+static const float kMinimumTemperature = 1;
+
+/*! @brief The largest gap between entities at which they repel each other; this is also the size
+ of the grid cells that are used to find nearby entities. */
+static const float kRepulsionRange = (2 * kIdealEdgeLength);
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return @c true if the layout in progress is no longer wanted.
+ @param[in] stuff The layout thread.
+ @return @c true if the layout in progress is no longer wanted. */
+static bool
+checkForObsoleteLayout(void * stuff)
+{
+    ODL_ENTER(); //####
+    ODL_P1("stuff = ", stuff); //####
+    bool result = static_cast<LayoutThread *>(stuff)->layoutIsObsolete();
+
+    ODL_EXIT_B(result); //####
+    return result;
+} // checkForObsoleteLayout
+
+/*! @brief Return the grid cell coordinate for a panel coordinate.
+ @param[in] value The panel coordinate.
+ @return The grid cell coordinate. */
+inline static int
+getCellCoordinate(const float value)
+{
+    return static_cast<int>(floor(value / kRepulsionRange));
+} // getCellCoordinate
+
+/*! @brief Return the key for a grid cell.
+ @param[in] column The column of the cell.
+ @param[in] row The row of the cell.
+ @return The key for the grid cell. */
+inline static int64
+makeCellKey(const int column,
+            const int row)
+{
+    return ((static_cast<int64>(column) << 32) | static_cast<uint32>(row));
+} // makeCellKey
+
+/*! @brief Record the grid cell that contains the centre of a layout node.
+ @param[in,out] cells The grid cells to be updated.
+ @param[in] centre The centre of the layout node.
+ @param[in] index The index of the layout node. */
+static void
+addNodeToCells(NodeCellMap &    cells,
+               const Position & centre,
+               const size_t     index)
+{
+    ODL_ENTER(); //####
+    ODL_P2("cells = ", &cells, "centre = ", &centre); //####
+    ODL_I1("index = ", index); //####
+    cells[makeCellKey(getCellCoordinate(centre.getX()),
+                      getCellCoordinate(centre.getY()))].push_back(index);
+    ODL_EXIT(); //####
+} // addNodeToCells
+
+/*! @brief Add the repulsion from the nearby layout nodes in a set of grid cells.
+ @param[in,out] force The force acting on the layout node.
+ @param[in] index The index of the layout node.
+ @param[in] cells The grid cells containing the nodes that repel the layout node.
+ @param[in] centres The centres of all the layout nodes.
+ @param[in] radii The approximate radii of all the layout nodes. */
+static void
+addRepulsion(Position &                    force,
+             const size_t                  index,
+             const NodeCellMap &           cells,
+             const std::vector<Position> & centres,
+             const std::vector<float> &    radii)
+{
+    ODL_ENTER(); //####
+    ODL_P4("force = ", &force, "cells = ", &cells, "centres = ", &centres, "radii = ", //####
+           &radii); //####
+    ODL_I1("index = ", index); //####
+    const Position & thisCentre = centres[index];
+    int              column = getCellCoordinate(thisCentre.getX());
+    int              row = getCellCoordinate(thisCentre.getY());
+
+    for (int ii = column - 1; column + 1 >= ii; ++ii)
+    {
+        for (int jj = row - 1; row + 1 >= jj; ++jj)
+        {
+            NodeCellMap::const_iterator match(cells.find(makeCellKey(ii, jj)));
+
+            if (cells.end() != match)
+            {
+                const std::vector<size_t> & occupants(match->second);
+
+                for (size_t kk = 0, mm = occupants.size(); mm > kk; ++kk)
+                {
+                    size_t other = occupants[kk];
+
+                    if (index != other)
+                    {
+                        Position delta(thisCentre - centres[other]);
+                        float    distance = delta.getDistanceFromOrigin();
+
+                        // Separate entities that are on top of each other in a consistent
+                        // direction.
+                        if (kMinimumGap > distance)
+                        {
+                            delta = Position((index < other) ? -1.0f : 1.0f, 0);
+                            distance = 1;
+                        }
+                        float gap = distance - (radii[index] + radii[other]);
+
+                        if (kRepulsionRange > gap)
+                        {
+                            gap = jmax(gap, kMinimumGap);
+                            force += delta * ((kIdealEdgeLength * kIdealEdgeLength) /
+                                              (gap * distance));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    ODL_EXIT(); //####
+} // addRepulsion
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+LayoutThread::LayoutThread(ContentPanel & owner) :
+    inherited("Entity layout"), _owner(owner), _lock(), _forceLayout(new ForceLayout),
+    _randomizer(Time::currentTimeMillis()),
+    _requestedArea(), _requestedEdges(), _requestedNodes(), _results(), _requestedGeneration(0),
+    _workingGeneration(0), _layoutIsComplete(false), _layoutRequested(false)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    ODL_EXIT_P(this); //####
+} // LayoutThread::LayoutThread
+
+LayoutThread::~LayoutThread(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // LayoutThread::~LayoutThread
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+bool
+LayoutThread::checkAndClearIfLayoutIsComplete(LayoutNodes & results)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("results = ", &results); //####
+    const ScopedLock lock(_lock);
+    bool             result = _layoutIsComplete;
+
+    if (_layoutIsComplete)
+    {
+        results.swap(_results);
+        _results.clear();
+        _layoutIsComplete = false;
+        ODL_B1("_layoutIsComplete <- ", _layoutIsComplete); //####
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::checkAndClearIfLayoutIsComplete
+
+bool
+LayoutThread::computeForceLayout(LayoutNodes &                  nodes,
+                                 const LayoutEdges &            edges,
+                                 const juce::Rectangle<float> & area)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("nodes = ", &nodes, "edges = ", &edges, "area = ", &area); //####
+    bool result = _forceLayout->layOut(nodes, edges, area, checkForObsoleteLayout, this);
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::computeForceLayout
+
+bool
+LayoutThread::computeIncrementalLayout(LayoutNodes &                  nodes,
+                                       const LayoutEdges &            edges,
+                                       const juce::Rectangle<float> & area)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("nodes = ", &nodes, "edges = ", &edges, "area = ", &area); //####
+    bool                              result = true;
+    size_t                            count = nodes.size();
+    float                             temperature = kIdealEdgeLength;
+    float                             cooling = (temperature / kIterationCount);
+    std::vector<Position>             centres(count);
+    std::vector<float>                radii(count);
+    std::vector<std::vector<size_t> > neighbours(count);
+    std::vector<size_t>               freeNodes;
+    std::vector<bool>                 placed(count);
+    NodeCellMap                       pinnedCells;
+
+    for (size_t ii = 0; count > ii; ++ii)
+    {
+        const LayoutNode & aNode = nodes[ii];
+
+        centres[ii] = Position(aNode._x + (aNode._width / 2), aNode._y + (aNode._height / 2));
+        radii[ii] = (jmax(aNode._width, aNode._height) / 2);
+        placed[ii] = aNode._pinned;
+        if (aNode._pinned)
+        {
+            // The pinned entities don't move, so their grid cells only need to be filled once.
+            addNodeToCells(pinnedCells, centres[ii], ii);
+        }
+        else
+        {
+            freeNodes.push_back(ii);
+        }
+    }
+    for (LayoutEdges::const_iterator walker(edges.begin()); edges.end() != walker; ++walker)
+    {
+        if ((walker->first != walker->second) && (count > walker->first) &&
+            (count > walker->second))
+        {
+            neighbours[walker->first].push_back(walker->second);
+            neighbours[walker->second].push_back(walker->first);
+        }
+    }
+    // Start each new entity next to the entities that it's connected to; unconnected entities
+    // keep their initial positions.
+    for (size_t ii = 0, mm = freeNodes.size(); mm > ii; ++ii)
+    {
+        size_t                      index = freeNodes[ii];
+        const std::vector<size_t> & adjacent(neighbours[index]);
+        Position                    sum;
+        int                         numPlaced = 0;
+
+        for (size_t jj = 0, nn = adjacent.size(); nn > jj; ++jj)
+        {
+            if (placed[adjacent[jj]])
+            {
+                sum += centres[adjacent[jj]];
+                ++numPlaced;
+            }
+        }
+        if (0 < numPlaced)
+        {
+            float angle = (_randomizer.nextFloat() * 2 * float_Pi);
+
+            centres[index] = ((sum / static_cast<float>(numPlaced)) +
+                              (Position(cos(angle), sin(angle)) * kIdealEdgeLength));
+        }
+        placed[index] = true;
+    }
+    // Let the new entities settle, using a force-directed model where entities repel each other
+    // and connections pull entities together.
+    for (int ii = 0; result && (kIterationCount > ii); ++ii)
+    {
+        if (layoutIsObsolete())
+        {
+            result = false;
+        }
+        else
+        {
+            NodeCellMap freeCells;
+
+            for (size_t jj = 0, mm = freeNodes.size(); mm > jj; ++jj)
+            {
+                addNodeToCells(freeCells, centres[freeNodes[jj]], freeNodes[jj]);
+            }
+            for (size_t jj = 0, mm = freeNodes.size(); mm > jj; ++jj)
+            {
+                size_t                      index = freeNodes[jj];
+                const std::vector<size_t> & adjacent(neighbours[index]);
+                Position                    force;
+
+                addRepulsion(force, index, pinnedCells, centres, radii);
+                addRepulsion(force, index, freeCells, centres, radii);
+                for (size_t kk = 0, nn = adjacent.size(); nn > kk; ++kk)
+                {
+                    Position delta(centres[adjacent[kk]] - centres[index]);
+                    float    distance = delta.getDistanceFromOrigin();
+
+                    force += delta * (distance / kIdealEdgeLength);
+                }
+                float magnitude = force.getDistanceFromOrigin();
+
+                if (0 < magnitude)
+                {
+                    centres[index] += force * (jmin(magnitude, temperature) / magnitude);
+                }
+            }
+            temperature = jmax(temperature - cooling, kMinimumTemperature);
+        }
+    }
+    if (result)
+    {
+        for (size_t ii = 0, mm = freeNodes.size(); mm > ii; ++ii)
+        {
+            LayoutNode & aNode = nodes[freeNodes[ii]];
+            Position &   centre = centres[freeNodes[ii]];
+
+            aNode._x = jmax(area.getX(), centre.getX() - (aNode._width / 2));
+            aNode._y = jmax(area.getY(), centre.getY() - (aNode._height / 2));
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::computeIncrementalLayout
+
+bool
+LayoutThread::computeLayout(LayoutNodes &                  nodes,
+                            const LayoutEdges &            edges,
+                            const juce::Rectangle<float> & area,
+                            const LayoutMethod             method)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("nodes = ", &nodes, "edges = ", &edges, "area = ", &area); //####
+    ODL_I1("method = ", method); //####
+    bool         result;
+    LayoutMethod methodToUse = method;
+
+    if (kLayoutMethodAutomatic == methodToUse)
+    {
+        bool anyPinned = false;
+
+        for (LayoutNodes::const_iterator walker(nodes.begin()); nodes.end() != walker; ++walker)
+        {
+            if (walker->_pinned)
+            {
+                anyPinned = true;
+                break;
+            }
+        }
+        // A global layout is only worthwhile when nothing has been placed yet.
+        if (anyPinned)
+        {
+            methodToUse = kLayoutMethodIncremental;
+        }
+#if defined(USE_OGDF_POSITIONING_)
+        else if (kMaximumOgdfNodes >= nodes.size())
+        {
+            methodToUse = kLayoutMethodOgdf;
+        }
+#endif // defined(USE_OGDF_POSITIONING_)
+        else
+        {
+            methodToUse = kLayoutMethodForce;
+        }
+    }
+    switch (methodToUse)
+    {
+        case kLayoutMethodIncremental :
+            result = computeIncrementalLayout(nodes, edges, area);
+            break;
+
+#if defined(USE_OGDF_POSITIONING_)
+        case kLayoutMethodOgdf :
+            result = computeOgdfLayout(nodes, edges, area);
+            break;
+
+#endif // defined(USE_OGDF_POSITIONING_)
+        default :
+            // Without OGDF, the built-in layout is used in its place.
+            result = computeForceLayout(nodes, edges, area);
+            break;
+
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::computeLayout
+
+#if defined(USE_OGDF_POSITIONING_)
+bool
+LayoutThread::computeOgdfLayout(LayoutNodes &                  nodes,
+                                const LayoutEdges &            edges,
+                                const juce::Rectangle<float> & area)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("nodes = ", &nodes, "edges = ", &edges, "area = ", &area); //####
+    bool                    result;
+    size_t                  count = nodes.size();
+    ogdf::Graph             graph;
+    ogdf::GraphAttributes   attributes(graph);
+    ogdf::FMMMLayout        fmmm;
+    ogdf::node              phantomNode = graph.newNode();
+    std::vector<ogdf::node> graphNodes(count);
+    std::vector<bool>       connected(count);
+
+    attributes.setDirected(true);
+    // If nodes are not connected, OGDF will pile them all at the origin; by adding a 'phantom' node
+    // that is connected to every other node, we force OGDF to spread the nodes out.
+    attributes.width(phantomNode) = 1;
+    attributes.height(phantomNode) = 1;
+    attributes.x(phantomNode) = area.getX() + (_randomizer.nextFloat() * area.getWidth());
+    attributes.y(phantomNode) = area.getY() + (_randomizer.nextFloat() * area.getHeight());
+    for (size_t ii = 0; count > ii; ++ii)
+    {
+        const LayoutNode & aNode = nodes[ii];
+        ogdf::node         graphNode = graph.newNode();
+
+        attributes.width(graphNode) = aNode._width;
+        attributes.height(graphNode) = aNode._height;
+        attributes.x(graphNode) = aNode._x;
+        attributes.y(graphNode) = aNode._y;
+        graphNodes[ii] = graphNode;
+    }
+    for (LayoutEdges::const_iterator walker(edges.begin()); edges.end() != walker; ++walker)
+    {
+        if ((walker->first != walker->second) && (count > walker->first) &&
+            (count > walker->second))
+        {
+            /*ogdf::edge ee =*/ graph.newEdge(graphNodes[walker->first],
+                                              graphNodes[walker->second]);
+
+            connected[walker->first] = connected[walker->second] = true;
+        }
+    }
+    for (size_t ii = 0; count > ii; ++ii)
+    {
+        if (! connected[ii])
+        {
+            /*ogdf::edge phantomNodeToThis =*/ graph.newEdge(phantomNode, graphNodes[ii]);
+
+        }
+    }
+    // Apply an energy-based layout.
+    fmmm.useHighLevelOptions(true);
+    fmmm.newInitialPlacement(false); //true);
+    fmmm.qualityVersusSpeed(ogdf::FMMMLayout::qvsGorgeousAndEfficient);
+    fmmm.allowedPositions(ogdf::FMMMLayout::apAll);
+    fmmm.initialPlacementMult(ogdf::FMMMLayout::ipmAdvanced);
+    fmmm.initialPlacementForces(ogdf::FMMMLayout::ipfKeepPositions);
+    fmmm.repForcesStrength(2);
+    fmmm.call(attributes);
+    result = (! layoutIsObsolete());
+    if (result)
+    {
+        for (size_t ii = 0; count > ii; ++ii)
+        {
+            LayoutNode & aNode = nodes[ii];
+
+            aNode._x = static_cast<float>(attributes.x(graphNodes[ii]));
+            aNode._y = static_cast<float>(attributes.y(graphNodes[ii]));
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::computeOgdfLayout
+#endif // defined(USE_OGDF_POSITIONING_)
+
+bool
+LayoutThread::layoutIsObsolete(void)
+{
+    ODL_OBJENTER(); //####
+    bool result = threadShouldExit();
+
+    if (! result)
+    {
+        const ScopedLock lock(_lock);
+
+        result = (_workingGeneration != _requestedGeneration);
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::layoutIsObsolete
+
+void
+LayoutThread::requestLayout(const LayoutNodes &            nodes,
+                            const LayoutEdges &            edges,
+                            const juce::Rectangle<float> & area)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("nodes = ", &nodes, "edges = ", &edges, "area = ", &area); //####
+    {
+        const ScopedLock lock(_lock);
+
+        _requestedNodes = nodes;
+        _requestedEdges = edges;
+        _requestedArea = area;
+        ++_requestedGeneration;
+        _layoutRequested = true;
+        ODL_I1("_requestedGeneration <- ", _requestedGeneration); //####
+        ODL_B1("_layoutRequested <- ", _layoutRequested); //####
+    }
+    notify();
+    ODL_OBJEXIT(); //####
+} // LayoutThread::requestLayout
+
+void
+LayoutThread::run(void)
+{
+    ODL_OBJENTER(); //####
+    while (! threadShouldExit())
+    {
+        juce::Rectangle<float> area;
+        LayoutEdges            edges;
+        LayoutNodes            nodes;
+        bool                   haveRequest;
+
+        {
+            const ScopedLock lock(_lock);
+
+            haveRequest = _layoutRequested;
+            if (haveRequest)
+            {
+                nodes.swap(_requestedNodes);
+                edges.swap(_requestedEdges);
+                area = _requestedArea;
+                _workingGeneration = _requestedGeneration;
+                _layoutRequested = false;
+                ODL_I1("_workingGeneration <- ", _workingGeneration); //####
+                ODL_B1("_layoutRequested <- ", _layoutRequested); //####
+            }
+        }
+        if (haveRequest)
+        {
+            ODL_LOG("(haveRequest)"); //####
+            if (computeLayout(nodes, edges, area, kLayoutMethodAutomatic))
+            {
+                ODL_LOG("(computeLayout(nodes, edges, area, kLayoutMethodAutomatic))"); //####
+                bool isCurrent;
+
+                {
+                    const ScopedLock lock(_lock);
+
+                    // Only the entities that were placed are of interest.
+                    isCurrent = (_workingGeneration == _requestedGeneration);
+                    if (isCurrent)
+                    {
+                        _results.clear();
+                        for (LayoutNodes::const_iterator walker(nodes.begin());
+                             nodes.end() != walker; ++walker)
+                        {
+                            if (! walker->_pinned)
+                            {
+                                _results.push_back(*walker);
+                            }
+                        }
+                        _layoutIsComplete = true;
+                        ODL_B1("_layoutIsComplete <- ", _layoutIsComplete); //####
+                    }
+                }
+                if (isCurrent)
+                {
+                    // The results are ready, so it's safe for the foreground thread to apply
+                    // them - force a repaint of the displayed panel, which will retrieve them.
+                    triggerRepaint();
+                }
+            }
+        }
+        else
+        {
+            // Sleep until a layout is requested or the thread is told to exit.
+            wait(-1);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // LayoutThread::run
+
+void
+LayoutThread::triggerRepaint(void)
+{
+    ODL_OBJENTER(); //####
+    // Because this is a background thread, we mustn't do any UI work without first grabbing a
+    // MessageManagerLock.
+    const MessageManagerLock mml(Thread::getCurrentThread());
+
+    // If something is trying to kill this job, the lock will fail, in which case we'd better
+    // return.
+    if (mml.lockWasGained())
+    {
+        _owner.getEntitiesPanel().repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // LayoutThread::triggerRepaint
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
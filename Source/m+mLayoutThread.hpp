@@ -0,0 +1,234 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mLayoutThread.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the background layout of the entities displayed by the m+m
+//              manager application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmLayoutThread_HPP_))
+# define mpmLayoutThread_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the background layout of the entities displayed by the m+m
+ manager application. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class ContentPanel;
+    class ForceLayout;
+
+    /*! @brief A background layout thread.
+
+     The layout is calculated from a snapshot of the entities and their connections, so that the
+     displayed entities are never touched by the thread. Entities that have already been placed are
+     'pinned' and are not moved; only the new entities are positioned, close to the entities that
+     they are connected to. */
+    class LayoutThread : public Thread
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef Thread inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in,out] owner The panel that is to receive the results of the layout. */
+        explicit
+        LayoutThread(ContentPanel & owner);
+
+        /*! @brief The destructor. */
+        virtual
+        ~LayoutThread(void);
+
+        /*! @brief Returns @c true if the results of a layout are available and @c false otherwise.
+
+         Note that the results are only returned once; the next call will return @c false until
+         another layout has been completed.
+         @param[out] results The entities that were positioned by the layout.
+         @return @c true if the results of a layout are available and @c false otherwise. */
+        bool
+        checkAndClearIfLayoutIsComplete(LayoutNodes & results);
+
+        /*! @brief Position the entities.
+
+         This is normally called by the thread itself, but it can also be called directly on a
+         thread that hasn't been started, such as when measuring the layout methods.
+         @param[in,out] nodes The entities to be laid out.
+         @param[in] edges The connections between the entities.
+         @param[in] area The area in which unconnected entities are to be placed.
+         @param[in] method The method to be used to position the entities.
+         @return @c true if the layout was completed and @c false if it was abandoned. */
+        bool
+        computeLayout(LayoutNodes &                  nodes,
+                      const LayoutEdges &            edges,
+                      const juce::Rectangle<float> & area,
+                      const LayoutMethod             method);
+
+        /*! @brief Returns @c true if the layout in progress is no longer wanted.
+         @return @c true if the thread is exiting or a newer layout has been requested and
+         @c false otherwise. */
+        bool
+        layoutIsObsolete(void);
+
+        /*! @brief Request that a layout be performed, replacing any layout that is in progress.
+         @param[in] nodes The entities to be laid out.
+         @param[in] edges The connections between the entities.
+         @param[in] area The area in which unconnected entities are to be placed. */
+        void
+        requestLayout(const LayoutNodes &            nodes,
+                      const LayoutEdges &            edges,
+                      const juce::Rectangle<float> & area);
+
+    protected :
+
+    private :
+
+        /*! @brief Position the entities that are not pinned, leaving the pinned entities in place.
+         @param[in,out] nodes The entities to be laid out.
+         @param[in] edges The connections between the entities.
+         @param[in] area The area in which unconnected entities are to be placed.
+         @return @c true if the layout was completed and @c false if it was abandoned. */
+        bool
+        computeIncrementalLayout(LayoutNodes &                  nodes,
+                                 const LayoutEdges &            edges,
+                                 const juce::Rectangle<float> & area);
+
+        /*! @brief Position all the entities, using the built-in force-directed layout.
+         @param[in,out] nodes The entities to be laid out.
+         @param[in] edges The connections between the entities.
+         @param[in] area The area in which the entities are to be placed.
+         @return @c true if the layout was completed and @c false if it was abandoned. */
+        bool
+        computeForceLayout(LayoutNodes &                  nodes,
+                           const LayoutEdges &            edges,
+                           const juce::Rectangle<float> & area);
+
+# if defined(USE_OGDF_POSITIONING_)
+        /*! @brief Position all the entities, using an energy-based layout.
+         @param[in,out] nodes The entities to be laid out.
+         @param[in] edges The connections between the entities.
+         @param[in] area The area in which unconnected entities are to be placed.
+         @return @c true if the layout was completed and @c false if it was abandoned. */
+        bool
+        computeOgdfLayout(LayoutNodes &                  nodes,
+                          const LayoutEdges &            edges,
+                          const juce::Rectangle<float> & area);
+# endif // defined(USE_OGDF_POSITIONING_)
+
+        /*! @brief Perform the background layout. */
+        virtual void
+        run(void);
+
+        /*! @brief Tell the displayed panel to do a repaint. */
+        void
+        triggerRepaint(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The panel that is to receive the results of the layout. */
+        ContentPanel & _owner;
+
+        /*! @brief A lock to manage access to shared resources. */
+        CriticalSection _lock;
+
+        /*! @brief The built-in force-directed layout, for graphs with no pinned entities. */
+        ScopedPointer<ForceLayout> _forceLayout;
+
+        /*! @brief The random number generator for the initial positions of entities. */
+        Random _randomizer;
+
+        /*! @brief The area for the requested layout. */
+        juce::Rectangle<float> _requestedArea;
+
+        /*! @brief The connections for the requested layout. */
+        LayoutEdges _requestedEdges;
+
+        /*! @brief The entities for the requested layout. */
+        LayoutNodes _requestedNodes;
+
+        /*! @brief The entities that were positioned by the most recently completed layout. */
+        LayoutNodes _results;
+
+        /*! @brief The sequence number of the most recently requested layout. */
+        int64 _requestedGeneration;
+
+        /*! @brief The sequence number of the layout in progress. */
+        int64 _workingGeneration;
+
+        /*! @brief @c true if the results of a layout are available and @c false otherwise. */
+        bool _layoutIsComplete;
+
+        /*! @brief @c true if a layout has been requested but not yet started and @c false
+         otherwise. */
+        bool _layoutRequested;
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[6];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LayoutThread)
+
+    }; // LayoutThread
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmLayoutThread_HPP_)
@@ -1195,7 +1195,7 @@ ManagerApplication::initialise(const String & commandLine)
 
         entities.recallPositions();
         _peeker = new Common::GeneralChannel(false);
-        _peekHandler = new PeekInputHandler;
+        _peekHandler = new PeekInputHandler(&_mainWindow->getTimingRecorder());
         if (_peeker && _peekHandler)
         {
 #if defined(MpM_ReportOnConnections)
@@ -1359,6 +1359,11 @@ ManagerApplication::shutdown(void)
     _peeker->close();
 #endif // defined(MpM_DoExplicitClose)
     Common::GeneralChannel::RelinquishChannel(_peeker);
+    // The status handler records events in the timing recorder of the window.
+    if (_peekHandler)
+    {
+        _peekHandler->detachTimingRecorder();
+    }
     _mainWindow = NULL; // (deletes our window)
     yarp::os::Network::fini();
     _yarp = NULL;
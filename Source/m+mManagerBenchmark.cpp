@@ -0,0 +1,896 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mManagerBenchmark.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   A benchmark of the layout and drawing of entities for the m+m manager application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mChannelContainer.hpp"
+#include "m+mChannelEntry.hpp"
+#include "m+mContentPanel.hpp"
+#include "m+mEntitiesData.hpp"
+#include "m+mEntitiesPanel.hpp"
+#include "m+mEntityData.hpp"
+#include "m+mLayoutThread.hpp"
+#include "m+mPortData.hpp"
+#include "m+mPositionStore.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief A benchmark of the layout and drawing of entities for the m+m manager application.
+
+ Synthetic sets of entities are fed through the same steps that the application uses for the
+ results of a scan, and each step is timed. The entities are never shown on the screen and no
+ YARP network is needed, so the benchmark can be run on a machine without a display. The results
+ are written to the standard output as comma-separated values, one measurement per line. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The shapes of the synthetic sets of entities. */
+enum TopologyKind
+{
+    /*! @brief Client entities, each connected to one of a smaller number of services. */
+    kTopologyKindBipartite,
+
+    /*! @brief Entities connected one after another. */
+    kTopologyKindChain,
+
+    /*! @brief Entities with connections to randomly chosen entities. */
+    kTopologyKindRandom,
+
+    /*! @brief Entities that are all connected to a single hub entity. */
+    kTopologyKindStar,
+
+    /*! @brief The number of shapes. */
+    kTopologyKindCount
+
+}; // TopologyKind
+
+/*! @brief The details of a measurement that are reported along with its duration. */
+struct RunDetails
+{
+    /*! @brief The name of the shape of the set of entities. */
+    const char * _topology;
+
+    /*! @brief The number of connections between the entities. */
+    size_t _connections;
+
+    /*! @brief The number of entities. */
+    size_t _entities;
+
+    /*! @brief The repetition of the measurements, starting from one. */
+    int _repetition;
+
+}; // RunDetails
+
+/*! @brief The behavioural models that are given to the synthetic entities, in turn. */
+static const char * kBehaviours[] =
+{
+    "filter", "input", "output", "adapter"
+};
+
+/*! @brief The default sizes of the drawing area. */
+static const char * kDefaultDrawingArea = "1600x1200";
+
+/*! @brief The default numbers of entities in each set. */
+static const char * kDefaultSizes = "100,1000,5000";
+
+/*! @brief The name reported for the measurements of connections from one port to many others. */
+static const char * kFanOutName = "fanout";
+
+/*! @brief The name reported for the measurements of loading and saving remembered positions. */
+static const char * kPositionsName = "positions";
+
+/*! @brief The name reported for the measurements of drawing with the panel zoomed out. */
+static const char * kZoomedOutName = "zoomedout";
+
+/*! @brief The names of the shapes of the sets of entities, in the order of TopologyKind. */
+static const char * kTopologyNames[kTopologyKindCount] =
+{
+    "bipartite", "chain", "random", "star"
+};
+
+/*! @brief The number of clients for each service, for the bipartite shape. */
+static const int kClientsPerService = 4;
+
+/*! @brief The default number of times that the measurements are repeated. */
+static const int kDefaultRepetitions = 3;
+
+/*! @brief The number of connections from the single port, for the fan-out measurement. */
+static const size_t kFanOutSize = 1000;
+
+/*! @brief The number of remembered positions, for the positions measurement; this is the
+ largest number that the application keeps. */
+static const size_t kPositionsSize = 100000;
+
+/*! @brief The number of entities in each row of the grid, for the zoomed-out measurement. */
+static const size_t kZoomedOutColumns = 100;
+
+/*! @brief The number of entities, for the zoomed-out measurement. */
+static const size_t kZoomedOutSize = 10000;
+
+/*! @brief The scale of the panel, for the zoomed-out measurement; this is the smallest scale that
+ is offered. */
+static const float kZoomedOutLevel = 0.05f;
+
+/*! @brief The distance between the entities, for the zoomed-out measurement. */
+static const int kZoomedOutSpacing = 300;
+
+/*! @brief The number of different hosts that the entities are spread over. */
+static const int kHostCount = 16;
+
+/*! @brief The number of connections from each entity, for the random shape. */
+static const int kRandomConnectionsPerEntity = 2;
+
+/*! @brief The seed for the random shape, so that every run sees the same connections. */
+static const int64 kRandomSeed = 20151019;
+
+/*! @brief The longest time, in milliseconds, to wait for the layout thread. */
+static const double kLayoutTimeLimit = 600000;
+
+/*! @brief One entity in this many is moved by the incremental layout; the rest are pinned. */
+static const size_t kIncrementalLayoutStride = 10;
+
+#if defined(USE_OGDF_POSITIONING_)
+/*! @brief The largest number of entities that are laid out by OGDF; it gets slow very quickly
+ for larger graphs. */
+static const size_t kMaximumOgdfEntities = 5000;
+#endif // defined(USE_OGDF_POSITIONING_)
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Add a synthetic entity to a set of entities.
+
+ The entity has a port for requests, as well as an input and an output channel that can be
+ connected to the channels of the other entities.
+ @param[in,out] workingData The set of entities to be added to.
+ @param[in] topology The shape of the set of entities.
+ @param[in] index The position of the entity in the set.
+ @param[in] kind The kind of entity.
+ @return The name of the entity, which is also the name of its port for requests. */
+static YarpString
+addSyntheticEntity(EntitiesData &      workingData,
+                   const TopologyKind  topology,
+                   const size_t        index,
+                   const ContainerKind kind)
+{
+    String       indexAsString(static_cast<int64>(index));
+    YarpString   name((String("/bench/") + kTopologyNames[topology] + "/" +
+                       indexAsString).toStdString());
+    EntityData * anEntity = new EntityData(kind, name,
+                                           kBehaviours[index % numElementsInArray(kBehaviours)],
+                                           "A synthetic entity", "", "");
+
+    anEntity->setIPAddress((String("10.0.0.") + String(index % kHostCount)).toStdString());
+    anEntity->addPort(name, "", "", kPortUsageService,
+                      kPortDirectionInput)->setPortNumber(indexAsString.toStdString());
+    anEntity->addPort(name + "/in", "", "", kPortUsageInputOutput, kPortDirectionInput);
+    anEntity->addPort(name + "/out", "", "", kPortUsageInputOutput, kPortDirectionOutput);
+    if (kContainerKindAdapter == kind)
+    {
+        anEntity->addPort(name + "/client", "", "", kPortUsageClient, kPortDirectionInputOutput);
+    }
+    workingData.addEntity(anEntity);
+    return name;
+} // addSyntheticEntity
+
+/*! @brief Fill in a set of entities with a given shape.
+ @param[in,out] workingData The set of entities to be filled in.
+ @param[in] topology The shape of the set of entities.
+ @param[in] numEntities The number of entities in the set. */
+static void
+buildTopology(EntitiesData &     workingData,
+              const TopologyKind topology,
+              const size_t       numEntities)
+{
+    Common::ChannelMode mode = Common::kChannelModeTCP;
+    YarpStringVector    names;
+    size_t              numServices = jmax(static_cast<size_t>(1),
+                                           numEntities / (kClientsPerService + 1));
+    Random              randomizer(kRandomSeed);
+
+    workingData.clearOutData();
+    for (size_t ii = 0; numEntities > ii; ++ii)
+    {
+        bool isClient = ((kTopologyKindBipartite == topology) && (numServices <= ii));
+
+        names.push_back(addSyntheticEntity(workingData, topology, ii,
+                                           isClient ? kContainerKindAdapter :
+                                           kContainerKindService));
+    }
+    for (size_t ii = 1; numEntities > ii; ++ii)
+    {
+        switch (topology)
+        {
+            case kTopologyKindBipartite :
+                if (numServices <= ii)
+                {
+                    workingData.addConnection(names[ii % numServices], names[ii] + "/client",
+                                              mode);
+                }
+                break;
+
+            case kTopologyKindChain :
+                workingData.addConnection(names[ii] + "/in", names[ii - 1] + "/out", mode);
+                break;
+
+            case kTopologyKindStar :
+                workingData.addConnection(names[0] + "/in", names[ii] + "/out", mode);
+                workingData.addConnection(names[ii] + "/in", names[0] + "/out", mode);
+                break;
+
+            default :
+                break;
+
+        }
+    }
+    if ((kTopologyKindRandom == topology) && (1 < numEntities))
+    {
+        for (size_t ii = 0; numEntities > ii; ++ii)
+        {
+            for (int jj = 0; kRandomConnectionsPerEntity > jj; ++jj)
+            {
+                // Pick any entity other than this one.
+                int    offset = randomizer.nextInt(static_cast<int>(numEntities - 1));
+                size_t other = (ii + 1 + static_cast<size_t>(offset)) % numEntities;
+
+                workingData.addConnection(names[other] + "/in", names[ii] + "/out", mode);
+            }
+        }
+    }
+} // buildTopology
+
+/*! @brief Return the number of milliseconds since a given time.
+ @param[in] startTime The time, in milliseconds, that the measurement started.
+ @return The number of milliseconds since the start time. */
+static double
+elapsedSince(const double startTime)
+{
+    return (Time::getMillisecondCounterHiRes() - startTime);
+} // elapsedSince
+
+/*! @brief Parse the numbers of entities to be measured.
+ @param[in] sizeList A comma-separated list of numbers of entities.
+ @param[out] sizes The numbers of entities.
+ @return @c true if the list was valid and @c false otherwise. */
+static bool
+parseSizes(const String &        sizeList,
+           std::vector<size_t> & sizes)
+{
+    bool        okSoFar = true;
+    StringArray pieces;
+
+    sizes.clear();
+    pieces.addTokens(sizeList, ",", "");
+    for (int ii = 0; okSoFar && (pieces.size() > ii); ++ii)
+    {
+        String aPiece(pieces[ii].trim());
+
+        if (aPiece.containsOnly("0123456789") && aPiece.isNotEmpty())
+        {
+            sizes.push_back(static_cast<size_t>(aPiece.getLargeIntValue()));
+        }
+        else
+        {
+            okSoFar = false;
+        }
+    }
+    return (okSoFar && (0 < sizes.size()));
+} // parseSizes
+
+/*! @brief Discard the cached appearance of the entities, so that it is recalculated by the next
+ drawing, as was done for every frame before it was cached.
+ @param[in,out] entitiesPanel The panel containing the entities.
+ @param[in] geometry @c true if the appearance of the connections is to be discarded.
+ @param[in] titles @c true if the arrangement of the text of the entities is to be discarded. */
+static void
+invalidateCaches(EntitiesPanel & entitiesPanel,
+                 const bool      geometry,
+                 const bool      titles)
+{
+    for (size_t ii = 0, mm = entitiesPanel.getNumberOfEntities(); mm > ii; ++ii)
+    {
+        ChannelContainer * anEntity = entitiesPanel.getEntity(ii);
+
+        if (anEntity)
+        {
+            if (geometry)
+            {
+                anEntity->invalidateConnectionGeometry();
+            }
+            if (titles)
+            {
+                anEntity->invalidateTitleLayouts();
+            }
+        }
+    }
+    // The connections are drawn into a layer that is kept between frames.
+    entitiesPanel.invalidateConnectionsLayer();
+} // invalidateCaches
+
+/*! @brief Draw the entities into an image, as would be done when the window is repainted.
+ @param[in] entitiesPanel The panel containing the entities.
+ @param[in,out] canvas The image to be drawn into.
+ @return The number of milliseconds that the drawing took. */
+static double
+timeDrawing(EntitiesPanel & entitiesPanel,
+            Image &         canvas)
+{
+    Graphics gg(canvas);
+    double   startTime = Time::getMillisecondCounterHiRes();
+
+    // The panel is drawn at its scale, as it would be by the viewport that holds it.
+    gg.addTransform(AffineTransform::scale(entitiesPanel.getZoomLevel()));
+    entitiesPanel.paintEntireComponent(gg, false);
+    return elapsedSince(startTime);
+} // timeDrawing
+
+/*! @brief Draw each entity into an image of its own, to find the cost of drawing one entity.
+ @param[in] entitiesPanel The panel containing the entities.
+ @param[in] uncached @c true if the arrangement of the text of each entity is to be discarded
+ before it is drawn.
+ @param[out] meanDuration The average number of milliseconds that drawing an entity took.
+ @param[out] maxDuration The largest number of milliseconds that drawing an entity took. */
+static void
+timeEntityDrawing(EntitiesPanel & entitiesPanel,
+                  const bool      uncached,
+                  double &        meanDuration,
+                  double &        maxDuration)
+{
+    double totalDuration = 0;
+    size_t numDrawn = 0;
+
+    maxDuration = 0;
+    for (size_t ii = 0, mm = entitiesPanel.getNumberOfEntities(); mm > ii; ++ii)
+    {
+        ChannelContainer * anEntity = entitiesPanel.getEntity(ii);
+
+        if (anEntity && (0 < anEntity->getWidth()) && (0 < anEntity->getHeight()))
+        {
+            Image    canvas(Image::ARGB, anEntity->getWidth(), anEntity->getHeight(), true);
+            Graphics gg(canvas);
+            double   duration;
+            double   startTime;
+
+            if (uncached)
+            {
+                anEntity->invalidateTitleLayouts();
+            }
+            startTime = Time::getMillisecondCounterHiRes();
+            anEntity->paintEntireComponent(gg, false);
+            duration = elapsedSince(startTime);
+            totalDuration += duration;
+            maxDuration = jmax(maxDuration, duration);
+            ++numDrawn;
+        }
+    }
+    meanDuration = ((0 < numDrawn) ? (totalDuration / numDrawn) : 0);
+} // timeEntityDrawing
+
+/*! @brief Lay out a copy of the entities on the calling thread.
+ @param[in,out] scratch A layout thread that is not running, to perform the layout.
+ @param[in] nodes The entities to be laid out.
+ @param[in] edges The connections between the entities.
+ @param[in] area The area to lay the entities out within.
+ @param[in] method The layout algorithm to be used.
+ @param[in] stride If non-zero, all entities but one in this many are pinned in place.
+ @return The number of milliseconds that the layout took. */
+static double
+timeLayout(LayoutThread &                 scratch,
+           const LayoutNodes &            nodes,
+           const LayoutEdges &            edges,
+           const juce::Rectangle<float> & area,
+           const LayoutMethod             method,
+           const size_t                   stride)
+{
+    double      startTime;
+    LayoutNodes workingNodes(nodes);
+
+    for (size_t ii = 0, mm = workingNodes.size(); mm > ii; ++ii)
+    {
+        workingNodes[ii]._pinned = ((0 < stride) && (0 != (ii % stride)));
+    }
+    startTime = Time::getMillisecondCounterHiRes();
+    scratch.computeLayout(workingNodes, edges, area, method);
+    return elapsedSince(startTime);
+} // timeLayout
+
+/*! @brief Write out a measurement.
+ @param[in,out] outStream The stream to write to.
+ @param[in] details The description of the set of entities that was measured.
+ @param[in] phase The name of the step that was measured.
+ @param[in] duration The number of milliseconds that the step took. */
+static void
+reportMeasurement(std::ostream &     outStream,
+                  const RunDetails & details,
+                  const char *       phase,
+                  const double       duration)
+{
+    outStream << details._topology << "," << details._entities << "," <<
+                details._connections << "," << details._repetition << "," << phase << "," <<
+                std::fixed << std::setprecision(3) << duration << std::endl;
+} // reportMeasurement
+
+/*! @brief Wait for the layout thread of a panel to finish and apply its results.
+ @param[in,out] panel The panel that requested a layout.
+ @return @c true if the layout was applied and @c false if it took too long. */
+static bool
+waitForLayout(ContentPanel & panel)
+{
+    bool   done = false;
+    double limit = Time::getMillisecondCounterHiRes() + kLayoutTimeLimit;
+
+    while ((! done) && (Time::getMillisecondCounterHiRes() < limit))
+    {
+        // The layout thread locks the message thread to ask for a repaint, so messages have to
+        // be dispatched while waiting.
+        MessageManager::getInstance()->runDispatchLoopUntil(1);
+        done = panel.applyCompletedLayout();
+    }
+    return done;
+} // waitForLayout
+
+/*! @brief Measure adding, finding and removing the connections from one port to many others.
+ @param[in] repetition The repetition of the measurements, starting from one. */
+static void
+measureFanOut(const int repetition)
+{
+    Common::ChannelMode         mode = Common::kChannelModeTCP;
+    EntitiesData                workingData;
+    RunDetails                  details;
+    ScopedPointer<ContentPanel> panel(new ContentPanel(NULL));
+    EntitiesPanel &             entitiesPanel = panel->getEntitiesPanel();
+    YarpStringVector            names;
+    std::vector<ChannelEntry *> others;
+    ChannelEntry *              hub;
+    double                      startTime;
+    size_t                      found = 0;
+
+    for (size_t ii = 0; kFanOutSize >= ii; ++ii)
+    {
+        names.push_back(addSyntheticEntity(workingData, kTopologyKindStar, ii,
+                                           kContainerKindService));
+    }
+    panel->updatePanels(workingData);
+    hub = entitiesPanel.findKnownPort(names[0] + "/out");
+    for (size_t ii = 1; kFanOutSize >= ii; ++ii)
+    {
+        others.push_back(entitiesPanel.findKnownPort(names[ii] + "/in"));
+    }
+    details._topology = kFanOutName;
+    details._connections = kFanOutSize;
+    details._entities = kFanOutSize + 1;
+    details._repetition = repetition;
+    startTime = Time::getMillisecondCounterHiRes();
+    for (size_t ii = 0; kFanOutSize > ii; ++ii)
+    {
+        hub->addOutputConnection(others[ii], mode, false);
+        others[ii]->addInputConnection(hub, mode, false);
+    }
+    reportMeasurement(cout, details, "fanOutAdd", elapsedSince(startTime));
+    startTime = Time::getMillisecondCounterHiRes();
+    for (size_t ii = 0; kFanOutSize > ii; ++ii)
+    {
+        if (hub->hasOutgoingConnectionTo(others[ii]->getPortName()))
+        {
+            ++found;
+        }
+    }
+    reportMeasurement(cout, details, "fanOutLookup", elapsedSince(startTime));
+    if (kFanOutSize != found)
+    {
+        cerr << "Only " << found << " of the " << kFanOutSize <<
+                " fan-out connections were found." << endl;
+    }
+    // Remove every second connection first, so that most removals are from the middle of the set;
+    // the connections are walked at the end so that closing up the gaps is included.
+    startTime = Time::getMillisecondCounterHiRes();
+    for (size_t jj = 0; 2 > jj; ++jj)
+    {
+        for (size_t ii = jj; kFanOutSize > ii; ii += 2)
+        {
+            hub->removeOutputConnection(others[ii]);
+            others[ii]->removeInputConnection(hub);
+        }
+    }
+    hub->getOutputConnections();
+    reportMeasurement(cout, details, "fanOutRemove", elapsedSince(startTime));
+} // measureFanOut
+
+/*! @brief Measure saving and loading a large set of remembered positions.
+ @param[in] repetition The repetition of the measurements, starting from one. */
+static void
+measurePositions(const int repetition)
+{
+    PositionStore reloaded(0, kPositionsSize);
+    PositionStore store(0, kPositionsSize);
+    RunDetails    details;
+    TemporaryFile scratch;
+    double        startTime;
+
+    details._topology = kPositionsName;
+    details._connections = 0;
+    details._entities = kPositionsSize;
+    details._repetition = repetition;
+    startTime = Time::getMillisecondCounterHiRes();
+    for (size_t ii = 0; kPositionsSize > ii; ++ii)
+    {
+        YarpString name((String("/bench/") + kPositionsName + "/" +
+                         String(static_cast<int64>(ii))).toStdString());
+
+        store.remember(name, Position(static_cast<float>(ii % kZoomedOutColumns) *
+                                      kZoomedOutSpacing,
+                                      static_cast<float>(ii / kZoomedOutColumns) *
+                                      kZoomedOutSpacing));
+    }
+    reportMeasurement(cout, details, "positionsRemember", elapsedSince(startTime));
+    startTime = Time::getMillisecondCounterHiRes();
+    if (! store.save(scratch.getFile()))
+    {
+        cerr << "The remembered positions could not be saved." << endl;
+    }
+    reportMeasurement(cout, details, "positionsSave", elapsedSince(startTime));
+    startTime = Time::getMillisecondCounterHiRes();
+    if (! reloaded.load(scratch.getFile()))
+    {
+        cerr << "The remembered positions could not be loaded." << endl;
+    }
+    reportMeasurement(cout, details, "positionsLoad", elapsedSince(startTime));
+    if (store.size() != reloaded.size())
+    {
+        cerr << "Only " << reloaded.size() << " of the " << store.size() <<
+                " remembered positions were loaded." << endl;
+    }
+} // measurePositions
+
+/*! @brief Measure the steps that are performed for a set of entities.
+ @param[in] workingData The set of entities.
+ @param[in] details The description of the set of entities.
+ @param[in] areaWidth The width of the drawing area.
+ @param[in] areaHeight The height of the drawing area. */
+static void
+measureSteps(const EntitiesData & workingData,
+             const RunDetails &   details,
+             const int            areaWidth,
+             const int            areaHeight)
+{
+    Image                       canvas(Image::ARGB, areaWidth, areaHeight, true);
+    juce::Rectangle<float>      area;
+    LayoutEdges                 edges;
+    LayoutNodes                 nodes;
+    ScopedPointer<ContentPanel> panel(new ContentPanel(NULL));
+    EntitiesPanel &             entitiesPanel = panel->getEntitiesPanel();
+    double                      maxDuration;
+    double                      meanDuration;
+    double                      startTime;
+
+    panel->setSize(areaWidth, areaHeight);
+    startTime = Time::getMillisecondCounterHiRes();
+    panel->updatePanels(workingData);
+    reportMeasurement(cout, details, "updatePanels", elapsedSince(startTime));
+    entitiesPanel.updateClusters();
+    startTime = Time::getMillisecondCounterHiRes();
+    panel->setEntityPositions();
+    reportMeasurement(cout, details, "setEntityPositions", elapsedSince(startTime));
+    startTime = Time::getMillisecondCounterHiRes();
+    if (waitForLayout(*panel))
+    {
+        reportMeasurement(cout, details, "layoutBackground", elapsedSince(startTime));
+    }
+    else
+    {
+        cerr << "Layout of " << details._entities << " " << details._topology <<
+                " entities did not finish in time." << endl;
+    }
+    startTime = Time::getMillisecondCounterHiRes();
+    panel->updatePanels(workingData);
+    reportMeasurement(cout, details, "updatePanelsRepeat", elapsedSince(startTime));
+    panel->collectLayoutInput(nodes, edges, area);
+    LayoutThread scratch(*panel);
+
+    reportMeasurement(cout, details, "layoutForce",
+                      timeLayout(scratch, nodes, edges, area, kLayoutMethodForce, 0));
+#if defined(USE_OGDF_POSITIONING_)
+    if (kMaximumOgdfEntities >= nodes.size())
+    {
+        reportMeasurement(cout, details, "layoutOgdf",
+                          timeLayout(scratch, nodes, edges, area, kLayoutMethodOgdf, 0));
+    }
+#endif // defined(USE_OGDF_POSITIONING_)
+    reportMeasurement(cout, details, "layoutIncremental",
+                      timeLayout(scratch, nodes, edges, area, kLayoutMethodIncremental,
+                                 kIncrementalLayoutStride));
+    entitiesPanel.setDrawEntitiesDirectly(false);
+    entitiesPanel.invalidateSpatialIndex();
+    reportMeasurement(cout, details, "paintComponentsFirst", timeDrawing(entitiesPanel, canvas));
+    reportMeasurement(cout, details, "paintComponents", timeDrawing(entitiesPanel, canvas));
+    entitiesPanel.setDrawEntitiesDirectly(true);
+    entitiesPanel.invalidateSpatialIndex();
+    reportMeasurement(cout, details, "paintDirectFirst", timeDrawing(entitiesPanel, canvas));
+    reportMeasurement(cout, details, "paintDirect", timeDrawing(entitiesPanel, canvas));
+    // Compare frames that recalculate the connection geometry or the text arrangement, as every
+    // frame did before they were cached, with frames that use the caches.
+    entitiesPanel.setDrawEntitiesDirectly(false);
+    invalidateCaches(entitiesPanel, true, false);
+    reportMeasurement(cout, details, "paintUncachedGeometry", timeDrawing(entitiesPanel, canvas));
+    invalidateCaches(entitiesPanel, false, true);
+    reportMeasurement(cout, details, "paintUncachedTitles", timeDrawing(entitiesPanel, canvas));
+    invalidateCaches(entitiesPanel, false, false);
+    reportMeasurement(cout, details, "paintCached", timeDrawing(entitiesPanel, canvas));
+    timeEntityDrawing(entitiesPanel, true, meanDuration, maxDuration);
+    reportMeasurement(cout, details, "paintEntityUncachedMean", meanDuration);
+    reportMeasurement(cout, details, "paintEntityUncachedMax", maxDuration);
+    timeEntityDrawing(entitiesPanel, false, meanDuration, maxDuration);
+    reportMeasurement(cout, details, "paintEntityMean", meanDuration);
+    reportMeasurement(cout, details, "paintEntityMax", maxDuration);
+} // measureSteps
+
+/*! @brief Measure the drawing of a large set of entities with the panel zoomed out, where most of
+ the entries are too small to be seen.
+ @param[in] repetition The repetition of the measurements, starting from one.
+ @param[in] areaWidth The width of the drawing area.
+ @param[in] areaHeight The height of the drawing area. */
+static void
+measureZoomedOut(const int repetition,
+                 const int areaWidth,
+                 const int areaHeight)
+{
+    EntitiesData                workingData;
+    Image                       canvas(Image::ARGB, areaWidth, areaHeight, true);
+    RunDetails                  details;
+    ScopedPointer<ContentPanel> panel(new ContentPanel(NULL));
+    EntitiesPanel &             entitiesPanel = panel->getEntitiesPanel();
+
+    buildTopology(workingData, kTopologyKindRandom, kZoomedOutSize);
+    details._topology = kZoomedOutName;
+    details._connections = workingData.getConnections().size();
+    details._entities = workingData.getNumberOfEntities();
+    details._repetition = repetition;
+    panel->setSize(areaWidth, areaHeight);
+    panel->updatePanels(workingData);
+    // The entities are placed on a grid, rather than laid out, so that every run draws the same
+    // picture.
+    for (size_t ii = 0, mm = entitiesPanel.getNumberOfEntities(); mm > ii; ++ii)
+    {
+        ChannelContainer * anEntity = entitiesPanel.getEntity(ii);
+
+        if (anEntity)
+        {
+            anEntity->setTopLeftPosition(static_cast<int>(ii % kZoomedOutColumns) *
+                                         kZoomedOutSpacing,
+                                         static_cast<int>(ii / kZoomedOutColumns) *
+                                         kZoomedOutSpacing);
+        }
+    }
+    entitiesPanel.setZoomLevel(kZoomedOutLevel);
+    entitiesPanel.setDrawEntitiesDirectly(false);
+    entitiesPanel.invalidateSpatialIndex();
+    reportMeasurement(cout, details, "paintComponentsFirst", timeDrawing(entitiesPanel, canvas));
+    reportMeasurement(cout, details, "paintComponents", timeDrawing(entitiesPanel, canvas));
+    entitiesPanel.setDrawEntitiesDirectly(true);
+    entitiesPanel.invalidateSpatialIndex();
+    reportMeasurement(cout, details, "paintDirectFirst", timeDrawing(entitiesPanel, canvas));
+    reportMeasurement(cout, details, "paintDirect", timeDrawing(entitiesPanel, canvas));
+} // measureZoomedOut
+
+/*! @brief Report how the benchmark is to be run.
+ @param[in] progName The name of the executable. */
+static void
+showUsage(const char * progName)
+{
+    cerr << "Usage: " << progName << " [-t topology] [-n sizes] [-r repetitions] [-a area]" <<
+            endl;
+    cerr << "  topology    one of bipartite, chain, fanout, positions, random, star, zoomedout" <<
+            " or all (default all)" << endl;
+    cerr << "  sizes       comma-separated numbers of entities (default " << kDefaultSizes <<
+            ")" << endl;
+    cerr << "  repetitions number of times to measure each set (default " <<
+            kDefaultRepetitions << ")" << endl;
+    cerr << "  area        size of the drawing area, as WIDTHxHEIGHT (default " <<
+            kDefaultDrawingArea << ")" << endl;
+} // showUsage
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and destructors
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Actions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Accessors
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
+
+/*! @brief The entry point for the benchmark.
+
+ The first argument is the name of the executable and the remaining arguments are the options
+ described by showUsage().
+ @param[in] argc The number of arguments.
+ @param[in] argv The arguments.
+ @return @c 0 on a successful run and @c 1 on failure. */
+int
+main(int     argc,
+     char ** argv)
+{
+    ODL_ENTER(); //####
+    bool                okSoFar = true;
+    int                 areaHeight = 0;
+    int                 areaWidth = 0;
+    int                 repetitions = kDefaultRepetitions;
+    String              areaSpec(kDefaultDrawingArea);
+    String              topologyName("all");
+    std::vector<size_t> sizes;
+
+    parseSizes(kDefaultSizes, sizes);
+    for (int ii = 1; okSoFar && (argc > ii); ii += 2)
+    {
+        String option(argv[ii]);
+
+        if (argc <= (ii + 1))
+        {
+            okSoFar = false;
+        }
+        else if (option == "-a")
+        {
+            areaSpec = argv[ii + 1];
+        }
+        else if (option == "-n")
+        {
+            okSoFar = parseSizes(argv[ii + 1], sizes);
+        }
+        else if (option == "-r")
+        {
+            repetitions = String(argv[ii + 1]).getIntValue();
+            okSoFar = (0 < repetitions);
+        }
+        else if (option == "-t")
+        {
+            topologyName = argv[ii + 1];
+        }
+        else
+        {
+            okSoFar = false;
+        }
+    }
+    if (okSoFar)
+    {
+        areaWidth = areaSpec.upToFirstOccurrenceOf("x", false, true).getIntValue();
+        areaHeight = areaSpec.fromFirstOccurrenceOf("x", false, true).getIntValue();
+        okSoFar = ((0 < areaWidth) && (0 < areaHeight));
+    }
+    if (okSoFar && (topologyName != "all"))
+    {
+        okSoFar = ((topologyName == kFanOutName) || (topologyName == kPositionsName) ||
+                   (topologyName == kZoomedOutName) ||
+                   StringArray(kTopologyNames, kTopologyKindCount).contains(topologyName));
+    }
+    if (okSoFar)
+    {
+        // The GUI parts of JUCE, including the message manager, are started, as the components
+        // and the layout thread need them; no window is ever shown.
+        ScopedJuceInitialiser_GUI juceSystem;
+
+        cout << "topology,entities,connections,repetition,phase,duration_ms" << endl;
+        if ((topologyName == "all") || (topologyName == kFanOutName))
+        {
+            for (int jj = 1; repetitions >= jj; ++jj)
+            {
+                measureFanOut(jj);
+            }
+        }
+        if ((topologyName == "all") || (topologyName == kPositionsName))
+        {
+            for (int jj = 1; repetitions >= jj; ++jj)
+            {
+                measurePositions(jj);
+            }
+        }
+        if ((topologyName == "all") || (topologyName == kZoomedOutName))
+        {
+            for (int jj = 1; repetitions >= jj; ++jj)
+            {
+                measureZoomedOut(jj, areaWidth, areaHeight);
+            }
+        }
+        for (int kk = 0; kTopologyKindCount > kk; ++kk)
+        {
+            TopologyKind topology = static_cast<TopologyKind>(kk);
+
+            if ((topologyName == "all") || (topologyName == kTopologyNames[topology]))
+            {
+                for (size_t ii = 0, mm = sizes.size(); mm > ii; ++ii)
+                {
+                    EntitiesData workingData;
+                    RunDetails   details;
+
+                    buildTopology(workingData, topology, sizes[ii]);
+                    details._topology = kTopologyNames[topology];
+                    details._connections = workingData.getConnections().size();
+                    details._entities = workingData.getNumberOfEntities();
+                    for (int jj = 1; repetitions >= jj; ++jj)
+                    {
+                        details._repetition = jj;
+                        measureSteps(workingData, details, areaWidth, areaHeight);
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        showUsage(argv[0]);
+    }
+    ODL_EXIT_I(okSoFar ? 0 : 1); //####
+    return (okSoFar ? 0 : 1);
+} // main
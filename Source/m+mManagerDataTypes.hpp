@@ -58,6 +58,7 @@
 # include <list>
 # include <map>
 # include <set>
+# include <unordered_map>
 # include <vector>
 
 # if defined(__APPLE__)
@@ -85,19 +86,22 @@
 /*! @brief The minimum time for a thread to sleep, in milliseconds. */
 # define SHORT_SLEEP_ (VERY_SHORT_SLEEP_ * 4)
 
-# define USE_OGDF_FOR_FIRST_POSITIONING_ONLY_ /* Use OGDF for the initial entity placement. */
-
-# define USE_OGDF_POSITIONING_ /* Use OGDF for new entity placement.*/
+# define USE_OGDF_POSITIONING_ /* Use OGDF for the initial placement of smaller graphs.*/
 
 /*! @brief A very short sleep, in milliseconds. */
 # define VERY_SHORT_SLEEP_ 5
 
 namespace MPlusM_Manager
 {
+    class ActivityConnectJob;
+    class ActivityInputHandler;
     class ChannelContainer;
     class ChannelEntry;
+    class EntityCluster;
     class EntityData;
+    class MetricsSeries;
     class PortData;
+    class ScrollingMonitorWindow;
 
     /*! @brief The anchor position for a connection between ports. */
     enum AnchorSide
@@ -119,6 +123,27 @@ namespace MPlusM_Manager
 
     }; // AnchorSide
 
+    /*! @brief The kinds of unusual behaviour that can be seen in the metrics of a channel or a
+     service, in increasing order of severity. */
+    enum AnomalyKind
+    {
+        /*! @brief Nothing unusual was seen. */
+        kAnomalyNone,
+
+        /*! @brief The channel is connected, but no traffic has passed through it recently. */
+        kAnomalyIdleConnection,
+
+        /*! @brief The traffic of the channel has dropped far below its recent level. */
+        kAnomalyRateDrop,
+
+        /*! @brief The counters of the service, which had been advancing, have stopped. */
+        kAnomalyStalledService,
+
+        /*! @brief The kind of anomaly is unknown. */
+        kAnomalyUnknown = 0x7FFFFFF
+
+    }; // AnomalyKind
+
     /*! @brief The kind of application. */
     enum ApplicationKind
     {
@@ -156,6 +181,20 @@ namespace MPlusM_Manager
 
     }; // ChannelPopupMenuSelection
 
+    /*! @brief How entities are grouped together. */
+    enum ClusterMode
+    {
+        /*! @brief The entities are not grouped. */
+        kClusterModeNone,
+
+        /*! @brief The entities are grouped by the IP address of their host. */
+        kClusterModeByAddress,
+
+        /*! @brief The entities are grouped by their behavioural model. */
+        kClusterModeByBehaviour
+
+    }; // ClusterMode
+
     /*! @brief The values to be returned by a configuration or settings window. */
     enum ConfigurationRequest
     {
@@ -199,11 +238,17 @@ namespace MPlusM_Manager
         /*! @brief Placeholder to ensure that the menu items don't start at zero. */
         kPopupEntityDummy = 0x2200,
 
+        /*! @brief Collapse the group containing the entity. */
+        kPopupCollapseGroup,
+
         /*! @brief Configure settings for an input / output service or adapter. */
         kPopupConfigureService,
 
-        /*! @brief Change the state of service metrics collection. */
-        kPopupDisplayChangeServiceMetrics,
+        /*! @brief Stop the collection of service metrics. */
+        kPopupDisableServiceMetrics,
+
+        /*! @brief Start the collection of service metrics. */
+        kPopupEnableServiceMetrics,
 
         /*! @brief Display detailed information request. */
         kPopupDetailedDisplayEntityInfo,
@@ -214,6 +259,9 @@ namespace MPlusM_Manager
         /*! @brief Display the channel metrics for a service or adapter. */
         kPopupDisplayServiceMetrics,
 
+        /*! @brief Expand a group of entities. */
+        kPopupExpandGroup,
+
         /*! @brief Hide the entity. */
         kPopupHideEntity,
 
@@ -225,6 +273,81 @@ namespace MPlusM_Manager
 
     }; // EntityPopupMenuSelection
 
+    /*! @brief The kinds of records in a flight recording. */
+    enum FlightRecordKind
+    {
+        /*! @brief The complete topology, to which the following changes are applied. */
+        kFlightRecordKeyframe,
+
+        /*! @brief The changes to the topology since the previous record. */
+        kFlightRecordDelta,
+
+        /*! @brief The metrics of the services. */
+        kFlightRecordMetrics,
+
+        /*! @brief Force the size to be 4 bytes. */
+        kFlightRecordUnknown = 0x7FFFFFF
+
+    }; // FlightRecordKind
+
+    /*! @brief The method used to position entities. */
+    enum LayoutMethod
+    {
+        /*! @brief Choose the method based on the entities to be positioned. */
+        kLayoutMethodAutomatic,
+
+        /*! @brief Position all the entities with the built-in force-directed layout. */
+        kLayoutMethodForce,
+
+        /*! @brief Position only the entities that are not pinned, leaving the others in place. */
+        kLayoutMethodIncremental,
+
+        /*! @brief Position all the entities with the OGDF energy-based layout, if it is
+         available. */
+        kLayoutMethodOgdf
+
+    }; // LayoutMethod
+
+    /*! @brief The resolution of the metrics history that is to be retrieved. */
+    enum MetricsResolution
+    {
+        /*! @brief Each point is a single sample. */
+        kMetricsResolutionRaw,
+
+        /*! @brief Each point summarizes the samples in one second. */
+        kMetricsResolutionSecond,
+
+        /*! @brief Each point summarizes the samples in one minute. */
+        kMetricsResolutionMinute,
+
+        /*! @brief Each point summarizes the samples in one hour. */
+        kMetricsResolutionHour,
+
+        /*! @brief The number of resolutions. */
+        kMetricsResolutionCount
+
+    }; // MetricsResolution
+
+    /*! @brief The kinds of traffic that are recorded for a channel. */
+    enum MetricsValue
+    {
+        /*! @brief The number of bytes received per second. */
+        kMetricsValueInBytes,
+
+        /*! @brief The number of messages received per second. */
+        kMetricsValueInMessages,
+
+        /*! @brief The number of bytes sent per second. */
+        kMetricsValueOutBytes,
+
+        /*! @brief The number of messages sent per second. */
+        kMetricsValueOutMessages,
+
+        /*! @brief The number of kinds of traffic. */
+        kMetricsValueCount
+
+    }; // MetricsValue
+
     /*! @brief The primary direction of the port. */
     enum PortDirection
     {
@@ -262,6 +385,52 @@ namespace MPlusM_Manager
 
     }; // PortUsage
 
+    /*! @brief What a timing sample measures. */
+    enum TimingKind
+    {
+        /*! @brief The time taken to draw a frame of the main window. */
+        kTimingKindPaint,
+
+        /*! @brief The time taken to refresh the displayed entities from a scan. */
+        kTimingKindUpdatePanels,
+
+        /*! @brief The time taken to position the entities after a scan. */
+        kTimingKindSetEntityPositions,
+
+        /*! @brief The time from the end of a scan to the frame that shows its results. */
+        kTimingKindScanLatency,
+
+        /*! @brief The time from a status report from the Registry Service to the frame that shows
+         the results of the following scan. */
+        kTimingKindRegistryLatency,
+
+        /*! @brief The number of kinds of timing samples. */
+        kTimingKindCount
+
+    }; // TimingKind
+
+    /*! @brief A hidden port that watches the traffic leaving a channel. */
+    struct ActivityProbe
+    {
+        /*! @brief The hidden port that is connected to the channel. */
+        MplusM::Common::GeneralChannel * _channel;
+
+        /*! @brief The job that is opening the hidden port and connecting it to the channel, or
+         @c NULL once the channel is connected. */
+        ActivityConnectJob * _connector;
+
+        /*! @brief The handler that counts the traffic arriving at the hidden port. */
+        ActivityInputHandler * _handler;
+
+        /*! @brief The scrolling monitor for the channel, or @c NULL if there is none. */
+        ScrollingMonitorWindow * _monitor;
+
+        /*! @brief @c true if the activity indicator of the channel is enabled and @c false
+         otherwise. */
+        bool _showIndicator;
+
+    }; // ActivityProbe
+
     /*! @brief The information used to launch an application. */
     struct ApplicationInfo
     {
@@ -288,12 +457,75 @@ namespace MPlusM_Manager
 
     }; // ApplicationInfo
 
+    /*! @brief The precalculated appearance of a connection, in the coordinates of the entities
+     panel. */
+    struct ConnectionGeometry
+    {
+        /*! @brief The outline of the curve of the connection, ready to be filled. */
+        Path _curve;
+
+        /*! @brief The outlines of the anchors at both ends of the connection, ready to be
+         filled. */
+        Path _anchors;
+
+        /*! @brief The curve of the connection, for hit testing. */
+        Path _centreline;
+
+        /*! @brief The area covered by the curve and the anchors. */
+        juce::Rectangle<float> _bounds;
+
+        /*! @brief @c true if the appearance matches the current positions of the ends of the
+         connection and @c false if it must be recalculated. */
+        bool _valid;
+
+    }; // ConnectionGeometry
+
+    /*! @brief The running statistics of the traffic of a channel, used to notice when it
+     changes. */
+    struct ChannelBaseline
+    {
+        /*! @brief The name of the channel. */
+        YarpString _channelName;
+
+        /*! @brief The exponentially-weighted mean of the byte rate of the channel. */
+        double _meanRate;
+
+        /*! @brief The exponentially-weighted variance of the byte rate of the channel. */
+        double _rateVariance;
+
+        /*! @brief The total number of bytes sent and received by the channel, as of the previous
+         sample. */
+        int64 _lastBytes;
+
+        /*! @brief The number of consecutive samples in which the channel had no traffic. */
+        int _idleCount;
+
+        /*! @brief The number of samples contributing to the statistics. */
+        int _sampleCount;
+
+        /*! @brief @c true if the byte rate of the channel is far below its mean and @c false
+         otherwise. */
+        bool _dropped;
+
+    }; // ChannelBaseline
+
     /*! @brief The form of a channel connection. */
     struct ChannelInfo
     {
         /*! @brief The 'other-end' of a channel connection, as a ChannelEntry. */
         ChannelEntry * _otherChannel;
 
+        /*! @brief The appearance of the channel connection, for outgoing connections. */
+        ConnectionGeometry _geometry;
+
+        /*! @brief The colour of the channel connection when connections are coloured by their
+         traffic, or transparent if the connection is coloured by its kind. */
+        Colour _trafficColour;
+
+        /*! @brief The thickness of the channel connection when connections are thickened by their
+         traffic, or zero if the connection has its usual thickness. */
+        float _trafficWidth;
+
         /*! @brief The kind of channel connection. */
         MplusM::Common::ChannelMode _connectionMode;
 
@@ -306,6 +538,26 @@ namespace MPlusM_Manager
 
     }; // ChannelInfo
 
+    /*! @brief The traffic counted by a service on one of its channels. */
+    struct ChannelMetrics
+    {
+        /*! @brief The name of the channel. */
+        YarpString _channelName;
+
+        /*! @brief The number of bytes received by the channel. */
+        int64 _inBytes;
+
+        /*! @brief The number of messages received by the channel. */
+        int64 _inMessages;
+
+        /*! @brief The number of bytes sent by the channel. */
+        int64 _outBytes;
+
+        /*! @brief The number of messages sent by the channel. */
+        int64 _outMessages;
+
+    }; // ChannelMetrics
+
     /*! @brief The information for a connection. */
     struct ConnectionDetails
     {
@@ -320,6 +572,137 @@ namespace MPlusM_Manager
 
     }; // ConnectionDetails
 
+    /*! @brief The location of a record within a flight recording. */
+    struct FlightRecordEntry
+    {
+        /*! @brief The offset of the compressed contents of the record from the start of the
+         recording. */
+        size_t _offset;
+
+        /*! @brief The number of bytes of compressed contents. */
+        size_t _size;
+
+        /*! @brief When the record was made, in milliseconds since the epoch. */
+        int64 _time;
+
+        /*! @brief The kind of record. */
+        FlightRecordKind _kind;
+
+    }; // FlightRecordEntry
+
+    /*! @brief The topology found by a scan, as copied for the flight recorder. */
+    struct FlightTopology
+    {
+        /*! @brief The encoded descriptions of the entities, by the names of the entities. */
+        std::map<YarpString, MemoryBlock> _entities;
+
+        /*! @brief The modes of the connections, by their source and destination ports. */
+        std::map<std::pair<YarpString, YarpString>, MplusM::Common::ChannelMode> _connections;
+
+        /*! @brief When the scan was shown, in milliseconds since the epoch. */
+        int64 _time;
+
+    }; // FlightTopology
+
+    /*! @brief An entity heading or entry that is drawn by the entities panel, rather than by a
+     component of its own. */
+    struct FlyweightItem
+    {
+        /*! @brief The location of the item in the panel. */
+        juce::Rectangle<int> _bounds;
+
+        /*! @brief The entity that is, or holds, the item. */
+        ChannelContainer * _container;
+
+        /*! @brief The entry, or @c NULL if the item is the heading of the entity. */
+        ChannelEntry * _entry;
+
+    }; // FlyweightItem
+
+    /*! @brief The description of an entity, as seen by the layout engine. */
+    struct LayoutNode
+    {
+        /*! @brief The name of the entity. */
+        YarpString _name;
+
+        /*! @brief The horizontal position of the top-left corner of the entity. */
+        float _x;
+
+        /*! @brief The vertical position of the top-left corner of the entity. */
+        float _y;
+
+        /*! @brief The width of the entity. */
+        float _width;
+
+        /*! @brief The height of the entity. */
+        float _height;
+
+        /*! @brief @c true if the entity must not be moved and @c false if it is to be placed. */
+        bool _pinned;
+
+    }; // LayoutNode
+
+    /*! @brief The traffic on a channel at a point in the metrics history. */
+    struct MetricsPoint
+    {
+        /*! @brief When the point starts, in seconds since the epoch. */
+        double _time;
+
+        /*! @brief The average rate of each kind of traffic. */
+        float _average[kMetricsValueCount];
+
+        /*! @brief The largest rate of each kind of traffic. */
+        float _maximum[kMetricsValueCount];
+
+        /*! @brief The smallest rate of each kind of traffic. */
+        float _minimum[kMetricsValueCount];
+
+    }; // MetricsPoint
+
+    /*! @brief The outcome of changing the state of metrics collection for a single service. */
+    struct MetricsStateChange
+    {
+        /*! @brief The name of the entity for the service, as displayed. */
+        String _entityName;
+
+        /*! @brief The name of the service port. */
+        YarpString _servicePortName;
+
+        /*! @brief @c true if the service answered the request to change its state and @c false
+         if the change was cancelled first. */
+        bool _attempted;
+
+        /*! @brief @c true if the service changed its state and @c false otherwise. */
+        bool _succeeded;
+
+    }; // MetricsStateChange
+
+    /*! @brief One resolution of the metrics history of a channel, as a fixed-size ring of points
+     and the point that is being accumulated. */
+    struct MetricsTier
+    {
+        /*! @brief The ring of completed points; its size never changes. */
+        std::vector<MetricsPoint> _points;
+
+        /*! @brief The point that is being accumulated, whose averages are sums until it is
+         completed. */
+        MetricsPoint _pending;
+
+        /*! @brief The length of time summarized by each point, in seconds, or zero if each point is
+         a single sample. */
+        double _pointLength;
+
+        /*! @brief The number of completed points in the ring. */
+        size_t _count;
+
+        /*! @brief The position in the ring for the next completed point. */
+        size_t _nextPoint;
+
+        /*! @brief The number of samples in the point that is being accumulated. */
+        int _pendingSamples;
+
+    }; // MetricsTier
+
     /*! @brief The name and direction for a port. */
     struct NameAndDirection
     {
@@ -345,21 +728,268 @@ namespace MPlusM_Manager
 
     }; // PortInfo
 
+    /*! @brief A hash function for port names, for use with unordered containers. */
+    struct PortNameHash
+    {
+        /*! @brief Return the hash value for a port name.
+         @param[in] key The port name to be hashed.
+         @return The FNV-1a hash of the characters of the port name. */
+        inline size_t
+        operator ()(const YarpString & key)
+        const
+        {
+            const char * walker = key.c_str();
+            size_t       result = static_cast<size_t>(2166136261U);
+
+            for (size_t ii = 0, mm = key.length(); mm > ii; ++ii)
+            {
+                result ^= static_cast<unsigned char>(walker[ii]);
+                result *= static_cast<size_t>(16777619U);
+            }
+            return result;
+        } // operator ()
+
+    }; // PortNameHash
+
+    /*! @brief The last known position of an entity, and when the entity was last seen. */
+    struct RememberedPosition
+    {
+        /*! @brief The position of the top-left corner of the entity. */
+        Point<float> _position;
+
+        /*! @brief When the entity was last seen, in seconds since the epoch. */
+        int64 _lastSeen;
+
+    }; // RememberedPosition
+
+    /*! @brief The running statistics of the traffic of a service and its channels. */
+    struct ServiceBaseline
+    {
+        /*! @brief The statistics of each of the channels of the service, in the order that the
+         service reports them. */
+        std::vector<ChannelBaseline> _channels;
+
+        /*! @brief When the previous sample was collected, in milliseconds. */
+        double _lastSampleTime;
+
+        /*! @brief The number of consecutive samples in which none of the counters of the service
+         advanced. */
+        int _idleCount;
+
+        /*! @brief @c true if the counters of the service have advanced since the statistics were
+         started and @c false otherwise. */
+        bool _hasAdvanced;
+
+    }; // ServiceBaseline
+
+    /*! @brief The metrics reported by a service for all of its channels. */
+    struct ServiceMetrics
+    {
+        /*! @brief The traffic on each of the channels of the service. */
+        std::vector<ChannelMetrics> _channels;
+
+        /*! @brief When the metrics were collected, in milliseconds. */
+        double _sampleTime;
+
+        /*! @brief @c true if the service is collecting metrics and @c false otherwise. */
+        bool _enabled;
+
+        /*! @brief @c true if the service responded and @c false otherwise. */
+        bool _valid;
+
+    }; // ServiceMetrics
+
+    /*! @brief The last known state of a service, as kept for building menus and displays without
+     contacting the service. */
+    struct ServiceState
+    {
+        /*! @brief The extra information reported by the service. */
+        YarpString _extraInfo;
+
+        /*! @brief When the extra information was collected, in milliseconds, or a negative value
+         if it hasn't been collected. */
+        double _extraInfoTime;
+
+        /*! @brief When the state of metrics collection was collected, in milliseconds, or a
+         negative value if it hasn't been collected. */
+        double _metricsStateTime;
+
+        /*! @brief @c true if the extra information is missing or out of date and @c false
+         otherwise. */
+        bool _extraInfoIsStale;
+
+        /*! @brief @c true if the service is collecting metrics and @c false otherwise. */
+        bool _metricsEnabled;
+
+        /*! @brief @c true if the state of metrics collection is missing or out of date and
+         @c false otherwise. */
+        bool _metricsStateIsStale;
+
+        /*! @brief @c true if the service is waiting to be asked for its state and @c false
+         otherwise. */
+        bool _refreshRequested;
+
+    }; // ServiceState
+
+    /*! @brief The summary of the throughput samples that are drawn in a single column of a
+     scrolling monitor. */
+    struct ThroughputColumn
+    {
+        /*! @brief The average of the samples. */
+        float _average;
+
+        /*! @brief The largest of the samples. */
+        float _maximum;
+
+        /*! @brief The smallest of the samples. */
+        float _minimum;
+
+        /*! @brief The number of samples that were summarized; zero if there were none. */
+        int _numSamples;
+
+    }; // ThroughputColumn
+
+    /*! @brief A single measurement of the traffic on a channel. */
+    struct ThroughputSample
+    {
+        /*! @brief The number of bytes received per second. */
+        float _bytesPerSecond;
+
+        /*! @brief The number of messages received per second. */
+        float _messagesPerSecond;
+
+    }; // ThroughputSample
+
+    /*! @brief A single measurement made by the timing recorder. */
+    struct TimingSample
+    {
+        /*! @brief When the measurement started, in milliseconds since the recorder was created. */
+        double _startTime;
+
+        /*! @brief The duration of the measurement, in milliseconds. */
+        double _duration;
+
+        /*! @brief What was measured. */
+        TimingKind _kind;
+
+        /*! @brief The number of entities that were in the visible area, for a frame. */
+        int _entitiesDrawn;
+
+        /*! @brief The number of entities that were outside the visible area, for a frame. */
+        int _entitiesCulled;
+
+        /*! @brief The number of connections that were in the visible area, for a frame. */
+        int _connectionsDrawn;
+
+        /*! @brief The number of connections that were outside the visible area, for a frame. */
+        int _connectionsCulled;
+
+    }; // TimingSample
+
     /*! @brief Coordinates on the display. */
     typedef Point<float> Position;
 
     /*! @brief The set of connections to the channel. */
     typedef std::vector<ChannelInfo> ChannelConnections;
 
+    /*! @brief A mapping from the port names of the 'other-end' of channel connections to their
+     positions in the set of connections. */
+    typedef std::unordered_map<YarpString, size_t, PortNameHash> ChannelConnectionIndex;
+
+    /*! @brief A mapping from the names of channels to the hidden ports watching them. */
+    typedef std::map<YarpString, ActivityProbe> ActivityProbeMap;
+
+    /*! @brief A mapping from the names of channels or service ports to their anomalies. */
+    typedef std::unordered_map<YarpString, AnomalyKind, PortNameHash> AnomalyMap;
+
+    /*! @brief The traffic on each of the channels of a service. */
+    typedef std::vector<ChannelMetrics> ChannelMetricsList;
+
     /*! @brief A collection of application details. */
     typedef std::vector<ApplicationInfo> ApplicationList;
 
     /*! @brief A collection of connections. */
     typedef std::vector<ConnectionDetails> ConnectionList;
 
+    /*! @brief The source and destination of a connection. */
+    typedef std::pair<ChannelEntry *, ChannelEntry *> ConnectionEnds;
+
+    /*! @brief A set of connections, identified by their source and destination. */
+    typedef std::set<ConnectionEnds> ConnectionEndsSet;
+
+    /*! @brief A sequence of connections, identified by their source and destination. */
+    typedef std::vector<ConnectionEnds> ConnectionEndsList;
+
     /*! @brief A collection of services and ports. */
     typedef std::vector<ChannelContainer *> ContainerList;
 
+    /*! @brief A collection of groups of entities. */
+    typedef std::vector<EntityCluster *> ClusterList;
+
+    /*! @brief The ends of a combined connection, where at least one end is a collapsed group. */
+    typedef std::pair<Component *, Component *> ClusterConnectionEnds;
+
+    /*! @brief A mapping from the ends of combined connections to the number of connections that
+     they represent. */
+    typedef std::map<ClusterConnectionEnds, int> ClusterConnectionMap;
+
+    /*! @brief The entity headings and entries that are drawn by the entities panel, with each
+     heading followed by the entries of the entity. */
+    typedef std::vector<FlyweightItem> FlyweightItems;
+
+    /*! @brief A mapping from entities to the positions of their headings in the set of items that
+     are drawn by the entities panel. */
+    typedef std::unordered_map<ChannelContainer *, size_t> FlyweightIndexMap;
+
+    /*! @brief A mapping from the source and destination ports of recorded connections to the
+     modes of the connections. */
+    typedef std::map<std::pair<YarpString, YarpString>, MplusM::Common::ChannelMode>
+                                                                        FlightConnectionMap;
+
+    /*! @brief A mapping from the names of recorded entities to their encoded descriptions. */
+    typedef std::map<YarpString, MemoryBlock> FlightEntityMap;
+
+    /*! @brief The locations of the records within a flight recording, in the order that they were
+     made. */
+    typedef std::vector<FlightRecordEntry> FlightRecordEntries;
+
+    /*! @brief The topologies that are waiting to be recorded, oldest first. */
+    typedef std::list<FlightTopology> FlightTopologyQueue;
+
+    /*! @brief A sequence of timing samples, oldest first. */
+    typedef std::vector<TimingSample> TimingSamples;
+
+    /*! @brief A sequence of summaries of throughput samples, one for each column of a chart. */
+    typedef std::vector<ThroughputColumn> ThroughputColumns;
+
+    /*! @brief A sequence of throughput samples. */
+    typedef std::vector<ThroughputSample> ThroughputSamples;
+
+    /*! @brief A connection between two entities, as the indices of the corresponding layout
+     nodes. */
+    typedef std::pair<size_t, size_t> LayoutEdge;
+
+    /*! @brief A collection of connections between entities, as seen by the layout engine. */
+    typedef std::vector<LayoutEdge> LayoutEdges;
+
+    /*! @brief A collection of entities, as seen by the layout engine. */
+    typedef std::vector<LayoutNode> LayoutNodes;
+
+    /*! @brief A sequence of points from the metrics history of a channel. */
+    typedef std::vector<MetricsPoint> MetricsPoints;
+
+    /*! @brief The outcomes of changing the state of metrics collection for a set of services. */
+    typedef std::vector<MetricsStateChange> MetricsStateChanges;
+
+    /*! @brief A mapping from the names of channels to their metrics histories. */
+    typedef std::unordered_map<YarpString, MetricsSeries *, PortNameHash> MetricsSeriesMap;
+
+    /*! @brief The names of the channels with metrics histories, least recently updated first. */
+    typedef std::list<YarpString> MetricsSeriesOrder;
+
+    /*! @brief A set of services and ports. */
+    typedef std::set<ChannelContainer *> ContainerSet;
+
     /*! @brief A collection of entities (services, standalone ports, et cetera). */
     typedef std::vector<EntityData *> EntitiesList;
 
@@ -381,12 +1011,33 @@ namespace MPlusM_Manager
     /*! @brief A mapping from entity names to positions. */
     typedef std::map<YarpString, Position> PositionMap;
 
+    /*! @brief A mapping from entity names to their last known positions. */
+    typedef std::unordered_map<YarpString, RememberedPosition, PortNameHash>
+                                                                        RememberedPositionMap;
+
+    /*! @brief A mapping from the names of service ports to the metrics of the services. */
+    typedef std::map<YarpString, ServiceMetrics> ServiceMetricsMap;
+
+    /*! @brief A mapping from the names of service ports to the statistics of their traffic. */
+    typedef std::map<YarpString, ServiceBaseline> ServiceBaselineMap;
+
     /*! @brief A mapping from strings to service descriptions. */
     typedef std::map<YarpString, MplusM::Utilities::ServiceDescriptor> ServiceMap;
 
+    /*! @brief A mapping from the names of service ports that are to be asked for their state to
+     whether their extra information is wanted. */
+    typedef std::map<YarpString, bool> ServiceRefreshMap;
+
+    /*! @brief A mapping from the names of service ports to the last known states of the
+     services. */
+    typedef std::map<YarpString, ServiceState> ServiceStateMap;
+
     /*! @brief A collection of singular port names. */
     typedef std::map<YarpString, NameAndDirection> SingularPortMap;
 
+    /*! @brief A mapping from the names of channels to their byte rates. */
+    typedef std::unordered_map<YarpString, float, PortNameHash> TrafficRateMap;
+
 } // MPlusM_Manager
 
 /*! @brief Return @c true if exit is requested.
@@ -162,6 +162,17 @@ const
     return thePanel;
 } // ManagerWindow::getEntitiesPanel
 
+TimingRecorder &
+ManagerWindow::getTimingRecorder(void)
+const
+{
+    ODL_OBJENTER(); //####
+    TimingRecorder & theRecorder(_contentPanel->getTimingRecorder());
+
+    ODL_OBJEXIT_P(&theRecorder); //####
+    return theRecorder;
+} // ManagerWindow::getTimingRecorder
+
 void
 ManagerWindow::handleAsyncUpdate(void)
 {
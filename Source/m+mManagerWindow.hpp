@@ -58,6 +58,7 @@ namespace MPlusM_Manager
     class ContentPanel;
     class EntitiesPanel;
     class ScannerThread;
+    class TimingRecorder;
 
     /*! @brief The main window of the application. */
     class ManagerWindow : private AsyncUpdater,
@@ -90,7 +91,55 @@ namespace MPlusM_Manager
             kCommandLaunchRegistryService,
 
             /*! @brief Launch other executables. */
-            kCommandLaunchExecutables
+            kCommandLaunchExecutables,
+
+            /*! @brief Display the entities at a larger scale. */
+            kCommandZoomIn,
+
+            /*! @brief Display the entities at a smaller scale. */
+            kCommandZoomOut,
+
+            /*! @brief Display the entities at their actual size. */
+            kCommandZoomToActualSize,
+
+            /*! @brief Group the entities by the IP address of their host. */
+            kCommandGroupByAddress,
+
+            /*! @brief Group the entities by their behavioural model. */
+            kCommandGroupByBehaviour,
+
+            /*! @brief Display the entities without grouping. */
+            kCommandUngroupEntities,
+
+            /*! @brief Draw the entities from the entities panel rather than as components. */
+            kCommandDrawEntitiesDirectly,
+
+            /*! @brief Show or hide the timing information. */
+            kCommandShowTimingOverlay,
+
+            /*! @brief Save the recent timing samples to a file. */
+            kCommandSaveTimingSamples,
+
+            /*! @brief Colour the connections by their measured traffic. */
+            kCommandColourByTraffic,
+
+            /*! @brief Thicken the connections by their measured traffic. */
+            kCommandThickenByTraffic,
+
+            /*! @brief Use a logarithmic scale for the measured traffic. */
+            kCommandLogarithmicTrafficScale,
+
+            /*! @brief Select the services whose names match a pattern. */
+            kCommandSelectMatchingServices,
+
+            /*! @brief Enable metrics collection for the selected services. */
+            kCommandEnableSelectedMetrics,
+
+            /*! @brief Disable metrics collection for the selected services. */
+            kCommandDisableSelectedMetrics,
+
+            /*! @brief Replay a flight recording, or return to the live network. */
+            kCommandReplayRecording
 
         }; // CommandIDs
 
@@ -135,6 +184,12 @@ namespace MPlusM_Manager
             return _scannerThread;
         } // getScannerThread
 
+        /*! @brief Returns the recorder of timing samples.
+         @return The recorder of timing samples. */
+        TimingRecorder &
+        getTimingRecorder(void)
+        const;
+
         /*! @brief Set up the reference to the background scanning thread. */
         void
         setScannerThread(ScannerThread * theScanner);
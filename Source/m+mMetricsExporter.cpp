@@ -0,0 +1,472 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsExporter.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the export of metrics over HTTP.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mMetricsExporter.hpp"
+#include "m+mChannelContainer.hpp"
+#include "m+mChannelEntry.hpp"
+#include "m+mContentPanel.hpp"
+#include "m+mEntitiesPanel.hpp"
+#include "m+mMetricsPoller.hpp"
+#include "m+mTimingRecorder.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the export of metrics over HTTP. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The address on which requests are accepted; only the local machine can connect. */
+static const char * kListenAddress = "127.0.0.1";
+
+/*! @brief The largest request that is read, in bytes. */
+static const int kRequestBufferSize = 4096;
+
+/*! @brief The number of milliseconds to wait for a client to send its request; requests are
+ answered one at a time, so this is kept short. */
+static const int kRequestTimeout = 100;
+
+/*! @brief The number of milliseconds to wait for the thread to stop. */
+static const int kThreadKillTime = 3000;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Add the description of a metric to a page.
+ @param[in,out] page The page being built.
+ @param[in] name The name of the metric.
+ @param[in] help The description of the metric.
+ @param[in] type The type of the metric. */
+static void
+addMetricHeader(MemoryOutputStream & page,
+                const char *         name,
+                const char *         help,
+                const char *         type)
+{
+    page << "# HELP " << name << " " << help << "\n";
+    page << "# TYPE " << name << " " << type << "\n";
+} // addMetricHeader
+
+/*! @brief Return a string in the form needed for a label value, with backslashes, double quotes
+ and line feeds escaped.
+ @param[in] value The string to be converted.
+ @return The string in the form needed for a label value. */
+static String
+escapeLabelValue(const YarpString & value)
+{
+    String result;
+
+    for (size_t ii = 0, mm = value.size(); mm > ii; ++ii)
+    {
+        char aChar = value[ii];
+
+        if ('\\' == aChar)
+        {
+            result += "\\\\";
+        }
+        else if ('"' == aChar)
+        {
+            result += "\\\"";
+        }
+        else if ('\n' == aChar)
+        {
+            result += "\\n";
+        }
+        else
+        {
+            result += aChar;
+        }
+    }
+    return result;
+} // escapeLabelValue
+
+/*! @brief Return one of the counters of a channel.
+ @param[in] metrics The counters of the channel.
+ @param[in] which The counter of interest.
+ @return The value of the counter. */
+static int64
+getChannelCounter(const ChannelMetrics & metrics,
+                  const MetricsValue     which)
+{
+    int64 result;
+
+    switch (which)
+    {
+        case kMetricsValueInBytes :
+            result = metrics._inBytes;
+            break;
+
+        case kMetricsValueInMessages :
+            result = metrics._inMessages;
+            break;
+
+        case kMetricsValueOutBytes :
+            result = metrics._outBytes;
+            break;
+
+        case kMetricsValueOutMessages :
+            result = metrics._outMessages;
+            break;
+
+        default :
+            result = 0;
+            break;
+
+    }
+    return result;
+} // getChannelCounter
+
+/*! @brief Add one of the counters of all the channels being measured to a page.
+ @param[in,out] page The page being built.
+ @param[in] services The metrics of the services.
+ @param[in] name The name of the metric.
+ @param[in] help The description of the metric.
+ @param[in] which The counter of interest. */
+static void
+addChannelCounters(MemoryOutputStream &      page,
+                   const ServiceMetricsMap & services,
+                   const char *              name,
+                   const char *              help,
+                   const MetricsValue        which)
+{
+    addMetricHeader(page, name, help, "counter");
+    for (ServiceMetricsMap::const_iterator walker(services.begin()); services.end() != walker;
+         ++walker)
+    {
+        const ServiceMetrics & aService = walker->second;
+
+        if (aService._valid && aService._enabled)
+        {
+            String serviceLabel(escapeLabelValue(walker->first));
+
+            for (ChannelMetricsList::const_iterator chanWalker(aService._channels.begin());
+                 aService._channels.end() != chanWalker; ++chanWalker)
+            {
+                page << name << "{service=\"" << serviceLabel << "\",channel=\"" <<
+                        escapeLabelValue(chanWalker->_channelName) << "\"} " <<
+                        String(getChannelCounter(*chanWalker, which)) << "\n";
+            }
+        }
+    }
+} // addChannelCounters
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+MetricsExporter::MetricsExporter(ContentPanel &  owner,
+                                 MetricsPoller & poller) :
+    inherited1("Metrics exporter"), inherited2(), inherited3(), _listener(), _pageLock(), _page(),
+    _owner(owner), _poller(poller)
+{
+    ODL_ENTER(); //####
+    ODL_P2("owner = ", &owner, "poller = ", &poller); //####
+    _poller.addChangeListener(this);
+    ODL_EXIT_P(this); //####
+} // MetricsExporter::MetricsExporter
+
+MetricsExporter::~MetricsExporter(void)
+{
+    ODL_OBJENTER(); //####
+    _poller.removeChangeListener(this);
+    cancelPendingUpdate();
+    signalThreadShouldExit();
+    // Closing the socket releases the thread if it is waiting for a connection.
+    if (_listener)
+    {
+        _listener->close();
+    }
+    stopThread(kThreadKillTime);
+    _listener = NULL;
+    ODL_OBJEXIT(); //####
+} // MetricsExporter::~MetricsExporter
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+MetricsExporter::changeListenerCallback(ChangeBroadcaster * source)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("source = ", source); //####
+    render();
+    ODL_OBJEXIT(); //####
+} // MetricsExporter::changeListenerCallback
+
+void
+MetricsExporter::handleAsyncUpdate(void)
+{
+    ODL_OBJENTER(); //####
+    render();
+    ODL_OBJEXIT(); //####
+} // MetricsExporter::handleAsyncUpdate
+
+void
+MetricsExporter::render(void)
+{
+    ODL_OBJENTER(); //####
+    MetricsSnapshot::Ptr snapshot(_poller.getSnapshot());
+    EntitiesPanel &      entities = _owner.getEntitiesPanel();
+    TimingRecorder &     recorder = _owner.getTimingRecorder();
+    MemoryOutputStream   page;
+    size_t               numEntities = entities.getNumberOfEntities();
+    size_t               numConnections = 0;
+
+    if (snapshot)
+    {
+        const ServiceMetricsMap & services = snapshot->getServices();
+
+        addChannelCounters(page, services, "mpm_manager_channel_received_bytes_total",
+                           "Bytes received by a channel.", kMetricsValueInBytes);
+        addChannelCounters(page, services, "mpm_manager_channel_received_messages_total",
+                           "Messages received by a channel.", kMetricsValueInMessages);
+        addChannelCounters(page, services, "mpm_manager_channel_sent_bytes_total",
+                           "Bytes sent by a channel.", kMetricsValueOutBytes);
+        addChannelCounters(page, services, "mpm_manager_channel_sent_messages_total",
+                           "Messages sent by a channel.", kMetricsValueOutMessages);
+        addMetricHeader(page, "mpm_manager_service_metrics_enabled",
+                        "Whether a service is collecting the metrics of its channels.", "gauge");
+        for (ServiceMetricsMap::const_iterator walker(services.begin());
+             services.end() != walker; ++walker)
+        {
+            if (walker->second._valid)
+            {
+                page << "mpm_manager_service_metrics_enabled{service=\"" <<
+                        escapeLabelValue(walker->first) << "\"} " <<
+                        (walker->second._enabled ? "1" : "0") << "\n";
+            }
+        }
+    }
+    for (size_t ii = 0; numEntities > ii; ++ii)
+    {
+        ChannelContainer * anEntity = entities.getEntity(ii);
+
+        for (int jj = 0, mm = (anEntity ? anEntity->getNumPorts() : 0); mm > jj; ++jj)
+        {
+            ChannelEntry * aPort = anEntity->getPort(jj);
+
+            if (aPort)
+            {
+                numConnections += aPort->getOutputConnections().size();
+            }
+        }
+    }
+    addMetricHeader(page, "mpm_manager_entities", "Entities shown by the manager.", "gauge");
+    page << "mpm_manager_entities " << String(static_cast<int64>(numEntities)) << "\n";
+    addMetricHeader(page, "mpm_manager_connections", "Connections shown by the manager.",
+                    "gauge");
+    page << "mpm_manager_connections " << String(static_cast<int64>(numConnections)) << "\n";
+    addMetricHeader(page, "mpm_manager_last_duration_seconds",
+                    "Duration of the most recent operation of each kind.", "gauge");
+    for (int ii = 0; kTimingKindCount > ii; ++ii)
+    {
+        TimingKind   kind = static_cast<TimingKind>(ii);
+        TimingSample aSample;
+
+        if (recorder.getLatestSample(kind, aSample))
+        {
+            page << "mpm_manager_last_duration_seconds{operation=\"" <<
+                    TimingRecorder::nameForKind(kind) << "\"} " <<
+                    String(aSample._duration / 1000, 6) << "\n";
+        }
+    }
+    String newPage(page.toString());
+
+    {
+        const SpinLock::ScopedLockType lock(_pageLock);
+
+        _page = newPage;
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsExporter::render
+
+void
+MetricsExporter::renderSoon(void)
+{
+    ODL_OBJENTER(); //####
+    triggerAsyncUpdate();
+    ODL_OBJEXIT(); //####
+} // MetricsExporter::renderSoon
+
+void
+MetricsExporter::respond(StreamingSocket & client)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("client = ", &client); //####
+    char   request[kRequestBufferSize];
+    int    length = 0;
+    bool   haveHeaders = false;
+    double deadline = Time::getMillisecondCounterHiRes() + kRequestTimeout;
+
+    request[0] = '\0';
+    for ( ; (! haveHeaders) && ((kRequestBufferSize - 1) > length) && (! threadShouldExit()); )
+    {
+        int remaining = static_cast<int>(deadline - Time::getMillisecondCounterHiRes());
+
+        if ((0 >= remaining) || (1 != client.waitUntilReady(true, remaining)))
+        {
+            break;
+        }
+
+        int count = client.read(request + length, kRequestBufferSize - (1 + length), false);
+
+        if (0 >= count)
+        {
+            break;
+        }
+
+        length += count;
+        request[length] = '\0';
+        haveHeaders = ((NULL != strstr(request, "\r\n\r\n")) || (NULL != strstr(request, "\n\n")));
+    }
+    if (haveHeaders)
+    {
+        StringArray requestLine;
+        String      body;
+        String      header;
+        String      path;
+        String      status;
+
+        requestLine.addTokens(String(request).upToFirstOccurrenceOf("\n", false, false).trim(),
+                              " ", "");
+        path = requestLine[1].upToFirstOccurrenceOf("?", false, false);
+        if ((requestLine[0] != "GET") && (requestLine[0] != "HEAD"))
+        {
+            status = "405 Method Not Allowed";
+            body = "Only GET and HEAD are supported.\n";
+        }
+        else if ((path == "/metrics") || (path == "/"))
+        {
+            const SpinLock::ScopedLockType lock(_pageLock);
+
+            status = "200 OK";
+            body = _page;
+        }
+        else
+        {
+            status = "404 Not Found";
+            body = "The metrics are at /metrics.\n";
+        }
+        header = "HTTP/1.0 " + status + "\r\n"
+                 "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                 "Content-Length: " + String(static_cast<int64>(body.getNumBytesAsUTF8())) +
+                 "\r\nConnection: close\r\n\r\n";
+        client.write(header.toRawUTF8(), static_cast<int>(header.getNumBytesAsUTF8()));
+        // A HEAD request only receives the header.
+        if (requestLine[0] == "GET")
+        {
+            client.write(body.toRawUTF8(), static_cast<int>(body.getNumBytesAsUTF8()));
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsExporter::respond
+
+void
+MetricsExporter::run(void)
+{
+    ODL_OBJENTER(); //####
+    for ( ; ! threadShouldExit(); )
+    {
+        ScopedPointer<StreamingSocket> client(_listener->waitForNextConnection());
+
+        if (client)
+        {
+            respond(*client);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsExporter::run
+
+bool
+MetricsExporter::startExporting(const int port)
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("port = ", port); //####
+    bool okSoFar;
+
+    render();
+    _listener = new StreamingSocket;
+    if (_listener->createListener(port, kListenAddress))
+    {
+        startThread();
+        okSoFar = true;
+    }
+    else
+    {
+        ODL_LOG("(! _listener->createListener(port, kListenAddress))"); //####
+        _listener = NULL;
+        okSoFar = false;
+    }
+    ODL_OBJEXIT_B(okSoFar); //####
+    return okSoFar;
+} // MetricsExporter::startExporting
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,167 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsExporter.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the export of metrics over HTTP.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmMetricsExporter_HPP_))
+# define mpmMetricsExporter_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the export of metrics over HTTP. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class ContentPanel;
+    class MetricsPoller;
+
+    /*! @brief A background thread that serves the metrics known to the application, in the
+     Prometheus text format, to HTTP requests on a local port.
+
+     The page is rebuilt on the message thread whenever the metrics poller reports new metrics
+     or a scan has been shown, from the most recent metrics snapshot, the entities panel and the
+     timing samples, and is kept as text; a request is answered by sending a copy of the text, so
+     no service is contacted while answering a request and the time taken doesn't depend on the
+     size of the network. A client that is slow to send its request is dropped after a short
+     time, so that it can't hold up the others. Only connections from the local machine are
+     accepted. */
+    class MetricsExporter : public Thread,
+                            private AsyncUpdater,
+                            private ChangeListener
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The first class that this class is derived from. */
+        typedef Thread inherited1;
+
+        /*! @brief The second class that this class is derived from. */
+        typedef AsyncUpdater inherited2;
+
+        /*! @brief The third class that this class is derived from. */
+        typedef ChangeListener inherited3;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] owner The panel whose metrics are to be exported.
+         @param[in] poller The source of the metrics of the services. */
+        MetricsExporter(ContentPanel &  owner,
+                        MetricsPoller & poller);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MetricsExporter(void);
+
+        /*! @brief Rebuild the page once the current event has been handled, such as after a scan
+         has been shown. */
+        void
+        renderSoon(void);
+
+        /*! @brief Start answering requests on a port.
+         @param[in] port The port on which to listen for requests.
+         @return @c true if the port could be listened on and @c false otherwise. */
+        bool
+        startExporting(const int port);
+
+    protected :
+
+    private :
+
+        /*! @brief Called when the metrics poller has new metrics.
+         @param[in] source The metrics poller. */
+        virtual void
+        changeListenerCallback(ChangeBroadcaster * source);
+
+        /*! @brief Called back to rebuild the page. */
+        virtual void
+        handleAsyncUpdate(void);
+
+        /*! @brief Rebuild the page from the most recent metrics. */
+        void
+        render(void);
+
+        /*! @brief Read a request from a client and send the response.
+         @param[in,out] client The connection to the client. */
+        void
+        respond(StreamingSocket & client);
+
+        /*! @brief Answer requests. */
+        virtual void
+        run(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The socket on which requests arrive. */
+        ScopedPointer<StreamingSocket> _listener;
+
+        /*! @brief A lock to manage access to the page. */
+        mutable SpinLock _pageLock;
+
+        /*! @brief The page to be sent in response to a request. */
+        String _page;
+
+        /*! @brief The panel whose metrics are being exported. */
+        ContentPanel & _owner;
+
+        /*! @brief The source of the metrics of the services. */
+        MetricsPoller & _poller;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsExporter)
+
+    }; // MetricsExporter
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmMetricsExporter_HPP_)
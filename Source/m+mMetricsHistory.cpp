@@ -0,0 +1,554 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsHistory.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the bounded history of the metrics of channels.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mMetricsHistory.hpp"
+#include "m+mMetricsPoller.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the bounded history of the metrics of channels. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The length of time summarized by each point of each resolution, in seconds. */
+static const double kPointLength[kMetricsResolutionCount] = { 0, 1, 60, 60 * 60 };
+
+/*! @brief The estimated number of bytes used by the entry for a history in the set of
+ histories, apart from the name of the channel. */
+static const size_t kSeriesEntryOverhead = 64;
+
+/*! @brief The number of points kept for each resolution; two minutes of seconds, four hours of
+ minutes and a week of hours. */
+static const size_t kTierCapacity[kMetricsResolutionCount] = { 30, 120, 240, 7 * 24 };
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Add a completed point to the ring of a resolution, replacing the oldest point if the
+ ring is full.
+ @param[in,out] tier The resolution to be updated.
+ @param[in] aPoint The point to be added. */
+inline static void
+storePoint(MetricsTier &        tier,
+           const MetricsPoint & aPoint)
+{
+    tier._points[tier._nextPoint] = aPoint;
+    tier._nextPoint = (tier._nextPoint + 1) % tier._points.size();
+    if (tier._points.size() > tier._count)
+    {
+        ++tier._count;
+    }
+} // storePoint
+
+/*! @brief Convert the point being accumulated for a resolution into a completed point.
+ @param[in] tier The resolution.
+ @param[out] aPoint The completed point. */
+static void
+finishPendingPoint(const MetricsTier & tier,
+                   MetricsPoint &      aPoint)
+{
+    aPoint = tier._pending;
+    for (int ii = 0; kMetricsValueCount > ii; ++ii)
+    {
+        aPoint._average[ii] /= tier._pendingSamples;
+    }
+} // finishPendingPoint
+
+/*! @brief Add a set of rates to a resolution.
+ @param[in,out] tier The resolution to be updated.
+ @param[in] sampleTime When the rates were measured, in seconds.
+ @param[in] rates The rates of each kind of traffic. */
+static void
+addRates(MetricsTier & tier,
+         const double  sampleTime,
+         const float   rates[kMetricsValueCount])
+{
+    if (0 < tier._pointLength)
+    {
+        double pointStart = floor(sampleTime / tier._pointLength) * tier._pointLength;
+
+        if ((0 < tier._pendingSamples) && (pointStart != tier._pending._time))
+        {
+            MetricsPoint aPoint;
+
+            finishPendingPoint(tier, aPoint);
+            storePoint(tier, aPoint);
+            tier._pendingSamples = 0;
+        }
+        if (0 == tier._pendingSamples)
+        {
+            tier._pending._time = pointStart;
+            for (int ii = 0; kMetricsValueCount > ii; ++ii)
+            {
+                tier._pending._average[ii] = tier._pending._maximum[ii] =
+                                                            tier._pending._minimum[ii] = rates[ii];
+            }
+        }
+        else
+        {
+            for (int ii = 0; kMetricsValueCount > ii; ++ii)
+            {
+                tier._pending._average[ii] += rates[ii];
+                tier._pending._maximum[ii] = jmax(tier._pending._maximum[ii], rates[ii]);
+                tier._pending._minimum[ii] = jmin(tier._pending._minimum[ii], rates[ii]);
+            }
+        }
+        ++tier._pendingSamples;
+    }
+    else
+    {
+        MetricsPoint aPoint;
+
+        aPoint._time = sampleTime;
+        for (int ii = 0; kMetricsValueCount > ii; ++ii)
+        {
+            aPoint._average[ii] = aPoint._maximum[ii] = aPoint._minimum[ii] = rates[ii];
+        }
+        storePoint(tier, aPoint);
+    }
+} // addRates
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+MetricsSeries::MetricsSeries(void) :
+    _orderPosition(), _lastUpdate(0), _haveCounts(false)
+{
+    ODL_ENTER(); //####
+    for (int ii = 0; kMetricsResolutionCount > ii; ++ii)
+    {
+        MetricsTier & aTier = _tiers[ii];
+
+        aTier._points.resize(kTierCapacity[ii]);
+        aTier._pointLength = kPointLength[ii];
+        aTier._count = aTier._nextPoint = 0;
+        aTier._pendingSamples = 0;
+    }
+    for (int ii = 0; kMetricsValueCount > ii; ++ii)
+    {
+        _lastCounts[ii] = 0;
+    }
+    ODL_EXIT_P(this); //####
+} // MetricsSeries::MetricsSeries
+
+MetricsSeries::~MetricsSeries(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // MetricsSeries::~MetricsSeries
+
+MetricsHistory::MetricsHistory(const size_t memoryBudget) :
+    _series(), _updateOrder(), _lock(), _memoryBudget(memoryBudget), _memoryUsed(0),
+    _noStaleSeries(false)
+{
+    ODL_ENTER(); //####
+    ODL_I1("memoryBudget = ", memoryBudget); //####
+    ODL_EXIT_P(this); //####
+} // MetricsHistory::MetricsHistory
+
+MetricsHistory::~MetricsHistory(void)
+{
+    ODL_OBJENTER(); //####
+    for (MetricsSeriesMap::iterator walker(_series.begin()); _series.end() != walker; ++walker)
+    {
+        delete walker->second;
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsHistory::~MetricsHistory
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+MetricsSeries::addSample(const ChannelMetrics & metrics,
+                         const double           sampleTime)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("metrics = ", &metrics); //####
+    ODL_D1("sampleTime = ", sampleTime); //####
+    if ((! _haveCounts) || (_lastUpdate < sampleTime))
+    {
+        int64 counts[kMetricsValueCount];
+        bool  countsAreUsable = _haveCounts;
+
+        counts[kMetricsValueInBytes] = metrics._inBytes;
+        counts[kMetricsValueInMessages] = metrics._inMessages;
+        counts[kMetricsValueOutBytes] = metrics._outBytes;
+        counts[kMetricsValueOutMessages] = metrics._outMessages;
+        for (int ii = 0; countsAreUsable && (kMetricsValueCount > ii); ++ii)
+        {
+            // A counter that has gone down means that the service was restarted.
+            if (_lastCounts[ii] > counts[ii])
+            {
+                countsAreUsable = false;
+            }
+        }
+        if (countsAreUsable)
+        {
+            double elapsed = sampleTime - _lastUpdate;
+            float  rates[kMetricsValueCount];
+
+            for (int ii = 0; kMetricsValueCount > ii; ++ii)
+            {
+                rates[ii] = static_cast<float>((counts[ii] - _lastCounts[ii]) / elapsed);
+            }
+            for (int ii = 0; kMetricsResolutionCount > ii; ++ii)
+            {
+                addRates(_tiers[ii], sampleTime, rates);
+            }
+        }
+        for (int ii = 0; kMetricsValueCount > ii; ++ii)
+        {
+            _lastCounts[ii] = counts[ii];
+        }
+        _lastUpdate = sampleTime;
+        _haveCounts = true;
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsSeries::addSample
+
+bool
+MetricsSeries::getLatestPoint(MetricsPoint & result)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("result = ", &result); //####
+    const MetricsTier & aTier = _tiers[kMetricsResolutionRaw];
+    bool                okSoFar = false;
+
+    if (0 < aTier._count)
+    {
+        size_t               capacity = aTier._points.size();
+        const MetricsPoint & aPoint = aTier._points[(aTier._nextPoint + capacity - 1) % capacity];
+
+        // A sample that only provided starting counts leaves an older point at the end.
+        if (aPoint._time == _lastUpdate)
+        {
+            result = aPoint;
+            okSoFar = true;
+        }
+    }
+    ODL_OBJEXIT_B(okSoFar); //####
+    return okSoFar;
+} // MetricsSeries::getLatestPoint
+
+size_t
+MetricsSeries::getMemorySize(void)
+{
+    ODL_ENTER(); //####
+    size_t result = sizeof(MetricsSeries);
+
+    for (int ii = 0; kMetricsResolutionCount > ii; ++ii)
+    {
+        result += (kTierCapacity[ii] * sizeof(MetricsPoint));
+    }
+    ODL_EXIT_I(result); //####
+    return result;
+} // MetricsSeries::getMemorySize
+
+void
+MetricsSeries::getPoints(const MetricsResolution resolution,
+                         const double            startTime,
+                         const double            endTime,
+                         MetricsPoints &         result)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("resolution = ", resolution); //####
+    ODL_D2("startTime = ", startTime, "endTime = ", endTime); //####
+    ODL_P1("result = ", &result); //####
+    const MetricsTier & aTier = _tiers[resolution];
+    size_t              capacity = aTier._points.size();
+    size_t              oldest = (aTier._nextPoint + capacity - aTier._count) % capacity;
+    size_t              low = 0;
+    size_t              high = aTier._count;
+
+    // The points are in time order, so the first point in the range can be found by bisection.
+    for ( ; low < high; )
+    {
+        size_t middle = low + ((high - low) / 2);
+
+        if (aTier._points[(oldest + middle) % capacity]._time < startTime)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    for (size_t ii = low; aTier._count > ii; ++ii)
+    {
+        const MetricsPoint & aPoint = aTier._points[(oldest + ii) % capacity];
+
+        if (aPoint._time > endTime)
+        {
+            break;
+        }
+
+        result.push_back(aPoint);
+    }
+    if ((0 < aTier._pendingSamples) && (startTime <= aTier._pending._time) &&
+        (endTime >= aTier._pending._time))
+    {
+        MetricsPoint aPoint;
+
+        finishPendingPoint(aTier, aPoint);
+        result.push_back(aPoint);
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsSeries::getPoints
+
+MetricsSeries *
+MetricsHistory::addSeries(const YarpString & channelName,
+                          const double       roundStart)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("channelName = ", channelName); //####
+    ODL_D1("roundStart = ", roundStart); //####
+    MetricsSeries * result = NULL;
+    size_t          seriesSize = getSeriesSize(channelName);
+
+    for ( ; (_memoryBudget < (_memoryUsed + seriesSize)) && (! _noStaleSeries); )
+    {
+        MetricsSeriesMap::iterator stalest(_updateOrder.empty() ? _series.end() :
+                                           _series.find(_updateOrder.front()));
+
+        // A history that was updated in this round belongs to a live channel.
+        if ((_series.end() != stalest) && (stalest->second->getLastUpdate() < roundStart))
+        {
+            _memoryUsed -= getSeriesSize(stalest->first);
+            _updateOrder.pop_front();
+            delete stalest->second;
+            _series.erase(stalest);
+        }
+        else
+        {
+            _noStaleSeries = true;
+        }
+    }
+    if (_memoryBudget >= (_memoryUsed + seriesSize))
+    {
+        result = new MetricsSeries;
+        _series[channelName] = result;
+        result->setOrderPosition(_updateOrder.insert(_updateOrder.end(), channelName));
+        _memoryUsed += seriesSize;
+    }
+    ODL_OBJEXIT_P(result); //####
+    return result;
+} // MetricsHistory::addSeries
+
+void
+MetricsHistory::addSnapshot(const MetricsSnapshot & snapshot)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("snapshot = ", &snapshot); //####
+    const ScopedLock          lock(_lock);
+    const ServiceMetricsMap & services = snapshot.getServices();
+    double                    roundStart = 0;
+    bool                      haveRoundStart = false;
+    double                    clockOffset = (static_cast<double>(Time::currentTimeMillis()) -
+                                             Time::getMillisecondCounterHiRes());
+
+    for (ServiceMetricsMap::const_iterator walker(services.begin()); services.end() != walker;
+         ++walker)
+    {
+        if ((! haveRoundStart) || (walker->second._sampleTime < roundStart))
+        {
+            roundStart = walker->second._sampleTime;
+            haveRoundStart = true;
+        }
+    }
+    // The samples are timed with the millisecond counter, which has no fixed origin; the points
+    // are placed on the wall clock, so that the minutes and hours start where they're expected.
+    roundStart = (roundStart + clockOffset) / 1000;
+    _noStaleSeries = false;
+    for (ServiceMetricsMap::const_iterator walker(services.begin()); services.end() != walker;
+         ++walker)
+    {
+        const ServiceMetrics & aService = walker->second;
+
+        if (aService._valid && aService._enabled)
+        {
+            double sampleTime = (aService._sampleTime + clockOffset) / 1000;
+
+            for (ChannelMetricsList::const_iterator chanWalker(aService._channels.begin());
+                 aService._channels.end() != chanWalker; ++chanWalker)
+            {
+                MetricsSeriesMap::iterator match(_series.find(chanWalker->_channelName));
+                MetricsSeries *            aSeries;
+
+                if (_series.end() == match)
+                {
+                    aSeries = addSeries(chanWalker->_channelName, roundStart);
+                }
+                else
+                {
+                    aSeries = match->second;
+                    // The history becomes the most recently updated one.
+                    _updateOrder.splice(_updateOrder.end(), _updateOrder,
+                                        aSeries->getOrderPosition());
+                }
+                if (aSeries)
+                {
+                    aSeries->addSample(*chanWalker, sampleTime);
+                }
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsHistory::addSnapshot
+
+bool
+MetricsHistory::getLatestPoint(const YarpString & channelName,
+                               MetricsPoint &     result)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("channelName = ", channelName); //####
+    ODL_P1("result = ", &result); //####
+    const ScopedLock                 lock(_lock);
+    MetricsSeriesMap::const_iterator match(_series.find(channelName));
+    bool                             okSoFar;
+
+    if (_series.end() == match)
+    {
+        okSoFar = false;
+    }
+    else
+    {
+        okSoFar = match->second->getLatestPoint(result);
+    }
+    ODL_OBJEXIT_B(okSoFar); //####
+    return okSoFar;
+} // MetricsHistory::getLatestPoint
+
+size_t
+MetricsHistory::getMemoryUsed(void)
+const
+{
+    ODL_OBJENTER(); //####
+    size_t result;
+
+    {
+        const ScopedLock lock(_lock);
+
+        result = _memoryUsed;
+    }
+    ODL_OBJEXIT_I(result); //####
+    return result;
+} // MetricsHistory::getMemoryUsed
+
+bool
+MetricsHistory::getPoints(const YarpString &      channelName,
+                          const MetricsResolution resolution,
+                          const double            startTime,
+                          const double            endTime,
+                          MetricsPoints &         result)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("channelName = ", channelName); //####
+    ODL_I1("resolution = ", resolution); //####
+    ODL_D2("startTime = ", startTime, "endTime = ", endTime); //####
+    ODL_P1("result = ", &result); //####
+    const ScopedLock                 lock(_lock);
+    MetricsSeriesMap::const_iterator match(_series.find(channelName));
+    bool                             okSoFar;
+
+    result.clear();
+    if (_series.end() == match)
+    {
+        okSoFar = false;
+    }
+    else
+    {
+        match->second->getPoints(resolution, startTime, endTime, result);
+        okSoFar = true;
+    }
+    ODL_OBJEXIT_B(okSoFar); //####
+    return okSoFar;
+} // MetricsHistory::getPoints
+
+size_t
+MetricsHistory::getSeriesSize(const YarpString & channelName)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("channelName = ", channelName); //####
+    size_t result = MetricsSeries::getMemorySize() + channelName.size() + kSeriesEntryOverhead;
+
+    ODL_EXIT_I(result); //####
+    return result;
+} // MetricsHistory::getSeriesSize
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,314 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsHistory.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the bounded history of the metrics of channels.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmMetricsHistory_HPP_))
+# define mpmMetricsHistory_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the bounded history of the metrics of channels. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class MetricsSnapshot;
+
+    /*! @brief The metrics history of a single channel.
+
+     The counters reported by the service are turned into rates, which are kept at each resolution
+     in a ring of fixed size; the rings are allocated when the history is created, so the memory
+     used by a history never changes. The coarser resolutions keep the average, largest and
+     smallest rates of the samples in each of their points. The points of the coarser resolutions
+     start on whole seconds, minutes and hours of the wall clock. */
+    class MetricsSeries
+    {
+    public :
+
+    protected :
+
+    private :
+
+    public :
+
+        /*! @brief The constructor. */
+        MetricsSeries(void);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MetricsSeries(void);
+
+        /*! @brief Add a sample of the counters of the channel.
+
+         The first sample, and a sample whose counters are lower than those of the previous sample
+         because the service was restarted, only provide the starting counts for the next sample.
+         @param[in] metrics The counters of the channel.
+         @param[in] sampleTime When the counters were collected, in seconds since the epoch. */
+        void
+        addSample(const ChannelMetrics & metrics,
+                  const double           sampleTime);
+
+        /*! @brief Return the time of the most recent sample.
+         @return The time of the most recent sample, in seconds since the epoch. */
+        inline double
+        getLastUpdate(void)
+        const
+        {
+            return _lastUpdate;
+        } // getLastUpdate
+
+        /*! @brief Retrieve the rates from the most recent sample.
+         @param[out] result The rates from the most recent sample.
+         @return @c true if the most recent sample provided rates and @c false if there is no
+         sample or if the most recent sample only provided starting counts. */
+        bool
+        getLatestPoint(MetricsPoint & result)
+        const;
+
+        /*! @brief Return the number of bytes used by a history.
+         @return The number of bytes used by a history. */
+        static size_t
+        getMemorySize(void);
+
+        /*! @brief Return the position of the history in the order of updates.
+         @return The position of the history in the order of updates. */
+        inline MetricsSeriesOrder::iterator
+        getOrderPosition(void)
+        const
+        {
+            return _orderPosition;
+        } // getOrderPosition
+
+        /*! @brief Retrieve the points whose start times lie within a range, oldest first.
+
+         The point that is still being accumulated is included, so that the most recent traffic is
+         always visible. The time taken is proportional to the number of points retrieved.
+         @param[in] resolution The resolution of the points.
+         @param[in] startTime The start of the range, in seconds since the epoch.
+         @param[in] endTime The end of the range, in seconds since the epoch.
+         @param[in,out] result The points, which are added to the end of the sequence. */
+        void
+        getPoints(const MetricsResolution resolution,
+                  const double            startTime,
+                  const double            endTime,
+                  MetricsPoints &         result)
+        const;
+
+        /*! @brief Set the position of the history in the order of updates.
+         @param[in] position The position of the history in the order of updates. */
+        inline void
+        setOrderPosition(MetricsSeriesOrder::iterator position)
+        {
+            _orderPosition = position;
+        } // setOrderPosition
+
+    protected :
+
+    private :
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The rings of points, one for each resolution. */
+        MetricsTier _tiers[kMetricsResolutionCount];
+
+        /*! @brief The counters from the most recent sample. */
+        int64 _lastCounts[kMetricsValueCount];
+
+        /*! @brief The position of the history in the order of updates. */
+        MetricsSeriesOrder::iterator _orderPosition;
+
+        /*! @brief The time of the most recent sample, in seconds. */
+        double _lastUpdate;
+
+        /*! @brief @c true if there has been a sample and @c false otherwise. */
+        bool _haveCounts;
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[7];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsSeries)
+
+    }; // MetricsSeries
+
+    /*! @brief The metrics histories of all the channels whose services are collecting metrics.
+
+     The histories share a fixed memory budget. When a channel appears and the budget has been
+     used up, the histories of the channels that have gone the longest without being updated are
+     discarded to make room; if every history is still being updated, the new channel isn't
+     recorded. The histories are kept in the order that they were last updated, so the stalest one
+     is found without searching. Since each history has a fixed size, the memory used never grows
+     past the budget, however long the application runs. */
+    class MetricsHistory
+    {
+    public :
+
+    protected :
+
+    private :
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] memoryBudget The largest number of bytes to be used by the histories. */
+        explicit
+        MetricsHistory(const size_t memoryBudget);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MetricsHistory(void);
+
+        /*! @brief Add the metrics from a round of polling to the histories.
+         @param[in] snapshot The metrics from the round of polling. */
+        void
+        addSnapshot(const MetricsSnapshot & snapshot);
+
+        /*! @brief Retrieve the rates from the most recent sample of a channel.
+         @param[in] channelName The name of the channel.
+         @param[out] result The rates from the most recent sample.
+         @return @c true if the channel has a history and its most recent sample provided rates
+         and @c false otherwise. */
+        bool
+        getLatestPoint(const YarpString & channelName,
+                       MetricsPoint &     result)
+        const;
+
+        /*! @brief Return the number of bytes used by the histories.
+         @return The number of bytes used by the histories. */
+        size_t
+        getMemoryUsed(void)
+        const;
+
+        /*! @brief Retrieve the points of the history of a channel whose start times lie within a
+         range, oldest first.
+         @param[in] channelName The name of the channel.
+         @param[in] resolution The resolution of the points.
+         @param[in] startTime The start of the range, in seconds since the epoch.
+         @param[in] endTime The end of the range, in seconds since the epoch.
+         @param[out] result The points.
+         @return @c true if the channel has a history and @c false otherwise. */
+        bool
+        getPoints(const YarpString &      channelName,
+                  const MetricsResolution resolution,
+                  const double            startTime,
+                  const double            endTime,
+                  MetricsPoints &         result)
+        const;
+
+    protected :
+
+    private :
+
+        /*! @brief Create the history for a channel, discarding stale histories if the memory
+         budget has been used up.
+         @param[in] channelName The name of the channel.
+         @param[in] roundStart The time of the earliest sample in the current round, in seconds
+         since the epoch.
+         @return The new history or @c NULL if there was no room for it. */
+        MetricsSeries *
+        addSeries(const YarpString & channelName,
+                  const double       roundStart);
+
+        /*! @brief Return the number of bytes used by the history of a channel, including its
+         entry in the set of histories.
+         @param[in] channelName The name of the channel.
+         @return The number of bytes used by the history of the channel. */
+        static size_t
+        getSeriesSize(const YarpString & channelName);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The histories, by the names of the channels. */
+        MetricsSeriesMap _series;
+
+        /*! @brief The names of the channels with histories, least recently updated first. */
+        MetricsSeriesOrder _updateOrder;
+
+        /*! @brief A lock to manage access to the histories. */
+        mutable CriticalSection _lock;
+
+        /*! @brief The largest number of bytes to be used by the histories. */
+        size_t _memoryBudget;
+
+        /*! @brief The number of bytes used by the histories. */
+        size_t _memoryUsed;
+
+        /*! @brief @c true if no history can be discarded in the current round and @c false
+         otherwise. */
+        bool _noStaleSeries;
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[7];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsHistory)
+
+    }; // MetricsHistory
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmMetricsHistory_HPP_)
@@ -0,0 +1,512 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsPoller.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the background collection of the metrics of services.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mMetricsPoller.hpp"
+
+#include <m+m/m+mSendReceiveCounters.hpp>
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the background collection of the metrics of services. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The number of rounds of polling between requests for the state of the services that
+ are not collecting metrics. */
+static const int kDisabledRecheckRounds = 10;
+
+/*! @brief The number of services that are polled at the same time. */
+static const int kPollThreadCount = 4;
+
+/*! @brief The time, in milliseconds, to wait for a job to stop when the poller is destroyed. */
+static const int kJobKillTime = 3000;
+
+/*! @brief The time, in milliseconds, to wait for a job to finish before checking whether the
+ thread should exit. */
+static const int kJobWaitTime = 100;
+
+/*! @brief The time, in milliseconds, to wait for the thread to stop when the poller is
+ destroyed. */
+static const int kThreadKillTime = 3000;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return the integer held by a metrics value, which might have been sent as an integer,
+ as a floating-point number or as a string.
+ @param[in] aValue The value to be converted.
+ @return The integer held by the value, or zero if it is not numeric. */
+static int64
+getMetricsValue(yarp::os::Value & aValue)
+{
+    ODL_ENTER(); //####
+    ODL_P1("aValue = ", &aValue); //####
+    int64 result;
+
+    if (aValue.isInt())
+    {
+        result = aValue.asInt();
+    }
+    else if (aValue.isDouble())
+    {
+        result = static_cast<int64>(aValue.asDouble());
+    }
+    else if (aValue.isString())
+    {
+        result = String(aValue.asString().c_str()).getLargeIntValue();
+    }
+    else
+    {
+        result = 0;
+    }
+    ODL_EXIT_LL(result); //####
+    return result;
+} // getMetricsValue
+
+/*! @brief Extract the metrics for each channel from the response of a service.
+ @param[in] metrics The response of the service.
+ @param[out] channels The metrics for each channel. */
+static void
+parseMetrics(const yarp::os::Bottle & metrics,
+             ChannelMetricsList &     channels)
+{
+    ODL_ENTER(); //####
+    ODL_P2("metrics = ", &metrics, "channels = ", &channels); //####
+    channels.clear();
+    for (int ii = 0, mm = metrics.size(); mm > ii; ++ii)
+    {
+        yarp::os::Value & anElement(metrics.get(ii));
+
+        if (anElement.isDict())
+        {
+            yarp::os::Property * propList = anElement.asDict();
+
+            if (propList && propList->check(MpM_SENDRECEIVE_CHANNEL_))
+            {
+                ChannelMetrics aChannel;
+
+                aChannel._channelName = propList->find(MpM_SENDRECEIVE_CHANNEL_).asString().c_str();
+                aChannel._inBytes = getMetricsValue(propList->find(MpM_SENDRECEIVE_INBYTES_));
+                aChannel._inMessages = getMetricsValue(propList->find(MpM_SENDRECEIVE_INMESSAGES_));
+                aChannel._outBytes = getMetricsValue(propList->find(MpM_SENDRECEIVE_OUTBYTES_));
+                aChannel._outMessages =
+                                    getMetricsValue(propList->find(MpM_SENDRECEIVE_OUTMESSAGES_));
+                channels.push_back(aChannel);
+            }
+        }
+    }
+    ODL_EXIT(); //####
+} // parseMetrics
+
+/*! @brief Collect the metrics of a service, waiting for the service to respond.
+ @param[in] servicePortName The name of the service port.
+ @param[out] result The metrics of the service.
+ @return @c true if the service responded and @c false otherwise. */
+static bool
+fetchServiceMetrics(const YarpString & servicePortName,
+                    ServiceMetrics &   result)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    ODL_P1("result = ", &result); //####
+    bool enabled = false;
+
+    result._channels.clear();
+    result._sampleTime = Time::getMillisecondCounterHiRes();
+    result._enabled = false;
+    result._valid = false;
+    if (Utilities::GetMetricsStateForService(servicePortName, enabled, STANDARD_WAIT_TIME_))
+    {
+        ODL_LOG("(Utilities::GetMetricsStateForService(servicePortName, enabled, " //####
+                "STANDARD_WAIT_TIME_))"); //####
+        result._enabled = enabled;
+        if (enabled)
+        {
+            yarp::os::Bottle metrics;
+
+            if (Utilities::GetMetricsForService(servicePortName, metrics, STANDARD_WAIT_TIME_))
+            {
+                ODL_LOG("(Utilities::GetMetricsForService(servicePortName, metrics, " //####
+                        "STANDARD_WAIT_TIME_))"); //####
+                parseMetrics(metrics, result._channels);
+                result._valid = true;
+            }
+        }
+        else
+        {
+            result._valid = true;
+        }
+    }
+    ODL_EXIT_B(result._valid); //####
+    return result._valid;
+} // fetchServiceMetrics
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+MetricsSnapshot::MetricsSnapshot(ServiceMetricsMap & services) :
+    inherited(), _services()
+{
+    ODL_ENTER(); //####
+    ODL_P1("services = ", &services); //####
+    _services.swap(services);
+    ODL_EXIT_P(this); //####
+} // MetricsSnapshot::MetricsSnapshot
+
+MetricsSnapshot::~MetricsSnapshot(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // MetricsSnapshot::~MetricsSnapshot
+
+MetricsPollJob::MetricsPollJob(const YarpString & servicePortName) :
+    inherited("Metrics poll"), _servicePortName(servicePortName), _result()
+{
+    ODL_ENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    _result._sampleTime = 0;
+    _result._enabled = false;
+    _result._valid = false;
+    ODL_EXIT_P(this); //####
+} // MetricsPollJob::MetricsPollJob
+
+MetricsPollJob::~MetricsPollJob(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // MetricsPollJob::~MetricsPollJob
+
+MetricsPoller::MetricsPoller(const int    interval,
+                             const size_t historyBudget) :
+    inherited1("Metrics poller"), inherited2(), _history(historyBudget), _jobs(),
+    _pool(kPollThreadCount), _servicesLock(), _servicePortNames(), _disabledServices(),
+    _notedServices(), _snapshotLock(), _snapshot(), _interval(interval), _roundsSinceRecheck(0)
+{
+    ODL_ENTER(); //####
+    ODL_I2("interval = ", interval, "historyBudget = ", historyBudget); //####
+    ODL_EXIT_P(this); //####
+} // MetricsPoller::MetricsPoller
+
+MetricsPoller::~MetricsPoller(void)
+{
+    ODL_OBJENTER(); //####
+    signalThreadShouldExit();
+    notify();
+    _pool.removeAllJobs(true, kJobKillTime);
+    stopThread(kThreadKillTime);
+    ODL_OBJEXIT(); //####
+} // MetricsPoller::~MetricsPoller
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+const ChannelMetrics *
+MetricsSnapshot::findChannel(const YarpString & servicePortName,
+                             const YarpString & channelName)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("servicePortName = ", servicePortName, "channelName = ", channelName); //####
+    const ChannelMetrics * result = NULL;
+    const ServiceMetrics * aService = findService(servicePortName);
+
+    if (aService)
+    {
+        for (ChannelMetricsList::const_iterator walker(aService->_channels.begin());
+             aService->_channels.end() != walker; ++walker)
+        {
+            if (walker->_channelName == channelName)
+            {
+                result = &*walker;
+                break;
+            }
+
+        }
+    }
+    ODL_OBJEXIT_P(result); //####
+    return result;
+} // MetricsSnapshot::findChannel
+
+const ServiceMetrics *
+MetricsSnapshot::findService(const YarpString & servicePortName)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    const ServiceMetrics *            result;
+    ServiceMetricsMap::const_iterator match(_services.find(servicePortName));
+
+    if (_services.end() == match)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = &match->second;
+    }
+    ODL_OBJEXIT_P(result); //####
+    return result;
+} // MetricsSnapshot::findService
+
+ThreadPoolJob::JobStatus
+MetricsPollJob::runJob(void)
+{
+    ODL_OBJENTER(); //####
+    fetchServiceMetrics(_servicePortName, _result);
+    ODL_OBJEXIT(); //####
+    return jobHasFinished;
+} // MetricsPollJob::runJob
+
+MetricsSnapshot::Ptr
+MetricsPoller::getSnapshot(void)
+const
+{
+    ODL_OBJENTER(); //####
+    MetricsSnapshot::Ptr result;
+
+    {
+        const SpinLock::ScopedLockType lock(_snapshotLock);
+
+        result = _snapshot;
+    }
+    ODL_OBJEXIT_P(result.get()); //####
+    return result;
+} // MetricsPoller::getSnapshot
+
+void
+MetricsPoller::noteMetricsState(const YarpString & servicePortName,
+                                const bool         enabled)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    ODL_B1("enabled = ", enabled); //####
+    bool wakeUp;
+
+    {
+        const ScopedLock lock(_servicesLock);
+
+        wakeUp = (enabled && (_disabledServices.end() != _disabledServices.find(servicePortName)));
+        if (enabled)
+        {
+            _disabledServices.erase(servicePortName);
+        }
+        else
+        {
+            _disabledServices.insert(servicePortName);
+        }
+        _notedServices.insert(servicePortName);
+    }
+    // A service that has started collecting metrics is polled without waiting for the rest of
+    // the interval.
+    if (wakeUp)
+    {
+        notify();
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsPoller::noteMetricsState
+
+void
+MetricsPoller::pollSoon(void)
+{
+    ODL_OBJENTER(); //####
+    notify();
+    ODL_OBJEXIT(); //####
+} // MetricsPoller::pollSoon
+
+void
+MetricsPoller::run(void)
+{
+    ODL_OBJENTER(); //####
+    while (! threadShouldExit())
+    {
+        bool                 recheckDisabled;
+        PortSet              disabledServices;
+        YarpStringVector     servicePortNames;
+        MetricsSnapshot::Ptr oldSnapshot(getSnapshot());
+        ServiceMetricsMap    services;
+
+        {
+            const ScopedLock lock(_servicesLock);
+
+            servicePortNames = _servicePortNames;
+            disabledServices = _disabledServices;
+            _notedServices.clear();
+        }
+        // A service that isn't collecting metrics is asked for its state now and then, as the
+        // state might have been changed by another tool; the job doesn't ask for the metrics
+        // of a service that isn't collecting them, so this is cheap.
+        recheckDisabled = (kDisabledRecheckRounds <= ++_roundsSinceRecheck);
+        if (recheckDisabled)
+        {
+            _roundsSinceRecheck = 0;
+        }
+        // Only the jobs of the previous round, which have all finished, are discarded.
+        _jobs.clear();
+        for (size_t ii = 0, mm = servicePortNames.size(); (mm > ii) && (! threadShouldExit());
+             ++ii)
+        {
+            const YarpString & aName = servicePortNames[ii];
+
+            if (recheckDisabled || (disabledServices.end() == disabledServices.find(aName)))
+            {
+                MetricsPollJob * aJob = new MetricsPollJob(aName);
+
+                _jobs.add(aJob);
+                _pool.addJob(aJob, false);
+            }
+            else
+            {
+                // The service isn't asked again, so its last known metrics are kept.
+                const ServiceMetrics * lastMetrics = (oldSnapshot ?
+                                                      oldSnapshot->findService(aName) : NULL);
+
+                if (lastMetrics)
+                {
+                    services[aName] = *lastMetrics;
+                }
+            }
+        }
+        for (int jj = 0, mm = _jobs.size(); (mm > jj) && (! threadShouldExit()); )
+        {
+            if (_pool.waitForJobToFinish(_jobs[jj], kJobWaitTime))
+            {
+                ++jj;
+            }
+        }
+        if (threadShouldExit())
+        {
+            break;
+        }
+        {
+            const ScopedLock lock(_servicesLock);
+
+            for (int jj = 0, mm = _jobs.size(); mm > jj; ++jj)
+            {
+                const MetricsPollJob * aJob = _jobs[jj];
+                const ServiceMetrics & aResult = aJob->getResult();
+                const YarpString &     aName = aJob->getServicePortName();
+
+                services[aName] = aResult;
+                // A state that was noted while the service was being asked is more recent than
+                // the response of the service.
+                if (aResult._valid && (_notedServices.end() == _notedServices.find(aName)))
+                {
+                    if (aResult._enabled)
+                    {
+                        _disabledServices.erase(aName);
+                    }
+                    else
+                    {
+                        _disabledServices.insert(aName);
+                    }
+                }
+            }
+        }
+        MetricsSnapshot::Ptr newSnapshot(new MetricsSnapshot(services));
+
+        {
+            const SpinLock::ScopedLockType lock(_snapshotLock);
+
+            _snapshot = newSnapshot;
+        }
+        _history.addSnapshot(*newSnapshot);
+        sendChangeMessage();
+        wait(_interval);
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsPoller::run
+
+void
+MetricsPoller::setServices(const YarpStringVector & servicePortNames)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("servicePortNames = ", &servicePortNames); //####
+    const ScopedLock lock(_servicesLock);
+    PortSet          present(servicePortNames.begin(), servicePortNames.end());
+
+    _servicePortNames = servicePortNames;
+    for (PortSet::iterator walker(_disabledServices.begin()); _disabledServices.end() != walker; )
+    {
+        if (present.end() == present.find(*walker))
+        {
+            _disabledServices.erase(walker++);
+        }
+        else
+        {
+            ++walker;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsPoller::setServices
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
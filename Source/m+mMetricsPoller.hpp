@@ -0,0 +1,328 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsPoller.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the background collection of the metrics of services.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmMetricsPoller_HPP_))
+# define mpmMetricsPoller_HPP_ /* Header guard */
+
+# include "m+mMetricsHistory.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the background collection of the metrics of services. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief The metrics of the services, as collected by a single round of polling.
+
+     A snapshot is not changed after it has been published, so it can be read from any thread
+     without locking; a reader holds on to the snapshot that it was given for as long as it needs
+     it, while newer snapshots replace it in the poller. */
+    class MetricsSnapshot : public ReferenceCountedObject
+    {
+    public :
+
+        /*! @brief A reference to a snapshot. */
+        typedef ReferenceCountedObjectPtr<MetricsSnapshot> Ptr;
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef ReferenceCountedObject inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] services The metrics of the services, which are moved into the snapshot. */
+        explicit
+        MetricsSnapshot(ServiceMetricsMap & services);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MetricsSnapshot(void);
+
+        /*! @brief Return the metrics for a channel of a service.
+         @param[in] servicePortName The name of the service port.
+         @param[in] channelName The name of the channel.
+         @return The metrics for the channel or @c NULL if the service did not report any for
+         it. */
+        const ChannelMetrics *
+        findChannel(const YarpString & servicePortName,
+                    const YarpString & channelName)
+        const;
+
+        /*! @brief Return the metrics for a service.
+         @param[in] servicePortName The name of the service port.
+         @return The metrics for the service or @c NULL if the service was not polled. */
+        const ServiceMetrics *
+        findService(const YarpString & servicePortName)
+        const;
+
+        /*! @brief Return the metrics of all the services that were polled.
+         @return The metrics of all the services that were polled. */
+        inline const ServiceMetricsMap &
+        getServices(void)
+        const
+        {
+            return _services;
+        } // getServices
+
+    protected :
+
+    private :
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The metrics of the services, by the names of the service ports. */
+        ServiceMetricsMap _services;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsSnapshot)
+
+    }; // MetricsSnapshot
+
+    /*! @brief A job that collects the metrics of a single service. */
+    class MetricsPollJob : public ThreadPoolJob
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef ThreadPoolJob inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] servicePortName The name of the service port. */
+        explicit
+        MetricsPollJob(const YarpString & servicePortName);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MetricsPollJob(void);
+
+        /*! @brief Return the metrics of the service; only meaningful once the job has finished.
+         @return The metrics of the service. */
+        inline const ServiceMetrics &
+        getResult(void)
+        const
+        {
+            return _result;
+        } // getResult
+
+        /*! @brief Return the name of the service port.
+         @return The name of the service port. */
+        inline const YarpString &
+        getServicePortName(void)
+        const
+        {
+            return _servicePortName;
+        } // getServicePortName
+
+    protected :
+
+    private :
+
+        /*! @brief Collect the metrics of the service.
+         @return @c jobHasFinished, since the job is always completed. */
+        virtual JobStatus
+        runJob(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The name of the service port. */
+        YarpString _servicePortName;
+
+        /*! @brief The metrics of the service, which belong to the job so that they remain valid
+         for as long as the job might be running. */
+        ServiceMetrics _result;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsPollJob)
+
+    }; // MetricsPollJob
+
+    /*! @brief A background thread that collects the metrics of services.
+
+     The services are polled periodically and concurrently, each by a job on a small thread pool,
+     so that a slow service does not hold up the others. Services that last reported that they
+     are not collecting metrics are only asked for their state every few rounds, unless they are
+     noted as collecting them first, so that a change made by another tool is still seen. The
+     metrics are parsed directly from the responses into typed values and published as an
+     immutable snapshot, which any panel can read without blocking or contacting the services
+     itself. Each snapshot is also added to the metrics history of the channels, after which the
+     listeners are told that new metrics are available. */
+    class MetricsPoller : public Thread,
+                          public ChangeBroadcaster
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The first class that this class is derived from. */
+        typedef Thread inherited1;
+
+        /*! @brief The second class that this class is derived from. */
+        typedef ChangeBroadcaster inherited2;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] interval The number of milliseconds between rounds of polling.
+         @param[in] historyBudget The largest number of bytes to be used by the metrics
+         history. */
+        MetricsPoller(const int    interval,
+                      const size_t historyBudget);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MetricsPoller(void);
+
+        /*! @brief Return the metrics history of the channels.
+         @return The metrics history of the channels. */
+        inline const MetricsHistory &
+        getHistory(void)
+        const
+        {
+            return _history;
+        } // getHistory
+
+        /*! @brief Return the most recent metrics.
+         @return The most recent metrics or an empty reference if no round of polling has been
+         completed. */
+        MetricsSnapshot::Ptr
+        getSnapshot(void)
+        const;
+
+        /*! @brief Record the state of metrics collection of a service, as learned or set outside
+         of the poller, so that a service that is collecting metrics is polled again.
+         @param[in] servicePortName The name of the service port.
+         @param[in] enabled @c true if the service is collecting metrics and @c false
+         otherwise. */
+        void
+        noteMetricsState(const YarpString & servicePortName,
+                         const bool         enabled);
+
+        /*! @brief Start a round of polling without waiting for the rest of the interval, such as
+         when the collection of metrics for a service has been switched on or off. */
+        void
+        pollSoon(void);
+
+        /*! @brief Set the services that are to be polled.
+         @param[in] servicePortNames The names of the service ports. */
+        void
+        setServices(const YarpStringVector & servicePortNames);
+
+    protected :
+
+    private :
+
+        /*! @brief Poll the services. */
+        virtual void
+        run(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The metrics history of the channels. */
+        MetricsHistory _history;
+
+        /*! @brief The jobs of the current round of polling; these are declared before the pool
+         so that they outlive any job that is still running when the pool is destroyed. */
+        OwnedArray<MetricsPollJob> _jobs;
+
+        /*! @brief The threads that collect the metrics of the services. */
+        ThreadPool _pool;
+
+        /*! @brief A lock to manage access to the services that are to be polled. */
+        CriticalSection _servicesLock;
+
+        /*! @brief The names of the service ports that are to be polled. */
+        YarpStringVector _servicePortNames;
+
+        /*! @brief The services that are not collecting metrics and are therefore not polled. */
+        PortSet _disabledServices;
+
+        /*! @brief The services whose state of metrics collection was noted during the current
+         round of polling, which the results of the round must not override. */
+        PortSet _notedServices;
+
+        /*! @brief A lock to manage access to the most recent metrics. */
+        mutable SpinLock _snapshotLock;
+
+        /*! @brief The most recent metrics. */
+        MetricsSnapshot::Ptr _snapshot;
+
+        /*! @brief The number of milliseconds between rounds of polling. */
+        int _interval;
+
+        /*! @brief The number of rounds of polling since the services that are not collecting
+         metrics were last asked for their state. */
+        int _roundsSinceRecheck;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsPoller)
+
+    }; // MetricsPoller
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmMetricsPoller_HPP_)
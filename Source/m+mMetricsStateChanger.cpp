@@ -0,0 +1,216 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsStateChanger.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for changing the state of metrics collection for a set of
+//              services.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mMetricsStateChanger.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for changing the state of metrics collection for a set of
+ services. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The largest number of services that are asked at the same time. */
+static const int kMaximumChangeThreadCount = 64;
+
+/*! @brief The time, in milliseconds, to wait for the running jobs to stop when the changes are
+ cancelled. A job cannot be interrupted while it is waiting for its service, so this is longer
+ than the longest such wait. */
+static const int kJobKillTime = static_cast<int>(3 * 1000 * STANDARD_WAIT_TIME_);
+
+/*! @brief The time, in milliseconds, between updates of the progress display. */
+static const int kProgressInterval = 100;
+
+/*! @brief The time, in milliseconds, to wait for the thread to stop when the cancel button is
+ pressed. This is longer than the time taken to stop the running jobs, so that the thread is
+ never killed while a job is still using its pool. */
+static const int kThreadKillTime = kJobKillTime + 5000;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+MetricsStateJob::MetricsStateJob(const YarpString & servicePortName,
+                                 const bool         newState) :
+    inherited("Metrics state change"), _servicePortName(servicePortName), _newState(newState),
+    _succeeded(false)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    ODL_B1("newState = ", newState); //####
+    ODL_EXIT_P(this); //####
+} // MetricsStateJob::MetricsStateJob
+
+MetricsStateJob::~MetricsStateJob(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // MetricsStateJob::~MetricsStateJob
+
+MetricsStateChanger::MetricsStateChanger(MetricsStateChanges & changes,
+                                         const bool            newState,
+                                         Component *           above) :
+    inherited(newState ? "Enabling metrics collection" : "Disabling metrics collection", true,
+              true, kThreadKillTime, String::empty, above), _changes(changes), _newState(newState)
+{
+    ODL_ENTER(); //####
+    ODL_P2("changes = ", &changes, "above = ", above); //####
+    ODL_B1("newState = ", newState); //####
+    ODL_EXIT_P(this); //####
+} // MetricsStateChanger::MetricsStateChanger
+
+MetricsStateChanger::~MetricsStateChanger(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // MetricsStateChanger::~MetricsStateChanger
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+ThreadPoolJob::JobStatus
+MetricsStateJob::runJob(void)
+{
+    ODL_OBJENTER(); //####
+    _succeeded = Utilities::SetMetricsStateForService(_servicePortName, _newState,
+                                                      STANDARD_WAIT_TIME_);
+    ODL_OBJEXIT(); //####
+    return jobHasFinished;
+} // MetricsStateJob::runJob
+
+void
+MetricsStateChanger::run(void)
+{
+    ODL_OBJENTER(); //####
+    int numChanges = static_cast<int>(_changes.size());
+
+    if (0 < numChanges)
+    {
+        // The jobs hold their own outcomes and must outlive the pool, which waits for any that
+        // are still running when it is destroyed.
+        OwnedArray<MetricsStateJob> jobs;
+        ThreadPool                  pool(jmin(numChanges, kMaximumChangeThreadCount));
+        int                         remaining = numChanges;
+
+        for (int ii = 0; numChanges > ii; ++ii)
+        {
+            MetricsStateChange & aChange = _changes[static_cast<size_t>(ii)];
+            MetricsStateJob *    aJob = new MetricsStateJob(aChange._servicePortName, _newState);
+
+            aChange._attempted = aChange._succeeded = false;
+            jobs.add(aJob);
+            pool.addJob(aJob, false);
+        }
+        // Finished jobs are removed from the pool, so the number left is the number of services
+        // still to respond.
+        for ( ; 0 < remaining; remaining = pool.getNumJobs())
+        {
+            if (threadShouldExit())
+            {
+                break;
+            }
+
+            setProgress(static_cast<double>(numChanges - remaining) / numChanges);
+            setStatusMessage(String(numChanges - remaining) + " of " + String(numChanges) +
+                             " services have responded");
+            wait(kProgressInterval);
+        }
+        // A job that is no longer in the pool has finished, so its outcome can be read; the
+        // others are left as cancelled, whether or not they have started.
+        for (int ii = 0; numChanges > ii; ++ii)
+        {
+            MetricsStateJob * aJob = jobs[ii];
+
+            if (! pool.contains(aJob))
+            {
+                MetricsStateChange & aChange = _changes[static_cast<size_t>(ii)];
+
+                aChange._attempted = true;
+                aChange._succeeded = aJob->wasSuccessful();
+            }
+        }
+        if (0 < remaining)
+        {
+            ODL_LOG("(0 < remaining)"); //####
+            // The jobs that have not started are dropped and the running ones are left to finish
+            // into their own storage, before the pool and the jobs go away.
+            pool.removeAllJobs(true, kJobKillTime);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsStateChanger::run
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,205 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsStateChanger.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for changing the state of metrics collection for a set of
+//              services.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmMetricsStateChanger_HPP_))
+# define mpmMetricsStateChanger_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for changing the state of metrics collection for a set of
+ services. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief A job that changes the state of metrics collection for a single service. */
+    class MetricsStateJob : public ThreadPoolJob
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef ThreadPoolJob inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] servicePortName The name of the service port.
+         @param[in] newState @c true if metrics collection is to be enabled and @c false
+         otherwise. */
+        MetricsStateJob(const YarpString & servicePortName,
+                        const bool         newState);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MetricsStateJob(void);
+
+        /*! @brief Return @c true if the service changed its state and @c false otherwise.
+
+         Only valid once the job has left its pool.
+         @return @c true if the service changed its state and @c false otherwise. */
+        inline bool
+        wasSuccessful(void)
+        const
+        {
+            return _succeeded;
+        } // wasSuccessful
+
+    protected :
+
+    private :
+
+        /*! @brief Change the state of metrics collection for the service.
+         @return @c jobHasFinished, since the job is always completed. */
+        virtual JobStatus
+        runJob(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The name of the service port. */
+        YarpString _servicePortName;
+
+        /*! @brief @c true if metrics collection is to be enabled and @c false otherwise. */
+        bool _newState;
+
+        /*! @brief @c true if the service changed its state and @c false otherwise. */
+        bool _succeeded;
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[6];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsStateJob)
+
+    }; // MetricsStateJob
+
+    /*! @brief A task that changes the state of metrics collection for a set of services, while
+     showing its progress.
+
+     The services are asked concurrently, each by a job on a thread pool that is sized to the
+     number of services, so that the whole set takes about as long as the slowest service rather
+     than the sum of all of them. Each job keeps its own outcome, which is copied to the changes
+     only once the job has finished; if the changes are cancelled, the ones that have not finished
+     are reported as cancelled. */
+    class MetricsStateChanger : public ThreadWithProgressWindow
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef ThreadWithProgressWindow inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in,out] changes The services to be changed and the outcomes of the changes.
+         @param[in] newState @c true if metrics collection is to be enabled and @c false
+         otherwise.
+         @param[in] above The component to be centred on. */
+        MetricsStateChanger(MetricsStateChanges & changes,
+                            const bool            newState,
+                            Component *           above);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MetricsStateChanger(void);
+
+    protected :
+
+    private :
+
+        /*! @brief Perform the changes. */
+        virtual void
+        run(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The services to be changed and the outcomes of the changes. */
+        MetricsStateChanges & _changes;
+
+        /*! @brief @c true if metrics collection is to be enabled and @c false otherwise. */
+        bool _newState;
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[7];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsStateChanger)
+
+    }; // MetricsStateChanger
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmMetricsStateChanger_HPP_)
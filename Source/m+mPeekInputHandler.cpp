@@ -39,6 +39,7 @@
 
 #include "m+mPeekInputHandler.hpp"
 #include "m+mManagerApplication.hpp"
+#include "m+mTimingRecorder.hpp"
 
 #include <m+m/m+mRequests.hpp>
 
@@ -85,10 +86,11 @@ using namespace MPlusM_Manager;
 # pragma mark Constructors and Destructors
 #endif // defined(__APPLE__)
 
-PeekInputHandler::PeekInputHandler(void) :
-    inherited()
+PeekInputHandler::PeekInputHandler(TimingRecorder * recorder) :
+    inherited(), _recorder(recorder), _recorderLock()
 {
     ODL_ENTER(); //####
+    ODL_P1("recorder = ", recorder); //####
     ODL_EXIT_P(this); //####
 } // PeekInputHandler::PeekInputHandler
 
@@ -102,6 +104,16 @@ PeekInputHandler::~PeekInputHandler(void)
 # pragma mark Actions and Accessors
 #endif // defined(__APPLE__)
 
+void
+PeekInputHandler::detachTimingRecorder(void)
+{
+    ODL_OBJENTER(); //####
+    const ScopedLock lock(_recorderLock);
+
+    _recorder = NULL;
+    ODL_OBJEXIT(); //####
+} // PeekInputHandler::detachTimingRecorder
+
 #if (! MAC_OR_LINUX_)
 # pragma warning(push)
 # pragma warning(disable: 4100)
@@ -140,10 +152,12 @@ PeekInputHandler::handleInput(const yarp::os::Bottle &     input,
                 {
                     if (argAsString == MpM_REGISTRY_STATUS_ADDING_)
                     {
+                        noteStatusEvent();
                         ourApp->doScanSoon();
                     }
                     else if (argAsString == MpM_REGISTRY_STATUS_REMOVING_)
                     {
+                        noteStatusEvent();
                         ourApp->doScanSoon();
                     }
                 }
@@ -162,6 +176,21 @@ PeekInputHandler::handleInput(const yarp::os::Bottle &     input,
 # pragma warning(pop)
 #endif // ! MAC_OR_LINUX_
 
+void
+PeekInputHandler::noteStatusEvent(void)
+{
+    ODL_OBJENTER(); //####
+    const ScopedLock lock(_recorderLock);
+
+    // The main window isn't safe to reach from the input thread, so the recorder was supplied
+    // when the handler was created.
+    if (_recorder)
+    {
+        _recorder->noteRegistryStatusEvent();
+    }
+    ODL_OBJEXIT(); //####
+} // PeekInputHandler::noteStatusEvent
+
 #if defined(__APPLE__)
 # pragma mark Global functions
 #endif // defined(__APPLE__)
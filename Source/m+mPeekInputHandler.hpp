@@ -40,6 +40,8 @@
 #if (! defined(mpmPeekInputHandler_HPP_))
 # define mpmPeekInputHandler_HPP_ /* Header guard */
 
+# include "m+mManagerDataTypes.hpp"
+
 # include <m+m/m+mBaseInputHandler.hpp>
 
 # if defined(__APPLE__)
@@ -57,6 +59,8 @@
 
 namespace MPlusM_Manager
 {
+    class TimingRecorder;
+
     /*! @brief A handler for partially-structured input data.
 
      The data is expected to be in the form of an integer specifying the number of values to
@@ -74,13 +78,21 @@ namespace MPlusM_Manager
 
     public :
 
-        /*! @brief The constructor. */
-        PeekInputHandler(void);
+        /*! @brief The constructor.
+         @param[in] recorder The recorder for status events, or @c NULL if they are not recorded. */
+        explicit
+        PeekInputHandler(TimingRecorder * recorder);
 
         /*! @brief The destructor. */
         virtual
         ~PeekInputHandler(void);
 
+        /*! @brief Stop recording status events, waiting for any input being handled to finish.
+
+         This must be called before the recorder is destroyed. */
+        void
+        detachTimingRecorder(void);
+
     protected :
 
     private :
@@ -101,6 +113,10 @@ namespace MPlusM_Manager
                     yarp::os::ConnectionWriter * replyMechanism,
                     const size_t                 numBytes);
 
+        /*! @brief Record that a status report was received from the Registry Service. */
+        void
+        noteStatusEvent(void);
+
         /*! @brief The assignment operator.
          @param[in] other The object to be copied.
          @return The updated object. */
@@ -113,6 +129,12 @@ namespace MPlusM_Manager
 
     private :
 
+        /*! @brief The recorder for status events, or @c NULL if they are not recorded. */
+        TimingRecorder * _recorder;
+
+        /*! @brief The lock that protects the recorder while input is being handled. */
+        CriticalSection _recorderLock;
+
     }; // PeekInputHandler
 
 } // MPlusM_Manager
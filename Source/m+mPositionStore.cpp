@@ -0,0 +1,400 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mPositionStore.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the store of remembered entity positions for the m+m
+//              manager application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mPositionStore.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the store of remembered entity positions for the m+m manager
+ application. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief An entry in the store, along with when its entity was last seen. */
+typedef std::pair<int64, RememberedPositionMap::iterator> SeenEntry;
+
+/*! @brief A collection of entries in the store, along with when their entities were last seen. */
+typedef std::vector<SeenEntry> SeenEntries;
+
+/*! @brief The approximate number of bytes that each entry occupies in the file. */
+static const size_t kBytesPerEntry = 64;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Append the decimal representation of an integer to a string.
+
+ This is considerably faster than the general-purpose formatting functions, which matters when
+ there are tens of thousands of entries to be written.
+ @param[in,out] buffer The string to be added to.
+ @param[in] value The integer to be added. */
+static void
+appendInteger(std::string & buffer,
+              const int64   value)
+{
+    char   digits[24];
+    char * walker = digits + sizeof(digits);
+    uint64 remainder = static_cast<uint64>((0 > value) ? -value : value);
+
+    do
+    {
+        *--walker = static_cast<char>('0' + (remainder % 10));
+        remainder /= 10;
+    }
+    while (0 < remainder);
+    if (0 > value)
+    {
+        *--walker = '-';
+    }
+    buffer.append(walker, static_cast<size_t>((digits + sizeof(digits)) - walker));
+} // appendInteger
+
+/*! @brief Return the current time, in seconds since the epoch.
+ @return The current time, in seconds since the epoch. */
+static int64
+getCurrentSeconds(void)
+{
+    return Time::currentTimeMillis() / 1000;
+} // getCurrentSeconds
+
+/*! @brief Returns @c true if the first entry was seen before the second entry.
+ @param[in] left The first entry to be compared.
+ @param[in] right The second entry to be compared.
+ @return @c true if the first entry was seen before the second entry. */
+static bool
+seenEarlier(const SeenEntry & left,
+            const SeenEntry & right)
+{
+    return (left.first < right.first);
+} // seenEarlier
+
+/*! @brief Move past the end of the current line.
+ @param[in] walker The current position in the text.
+ @return The start of the next line, or the end of the text. */
+static const char *
+skipToNextLine(const char * walker)
+{
+    for ( ; *walker && ('\n' != *walker); ++walker)
+    {
+    }
+    if ('\n' == *walker)
+    {
+        ++walker;
+    }
+    return walker;
+} // skipToNextLine
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+PositionStore::PositionStore(const int64  lifetime,
+                             const size_t maxEntries) :
+    _positions(), _lifetime(lifetime), _maxEntries(maxEntries), _dirty(false)
+{
+    ODL_ENTER(); //####
+    ODL_I1("lifetime = ", lifetime); //####
+    ODL_I1("maxEntries = ", maxEntries); //####
+    ODL_EXIT_P(this); //####
+} // PositionStore::PositionStore
+
+PositionStore::~PositionStore(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // PositionStore::~PositionStore
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+bool
+PositionStore::find(const YarpString & name,
+                    Position &         where)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("name = ", name); //####
+    ODL_P1("where = ", &where); //####
+    bool                                  result;
+    RememberedPositionMap::const_iterator match(_positions.find(name));
+
+    if (_positions.end() == match)
+    {
+        result = false;
+    }
+    else
+    {
+        where = match->second._position;
+        result = true;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // PositionStore::find
+
+bool
+PositionStore::load(const File & source)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("source = ", &source); //####
+    bool        result;
+    MemoryBlock contents;
+
+    _positions.clear();
+    if (source.loadFileAsData(contents))
+    {
+        ODL_LOG("(source.loadFileAsData(contents))"); //####
+        int64 now = getCurrentSeconds();
+
+        // Terminate the text, so that it can be parsed in place.
+        contents.append("", 1);
+        _positions.reserve(contents.getSize() / (kBytesPerEntry / 2));
+        for (const char * walker = static_cast<const char *>(contents.getData()); *walker; )
+        {
+            const char * nameEnd = strchr(walker, '\t');
+            const char * lineEnd = strchr(walker, '\n');
+
+            if ((! nameEnd) || (lineEnd && (lineEnd < nameEnd)))
+            {
+                // Not a valid entry.
+                walker = skipToNextLine(walker);
+                continue;
+            }
+
+            char *             fieldEnd;
+            RememberedPosition anEntry;
+            YarpString         name(walker, nameEnd - walker);
+
+            anEntry._position.x = static_cast<float>(strtod(nameEnd + 1, &fieldEnd));
+            if ('\t' == *fieldEnd)
+            {
+                anEntry._position.y = static_cast<float>(strtod(fieldEnd + 1, &fieldEnd));
+                if ('\t' == *fieldEnd)
+                {
+                    anEntry._lastSeen = strtoll(fieldEnd + 1, &fieldEnd, 10);
+                }
+                else
+                {
+                    // An entry from an older version of the application.
+                    anEntry._lastSeen = now;
+                }
+                if (0 < name.length())
+                {
+                    _positions[name] = anEntry;
+                }
+            }
+            walker = skipToNextLine(fieldEnd);
+        }
+        result = true;
+    }
+    else
+    {
+        result = false;
+    }
+    _dirty = false;
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // PositionStore::load
+
+void
+PositionStore::prune(void)
+{
+    ODL_OBJENTER(); //####
+    size_t oldSize = _positions.size();
+
+    if (0 < _lifetime)
+    {
+        int64 cutoff = getCurrentSeconds() - _lifetime;
+
+        for (RememberedPositionMap::iterator walker(_positions.begin());
+             _positions.end() != walker; )
+        {
+            if (cutoff > walker->second._lastSeen)
+            {
+                walker = _positions.erase(walker);
+            }
+            else
+            {
+                ++walker;
+            }
+        }
+    }
+    if (_maxEntries < _positions.size())
+    {
+        ODL_LOG("(_maxEntries < _positions.size())"); //####
+        // Partition the entries so that the least recently seen ones come first, and then discard
+        // just enough of them to bring the store down to its maximum size.
+        SeenEntries seenEntries;
+        size_t      toDiscard = _positions.size() - _maxEntries;
+
+        seenEntries.reserve(_positions.size());
+        for (RememberedPositionMap::iterator walker(_positions.begin());
+             _positions.end() != walker; ++walker)
+        {
+            seenEntries.push_back(SeenEntry(walker->second._lastSeen, walker));
+        }
+        std::nth_element(seenEntries.begin(), seenEntries.begin() + toDiscard, seenEntries.end(),
+                         seenEarlier);
+        for (size_t ii = 0; toDiscard > ii; ++ii)
+        {
+            _positions.erase(seenEntries[ii].second);
+        }
+    }
+    if (oldSize != _positions.size())
+    {
+        _dirty = true;
+    }
+    ODL_OBJEXIT(); //####
+} // PositionStore::prune
+
+void
+PositionStore::remember(const YarpString & name,
+                        const Position &   where)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("name = ", name); //####
+    ODL_P1("where = ", &where); //####
+    RememberedPosition & anEntry = _positions[name];
+
+    anEntry._position = where;
+    anEntry._lastSeen = getCurrentSeconds();
+    _dirty = true;
+    ODL_OBJEXIT(); //####
+} // PositionStore::remember
+
+bool
+PositionStore::save(const File & destination)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("destination = ", &destination); //####
+    bool        result;
+    std::string contents;
+
+    prune();
+    contents.reserve(_positions.size() * kBytesPerEntry);
+    for (RememberedPositionMap::const_iterator walker(_positions.begin());
+         _positions.end() != walker; ++walker)
+    {
+        const RememberedPosition & anEntry = walker->second;
+
+        // Entities are placed on whole pixels, so nothing is lost by writing the positions as
+        // integers.
+        contents += walker->first;
+        contents += '\t';
+        appendInteger(contents, roundToInt(anEntry._position.x));
+        contents += '\t';
+        appendInteger(contents, roundToInt(anEntry._position.y));
+        contents += '\t';
+        appendInteger(contents, anEntry._lastSeen);
+        contents += '\n';
+    }
+    // Write everything to a temporary file in the same directory, and then swap it into place.
+    if (destination.getParentDirectory().createDirectory().wasOk())
+    {
+        ODL_LOG("(destination.getParentDirectory().createDirectory().wasOk())"); //####
+        TemporaryFile temp(destination, TemporaryFile::useHiddenFile);
+
+        {
+            FileOutputStream outStream(temp.getFile());
+
+            if (outStream.openedOk())
+            {
+                ODL_LOG("(outStream.openedOk())"); //####
+                result = outStream.write(contents.data(), contents.size());
+                outStream.flush();
+                result = (result && outStream.getStatus().wasOk());
+            }
+            else
+            {
+                result = false;
+            }
+        }
+        if (result)
+        {
+            ODL_LOG("(result)"); //####
+            result = temp.overwriteTargetFileWithTemporary();
+        }
+    }
+    else
+    {
+        result = false;
+    }
+    if (result)
+    {
+        ODL_LOG("(result)"); //####
+        _dirty = false;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // PositionStore::save
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,179 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mPositionStore.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the store of remembered entity positions for the m+m
+//              manager application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmPositionStore_HPP_))
+# define mpmPositionStore_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the store of remembered entity positions for the m+m manager
+ application. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief The positions that entities were last seen at.
+
+     Each line of the file holds the name of an entity, its position and when it was last seen, as
+     tab-separated values. Lines without the time, as written by older versions of the application,
+     are treated as having just been seen. Entries for entities that have not been seen for longer
+     than the lifetime of the store are discarded when the store is saved, as are the least recently
+     seen entries when there are more than the maximum number of entries. */
+    class PositionStore
+    {
+    public :
+
+    protected :
+
+    private :
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] lifetime The number of seconds that an entry is kept after its entity was last
+         seen, or zero if entries are kept indefinitely.
+         @param[in] maxEntries The maximum number of entries that are kept. */
+        PositionStore(const int64  lifetime,
+                      const size_t maxEntries);
+
+        /*! @brief The destructor. */
+        virtual
+        ~PositionStore(void);
+
+        /*! @brief Find the remembered position of an entity.
+         @param[in] name The name of the entity.
+         @param[out] where The remembered position of the entity.
+         @return @c true if the entity has a remembered position and @c false otherwise. */
+        bool
+        find(const YarpString & name,
+             Position &         where)
+        const;
+
+        /*! @brief Returns @c true if there are changes that have not been saved.
+         @return @c true if there are changes that have not been saved. */
+        inline bool
+        isDirty(void)
+        const
+        {
+            return _dirty;
+        } // isDirty
+
+        /*! @brief Replace the contents of the store with the contents of a file.
+         @param[in] source The file to be read.
+         @return @c true if the file was read and @c false otherwise. */
+        bool
+        load(const File & source);
+
+        /*! @brief Discard the entries that have expired and, if there are too many entries, the
+         least recently seen entries. */
+        void
+        prune(void);
+
+        /*! @brief Record the position of an entity, marking it as seen now.
+         @param[in] name The name of the entity.
+         @param[in] where The position of the entity. */
+        void
+        remember(const YarpString & name,
+                 const Position &   where);
+
+        /*! @brief Write the contents of the store to a file, replacing the file as a whole so that
+         a partially-written file is never seen.
+         @param[in] destination The file to be written.
+         @return @c true if the file was written and @c false otherwise. */
+        bool
+        save(const File & destination);
+
+        /*! @brief Returns the number of entries in the store.
+         @return The number of entries in the store. */
+        inline size_t
+        size(void)
+        const
+        {
+            return _positions.size();
+        } // size
+
+    protected :
+
+    private :
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The remembered positions. */
+        RememberedPositionMap _positions;
+
+        /*! @brief The number of seconds that an entry is kept after its entity was last seen. */
+        int64 _lifetime;
+
+        /*! @brief The maximum number of entries that are kept. */
+        size_t _maxEntries;
+
+        /*! @brief @c true if there are changes that have not been saved. */
+        bool _dirty;
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[7];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PositionStore)
+
+    }; // PositionStore
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmPositionStore_HPP_)
@@ -0,0 +1,227 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mReplayBar.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the control used to move through a flight recording.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mReplayBar.hpp"
+#include "m+mContentPanel.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the control used to move through a flight recording. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The colour to be used for the background of the bar. */
+static const Colour kReplayBackgroundColour(0xFF202020);
+
+/*! @brief The colour to be used for text in the bar. */
+static const Colour & kReplayTextColour(Colours::white);
+
+/*! @brief The height of the bar. */
+static const int kReplayBarHeight = 48;
+
+/*! @brief The amount of space around the content of the bar. */
+static const int kReplayInset = 4;
+
+/*! @brief The shortest time, in milliseconds, between rebuilds of the state while the slider is
+ being dragged. */
+static const int kReplayRebuildInterval = 150;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ReplayBar::ReplayBar(ContentPanel & owner) :
+    inherited1(), inherited2(), inherited3(), _summary(),
+    _timeSlider(Slider::LinearHorizontal, Slider::NoTextBox), _owner(owner), _pendingTime(0),
+    _rebuildPending(false)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    setOpaque(true);
+    _summary.setColour(Label::textColourId, kReplayTextColour);
+    _summary.setJustificationType(Justification::centredLeft);
+    addAndMakeVisible(_summary);
+    _timeSlider.addListener(this);
+    addAndMakeVisible(_timeSlider);
+    setSize(getWidth(), kReplayBarHeight);
+    ODL_EXIT_P(this); //####
+} // ReplayBar::ReplayBar
+
+ReplayBar::~ReplayBar(void)
+{
+    ODL_OBJENTER(); //####
+    stopTimer();
+    _timeSlider.removeListener(this);
+    ODL_OBJEXIT(); //####
+} // ReplayBar::~ReplayBar
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ReplayBar::paint(Graphics & gg)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    gg.fillAll(kReplayBackgroundColour);
+    ODL_OBJEXIT(); //####
+} // ReplayBar::paint
+
+void
+ReplayBar::resized(void)
+{
+    ODL_OBJENTER(); //####
+    juce::Rectangle<int> area(getLocalBounds().reduced(kReplayInset));
+
+    _timeSlider.setBounds(area.removeFromTop(area.getHeight() / 2));
+    _summary.setBounds(area);
+    ODL_OBJEXIT(); //####
+} // ReplayBar::resized
+
+void
+ReplayBar::setTimeRange(const int64 startTime,
+                        const int64 endTime)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL2("startTime = ", startTime, "endTime = ", endTime); //####
+    // A slider can't have an empty range, so a recording with a single moment is given one.
+    _timeSlider.setRange(static_cast<double>(startTime),
+                         static_cast<double>(jmax(endTime, startTime + 1)), 1);
+    _timeSlider.setValue(static_cast<double>(startTime), dontSendNotification);
+    stopTimer();
+    _rebuildPending = false;
+    showStateAt(startTime);
+    ODL_OBJEXIT(); //####
+} // ReplayBar::setTimeRange
+
+void
+ReplayBar::showStateAt(const int64 when)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL1("when = ", when); //####
+    _summary.setText(_owner.showRecordedState(when), dontSendNotification);
+    ODL_OBJEXIT(); //####
+} // ReplayBar::showStateAt
+
+#if (! MAC_OR_LINUX_)
+# pragma warning(push)
+# pragma warning(disable: 4100)
+#endif // ! MAC_OR_LINUX_
+void
+ReplayBar::sliderValueChanged(Slider * slider)
+{
+#if (! defined(ODL_ENABLE_LOGGING_))
+# if MAC_OR_LINUX_
+#  pragma unused(slider)
+# endif // MAC_OR_LINUX_
+#endif // ! defined(ODL_ENABLE_LOGGING_)
+    ODL_OBJENTER(); //####
+    ODL_P1("slider = ", slider); //####
+    _pendingTime = static_cast<int64>(_timeSlider.getValue());
+    // A move soon after the last rebuild is held until the interval has passed, so that a drag
+    // shows the state as it goes without rebuilding it for every step of the slider.
+    if (isTimerRunning())
+    {
+        _rebuildPending = true;
+    }
+    else
+    {
+        showStateAt(_pendingTime);
+        startTimer(kReplayRebuildInterval);
+    }
+    ODL_OBJEXIT(); //####
+} // ReplayBar::sliderValueChanged
+#if (! MAC_OR_LINUX_)
+# pragma warning(pop)
+#endif // ! MAC_OR_LINUX_
+
+void
+ReplayBar::timerCallback(void)
+{
+    ODL_OBJENTER(); //####
+    if (_rebuildPending)
+    {
+        ODL_LOG("(_rebuildPending)"); //####
+        _rebuildPending = false;
+        showStateAt(_pendingTime);
+    }
+    else
+    {
+        stopTimer();
+    }
+    ODL_OBJEXIT(); //####
+} // ReplayBar::timerCallback
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
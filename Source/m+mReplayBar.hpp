@@ -0,0 +1,170 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mReplayBar.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the control used to move through a flight recording.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmReplayBar_HPP_))
+# define mpmReplayBar_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the control used to move through a flight recording. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class ContentPanel;
+
+    /*! @brief A bar along the bottom of the content area, with a slider that selects the moment
+     of a flight recording that is shown.
+
+     The bar is only visible while a recording is being replayed. The state is rebuilt while the
+     slider is being dragged, but no more often than a fixed interval, as moving back in time can
+     take a noticeable amount of work; the last position reached is always shown. */
+    class ReplayBar : public Component,
+                      private Slider::Listener,
+                      private Timer
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The first class that this class is derived from. */
+        typedef Component inherited1;
+
+        /*! @brief The second class that this class is derived from. */
+        typedef Slider::Listener inherited2;
+
+        /*! @brief The third class that this class is derived from. */
+        typedef Timer inherited3;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] owner The content area that shows the recorded state. */
+        explicit
+        ReplayBar(ContentPanel & owner);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ReplayBar(void);
+
+        /*! @brief Set the span of time that can be selected, and show the start of it.
+         @param[in] startTime The time of the first record, in milliseconds since the epoch.
+         @param[in] endTime The time of the last record, in milliseconds since the epoch. */
+        void
+        setTimeRange(const int64 startTime,
+                     const int64 endTime);
+
+    protected :
+
+    private :
+
+        /*! @brief Draw the content of the component.
+         @param[in,out] gg The graphics context in which to draw. */
+        virtual void
+        paint(Graphics & gg);
+
+        /*! @brief Called when the component size has been changed. */
+        virtual void
+        resized(void);
+
+        /*! @brief Show the recorded state at a given time.
+         @param[in] when The time of interest, in milliseconds since the epoch. */
+        void
+        showStateAt(const int64 when);
+
+        /*! @brief Called when the slider has been moved.
+         @param[in] slider The slider that was moved. */
+        virtual void
+        sliderValueChanged(Slider * slider);
+
+        /*! @brief Called when the timer fires. */
+        virtual void
+        timerCallback(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The description of the state that is shown. */
+        Label _summary;
+
+        /*! @brief The control used to select the time. */
+        Slider _timeSlider;
+
+        /*! @brief The content area that shows the recorded state. */
+        ContentPanel & _owner;
+
+        /*! @brief The time selected by the slider that has not been shown yet, in milliseconds
+         since the epoch. */
+        int64 _pendingTime;
+
+        /*! @brief @c true if the slider has been moved since the state was last shown and
+         @c false otherwise. */
+        bool _rebuildPending;
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[7];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReplayBar)
+
+    }; // ReplayBar
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmReplayBar_HPP_)
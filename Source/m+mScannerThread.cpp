@@ -42,6 +42,7 @@
 #include "m+mEntityData.hpp"
 #include "m+mManagerApplication.hpp"
 #include "m+mPortData.hpp"
+#include "m+mTimingRecorder.hpp"
 
 //#include <odlEnable.h>
 #include <odlInclude.h>
@@ -657,6 +658,7 @@ ScannerThread::gatherEntities(Utilities::PortVector & detectedPorts,
     int64 now = Time::currentTimeMillis();
 #endif //defined(CHECK_FOR_STALE_PORTS_) && (! defined(DO_SINGLE_CHECK_FOR_STALE_PORTS_))
 
+    _window.getTimingRecorder().noteScanStarted();
     // Mark our utility ports as known.
 #if defined(CHECK_FOR_STALE_PORTS_)
 # if defined(DO_SINGLE_CHECK_FOR_STALE_PORTS_)
@@ -816,6 +818,7 @@ ScannerThread::run(void)
             ODL_B3("_scanIsComplete <- ", _scanIsComplete, "_scanCanProceed <- ", //####
                    _scanCanProceed, "_scanSoon <- ", _scanSoon); //####
             relinquishFromWrite();
+            _window.getTimingRecorder().noteScanCompleted();
             // The data has been gathered, so it's safe for the foreground thread to process it -
             // force a repaint of the displayed panel, which will retrieve our data.
             triggerRepaint();
@@ -0,0 +1,257 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mScrollingMonitorPanel.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the strip charts of the traffic on a channel.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mScrollingMonitorPanel.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the strip charts of the traffic on a channel. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MPlusM_Manager;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The colour to be used for the line showing the averages. */
+static const Colour & kAverageColour(Colours::lightgreen);
+
+/*! @brief The colour to be used for the background of a chart. */
+static const Colour kChartBackgroundColour(0xFF202020);
+
+/*! @brief The colour to be used for the bars showing the ranges. */
+static const Colour kRangeColour(0xFF2E6B2E);
+
+/*! @brief The colour to be used for the captions. */
+static const Colour & kTextColour(Colours::white);
+
+/*! @brief The smallest value at the top of a chart, so that idle channels show a flat line. */
+static const float kMinimumChartScale = 1;
+
+/*! @brief The thickness of the line showing the averages. */
+static const float kAverageLineThickness = 1.5;
+
+/*! @brief The space between and around the charts. */
+static const int kChartGap = 4;
+
+/*! @brief The height of a caption. */
+static const int kCaptionHeight = 16;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return a rate as text, scaled to a readable size.
+ @param[in] value The rate.
+ @param[in] units The units of the rate.
+ @return The rate as text. */
+static String
+describeRate(const float  value,
+             const char * units)
+{
+    String result;
+
+    if (1e6 <= value)
+    {
+        result = String(value / 1e6, 2) + " M" + units;
+    }
+    else if (1e3 <= value)
+    {
+        result = String(value / 1e3, 2) + " k" + units;
+    }
+    else
+    {
+        result = String(value, 1) + " " + units;
+    }
+    return result;
+} // describeRate
+
+/*! @brief Draw a chart of the summaries of a rate.
+ @param[in,out] gg The graphics context in which to draw.
+ @param[in] area The area of the chart.
+ @param[in] columns The summaries of the rate, oldest first.
+ @param[in] latest The most recent rate.
+ @param[in] units The units of the rate. */
+static void
+drawChart(Graphics &                     gg,
+          const juce::Rectangle<float> & area,
+          const ThroughputColumns &      columns,
+          const float                    latest,
+          const char *                   units)
+{
+    float peak = kMinimumChartScale;
+
+    gg.setColour(kChartBackgroundColour);
+    gg.fillRect(area);
+    for (ThroughputColumns::const_iterator walker(columns.begin()); columns.end() != walker;
+         ++walker)
+    {
+        peak = jmax(peak, walker->_maximum);
+    }
+    if (0 < columns.size())
+    {
+        bool  lineStarted = false;
+        float columnWidth = area.getWidth() / columns.size();
+        float plotHeight = area.getHeight() - kCaptionHeight;
+        float scale = plotHeight / peak;
+        Path  averageLine;
+
+        gg.setColour(kRangeColour);
+        for (size_t ii = 0, mm = columns.size(); mm > ii; ++ii)
+        {
+            const ThroughputColumn & aColumn = columns[ii];
+
+            if (0 < aColumn._numSamples)
+            {
+                float xPos = area.getX() + (ii * columnWidth);
+                float yMax = area.getBottom() - (aColumn._maximum * scale);
+                float yMin = area.getBottom() - (aColumn._minimum * scale);
+                float yAverage = area.getBottom() - (aColumn._average * scale);
+
+                gg.fillRect(xPos, yMax, jmax(columnWidth, 1.0f), jmax(yMin - yMax, 1.0f));
+                if (lineStarted)
+                {
+                    averageLine.lineTo(xPos + (columnWidth / 2), yAverage);
+                }
+                else
+                {
+                    averageLine.startNewSubPath(xPos + (columnWidth / 2), yAverage);
+                    lineStarted = true;
+                }
+            }
+            else
+            {
+                // Leave a gap where there are no samples.
+                lineStarted = false;
+            }
+        }
+        gg.setColour(kAverageColour);
+        gg.strokePath(averageLine, PathStrokeType(kAverageLineThickness));
+    }
+    gg.setColour(kTextColour);
+    gg.drawText(describeRate(latest, units) + " (scale " + describeRate(peak, units) + ")",
+                area.withHeight(kCaptionHeight).reduced(kChartGap, 0), Justification::centredLeft,
+                true);
+} // drawChart
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ScrollingMonitorPanel::ScrollingMonitorPanel(const size_t historyLength) :
+    inherited(), _history(historyLength), _byteColumns(), _messageColumns()
+{
+    ODL_ENTER(); //####
+    ODL_I1("historyLength = ", historyLength); //####
+    setOpaque(true);
+    ODL_EXIT_P(this); //####
+} // ScrollingMonitorPanel::ScrollingMonitorPanel
+
+ScrollingMonitorPanel::~ScrollingMonitorPanel(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ScrollingMonitorPanel::~ScrollingMonitorPanel
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ScrollingMonitorPanel::addSample(const float messagesPerSecond,
+                                 const float bytesPerSecond)
+{
+    ODL_OBJENTER(); //####
+    ODL_D2("messagesPerSecond = ", messagesPerSecond, "bytesPerSecond = ", //####
+           bytesPerSecond); //####
+    _history.addSample(messagesPerSecond, bytesPerSecond);
+    repaint();
+    ODL_OBJEXIT(); //####
+} // ScrollingMonitorPanel::addSample
+
+void
+ScrollingMonitorPanel::paint(Graphics & gg)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    juce::Rectangle<float> area(getLocalBounds().toFloat().reduced(kChartGap));
+    float                  chartHeight = (area.getHeight() - kChartGap) / 2;
+    ThroughputSample       latest;
+
+    if (! _history.getLatestSample(latest))
+    {
+        latest._bytesPerSecond = latest._messagesPerSecond = 0;
+    }
+    _history.decimate(static_cast<size_t>(jmax(1, roundToInt(area.getWidth()))),
+                      _messageColumns, _byteColumns);
+    gg.fillAll(Colours::black);
+    gg.setFont(static_cast<float>(kCaptionHeight - 3));
+    drawChart(gg, area.withHeight(chartHeight), _messageColumns, latest._messagesPerSecond,
+              "messages/s");
+    drawChart(gg, area.withTrimmedTop(chartHeight + kChartGap), _byteColumns,
+              latest._bytesPerSecond, "bytes/s");
+    ODL_OBJEXIT(); //####
+} // ScrollingMonitorPanel::paint
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
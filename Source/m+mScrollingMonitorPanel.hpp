@@ -0,0 +1,126 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mScrollingMonitorPanel.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the strip charts of the traffic on a channel.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmScrollingMonitorPanel_HPP_))
+# define mpmScrollingMonitorPanel_HPP_ /* Header guard */
+
+# include "m+mThroughputHistory.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the strip charts of the traffic on a channel. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief A panel showing scrolling charts of the messages and bytes per second received
+     from a channel.
+
+     Each column of a chart shows the range and the average of the samples that it covers, so
+     that the cost of drawing depends only on the size of the panel and the length of the
+     history. */
+    class ScrollingMonitorPanel : public Component
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef Component inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] historyLength The number of samples that are shown. */
+        explicit
+        ScrollingMonitorPanel(const size_t historyLength);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ScrollingMonitorPanel(void);
+
+        /*! @brief Add a sample to the charts.
+         @param[in] messagesPerSecond The number of messages received per second.
+         @param[in] bytesPerSecond The number of bytes received per second. */
+        void
+        addSample(const float messagesPerSecond,
+                  const float bytesPerSecond);
+
+    protected :
+
+    private :
+
+        /*! @brief Draw the content of the component.
+         @param[in,out] gg The graphics context in which to draw. */
+        virtual void
+        paint(Graphics & gg);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The samples that are shown. */
+        ThroughputHistory _history;
+
+        /*! @brief The summaries of the byte rates, kept to avoid reallocating them on every
+         repaint. */
+        ThroughputColumns _byteColumns;
+
+        /*! @brief The summaries of the message rates, kept to avoid reallocating them on every
+         repaint. */
+        ThroughputColumns _messageColumns;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScrollingMonitorPanel)
+
+    }; // ScrollingMonitorPanel
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmScrollingMonitorPanel_HPP_)
@@ -0,0 +1,157 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mScrollingMonitorWindow.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the window showing the traffic on a channel.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mScrollingMonitorWindow.hpp"
+#include "m+mActivitySampler.hpp"
+#include "m+mScrollingMonitorPanel.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the window showing the traffic on a channel. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MPlusM_Manager;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The colour to be used for the window background. */
+static const Colour & kWindowBackgroundColour(Colours::black);
+
+/*! @brief The number of samples shown in the charts; five minutes at the sampler's rate. */
+static const size_t kHistoryLength = 1500;
+
+/*! @brief The initial height of the window. */
+static const int kInitialHeight = 240;
+
+/*! @brief The initial width of the window. */
+static const int kInitialWidth = 500;
+
+/*! @brief The largest width or height of the window. */
+static const int kMaximumSize = 32768;
+
+/*! @brief The smallest height of the window. */
+static const int kMinimumHeight = 120;
+
+/*! @brief The smallest width of the window. */
+static const int kMinimumWidth = 200;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ScrollingMonitorWindow::ScrollingMonitorWindow(const YarpString & portName,
+                                               ActivitySampler &  sampler) :
+    inherited(String("Traffic on ") + portName.c_str(), kWindowBackgroundColour,
+              inherited::closeButton), _portName(portName), _sampler(sampler),
+    _panel(new ScrollingMonitorPanel(kHistoryLength))
+{
+    ODL_ENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P1("sampler = ", &sampler); //####
+    setUsingNativeTitleBar(true);
+    setOpaque(true);
+    setResizable(true, false);
+    setResizeLimits(kMinimumWidth, kMinimumHeight, kMaximumSize, kMaximumSize);
+    setContentOwned(_panel, false);
+    centreWithSize(kInitialWidth, kInitialHeight);
+    setVisible(true);
+    ODL_EXIT_P(this); //####
+} // ScrollingMonitorWindow::ScrollingMonitorWindow
+
+ScrollingMonitorWindow::~ScrollingMonitorWindow(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ScrollingMonitorWindow::~ScrollingMonitorWindow
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ScrollingMonitorWindow::addSample(const float messagesPerSecond,
+                                  const float bytesPerSecond)
+{
+    ODL_OBJENTER(); //####
+    ODL_D2("messagesPerSecond = ", messagesPerSecond, "bytesPerSecond = ", //####
+           bytesPerSecond); //####
+    _panel->addSample(messagesPerSecond, bytesPerSecond);
+    ODL_OBJEXIT(); //####
+} // ScrollingMonitorWindow::addSample
+
+void
+ScrollingMonitorWindow::closeButtonPressed(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+    // The sampler deletes the window, so nothing can be done after this.
+    _sampler.stopMonitoring(_portName);
+} // ScrollingMonitorWindow::closeButtonPressed
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,125 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mScrollingMonitorWindow.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the window showing the traffic on a channel.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmScrollingMonitorWindow_HPP_))
+# define mpmScrollingMonitorWindow_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the window showing the traffic on a channel. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class ActivitySampler;
+    class ScrollingMonitorPanel;
+
+    /*! @brief A window showing scrolling charts of the traffic on a channel.
+
+     The window is owned by the activity sampler, which feeds it with samples; closing the window
+     tells the sampler to stop monitoring the channel. */
+    class ScrollingMonitorWindow : public DocumentWindow
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef DocumentWindow inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] portName The name of the channel being monitored.
+         @param[in] sampler The source of the samples. */
+        ScrollingMonitorWindow(const YarpString & portName,
+                               ActivitySampler &  sampler);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ScrollingMonitorWindow(void);
+
+        /*! @brief Add a sample to the charts.
+         @param[in] messagesPerSecond The number of messages received per second.
+         @param[in] bytesPerSecond The number of bytes received per second. */
+        void
+        addSample(const float messagesPerSecond,
+                  const float bytesPerSecond);
+
+    protected :
+
+    private :
+
+        /*! @brief Called when the close button is pressed. */
+        virtual void
+        closeButtonPressed(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The name of the channel being monitored. */
+        YarpString _portName;
+
+        /*! @brief The source of the samples. */
+        ActivitySampler & _sampler;
+
+        /*! @brief The charts; they are owned by the window. */
+        ScrollingMonitorPanel * _panel;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScrollingMonitorWindow)
+
+    }; // ScrollingMonitorWindow
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmScrollingMonitorWindow_HPP_)
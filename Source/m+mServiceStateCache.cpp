@@ -0,0 +1,375 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mServiceStateCache.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the cache of the states of services.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mServiceStateCache.hpp"
+#include "m+mMetricsPoller.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the cache of the states of services. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The number of milliseconds after which the extra information of a service is out of
+ date. */
+static const double kExtraInfoLifetime = 30000;
+
+/*! @brief The number of milliseconds after which the state of metrics collection of a service is
+ out of date. */
+static const double kMetricsStateLifetime = 10000;
+
+/*! @brief The number of milliseconds to wait for the thread to stop. */
+static const int kThreadKillTime = 3000;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ServiceStateCache::ServiceStateCache(MetricsPoller * poller) :
+    inherited1("Service state cache"), inherited2(), _pending(), _states(), _lock(),
+    _poller(poller)
+{
+    ODL_ENTER(); //####
+    ODL_P1("poller = ", poller); //####
+    if (_poller)
+    {
+        _poller->addChangeListener(this);
+    }
+    ODL_EXIT_P(this); //####
+} // ServiceStateCache::ServiceStateCache
+
+ServiceStateCache::~ServiceStateCache(void)
+{
+    ODL_OBJENTER(); //####
+    if (_poller)
+    {
+        _poller->removeChangeListener(this);
+    }
+    signalThreadShouldExit();
+    notify();
+    stopThread(kThreadKillTime);
+    ODL_OBJEXIT(); //####
+} // ServiceStateCache::~ServiceStateCache
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ServiceStateCache::changeListenerCallback(ChangeBroadcaster * source)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("source = ", source); //####
+    MetricsSnapshot::Ptr snapshot(_poller->getSnapshot());
+
+    if (snapshot)
+    {
+        const ScopedLock          lock(_lock);
+        const ServiceMetricsMap & services = snapshot->getServices();
+
+        for (ServiceMetricsMap::const_iterator walker(services.begin());
+             services.end() != walker; ++walker)
+        {
+            // A service that didn't respond keeps its last known state, which will become stale.
+            if (walker->second._valid)
+            {
+                ServiceState & aState = findState(walker->first);
+
+                if (aState._metricsStateTime < walker->second._sampleTime)
+                {
+                    aState._metricsEnabled = walker->second._enabled;
+                    aState._metricsStateTime = walker->second._sampleTime;
+                }
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ServiceStateCache::changeListenerCallback
+
+ServiceState &
+ServiceStateCache::findState(const YarpString & servicePortName)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    ServiceStateMap::iterator match(_states.find(servicePortName));
+
+    if (_states.end() == match)
+    {
+        ServiceState newState;
+
+        newState._extraInfoTime = -1;
+        newState._metricsStateTime = -1;
+        newState._extraInfoIsStale = true;
+        newState._metricsEnabled = false;
+        newState._metricsStateIsStale = true;
+        newState._refreshRequested = false;
+        match = _states.insert(ServiceStateMap::value_type(servicePortName, newState)).first;
+    }
+    ODL_OBJEXIT_P(&match->second); //####
+    return match->second;
+} // ServiceStateCache::findState
+
+void
+ServiceStateCache::getState(const YarpString & servicePortName,
+                            const bool         needExtraInfo,
+                            ServiceState &     result)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    ODL_B1("needExtraInfo = ", needExtraInfo); //####
+    ODL_P1("result = ", &result); //####
+    bool   needRefresh;
+    double now = Time::getMillisecondCounterHiRes();
+
+    {
+        const ScopedLock lock(_lock);
+        ServiceState &   aState = findState(servicePortName);
+
+        aState._extraInfoIsStale = ((0 > aState._extraInfoTime) ||
+                                    (kExtraInfoLifetime < (now - aState._extraInfoTime)));
+        aState._metricsStateIsStale = ((0 > aState._metricsStateTime) ||
+                                       (kMetricsStateLifetime < (now - aState._metricsStateTime)));
+        needRefresh = (aState._metricsStateIsStale || (needExtraInfo && aState._extraInfoIsStale));
+        result = aState;
+    }
+    if (needRefresh)
+    {
+        requestRefresh(servicePortName, needExtraInfo);
+    }
+    ODL_OBJEXIT(); //####
+} // ServiceStateCache::getState
+
+void
+ServiceStateCache::noteExtraInformation(const YarpString & servicePortName,
+                                        const YarpString & extraInfo)
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("servicePortName = ", servicePortName, "extraInfo = ", extraInfo); //####
+    const ScopedLock lock(_lock);
+    ServiceState &   aState = findState(servicePortName);
+
+    aState._extraInfo = extraInfo;
+    aState._extraInfoTime = Time::getMillisecondCounterHiRes();
+    ODL_OBJEXIT(); //####
+} // ServiceStateCache::noteExtraInformation
+
+void
+ServiceStateCache::noteMetricsState(const YarpString & servicePortName,
+                                    const bool         enabled)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    ODL_B1("enabled = ", enabled); //####
+    {
+        const ScopedLock lock(_lock);
+        ServiceState &   aState = findState(servicePortName);
+
+        aState._metricsEnabled = enabled;
+        aState._metricsStateTime = Time::getMillisecondCounterHiRes();
+    }
+    if (_poller)
+    {
+        _poller->noteMetricsState(servicePortName, enabled);
+    }
+    ODL_OBJEXIT(); //####
+} // ServiceStateCache::noteMetricsState
+
+void
+ServiceStateCache::requestRefresh(const YarpString & servicePortName,
+                                  const bool         needExtraInfo)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    ODL_B1("needExtraInfo = ", needExtraInfo); //####
+    bool wakeUp = false;
+
+    {
+        const ScopedLock            lock(_lock);
+        ServiceState &              aState = findState(servicePortName);
+        ServiceRefreshMap::iterator match(_pending.find(servicePortName));
+
+        if (_pending.end() == match)
+        {
+            // A service that is already being asked will not be asked again until it responds.
+            if (! aState._refreshRequested)
+            {
+                _pending[servicePortName] = needExtraInfo;
+                aState._refreshRequested = true;
+                wakeUp = true;
+            }
+        }
+        else
+        {
+            match->second |= needExtraInfo;
+        }
+    }
+    if (wakeUp)
+    {
+        notify();
+    }
+    ODL_OBJEXIT(); //####
+} // ServiceStateCache::requestRefresh
+
+void
+ServiceStateCache::run(void)
+{
+    ODL_OBJENTER(); //####
+    for ( ; ! threadShouldExit(); )
+    {
+        ServiceRefreshMap pending;
+
+        {
+            const ScopedLock lock(_lock);
+
+            pending.swap(_pending);
+        }
+        for (ServiceRefreshMap::const_iterator walker(pending.begin());
+             (pending.end() != walker) && (! threadShouldExit()); ++walker)
+        {
+            YarpString extraInfo;
+            bool       enabled = false;
+            bool       gotExtraInfo = false;
+            bool       gotMetricsState;
+            double     now;
+
+            // The services are asked without holding the lock, so that retrieving a state is
+            // never held up by a slow service.
+            if (walker->second)
+            {
+                gotExtraInfo = Utilities::GetExtraInformationForService(walker->first, extraInfo,
+                                                                        STANDARD_WAIT_TIME_);
+            }
+            gotMetricsState = Utilities::GetMetricsStateForService(walker->first, enabled,
+                                                                   STANDARD_WAIT_TIME_);
+            now = Time::getMillisecondCounterHiRes();
+            {
+                const ScopedLock          lock(_lock);
+                ServiceStateMap::iterator match(_states.find(walker->first));
+
+                // The service might have gone away while it was being asked.
+                if (_states.end() != match)
+                {
+                    ServiceState & aState = match->second;
+
+                    if (gotExtraInfo)
+                    {
+                        aState._extraInfo = extraInfo;
+                        aState._extraInfoTime = now;
+                    }
+                    if (gotMetricsState)
+                    {
+                        aState._metricsEnabled = enabled;
+                        aState._metricsStateTime = now;
+                    }
+                    aState._refreshRequested = false;
+                }
+            }
+            // The poller doesn't ask services that aren't collecting metrics, so it relies on
+            // being told when one has started.
+            if (gotMetricsState && _poller)
+            {
+                _poller->noteMetricsState(walker->first, enabled);
+            }
+        }
+        if (! threadShouldExit())
+        {
+            wait(-1);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ServiceStateCache::run
+
+void
+ServiceStateCache::setServices(const YarpStringVector & servicePortNames)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("servicePortNames = ", &servicePortNames); //####
+    const ScopedLock lock(_lock);
+    PortSet          present(servicePortNames.begin(), servicePortNames.end());
+
+    for (ServiceStateMap::iterator walker(_states.begin()); _states.end() != walker; )
+    {
+        if (present.end() == present.find(walker->first))
+        {
+            _states.erase(walker++);
+        }
+        else
+        {
+            ++walker;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ServiceStateCache::setServices
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
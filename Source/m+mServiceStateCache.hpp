@@ -0,0 +1,179 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mServiceStateCache.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the cache of the states of services.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmServiceStateCache_HPP_))
+# define mpmServiceStateCache_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the cache of the states of services. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class MetricsPoller;
+
+    /*! @brief The last known states of the services, kept so that menus and displays can be
+     built without waiting for a service to respond.
+
+     The state of metrics collection is updated from each round of the metrics poller. A state
+     that is missing or out of date is marked as stale when it is retrieved, and a background
+     thread is asked to collect it from the service; the result is used the next time the state
+     is retrieved. */
+    class ServiceStateCache : public Thread,
+                              private ChangeListener
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The first class that this class is derived from. */
+        typedef Thread inherited1;
+
+        /*! @brief The second class that this class is derived from. */
+        typedef ChangeListener inherited2;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] poller The source of the metrics of the services, or @c NULL if there is
+         none. */
+        explicit
+        ServiceStateCache(MetricsPoller * poller);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ServiceStateCache(void);
+
+        /*! @brief Retrieve the last known state of a service, asking the service for its state
+         in the background if the state is missing or out of date.
+         @param[in] servicePortName The name of the service port.
+         @param[in] needExtraInfo @c true if the extra information of the service is needed and
+         @c false otherwise.
+         @param[out] result The last known state of the service. */
+        void
+        getState(const YarpString & servicePortName,
+                 const bool         needExtraInfo,
+                 ServiceState &     result);
+
+        /*! @brief Record the extra information of a service that was collected by the
+         application.
+         @param[in] servicePortName The name of the service port.
+         @param[in] extraInfo The extra information of the service. */
+        void
+        noteExtraInformation(const YarpString & servicePortName,
+                             const YarpString & extraInfo);
+
+        /*! @brief Record a change to the state of metrics collection of a service that was made
+         by the application.
+         @param[in] servicePortName The name of the service port.
+         @param[in] enabled @c true if the service is collecting metrics and @c false
+         otherwise. */
+        void
+        noteMetricsState(const YarpString & servicePortName,
+                         const bool         enabled);
+
+        /*! @brief Ask a service for its state in the background.
+         @param[in] servicePortName The name of the service port.
+         @param[in] needExtraInfo @c true if the extra information of the service is needed and
+         @c false otherwise. */
+        void
+        requestRefresh(const YarpString & servicePortName,
+                       const bool         needExtraInfo);
+
+        /*! @brief Discard the states of the services that are no longer present.
+         @param[in] servicePortNames The names of the service ports that are present. */
+        void
+        setServices(const YarpStringVector & servicePortNames);
+
+    protected :
+
+    private :
+
+        /*! @brief Called when the metrics poller has new metrics.
+         @param[in] source The metrics poller. */
+        virtual void
+        changeListenerCallback(ChangeBroadcaster * source);
+
+        /*! @brief Return the state of a service, adding an empty state if it is not known.
+         @param[in] servicePortName The name of the service port.
+         @return The state of the service. */
+        ServiceState &
+        findState(const YarpString & servicePortName);
+
+        /*! @brief Ask the services for their states. */
+        virtual void
+        run(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The services that are to be asked for their states. */
+        ServiceRefreshMap _pending;
+
+        /*! @brief The last known states of the services. */
+        ServiceStateMap _states;
+
+        /*! @brief A lock to manage access to the states and the services to be asked. */
+        CriticalSection _lock;
+
+        /*! @brief The source of the metrics of the services. */
+        MetricsPoller * _poller;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ServiceStateCache)
+
+    }; // ServiceStateCache
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmServiceStateCache_HPP_)
@@ -0,0 +1,488 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mSpatialIndex.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for a spatial index of the entities and connections displayed
+//              by the m+m manager application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mSpatialIndex.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for a spatial index of the entities and connections displayed by the
+ m+m manager application. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The maximum number of grid cells that an item can occupy before it is treated as
+ oversized. */
+static const int kMaxCellsPerItem = 256;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return the key for a grid cell.
+ @param[in] column The column of the cell.
+ @param[in] row The row of the cell.
+ @return The key for the grid cell. */
+inline static int64
+makeCellKey(const int column,
+            const int row)
+{
+    return ((static_cast<int64>(column) << 32) | static_cast<uint32>(row));
+} // makeCellKey
+
+/*! @brief Remove an item from a collection, if it is present.
+ @param[in,out] collection The collection to be modified.
+ @param[in] item The item to be removed. */
+template <typename Collection, typename Item>
+static void
+removeFromCollection(Collection & collection,
+                     const Item & item)
+{
+    for (typename Collection::iterator walker(collection.begin()); collection.end() != walker;
+         ++walker)
+    {
+        if (item == *walker)
+        {
+            collection.erase(walker);
+            break;
+        }
+
+    }
+} // removeFromCollection
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+SpatialIndex::SpatialIndex(const float cellSize) :
+    _connectionBounds(), _containerBounds(), _cells(), _oversizedConnections(),
+    _oversizedContainers(), _nextOrder(0), _cellSize(cellSize)
+{
+    ODL_ENTER(); //####
+    ODL_D1("cellSize = ", cellSize); //####
+    ODL_EXIT_P(this); //####
+} // SpatialIndex::SpatialIndex
+
+SpatialIndex::~SpatialIndex(void)
+{
+    ODL_OBJENTER(); //####
+    clear();
+    ODL_OBJEXIT(); //####
+} // SpatialIndex::~SpatialIndex
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+SpatialIndex::clear(void)
+{
+    ODL_OBJENTER(); //####
+    _cells.clear();
+    _connectionBounds.clear();
+    _containerBounds.clear();
+    _oversizedConnections.clear();
+    _oversizedContainers.clear();
+    _nextOrder = 0;
+    ODL_OBJEXIT(); //####
+} // SpatialIndex::clear
+
+void
+SpatialIndex::findConnections(const juce::Rectangle<float> & area,
+                              ConnectionEndsList &           result)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("area = ", &area, "result = ", &result); //####
+    int                  firstColumn;
+    int                  lastColumn;
+    int                  firstRow;
+    int                  lastRow;
+    OrderedConnectionMap found;
+
+    result.clear();
+    // Walking the cells only pays when there are fewer of them than there are items; a large
+    // area, such as the whole panel at a low zoom, is answered by checking every item instead,
+    // so that the cost doesn't grow with the area.
+    if (getCellRange(area, firstColumn, lastColumn, firstRow, lastRow) &&
+        (_connectionBounds.size() >= static_cast<size_t>((lastColumn - firstColumn + 1) *
+                                                         (lastRow - firstRow + 1))))
+    {
+        for (int column = firstColumn; lastColumn >= column; ++column)
+        {
+            for (int row = firstRow; lastRow >= row; ++row)
+            {
+                CellMap::const_iterator match(_cells.find(makeCellKey(column, row)));
+
+                if (_cells.end() != match)
+                {
+                    const std::vector<ConnectionEnds> & connections = match->second._connections;
+
+                    for (std::vector<ConnectionEnds>::const_iterator walker(connections.begin());
+                         connections.end() != walker; ++walker)
+                    {
+                        ConnectionBoundsMap::const_iterator bounds(_connectionBounds.find(*walker));
+
+                        if ((_connectionBounds.end() != bounds) &&
+                            bounds->second._bounds.intersects(area))
+                        {
+                            found[bounds->second._order] = *walker;
+                        }
+                    }
+                }
+            }
+        }
+        for (std::vector<ConnectionEnds>::const_iterator walker(_oversizedConnections.begin());
+             _oversizedConnections.end() != walker; ++walker)
+        {
+            ConnectionBoundsMap::const_iterator bounds(_connectionBounds.find(*walker));
+
+            if ((_connectionBounds.end() != bounds) && bounds->second._bounds.intersects(area))
+            {
+                found[bounds->second._order] = *walker;
+            }
+        }
+    }
+    else
+    {
+        for (ConnectionBoundsMap::const_iterator walker(_connectionBounds.begin());
+             _connectionBounds.end() != walker; ++walker)
+        {
+            if (walker->second._bounds.intersects(area))
+            {
+                found[walker->second._order] = walker->first;
+            }
+        }
+    }
+    // The results are returned in a fixed order, so that overlapping items are drawn and hit the
+    // same way every time.
+    for (OrderedConnectionMap::const_iterator walker(found.begin()); found.end() != walker;
+         ++walker)
+    {
+        result.push_back(walker->second);
+    }
+    ODL_OBJEXIT(); //####
+} // SpatialIndex::findConnections
+
+void
+SpatialIndex::findContainers(const juce::Rectangle<float> & area,
+                             ContainerList &                result)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("area = ", &area, "result = ", &result); //####
+    int                 firstColumn;
+    int                 lastColumn;
+    int                 firstRow;
+    int                 lastRow;
+    OrderedContainerMap found;
+
+    result.clear();
+    // As for connections, a large area is answered by checking every item.
+    if (getCellRange(area, firstColumn, lastColumn, firstRow, lastRow) &&
+        (_containerBounds.size() >= static_cast<size_t>((lastColumn - firstColumn + 1) *
+                                                        (lastRow - firstRow + 1))))
+    {
+        for (int column = firstColumn; lastColumn >= column; ++column)
+        {
+            for (int row = firstRow; lastRow >= row; ++row)
+            {
+                CellMap::const_iterator match(_cells.find(makeCellKey(column, row)));
+
+                if (_cells.end() != match)
+                {
+                    const ContainerList & containers = match->second._containers;
+
+                    for (ContainerList::const_iterator walker(containers.begin());
+                         containers.end() != walker; ++walker)
+                    {
+                        ContainerBoundsMap::const_iterator bounds(_containerBounds.find(*walker));
+
+                        if ((_containerBounds.end() != bounds) &&
+                            bounds->second._bounds.intersects(area))
+                        {
+                            found[bounds->second._order] = *walker;
+                        }
+                    }
+                }
+            }
+        }
+        for (ContainerList::const_iterator walker(_oversizedContainers.begin());
+             _oversizedContainers.end() != walker; ++walker)
+        {
+            ContainerBoundsMap::const_iterator bounds(_containerBounds.find(*walker));
+
+            if ((_containerBounds.end() != bounds) && bounds->second._bounds.intersects(area))
+            {
+                found[bounds->second._order] = *walker;
+            }
+        }
+    }
+    else
+    {
+        for (ContainerBoundsMap::const_iterator walker(_containerBounds.begin());
+             _containerBounds.end() != walker; ++walker)
+        {
+            if (walker->second._bounds.intersects(area))
+            {
+                found[walker->second._order] = walker->first;
+            }
+        }
+    }
+    for (OrderedContainerMap::const_iterator walker(found.begin()); found.end() != walker;
+         ++walker)
+    {
+        result.push_back(walker->second);
+    }
+    ODL_OBJEXIT(); //####
+} // SpatialIndex::findContainers
+
+bool
+SpatialIndex::getCellRange(const juce::Rectangle<float> & area,
+                           int &                          firstColumn,
+                           int &                          lastColumn,
+                           int &                          firstRow,
+                           int &                          lastRow)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("area = ", &area); //####
+    bool result;
+
+    firstColumn = static_cast<int>(floor(area.getX() / _cellSize));
+    lastColumn = static_cast<int>(floor(area.getRight() / _cellSize));
+    firstRow = static_cast<int>(floor(area.getY() / _cellSize));
+    lastRow = static_cast<int>(floor(area.getBottom() / _cellSize));
+    result = (kMaxCellsPerItem >= ((lastColumn - firstColumn + 1) * (lastRow - firstRow + 1)));
+    ODL_I4("firstColumn <- ", firstColumn, "lastColumn <- ", lastColumn, "firstRow <- ", //####
+           firstRow, "lastRow <- ", lastRow); //####
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // SpatialIndex::getCellRange
+
+void
+SpatialIndex::insertConnection(const ConnectionEnds &         ends,
+                               const juce::Rectangle<float> & bounds)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("source = ", ends.first, "destination = ", ends.second, "bounds = ", &bounds); //####
+    int                                 firstColumn;
+    int                                 lastColumn;
+    int                                 firstRow;
+    int                                 lastRow;
+    ConnectionBoundsMap::const_iterator match(_connectionBounds.find(ends));
+    size_t                              order = ((_connectionBounds.end() == match) ?
+                                                 _nextOrder++ : match->second._order);
+
+    removeConnection(ends);
+    ItemBounds & newBounds = _connectionBounds[ends];
+
+    newBounds._bounds = bounds;
+    newBounds._order = order;
+    if (getCellRange(bounds, firstColumn, lastColumn, firstRow, lastRow))
+    {
+        for (int column = firstColumn; lastColumn >= column; ++column)
+        {
+            for (int row = firstRow; lastRow >= row; ++row)
+            {
+                _cells[makeCellKey(column, row)]._connections.push_back(ends);
+            }
+        }
+    }
+    else
+    {
+        _oversizedConnections.push_back(ends);
+    }
+    ODL_OBJEXIT(); //####
+} // SpatialIndex::insertConnection
+
+void
+SpatialIndex::insertContainer(ChannelContainer *             aContainer,
+                              const juce::Rectangle<float> & bounds)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("aContainer = ", aContainer, "bounds = ", &bounds); //####
+    int                                firstColumn;
+    int                                lastColumn;
+    int                                firstRow;
+    int                                lastRow;
+    ContainerBoundsMap::const_iterator match(_containerBounds.find(aContainer));
+    size_t                             order = ((_containerBounds.end() == match) ?
+                                                _nextOrder++ : match->second._order);
+
+    removeContainer(aContainer);
+    ItemBounds & newBounds = _containerBounds[aContainer];
+
+    newBounds._bounds = bounds;
+    newBounds._order = order;
+    if (getCellRange(bounds, firstColumn, lastColumn, firstRow, lastRow))
+    {
+        for (int column = firstColumn; lastColumn >= column; ++column)
+        {
+            for (int row = firstRow; lastRow >= row; ++row)
+            {
+                _cells[makeCellKey(column, row)]._containers.push_back(aContainer);
+            }
+        }
+    }
+    else
+    {
+        _oversizedContainers.push_back(aContainer);
+    }
+    ODL_OBJEXIT(); //####
+} // SpatialIndex::insertContainer
+
+void
+SpatialIndex::removeConnection(const ConnectionEnds & ends)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("source = ", ends.first, "destination = ", ends.second); //####
+    ConnectionBoundsMap::iterator match(_connectionBounds.find(ends));
+
+    if (_connectionBounds.end() != match)
+    {
+        int firstColumn;
+        int lastColumn;
+        int firstRow;
+        int lastRow;
+
+        if (getCellRange(match->second._bounds, firstColumn, lastColumn, firstRow, lastRow))
+        {
+            for (int column = firstColumn; lastColumn >= column; ++column)
+            {
+                for (int row = firstRow; lastRow >= row; ++row)
+                {
+                    CellMap::iterator cell(_cells.find(makeCellKey(column, row)));
+
+                    if (_cells.end() != cell)
+                    {
+                        removeFromCollection(cell->second._connections, ends);
+                        if (cell->second._connections.empty() &&
+                            cell->second._containers.empty())
+                        {
+                            _cells.erase(cell);
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            removeFromCollection(_oversizedConnections, ends);
+        }
+        _connectionBounds.erase(match);
+    }
+    ODL_OBJEXIT(); //####
+} // SpatialIndex::removeConnection
+
+void
+SpatialIndex::removeContainer(ChannelContainer * aContainer)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("aContainer = ", aContainer); //####
+    ContainerBoundsMap::iterator match(_containerBounds.find(aContainer));
+
+    if (_containerBounds.end() != match)
+    {
+        int firstColumn;
+        int lastColumn;
+        int firstRow;
+        int lastRow;
+
+        if (getCellRange(match->second._bounds, firstColumn, lastColumn, firstRow, lastRow))
+        {
+            for (int column = firstColumn; lastColumn >= column; ++column)
+            {
+                for (int row = firstRow; lastRow >= row; ++row)
+                {
+                    CellMap::iterator cell(_cells.find(makeCellKey(column, row)));
+
+                    if (_cells.end() != cell)
+                    {
+                        removeFromCollection(cell->second._containers, aContainer);
+                        if (cell->second._connections.empty() &&
+                            cell->second._containers.empty())
+                        {
+                            _cells.erase(cell);
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            removeFromCollection(_oversizedContainers, aContainer);
+        }
+        _containerBounds.erase(match);
+    }
+    ODL_OBJEXIT(); //####
+} // SpatialIndex::removeContainer
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,253 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mSpatialIndex.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for a spatial index of the entities and connections displayed
+//              by the m+m manager application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmSpatialIndex_HPP_))
+# define mpmSpatialIndex_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for a spatial index of the entities and connections displayed by the
+ m+m manager application. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief A uniform grid of the bounds of the entities and connections in the entities panel.
+
+     Items are recorded in every grid cell that their bounds overlap, so that a query only needs to
+     look at the cells that overlap the area of interest. Items that would occupy too many cells are
+     kept in a separate list that is checked directly. */
+    class SpatialIndex
+    {
+    public :
+
+    protected :
+
+    private :
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] cellSize The width and height of a grid cell. */
+        explicit
+        SpatialIndex(const float cellSize);
+
+        /*! @brief The destructor. */
+        virtual
+        ~SpatialIndex(void);
+
+        /*! @brief Remove all the items from the index. */
+        void
+        clear(void);
+
+        /*! @brief Find the connections whose bounds intersect an area.
+         @param[in] area The area of interest.
+         @param[out] result The connections whose bounds intersect the area, in the order in which
+         they were first added to the index. */
+        void
+        findConnections(const juce::Rectangle<float> & area,
+                        ConnectionEndsList &           result)
+        const;
+
+        /*! @brief Find the containers whose bounds intersect an area.
+         @param[in] area The area of interest.
+         @param[out] result The containers whose bounds intersect the area, in the order in which
+         they were first added to the index. */
+        void
+        findContainers(const juce::Rectangle<float> & area,
+                       ContainerList &                result)
+        const;
+
+        /*! @brief Returns @c true if a container is in the index and @c false otherwise.
+         @param[in] aContainer The container of interest.
+         @return @c true if the container is in the index and @c false otherwise. */
+        inline bool
+        hasContainer(ChannelContainer * aContainer)
+        const
+        {
+            return (_containerBounds.end() != _containerBounds.find(aContainer));
+        } // hasContainer
+
+        /*! @brief Add a connection to the index, replacing any previous bounds for the connection.
+
+         A connection that is already in the index keeps its place in the order of the results.
+         @param[in] ends The source and destination of the connection.
+         @param[in] bounds The area covered by the connection. */
+        void
+        insertConnection(const ConnectionEnds &         ends,
+                         const juce::Rectangle<float> & bounds);
+
+        /*! @brief Add a container to the index, replacing any previous bounds for the container.
+
+         A container that is already in the index keeps its place in the order of the results.
+         @param[in] aContainer The container to be added.
+         @param[in] bounds The area covered by the container. */
+        void
+        insertContainer(ChannelContainer *             aContainer,
+                        const juce::Rectangle<float> & bounds);
+
+        /*! @brief Remove a connection from the index.
+         @param[in] ends The source and destination of the connection. */
+        void
+        removeConnection(const ConnectionEnds & ends);
+
+        /*! @brief Remove a container from the index.
+         @param[in] aContainer The container to be removed. */
+        void
+        removeContainer(ChannelContainer * aContainer);
+
+    protected :
+
+    private :
+
+        /*! @brief The contents of a grid cell. */
+        struct GridCell
+        {
+            /*! @brief The connections that overlap the cell. */
+            std::vector<ConnectionEnds> _connections;
+
+            /*! @brief The containers that overlap the cell. */
+            ContainerList _containers;
+
+        }; // GridCell
+
+        /*! @brief The bounds of an item in the index. */
+        struct ItemBounds
+        {
+            /*! @brief The area covered by the item. */
+            juce::Rectangle<float> _bounds;
+
+            /*! @brief When the item was first added to the index, relative to the other items. */
+            size_t _order;
+
+        }; // ItemBounds
+
+        /*! @brief A mapping from cell keys to cell contents. */
+        typedef std::unordered_map<int64, GridCell> CellMap;
+
+        /*! @brief A mapping from connections to their bounds. */
+        typedef std::map<ConnectionEnds, ItemBounds> ConnectionBoundsMap;
+
+        /*! @brief A mapping from containers to their bounds. */
+        typedef std::map<ChannelContainer *, ItemBounds> ContainerBoundsMap;
+
+        /*! @brief A mapping from the order of addition to the index to connections. */
+        typedef std::map<size_t, ConnectionEnds> OrderedConnectionMap;
+
+        /*! @brief A mapping from the order of addition to the index to containers. */
+        typedef std::map<size_t, ChannelContainer *> OrderedContainerMap;
+
+        /*! @brief The copy constructor.
+         @param[in] other The object to be copied. */
+        SpatialIndex(const SpatialIndex & other);
+
+        /*! @brief Determine the range of grid cells that are covered by an area.
+         @param[in] area The area of interest.
+         @param[out] firstColumn The leftmost column covered by the area.
+         @param[out] lastColumn The rightmost column covered by the area.
+         @param[out] firstRow The topmost row covered by the area.
+         @param[out] lastRow The bottommost row covered by the area.
+         @return @c true if the area covers few enough cells to be recorded in the grid and
+         @c false otherwise. */
+        bool
+        getCellRange(const juce::Rectangle<float> & area,
+                     int &                          firstColumn,
+                     int &                          lastColumn,
+                     int &                          firstRow,
+                     int &                          lastRow)
+        const;
+
+        /*! @brief The assignment operator.
+         @param[in] other The object to be copied.
+         @return The updated object. */
+        SpatialIndex &
+        operator =(const SpatialIndex & other);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The bounds of the connections in the index. */
+        ConnectionBoundsMap _connectionBounds;
+
+        /*! @brief The bounds of the containers in the index. */
+        ContainerBoundsMap _containerBounds;
+
+        /*! @brief The grid cells that have something in them. */
+        CellMap _cells;
+
+        /*! @brief The connections that are too large to record in the grid. */
+        std::vector<ConnectionEnds> _oversizedConnections;
+
+        /*! @brief The containers that are too large to record in the grid. */
+        ContainerList _oversizedContainers;
+
+        /*! @brief The order to be given to the next new item in the index. */
+        size_t _nextOrder;
+
+        /*! @brief The width and height of a grid cell. */
+        float _cellSize;
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[4];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+    }; // SpatialIndex
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmSpatialIndex_HPP_)
@@ -0,0 +1,202 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mThroughputHistory.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the recent history of the traffic on a channel.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mThroughputHistory.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the recent history of the traffic on a channel. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MPlusM_Manager;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Include a value in the summary for a column.
+
+ The average holds the sum of the values until the column is complete.
+ @param[in,out] column The summary to be updated.
+ @param[in] value The value to be included. */
+static void
+includeInColumn(ThroughputColumn & column,
+                const float        value)
+{
+    if (0 < column._numSamples)
+    {
+        column._maximum = jmax(column._maximum, value);
+        column._minimum = jmin(column._minimum, value);
+    }
+    else
+    {
+        column._maximum = column._minimum = value;
+    }
+    column._average += value;
+    ++column._numSamples;
+} // includeInColumn
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ThroughputHistory::ThroughputHistory(const size_t capacity) :
+    _samples(capacity ? capacity : 1), _count(0), _nextSample(0)
+{
+    ODL_ENTER(); //####
+    ODL_I1("capacity = ", capacity); //####
+    ODL_EXIT_P(this); //####
+} // ThroughputHistory::ThroughputHistory
+
+ThroughputHistory::~ThroughputHistory(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ThroughputHistory::~ThroughputHistory
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ThroughputHistory::addSample(const float messagesPerSecond,
+                             const float bytesPerSecond)
+{
+    ODL_OBJENTER(); //####
+    ODL_D2("messagesPerSecond = ", messagesPerSecond, "bytesPerSecond = ", //####
+           bytesPerSecond); //####
+    ThroughputSample & aSample = _samples[_nextSample];
+
+    aSample._bytesPerSecond = bytesPerSecond;
+    aSample._messagesPerSecond = messagesPerSecond;
+    _nextSample = (_nextSample + 1) % _samples.size();
+    if (_samples.size() > _count)
+    {
+        ++_count;
+    }
+    ODL_OBJEXIT(); //####
+} // ThroughputHistory::addSample
+
+void
+ThroughputHistory::decimate(const size_t        numColumns,
+                            ThroughputColumns & messageColumns,
+                            ThroughputColumns & byteColumns)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("numColumns = ", numColumns); //####
+    ODL_P2("messageColumns = ", &messageColumns, "byteColumns = ", &byteColumns); //####
+    size_t           capacity = _samples.size();
+    size_t           columnCount = jmin(numColumns, capacity);
+    // The buffer is treated as a timeline of 'capacity' slots, ending with the most recent
+    // sample; the slots before 'firstSlot' have not been filled yet.
+    size_t           firstSlot = capacity - _count;
+    ThroughputColumn emptyColumn;
+
+    emptyColumn._average = emptyColumn._maximum = emptyColumn._minimum = 0;
+    emptyColumn._numSamples = 0;
+    messageColumns.assign(columnCount, emptyColumn);
+    byteColumns.assign(columnCount, emptyColumn);
+    for (size_t ii = 0; columnCount > ii; ++ii)
+    {
+        ThroughputColumn & messageColumn = messageColumns[ii];
+        ThroughputColumn & byteColumn = byteColumns[ii];
+        size_t             endSlot = ((ii + 1) * capacity) / columnCount;
+
+        for (size_t slot = jmax((ii * capacity) / columnCount, firstSlot); endSlot > slot; ++slot)
+        {
+            const ThroughputSample & aSample = _samples[(_nextSample + slot) % capacity];
+
+            includeInColumn(messageColumn, aSample._messagesPerSecond);
+            includeInColumn(byteColumn, aSample._bytesPerSecond);
+        }
+        if (0 < messageColumn._numSamples)
+        {
+            messageColumn._average /= messageColumn._numSamples;
+            byteColumn._average /= byteColumn._numSamples;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ThroughputHistory::decimate
+
+bool
+ThroughputHistory::getLatestSample(ThroughputSample & result)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("result = ", &result); //####
+    bool okSoFar = (0 < _count);
+
+    if (okSoFar)
+    {
+        result = _samples[(_nextSample + _samples.size() - 1) % _samples.size()];
+    }
+    ODL_OBJEXIT_B(okSoFar); //####
+    return okSoFar;
+} // ThroughputHistory::getLatestSample
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,146 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mThroughputHistory.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the recent history of the traffic on a channel.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmThroughputHistory_HPP_))
+# define mpmThroughputHistory_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the recent history of the traffic on a channel. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief A fixed-size ring buffer of throughput samples.
+
+     The buffer is allocated once and the oldest samples are overwritten when it is full, so the
+     memory used doesn't grow however long a channel is monitored. The samples are summarized into
+     at most one column per sample for drawing, so the cost of drawing is bounded by the capacity
+     of the buffer. The history is only used from the message thread. */
+    class ThroughputHistory
+    {
+    public :
+
+    protected :
+
+    private :
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] capacity The maximum number of samples that are kept. */
+        explicit
+        ThroughputHistory(const size_t capacity);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ThroughputHistory(void);
+
+        /*! @brief Add a sample to the buffer.
+         @param[in] messagesPerSecond The number of messages received per second.
+         @param[in] bytesPerSecond The number of bytes received per second. */
+        void
+        addSample(const float messagesPerSecond,
+                  const float bytesPerSecond);
+
+        /*! @brief Summarize the samples for drawing.
+
+         The whole capacity of the buffer is divided evenly between the columns, with the most
+         recent sample in the last column. Columns that are older than the oldest sample are
+         empty.
+         @param[in] numColumns The maximum number of columns; no more columns than the capacity
+         of the buffer are produced.
+         @param[out] messageColumns The summaries of the message rates.
+         @param[out] byteColumns The summaries of the byte rates. */
+        void
+        decimate(const size_t        numColumns,
+                 ThroughputColumns & messageColumns,
+                 ThroughputColumns & byteColumns)
+        const;
+
+        /*! @brief Return the most recent sample.
+         @param[out] result The most recent sample.
+         @return @c true if there was a sample and @c false otherwise. */
+        bool
+        getLatestSample(ThroughputSample & result)
+        const;
+
+    protected :
+
+    private :
+
+        /*! @brief The copy constructor.
+         @param[in] other The object to be copied. */
+        ThroughputHistory(const ThroughputHistory & other);
+
+        /*! @brief The assignment operator.
+         @param[in] other The object to be copied.
+         @return The updated object. */
+        ThroughputHistory &
+        operator =(const ThroughputHistory & other);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The samples. */
+        ThroughputSamples _samples;
+
+        /*! @brief The number of samples in the buffer. */
+        size_t _count;
+
+        /*! @brief The position in the buffer for the next sample. */
+        size_t _nextSample;
+
+    }; // ThroughputHistory
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmThroughputHistory_HPP_)
@@ -0,0 +1,224 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mTimingOverlay.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the display of timing information over the primary window
+//              of the m+m manager application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mTimingOverlay.hpp"
+#include "m+mTimingRecorder.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the display of timing information over the primary window of
+ the m+m manager application. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The number of frames that are averaged for the frame time. */
+static const size_t kFramesToAverage = 30;
+
+/*! @brief The height of each line of text. */
+static const int kLineHeight = 15;
+
+/*! @brief The number of lines of text. */
+static const int kNumLines = 7;
+
+/*! @brief The colour to be used for the background of the overlay. */
+static const Colour kOverlayBackgroundColour(0xFF202020);
+
+/*! @brief The colour to be used for text in the overlay. */
+static const Colour & kOverlayTextColour(Colours::lightgreen);
+
+/*! @brief The width of the overlay. */
+static const int kOverlayWidth = 300;
+
+/*! @brief The time between refreshes of the overlay, in milliseconds. */
+static const int kRefreshInterval = 250;
+
+/*! @brief The amount of space around the text being displayed. */
+static const int kTextInset = 4;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return the duration of the most recent sample of a given kind, as text.
+ @param[in] recorder The source of the timing samples.
+ @param[in] kind The kind of sample of interest.
+ @return The duration of the most recent sample, or a dash if there is no such sample. */
+static String
+describeLatestSample(const TimingRecorder & recorder,
+                     const TimingKind       kind)
+{
+    String       result;
+    TimingSample aSample;
+
+    if (recorder.getLatestSample(kind, aSample))
+    {
+        result = String(aSample._duration, 1) + " ms";
+    }
+    else
+    {
+        result = "-";
+    }
+    return result;
+} // describeLatestSample
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+TimingOverlay::TimingOverlay(TimingRecorder & recorder) :
+    inherited1(), inherited2(), _recorder(recorder)
+{
+    ODL_ENTER(); //####
+    ODL_P1("recorder = ", &recorder); //####
+    setOpaque(true);
+    setInterceptsMouseClicks(false, false);
+    setSize(kOverlayWidth, (kNumLines * kLineHeight) + (2 * kTextInset));
+    ODL_EXIT_P(this); //####
+} // TimingOverlay::TimingOverlay
+
+TimingOverlay::~TimingOverlay(void)
+{
+    ODL_OBJENTER(); //####
+    stopTimer();
+    ODL_OBJEXIT(); //####
+} // TimingOverlay::~TimingOverlay
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+TimingOverlay::paint(Graphics & gg)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    StringArray  lines;
+    TimingSample frame;
+
+    if (_recorder.getLatestSample(kTimingKindPaint, frame))
+    {
+        lines.add(String("Frame: ") + String(frame._duration, 1) + " ms (average " +
+                  String(_recorder.getAverageDuration(kTimingKindPaint, kFramesToAverage), 1) +
+                  " ms)");
+        lines.add(String("Entities: ") + String(frame._entitiesDrawn) + " drawn, " +
+                  String(frame._entitiesCulled) + " culled");
+        lines.add(String("Connections: ") + String(frame._connectionsDrawn) + " drawn, " +
+                  String(frame._connectionsCulled) + " culled");
+    }
+    else
+    {
+        lines.add("Frame: -");
+        lines.add("Entities: -");
+        lines.add("Connections: -");
+    }
+    lines.add(String("updatePanels: ") + describeLatestSample(_recorder,
+                                                              kTimingKindUpdatePanels));
+    lines.add(String("setEntityPositions: ") +
+              describeLatestSample(_recorder, kTimingKindSetEntityPositions));
+    lines.add(String("Scan to frame: ") + describeLatestSample(_recorder, kTimingKindScanLatency));
+    lines.add(String("Registry to frame: ") + describeLatestSample(_recorder,
+                                                                   kTimingKindRegistryLatency));
+    gg.fillAll(kOverlayBackgroundColour);
+    gg.setColour(kOverlayTextColour);
+    gg.setFont(static_cast<float>(kLineHeight - 2));
+    for (int ii = 0, mm = lines.size(); mm > ii; ++ii)
+    {
+        gg.drawText(lines[ii], kTextInset, kTextInset + (ii * kLineHeight),
+                    getWidth() - (2 * kTextInset), kLineHeight, Justification::centredLeft, true);
+    }
+    ODL_OBJEXIT(); //####
+} // TimingOverlay::paint
+
+void
+TimingOverlay::timerCallback(void)
+{
+    ODL_OBJENTER(); //####
+    repaint();
+    ODL_OBJEXIT(); //####
+} // TimingOverlay::timerCallback
+
+void
+TimingOverlay::visibilityChanged(void)
+{
+    ODL_OBJENTER(); //####
+    // There's no need to refresh the overlay while it can't be seen.
+    if (isVisible())
+    {
+        startTimer(kRefreshInterval);
+    }
+    else
+    {
+        stopTimer();
+    }
+    ODL_OBJEXIT(); //####
+} // TimingOverlay::visibilityChanged
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
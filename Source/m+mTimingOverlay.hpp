@@ -0,0 +1,125 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mTimingOverlay.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the display of timing information over the primary window
+//              of the m+m manager application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmTimingOverlay_HPP_))
+# define mpmTimingOverlay_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the display of timing information over the primary window of
+ the m+m manager application. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class TimingRecorder;
+
+    /*! @brief A small panel that shows the most recent timing samples.
+
+     The panel is refreshed on a timer, rather than after every frame, so that showing it doesn't
+     cause the main window to be redrawn continuously. */
+    class TimingOverlay : public Component,
+                          private Timer
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The first class that this class is derived from. */
+        typedef Component inherited1;
+
+        /*! @brief The second class that this class is derived from. */
+        typedef Timer inherited2;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] recorder The source of the timing samples. */
+        explicit
+        TimingOverlay(TimingRecorder & recorder);
+
+        /*! @brief The destructor. */
+        virtual
+        ~TimingOverlay(void);
+
+    protected :
+
+    private :
+
+        /*! @brief Draw the content of the component.
+         @param[in,out] gg The graphics context in which to draw. */
+        virtual void
+        paint(Graphics & gg);
+
+        /*! @brief Called when the component is shown or hidden. */
+        virtual void
+        visibilityChanged(void);
+
+        /*! @brief Called when the timer fires. */
+        virtual void
+        timerCallback(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The source of the timing samples. */
+        TimingRecorder & _recorder;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimingOverlay)
+
+    }; // TimingOverlay
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmTimingOverlay_HPP_)
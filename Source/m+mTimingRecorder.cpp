@@ -0,0 +1,395 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mTimingRecorder.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the recorder of timing samples for the m+m manager
+//              application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mTimingRecorder.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the recorder of timing samples for the m+m manager application. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return a sample with only the kind, start time and duration filled in.
+ @param[in] kind What was measured.
+ @param[in] startTime When the measurement started.
+ @param[in] duration The duration of the measurement.
+ @return The sample. */
+static TimingSample
+makeSample(const TimingKind kind,
+           const double     startTime,
+           const double     duration)
+{
+    TimingSample result;
+
+    result._startTime = startTime;
+    result._duration = duration;
+    result._kind = kind;
+    result._entitiesDrawn = result._entitiesCulled = 0;
+    result._connectionsDrawn = result._connectionsCulled = 0;
+    return result;
+} // makeSample
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+const char *
+TimingRecorder::nameForKind(const TimingKind kind)
+{
+    ODL_ENTER(); //####
+    ODL_I1("kind = ", kind); //####
+    const char * result;
+
+    switch (kind)
+    {
+        case kTimingKindPaint :
+            result = "paint";
+            break;
+
+        case kTimingKindUpdatePanels :
+            result = "updatePanels";
+            break;
+
+        case kTimingKindSetEntityPositions :
+            result = "setEntityPositions";
+            break;
+
+        case kTimingKindScanLatency :
+            result = "scanLatency";
+            break;
+
+        case kTimingKindRegistryLatency :
+            result = "registryLatency";
+            break;
+
+        default :
+            result = "unknown";
+            break;
+
+    }
+    ODL_EXIT_S(result); //####
+    return result;
+} // TimingRecorder::nameForKind
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+TimingRecorder::TimingRecorder(const size_t capacity) :
+    _samples(capacity ? capacity : 1), _lock(), _baseTime(Time::getMillisecondCounterHiRes()),
+    _pendingRegistryEventTime(-1), _completedScanStartTime(0), _completedScanEndTime(-1),
+    _currentScanStartTime(0), _count(0), _nextSample(0)
+{
+    ODL_ENTER(); //####
+    ODL_I1("capacity = ", capacity); //####
+    ODL_EXIT_P(this); //####
+} // TimingRecorder::TimingRecorder
+
+TimingRecorder::~TimingRecorder(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // TimingRecorder::~TimingRecorder
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+TimingRecorder::addSample(const TimingSample & sample)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("sample = ", &sample); //####
+    const ScopedLock lock(_lock);
+
+    addSampleLocked(sample);
+    ODL_OBJEXIT(); //####
+} // TimingRecorder::addSample
+
+void
+TimingRecorder::addSample(const TimingKind kind,
+                          const double     startTime)
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("kind = ", kind); //####
+    ODL_D1("startTime = ", startTime); //####
+    addSample(makeSample(kind, startTime, getCurrentTime() - startTime));
+    ODL_OBJEXIT(); //####
+} // TimingRecorder::addSample
+
+void
+TimingRecorder::addSampleLocked(const TimingSample & sample)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("sample = ", &sample); //####
+    _samples[_nextSample] = sample;
+    _nextSample = (_nextSample + 1) % _samples.size();
+    if (_samples.size() > _count)
+    {
+        ++_count;
+    }
+    ODL_OBJEXIT(); //####
+} // TimingRecorder::addSampleLocked
+
+void
+TimingRecorder::clear(void)
+{
+    ODL_OBJENTER(); //####
+    const ScopedLock lock(_lock);
+
+    _count = _nextSample = 0;
+    ODL_OBJEXIT(); //####
+} // TimingRecorder::clear
+
+double
+TimingRecorder::getAverageDuration(const TimingKind kind,
+                                   const size_t     maxSamples)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_I2("kind = ", kind, "maxSamples = ", maxSamples); //####
+    const ScopedLock lock(_lock);
+    double           total = 0;
+    size_t           found = 0;
+
+    // Walk backwards from the newest sample.
+    for (size_t ii = _count; (0 < ii) && (maxSamples > found); --ii)
+    {
+        const TimingSample & aSample = getSampleLocked(ii - 1);
+
+        if (kind == aSample._kind)
+        {
+            total += aSample._duration;
+            ++found;
+        }
+    }
+    double result = (found ? (total / found) : 0);
+
+    ODL_OBJEXIT_D(result); //####
+    return result;
+} // TimingRecorder::getAverageDuration
+
+double
+TimingRecorder::getCurrentTime(void)
+const
+{
+    ODL_OBJENTER(); //####
+    double result = Time::getMillisecondCounterHiRes() - _baseTime;
+
+    ODL_OBJEXIT_D(result); //####
+    return result;
+} // TimingRecorder::getCurrentTime
+
+bool
+TimingRecorder::getLatestSample(const TimingKind kind,
+                                TimingSample &   result)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("kind = ", kind); //####
+    ODL_P1("result = ", &result); //####
+    const ScopedLock lock(_lock);
+    bool             found = false;
+
+    for (size_t ii = _count; (0 < ii) && (! found); --ii)
+    {
+        const TimingSample & aSample = getSampleLocked(ii - 1);
+
+        if (kind == aSample._kind)
+        {
+            result = aSample;
+            found = true;
+        }
+    }
+    ODL_OBJEXIT_B(found); //####
+    return found;
+} // TimingRecorder::getLatestSample
+
+const TimingSample &
+TimingRecorder::getSampleLocked(const size_t index)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_I1("index = ", index); //####
+    // When the buffer has wrapped, the oldest sample is the one that will be overwritten next.
+    size_t               first = ((_samples.size() > _count) ? 0 : _nextSample);
+    const TimingSample & result = _samples[(first + index) % _samples.size()];
+
+    ODL_OBJEXIT_P(&result); //####
+    return result;
+} // TimingRecorder::getSampleLocked
+
+void
+TimingRecorder::getSamples(TimingSamples & result)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("result = ", &result); //####
+    const ScopedLock lock(_lock);
+
+    result.clear();
+    result.reserve(_count);
+    for (size_t ii = 0; _count > ii; ++ii)
+    {
+        result.push_back(getSampleLocked(ii));
+    }
+    ODL_OBJEXIT(); //####
+} // TimingRecorder::getSamples
+
+void
+TimingRecorder::noteRegistryStatusEvent(void)
+{
+    ODL_OBJENTER(); //####
+    double           now = getCurrentTime();
+    const ScopedLock lock(_lock);
+
+    // Only the earliest report matters, as the following scan covers all of them.
+    if (0 > _pendingRegistryEventTime)
+    {
+        _pendingRegistryEventTime = now;
+    }
+    ODL_OBJEXIT(); //####
+} // TimingRecorder::noteRegistryStatusEvent
+
+void
+TimingRecorder::noteScanCompleted(void)
+{
+    ODL_OBJENTER(); //####
+    double           now = getCurrentTime();
+    const ScopedLock lock(_lock);
+
+    _completedScanStartTime = _currentScanStartTime;
+    _completedScanEndTime = now;
+    ODL_OBJEXIT(); //####
+} // TimingRecorder::noteScanCompleted
+
+void
+TimingRecorder::noteScanShown(void)
+{
+    ODL_OBJENTER(); //####
+    double           now = getCurrentTime();
+    const ScopedLock lock(_lock);
+
+    if (0 <= _completedScanEndTime)
+    {
+        addSampleLocked(makeSample(kTimingKindScanLatency, _completedScanEndTime,
+                                   now - _completedScanEndTime));
+        // A status report is only reflected in a scan that started after the report arrived.
+        if ((0 <= _pendingRegistryEventTime) &&
+            (_pendingRegistryEventTime <= _completedScanStartTime))
+        {
+            addSampleLocked(makeSample(kTimingKindRegistryLatency, _pendingRegistryEventTime,
+                                       now - _pendingRegistryEventTime));
+            _pendingRegistryEventTime = -1;
+        }
+        _completedScanEndTime = -1;
+    }
+    ODL_OBJEXIT(); //####
+} // TimingRecorder::noteScanShown
+
+void
+TimingRecorder::noteScanStarted(void)
+{
+    ODL_OBJENTER(); //####
+    double           now = getCurrentTime();
+    const ScopedLock lock(_lock);
+
+    _currentScanStartTime = now;
+    ODL_OBJEXIT(); //####
+} // TimingRecorder::noteScanStarted
+
+bool
+TimingRecorder::writeToFile(const File & destination)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("destination = ", &destination); //####
+    TimingSamples samples;
+    String        contents("kind,start_ms,duration_ms,entities_drawn,entities_culled,"
+                           "connections_drawn,connections_culled\n");
+
+    // Copy the samples first, so that the lock isn't held while the file is written.
+    getSamples(samples);
+    contents.preallocateBytes(samples.size() * 64);
+    for (TimingSamples::const_iterator walker(samples.begin()); samples.end() != walker; ++walker)
+    {
+        contents << nameForKind(walker->_kind) << "," << String(walker->_startTime, 3) << "," <<
+                    String(walker->_duration, 3) << "," << walker->_entitiesDrawn << "," <<
+                    walker->_entitiesCulled << "," << walker->_connectionsDrawn << "," <<
+                    walker->_connectionsCulled << "\n";
+    }
+    bool result = destination.replaceWithText(contents);
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // TimingRecorder::writeToFile
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,217 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mTimingRecorder.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the recorder of timing samples for the m+m manager
+//              application.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmTimingRecorder_HPP_))
+# define mpmTimingRecorder_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the recorder of timing samples for the m+m manager application. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief A fixed-size ring buffer of timing samples.
+
+     The buffer is allocated once, so recording a sample is cheap enough to do on every frame. The
+     oldest samples are overwritten when the buffer is full. The recorder can be used from the
+     background threads as well as from the message thread. */
+    class TimingRecorder
+    {
+    public :
+
+    protected :
+
+    private :
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] capacity The maximum number of samples that are kept. */
+        explicit
+        TimingRecorder(const size_t capacity);
+
+        /*! @brief The destructor. */
+        virtual
+        ~TimingRecorder(void);
+
+        /*! @brief Add a sample to the buffer.
+         @param[in] sample The sample to be added. */
+        void
+        addSample(const TimingSample & sample);
+
+        /*! @brief Add a sample for an operation that has just finished.
+         @param[in] kind What was measured.
+         @param[in] startTime When the operation started, as returned by getCurrentTime(). */
+        void
+        addSample(const TimingKind kind,
+                  const double     startTime);
+
+        /*! @brief Remove all the samples from the buffer. */
+        void
+        clear(void);
+
+        /*! @brief Return the average duration of the most recent samples of a given kind.
+         @param[in] kind The kind of sample of interest.
+         @param[in] maxSamples The maximum number of samples to average.
+         @return The average duration, in milliseconds, or zero if there are no such samples. */
+        double
+        getAverageDuration(const TimingKind kind,
+                           const size_t     maxSamples)
+        const;
+
+        /*! @brief Return the current time, in milliseconds since the recorder was created.
+         @return The current time, in milliseconds since the recorder was created. */
+        double
+        getCurrentTime(void)
+        const;
+
+        /*! @brief Find the most recent sample of a given kind.
+         @param[in] kind The kind of sample of interest.
+         @param[out] result The most recent sample of the given kind.
+         @return @c true if there was a sample of the given kind and @c false otherwise. */
+        bool
+        getLatestSample(const TimingKind kind,
+                        TimingSample &   result)
+        const;
+
+        /*! @brief Return a copy of the samples in the buffer, oldest first.
+         @param[out] result The samples in the buffer. */
+        void
+        getSamples(TimingSamples & result)
+        const;
+
+        /*! @brief Return the name of a kind of sample, as used in the CSV output.
+         @param[in] kind The kind of sample.
+         @return The name of the kind of sample. */
+        static const char *
+        nameForKind(const TimingKind kind);
+
+        /*! @brief Record that the Registry Service has reported a change in the network. */
+        void
+        noteRegistryStatusEvent(void);
+
+        /*! @brief Record that a scan has finished and its results are available. */
+        void
+        noteScanCompleted(void);
+
+        /*! @brief Record that the results of the most recent scan have been drawn, adding latency
+         samples for the scan and for any status reports that the scan covers. */
+        void
+        noteScanShown(void);
+
+        /*! @brief Record that a scan is starting. */
+        void
+        noteScanStarted(void);
+
+        /*! @brief Write the samples in the buffer to a file, as comma-separated values.
+         @param[in] destination The file to be written.
+         @return @c true if the file was written and @c false otherwise. */
+        bool
+        writeToFile(const File & destination)
+        const;
+
+    protected :
+
+    private :
+
+        /*! @brief Add a sample to the buffer, with the lock held.
+         @param[in] sample The sample to be added. */
+        void
+        addSampleLocked(const TimingSample & sample);
+
+        /*! @brief Return the sample at a position in the buffer, with the lock held.
+         @param[in] index The position of the sample, where zero is the oldest sample.
+         @return The sample at the given position. */
+        const TimingSample &
+        getSampleLocked(const size_t index)
+        const;
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The samples. */
+        TimingSamples _samples;
+
+        /*! @brief The lock that protects the samples and the event times. */
+        CriticalSection _lock;
+
+        /*! @brief The time at which the recorder was created, in milliseconds. */
+        double _baseTime;
+
+        /*! @brief The time of the earliest status report that hasn't yet been shown, or a negative
+         value if there is none. */
+        double _pendingRegistryEventTime;
+
+        /*! @brief The time at which the most recent completed scan started. */
+        double _completedScanStartTime;
+
+        /*! @brief The time at which the most recent scan finished, or a negative value if its
+         results have been shown. */
+        double _completedScanEndTime;
+
+        /*! @brief The time at which the current scan started. */
+        double _currentScanStartTime;
+
+        /*! @brief The number of samples in the buffer. */
+        size_t _count;
+
+        /*! @brief The position in the buffer where the next sample will go. */
+        size_t _nextSample;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimingRecorder)
+
+    }; // TimingRecorder
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmTimingRecorder_HPP_)
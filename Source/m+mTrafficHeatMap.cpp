@@ -0,0 +1,440 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mTrafficHeatMap.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the colouring of connections by their traffic.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mTrafficHeatMap.hpp"
+#include "m+mChannelContainer.hpp"
+#include "m+mChannelEntry.hpp"
+#include "m+mEntitiesPanel.hpp"
+#include "m+mManagerApplication.hpp"
+#include "m+mMetricsPoller.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the colouring of connections by their traffic. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The smallest byte rate at the top of the scale, when the scale is set by the busiest
+ channel. */
+static const float kMinimumScaleMaximum = 1;
+
+/*! @brief The thickness of a connection with the most traffic. */
+static const float kMaximumTrafficWidth = 12;
+
+/*! @brief The thickness of a connection with no traffic; this is the usual thickness of a
+ connection. */
+static const float kMinimumTrafficWidth = 2;
+
+/*! @brief The number of seconds after which a sample no longer represents the traffic of a
+ channel. */
+static const double kStaleSampleTime = 10;
+
+/*! @brief The environment variable that holds the byte rate at the top of the scale; if it is
+ not set, the scale is set by the busiest channel. */
+static const char * kTrafficMaximumVariable = "MPM_MANAGER_TRAFFIC_MAXIMUM";
+
+/*! @brief The colour to be used for connections whose traffic isn't being measured. */
+static const Colour & kUnmeasuredColour(Colours::grey);
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Returns the byte rate at the top of the scale, if it is fixed.
+ @return The byte rate at the top of the scale, or zero if the scale is set by the busiest
+ channel. */
+static float
+getFixedScaleMaximum(void)
+{
+    String maximumAsString(ManagerApplication::getEnvironmentVar(kTrafficMaximumVariable));
+    float  maximum;
+
+    if (maximumAsString.isEmpty())
+    {
+        maximum = 0;
+    }
+    else
+    {
+        maximum = jmax(0.0f, maximumAsString.getFloatValue());
+    }
+    return maximum;
+} // getFixedScaleMaximum
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+TrafficHeatMap::TrafficHeatMap(EntitiesPanel & owner) :
+    inherited1(), inherited2(), _inRates(), _outRates(), _owner(owner), _poller(NULL),
+    _fixedMaximum(getFixedScaleMaximum()), _scaleMaximum(kMinimumScaleMaximum), _colouring(false),
+    _logarithmic(false), _thickening(false)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    if (0 < _fixedMaximum)
+    {
+        _scaleMaximum = _fixedMaximum;
+    }
+    ODL_EXIT_P(this); //####
+} // TrafficHeatMap::TrafficHeatMap
+
+TrafficHeatMap::~TrafficHeatMap(void)
+{
+    ODL_OBJENTER(); //####
+    setMetricsPoller(NULL);
+    ODL_OBJEXIT(); //####
+} // TrafficHeatMap::~TrafficHeatMap
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+TrafficHeatMap::changeListenerCallback(ChangeBroadcaster * source)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("source = ", source); //####
+    // The appearance is only worked out while it is being shown.
+    if (isActive())
+    {
+        refresh();
+    }
+    ODL_OBJEXIT(); //####
+} // TrafficHeatMap::changeListenerCallback
+
+void
+TrafficHeatMap::getAppearance(const YarpString & sourceName,
+                              const YarpString & destinationName,
+                              Colour &           colour,
+                              float &            width)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("sourceName = ", sourceName, "destinationName = ", destinationName); //####
+    ODL_P2("colour = ", &colour, "width = ", &width); //####
+    float rate;
+
+    colour = Colours::transparentBlack;
+    width = 0;
+    if (getConnectionRate(sourceName, destinationName, rate))
+    {
+        float level = getLevelForRate(rate);
+
+        if (_colouring)
+        {
+            colour = getColourForLevel(level);
+        }
+        if (_thickening)
+        {
+            width = kMinimumTrafficWidth + (level * (kMaximumTrafficWidth -
+                                                     kMinimumTrafficWidth));
+        }
+    }
+    else if (_colouring)
+    {
+        colour = kUnmeasuredColour;
+    }
+    ODL_OBJEXIT(); //####
+} // TrafficHeatMap::getAppearance
+
+Colour
+TrafficHeatMap::getColourForLevel(const float level)
+{
+    ODL_ENTER(); //####
+    ODL_D1("level = ", level); //####
+    // Blue for no traffic, through green and yellow, to red for the most traffic.
+    Colour result(Colour::fromHSV((1 - jlimit(0.0f, 1.0f, level)) * 0.66f, 0.9f, 0.95f, 1.0f));
+
+    ODL_EXIT(); //####
+    return result;
+} // TrafficHeatMap::getColourForLevel
+
+bool
+TrafficHeatMap::getConnectionRate(const YarpString & sourceName,
+                                  const YarpString & destinationName,
+                                  float &            rate)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("sourceName = ", sourceName, "destinationName = ", destinationName); //####
+    ODL_P1("rate = ", &rate); //####
+    TrafficRateMap::const_iterator sent(_outRates.find(sourceName));
+    TrafficRateMap::const_iterator received(_inRates.find(destinationName));
+    bool                           okSoFar = true;
+
+    // A channel's rate covers all of its connections, so the lower rate of the two ends is
+    // the closer to the rate of this connection.
+    if (_outRates.end() == sent)
+    {
+        if (_inRates.end() == received)
+        {
+            okSoFar = false;
+        }
+        else
+        {
+            rate = received->second;
+        }
+    }
+    else if (_inRates.end() == received)
+    {
+        rate = sent->second;
+    }
+    else
+    {
+        rate = jmin(sent->second, received->second);
+    }
+    ODL_OBJEXIT_B(okSoFar); //####
+    return okSoFar;
+} // TrafficHeatMap::getConnectionRate
+
+float
+TrafficHeatMap::getLevelForRate(const float rate)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("rate = ", rate); //####
+    float result;
+
+    if (_logarithmic)
+    {
+        result = static_cast<float>(log10(1.0 + jmax(0.0f, rate)) / log10(1.0 + _scaleMaximum));
+    }
+    else
+    {
+        result = jmax(0.0f, rate) / _scaleMaximum;
+    }
+    result = jmin(1.0f, result);
+    ODL_OBJEXIT_D(result); //####
+    return result;
+} // TrafficHeatMap::getLevelForRate
+
+float
+TrafficHeatMap::getRateForLevel(const float level)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("level = ", level); //####
+    float result;
+
+    if (_logarithmic)
+    {
+        result = static_cast<float>(pow(1.0 + _scaleMaximum, level) - 1.0);
+    }
+    else
+    {
+        result = level * _scaleMaximum;
+    }
+    ODL_OBJEXIT_D(result); //####
+    return result;
+} // TrafficHeatMap::getRateForLevel
+
+Colour
+TrafficHeatMap::getUnmeasuredColour(void)
+{
+    ODL_ENTER(); //####
+    ODL_EXIT(); //####
+    return kUnmeasuredColour;
+} // TrafficHeatMap::getUnmeasuredColour
+
+void
+TrafficHeatMap::refresh(void)
+{
+    ODL_OBJENTER(); //####
+    ConnectionEndsList widthChanged;
+
+    _inRates.clear();
+    _outRates.clear();
+    if (_poller && isActive())
+    {
+        const MetricsHistory & history = _poller->getHistory();
+        double                 now = static_cast<double>(Time::currentTimeMillis()) / 1000;
+
+        for (size_t ii = 0, mm = _owner.getNumberOfEntities(); mm > ii; ++ii)
+        {
+            ChannelContainer * anEntity = _owner.getEntity(ii);
+
+            for (int jj = 0, nn = (anEntity ? anEntity->getNumPorts() : 0); nn > jj; ++jj)
+            {
+                ChannelEntry * aPort = anEntity->getPort(jj);
+                MetricsPoint   latest;
+
+                if (aPort && history.getLatestPoint(aPort->getPortName(), latest) &&
+                    (kStaleSampleTime > (now - latest._time)))
+                {
+                    _inRates[aPort->getPortName()] = latest._average[kMetricsValueInBytes];
+                    _outRates[aPort->getPortName()] = latest._average[kMetricsValueOutBytes];
+                }
+            }
+        }
+    }
+    if (0 < _fixedMaximum)
+    {
+        _scaleMaximum = _fixedMaximum;
+    }
+    else
+    {
+        _scaleMaximum = kMinimumScaleMaximum;
+        for (TrafficRateMap::const_iterator walker(_inRates.begin()); _inRates.end() != walker;
+             ++walker)
+        {
+            _scaleMaximum = jmax(_scaleMaximum, walker->second);
+        }
+        for (TrafficRateMap::const_iterator walker(_outRates.begin()); _outRates.end() != walker;
+             ++walker)
+        {
+            _scaleMaximum = jmax(_scaleMaximum, walker->second);
+        }
+    }
+    for (size_t ii = 0, mm = _owner.getNumberOfEntities(); mm > ii; ++ii)
+    {
+        ChannelContainer * anEntity = _owner.getEntity(ii);
+
+        for (int jj = 0, nn = (anEntity ? anEntity->getNumPorts() : 0); nn > jj; ++jj)
+        {
+            ChannelEntry * aPort = anEntity->getPort(jj);
+
+            if (aPort)
+            {
+                aPort->updateConnectionTraffic(*this, widthChanged);
+            }
+        }
+    }
+    // Only the connections that changed thickness have new bounds; rebuilding the whole index
+    // would also cancel any drag in progress.
+    if (! widthChanged.empty())
+    {
+        _owner.updateSpatialIndex(widthChanged);
+    }
+    _owner.invalidateConnectionsLayer();
+    _owner.repaint();
+    sendChangeMessage();
+    ODL_OBJEXIT(); //####
+} // TrafficHeatMap::refresh
+
+void
+TrafficHeatMap::setColouring(const bool colouring)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("colouring = ", colouring); //####
+    if (colouring != _colouring)
+    {
+        _colouring = colouring;
+        refresh();
+    }
+    ODL_OBJEXIT(); //####
+} // TrafficHeatMap::setColouring
+
+void
+TrafficHeatMap::setLogarithmic(const bool logarithmic)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("logarithmic = ", logarithmic); //####
+    if (logarithmic != _logarithmic)
+    {
+        _logarithmic = logarithmic;
+        refresh();
+    }
+    ODL_OBJEXIT(); //####
+} // TrafficHeatMap::setLogarithmic
+
+void
+TrafficHeatMap::setMetricsPoller(MetricsPoller * poller)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("poller = ", poller); //####
+    if (poller != _poller)
+    {
+        if (_poller)
+        {
+            _poller->removeChangeListener(this);
+        }
+        _poller = poller;
+        if (_poller)
+        {
+            _poller->addChangeListener(this);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // TrafficHeatMap::setMetricsPoller
+
+void
+TrafficHeatMap::setThickening(const bool thickening)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("thickening = ", thickening); //####
+    if (thickening != _thickening)
+    {
+        _thickening = thickening;
+        refresh();
+    }
+    ODL_OBJEXIT(); //####
+} // TrafficHeatMap::setThickening
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
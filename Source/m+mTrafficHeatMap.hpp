@@ -0,0 +1,285 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mTrafficHeatMap.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the colouring of connections by their traffic.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmTrafficHeatMap_HPP_))
+# define mpmTrafficHeatMap_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the colouring of connections by their traffic. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class EntitiesPanel;
+    class MetricsPoller;
+
+    /*! @brief The colouring and thickening of connections by their measured traffic.
+
+     The appearance of the connections is worked out when the metrics poller reports new metrics,
+     and is kept with the connections, so that drawing a connection doesn't involve looking up its
+     traffic. The traffic of a connection is the byte rate of its channels, from the most recent
+     sample in the metrics history; connections whose channels aren't being measured are shown in
+     grey. The scale runs from zero to either a fixed maximum, taken from the environment, or the
+     busiest channel, and can be linear or logarithmic. */
+    class TrafficHeatMap : public ChangeBroadcaster,
+                           private ChangeListener
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The first class that this class is derived from. */
+        typedef ChangeBroadcaster inherited1;
+
+        /*! @brief The second class that this class is derived from. */
+        typedef ChangeListener inherited2;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] owner The panel containing the connections. */
+        explicit
+        TrafficHeatMap(EntitiesPanel & owner);
+
+        /*! @brief The destructor. */
+        virtual
+        ~TrafficHeatMap(void);
+
+        /*! @brief Return the appearance of a connection, as determined by its traffic.
+         @param[in] sourceName The name of the channel at the source of the connection.
+         @param[in] destinationName The name of the channel at the destination of the
+         connection.
+         @param[out] colour The colour of the connection, or transparent if connections aren't
+         being coloured by their traffic.
+         @param[out] width The thickness of the connection, or zero if connections aren't being
+         thickened by their traffic or the traffic of the connection isn't being measured. */
+        void
+        getAppearance(const YarpString & sourceName,
+                      const YarpString & destinationName,
+                      Colour &           colour,
+                      float &            width)
+        const;
+
+        /*! @brief Return the colour for a position on the scale.
+         @param[in] level The position on the scale, from zero to one.
+         @return The colour for the position on the scale. */
+        static Colour
+        getColourForLevel(const float level);
+
+        /*! @brief Return the byte rate for a position on the scale.
+         @param[in] level The position on the scale, from zero to one.
+         @return The byte rate for the position on the scale. */
+        float
+        getRateForLevel(const float level)
+        const;
+
+        /*! @brief Return the colour for connections whose traffic isn't being measured.
+         @return The colour for connections whose traffic isn't being measured. */
+        static Colour
+        getUnmeasuredColour(void);
+
+        /*! @brief Return @c true if connections are coloured by their traffic and @c false
+         otherwise.
+         @return @c true if connections are coloured by their traffic and @c false otherwise. */
+        inline bool
+        isColouring(void)
+        const
+        {
+            return _colouring;
+        } // isColouring
+
+        /*! @brief Return @c true if the scale is logarithmic and @c false if it is linear.
+         @return @c true if the scale is logarithmic and @c false if it is linear. */
+        inline bool
+        isLogarithmic(void)
+        const
+        {
+            return _logarithmic;
+        } // isLogarithmic
+
+        /*! @brief Return @c true if the scale has a fixed maximum and @c false if it is set by
+         the busiest connection.
+         @return @c true if the scale has a fixed maximum and @c false otherwise. */
+        inline bool
+        isScaleFixed(void)
+        const
+        {
+            return (0 < _fixedMaximum);
+        } // isScaleFixed
+
+        /*! @brief Return @c true if connections are thickened by their traffic and @c false
+         otherwise.
+         @return @c true if connections are thickened by their traffic and @c false otherwise. */
+        inline bool
+        isThickening(void)
+        const
+        {
+            return _thickening;
+        } // isThickening
+
+        /*! @brief Recalculate the appearance of the connections from the most recent metrics. */
+        void
+        refresh(void);
+
+        /*! @brief Set whether connections are coloured by their traffic.
+         @param[in] colouring @c true if connections are to be coloured by their traffic and
+         @c false if they are to be coloured by their kind. */
+        void
+        setColouring(const bool colouring);
+
+        /*! @brief Set whether the scale is logarithmic.
+         @param[in] logarithmic @c true if the scale is to be logarithmic and @c false if it is
+         to be linear. */
+        void
+        setLogarithmic(const bool logarithmic);
+
+        /*! @brief Set the source of the metrics.
+         @param[in] poller The source of the metrics, or @c NULL if there is none. */
+        void
+        setMetricsPoller(MetricsPoller * poller);
+
+        /*! @brief Set whether connections are thickened by their traffic.
+         @param[in] thickening @c true if connections are to be thickened by their traffic and
+         @c false if they are to have their usual thickness. */
+        void
+        setThickening(const bool thickening);
+
+    protected :
+
+    private :
+
+        /*! @brief Called when the metrics poller has new metrics.
+         @param[in] source The metrics poller. */
+        virtual void
+        changeListenerCallback(ChangeBroadcaster * source);
+
+        /*! @brief Return the traffic of a connection.
+         @param[in] sourceName The name of the channel at the source of the connection.
+         @param[in] destinationName The name of the channel at the destination of the
+         connection.
+         @param[out] rate The byte rate of the connection.
+         @return @c true if the traffic of the connection is being measured and @c false
+         otherwise. */
+        bool
+        getConnectionRate(const YarpString & sourceName,
+                          const YarpString & destinationName,
+                          float &            rate)
+        const;
+
+        /*! @brief Return the position of a byte rate on the scale.
+         @param[in] rate The byte rate.
+         @return The position of the byte rate on the scale, from zero to one. */
+        float
+        getLevelForRate(const float rate)
+        const;
+
+        /*! @brief Return @c true if connections are coloured or thickened by their traffic and
+         @c false otherwise.
+         @return @c true if connections are coloured or thickened by their traffic and @c false
+         otherwise. */
+        inline bool
+        isActive(void)
+        const
+        {
+            return (_colouring || _thickening);
+        } // isActive
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The byte rates arriving at the channels being measured, by channel name. */
+        TrafficRateMap _inRates;
+
+        /*! @brief The byte rates leaving the channels being measured, by channel name. */
+        TrafficRateMap _outRates;
+
+        /*! @brief The panel containing the connections. */
+        EntitiesPanel & _owner;
+
+        /*! @brief The source of the metrics. */
+        MetricsPoller * _poller;
+
+        /*! @brief The byte rate at the top of the scale, if it is fixed, or zero. */
+        float _fixedMaximum;
+
+        /*! @brief The byte rate at the top of the scale. */
+        float _scaleMaximum;
+
+        /*! @brief @c true if connections are coloured by their traffic and @c false otherwise. */
+        bool _colouring;
+
+        /*! @brief @c true if the scale is logarithmic and @c false if it is linear. */
+        bool _logarithmic;
+
+        /*! @brief @c true if connections are thickened by their traffic and @c false
+         otherwise. */
+        bool _thickening;
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[5];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrafficHeatMap)
+
+    }; // TrafficHeatMap
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmTrafficHeatMap_HPP_)
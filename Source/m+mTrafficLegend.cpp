@@ -0,0 +1,219 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mTrafficLegend.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the legend of the colouring of connections by their
+//              traffic.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mTrafficLegend.hpp"
+#include "m+mTrafficHeatMap.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the legend of the colouring of connections by their
+ traffic. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The height of the bar showing the colours of the scale. */
+static const int kBarHeight = 12;
+
+/*! @brief The height of each line of text. */
+static const int kLineHeight = 15;
+
+/*! @brief The colour to be used for the background of the legend. */
+static const Colour kLegendBackgroundColour(0xFF202020);
+
+/*! @brief The colour to be used for text in the legend. */
+static const Colour & kLegendTextColour(Colours::white);
+
+/*! @brief The width of the legend. */
+static const int kLegendWidth = 240;
+
+/*! @brief The number of steps used to draw the bar showing the colours of the scale; the scale
+ isn't linear in hue, so a gradient between its ends wouldn't match the connections. */
+static const int kNumBarSteps = 48;
+
+/*! @brief The amount of space around the content of the legend. */
+static const int kTextInset = 4;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return a byte rate as text, scaled to a readable size.
+ @param[in] value The byte rate.
+ @return The byte rate as text. */
+static String
+describeByteRate(const float value)
+{
+    String result;
+
+    if (1e6 <= value)
+    {
+        result = String(value / 1e6, 1) + " MB/s";
+    }
+    else if (1e3 <= value)
+    {
+        result = String(value / 1e3, 1) + " kB/s";
+    }
+    else
+    {
+        result = String(value, 0) + " B/s";
+    }
+    return result;
+} // describeByteRate
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+TrafficLegend::TrafficLegend(TrafficHeatMap & heatMap) :
+    inherited1(), inherited2(), _heatMap(heatMap)
+{
+    ODL_ENTER(); //####
+    ODL_P1("heatMap = ", &heatMap); //####
+    setOpaque(true);
+    setInterceptsMouseClicks(false, false);
+    setSize(kLegendWidth, (3 * kLineHeight) + kBarHeight + (2 * kTextInset));
+    _heatMap.addChangeListener(this);
+    ODL_EXIT_P(this); //####
+} // TrafficLegend::TrafficLegend
+
+TrafficLegend::~TrafficLegend(void)
+{
+    ODL_OBJENTER(); //####
+    _heatMap.removeChangeListener(this);
+    ODL_OBJEXIT(); //####
+} // TrafficLegend::~TrafficLegend
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+TrafficLegend::changeListenerCallback(ChangeBroadcaster * source)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("source = ", source); //####
+    setVisible(_heatMap.isColouring() || _heatMap.isThickening());
+    if (isVisible())
+    {
+        repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // TrafficLegend::changeListenerCallback
+
+void
+TrafficLegend::paint(Graphics & gg)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    int    innerWidth = getWidth() - (2 * kTextInset);
+    int    barTop = kTextInset + kLineHeight;
+    int    labelTop = barTop + kBarHeight;
+    String title("Traffic");
+
+    if (_heatMap.isLogarithmic())
+    {
+        title += ", logarithmic";
+    }
+    title += (_heatMap.isScaleFixed() ? ", fixed scale" : ", scaled to busiest channel");
+    gg.fillAll(kLegendBackgroundColour);
+    gg.setColour(kLegendTextColour);
+    gg.setFont(static_cast<float>(kLineHeight - 2));
+    gg.drawText(title, kTextInset, kTextInset, innerWidth, kLineHeight,
+                Justification::centredLeft, true);
+    for (int ii = 0; kNumBarSteps > ii; ++ii)
+    {
+        float left = kTextInset + ((ii * innerWidth) / static_cast<float>(kNumBarSteps));
+        float right = kTextInset + (((ii + 1) * innerWidth) / static_cast<float>(kNumBarSteps));
+
+        gg.setColour(TrafficHeatMap::getColourForLevel(ii / static_cast<float>(kNumBarSteps -
+                                                                                 1)));
+        gg.fillRect(left, static_cast<float>(barTop), right - left,
+                    static_cast<float>(kBarHeight));
+    }
+    gg.setColour(kLegendTextColour);
+    gg.drawText(describeByteRate(_heatMap.getRateForLevel(0)), kTextInset, labelTop,
+                innerWidth / 3, kLineHeight, Justification::centredLeft, true);
+    gg.drawText(describeByteRate(_heatMap.getRateForLevel(0.5f)), kTextInset + (innerWidth / 3),
+                labelTop, innerWidth / 3, kLineHeight, Justification::centred, true);
+    gg.drawText(describeByteRate(_heatMap.getRateForLevel(1)),
+                kTextInset + ((2 * innerWidth) / 3), labelTop, innerWidth / 3, kLineHeight,
+                Justification::centredRight, true);
+    gg.setColour(TrafficHeatMap::getUnmeasuredColour());
+    gg.fillRect(kTextInset, labelTop + kLineHeight + ((kLineHeight - kBarHeight) / 2), kBarHeight,
+                kBarHeight);
+    gg.setColour(kLegendTextColour);
+    gg.drawText("Not measured", (2 * kTextInset) + kBarHeight, labelTop + kLineHeight,
+                innerWidth - (kTextInset + kBarHeight), kLineHeight, Justification::centredLeft,
+                true);
+    ODL_OBJEXIT(); //####
+} // TrafficLegend::paint
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,123 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mTrafficLegend.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the legend of the colouring of connections by their
+//              traffic.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2014 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-19
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmTrafficLegend_HPP_))
+# define mpmTrafficLegend_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the legend of the colouring of connections by their
+ traffic. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class TrafficHeatMap;
+
+    /*! @brief A small panel that shows the scale used to colour and thicken connections by their
+     traffic.
+
+     The panel shows itself while connections are being coloured or thickened by their traffic,
+     and is redrawn whenever the appearance of the connections is recalculated. */
+    class TrafficLegend : public Component,
+                          private ChangeListener
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The first class that this class is derived from. */
+        typedef Component inherited1;
+
+        /*! @brief The second class that this class is derived from. */
+        typedef ChangeListener inherited2;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] heatMap The source of the scale. */
+        explicit
+        TrafficLegend(TrafficHeatMap & heatMap);
+
+        /*! @brief The destructor. */
+        virtual
+        ~TrafficLegend(void);
+
+    protected :
+
+    private :
+
+        /*! @brief Called when the appearance of the connections has been recalculated.
+         @param[in] source The source of the scale. */
+        virtual void
+        changeListenerCallback(ChangeBroadcaster * source);
+
+        /*! @brief Draw the content of the component.
+         @param[in,out] gg The graphics context in which to draw. */
+        virtual void
+        paint(Graphics & gg);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The source of the scale. */
+        TrafficHeatMap & _heatMap;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrafficLegend)
+
+    }; // TrafficLegend
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmTrafficLegend_HPP_)